@@ -1,12 +1,56 @@
 #ifndef CLUSTER_HLSLI
 #define CLUSTER_HLSLI
 
-// https://github.com/azer89/HelloVulkan
-// https://github.com/DaveH355/clustered-shading
-// https://github.com/pezcode/Cluster
-// https://github.com/topics/clustered-shading?l=c%2B%2B
+// ===================================================
+// Shaders/Cluster.hlsli
+// Lookup of clustered light lists built on CPU.
+// See Source/Engine/Render/LightClusters.hpp.
+// ===================================================
 
-// https://github.com/azer89/HelloDX12
-// https://github.com/azer89/HelloDX12/blob/main/HelloDX12/Shader/Mipmap.hlsl
+struct ClusterInfo
+{
+	uint	TilesX;
+	uint	TilesY;
+	uint	Slices;
+	uint	LightCount;
+	float	ScreenWidth;
+	float	ScreenHeight;
+	// Slice = log(ViewZ) * SliceScale - SliceBias
+	float	SliceScale;
+	float	SliceBias;
+};
+
+// Lights of a cluster are LightIndices[Offset, Offset + Count).
+struct ClusterRange
+{
+	uint Offset;
+	uint Count;
+};
+
+static const uint INVALID_CLUSTER = 0xFFFFFFFF;
+
+// Cluster of a pixel at given view space depth.
+// Returns INVALID_CLUSTER past the last slice.
+static uint GetClusterIndex(ClusterInfo Info, float2 PixelPosition, float ViewZ)
+{
+	const int slice = (int)floor(log(max(ViewZ, 1e-4f)) * Info.SliceScale - Info.SliceBias);
+	if (slice >= (int)Info.Slices)
+	{
+		return INVALID_CLUSTER;
+	}
+
+	const uint tileX = min((uint)(PixelPosition.x / Info.ScreenWidth * Info.TilesX), Info.TilesX - 1);
+	const uint tileY = min((uint)(PixelPosition.y / Info.ScreenHeight * Info.TilesY), Info.TilesY - 1);
+
+	return tileX + tileY * Info.TilesX + (uint)max(slice, 0) * Info.TilesX * Info.TilesY;
+}
+
+// Smooth falloff to zero at light range, so lights cut by cluster bounds have no visible edge.
+static float GetRangeWindow(float Distance, float Range)
+{
+	const float ratio = Distance / max(Range, 1e-4f);
+	const float window = saturate(1.0f - ratio * ratio * ratio * ratio);
+	return window * window;
+}
 
 #endif // CLUSTER_HLSLI
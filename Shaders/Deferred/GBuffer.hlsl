@@ -1,21 +1,29 @@
 #ifndef GBUFFER_HLSL
 #define GBUFFER_HLSL
 
+// Permutation defines; bit order matches MaterialFeature:
+//	ALPHA_TEST		- texels below material's AlphaCutoff are discarded.
+//	DOUBLE_SIDED	- drawn without culling; normals of back faces are flipped.
+//	NO_NORMAL_MAP	- vertex normals only; normal texture is never sampled.
+
 #include "../Material.hlsli"
 
-cbuffer cbPerObject : register(b0, space0)
+struct InstanceData
 {
 	row_major float4x4 WVP;
 	row_major float4x4 World;
 };
 
-struct Vertex
+struct DrawData
 {
 	uint VertexIndex;
+	uint BaseInstance;
 };
 
-ConstantBuffer<Vertex> vertexBuffer : register(b1, space0);
-ConstantBuffer<Material> material   : register(b2, space0);
+ConstantBuffer<DrawData> drawData	: register(b1, space0);
+ConstantBuffer<Material> material	: register(b2, space0);
+// Transforms of current frame, indexed by BaseInstance + SV_InstanceID.
+StructuredBuffer<InstanceData> instances : register(t0, space0);
 
 struct VSInput
 {
@@ -47,24 +55,31 @@ float3 GetBitangent(float4 WorldPos, float2 UV)
 // Load Vertex for current SV_VertexID.
 VSInput LoadVertex(uint Location)
 {
-	StructuredBuffer<VSInput> buffer = ResourceDescriptorHeap[vertexBuffer.VertexIndex];
+	StructuredBuffer<VSInput> buffer = ResourceDescriptorHeap[drawData.VertexIndex];
 	VSInput vertex = buffer.Load(Location);
 	
 	return vertex;
 }
 
-VSOutput VSmain(uint VertexID : SV_VertexID)
+// Load transforms for current SV_InstanceID.
+InstanceData LoadInstance(uint InstanceID)
+{
+	return instances.Load(drawData.BaseInstance + InstanceID);
+}
+
+VSOutput VSmain(uint VertexID : SV_VertexID, uint InstanceID : SV_InstanceID)
 {
 	VSInput vertex = LoadVertex(VertexID);
+	InstanceData instance = LoadInstance(InstanceID);
 	
 	VSOutput output = (VSOutput) 0;
-	output.Position			= mul(WVP, float4(vertex.Position, 1.0f));
-	output.WorldPosition	= mul(World, float4(vertex.Position, 1.0f));
+	output.Position			= mul(instance.WVP, float4(vertex.Position, 1.0f));
+	output.WorldPosition	= mul(instance.World, float4(vertex.Position, 1.0f));
 	output.TexCoord			= vertex.TexCoord;
-	output.Normal			= normalize(mul((float3x3) World, vertex.Normal));
+	output.Normal			= normalize(mul((float3x3)instance.World, vertex.Normal));
 	
 	float3x3 TBN = float3x3(vertex.Tangent, vertex.Bitangent, vertex.Normal);
-	output.TBN = mul((float3x3)World, transpose(TBN));
+	output.TBN = mul((float3x3)instance.World, transpose(TBN));
 
 	return output;
 }
@@ -82,7 +97,7 @@ struct GBufferOutput
 	float4 WorldPosition	: SV_Target6;
 };
 
-GBufferOutput PSmain(VSOutput pin)
+GBufferOutput PSmain(VSOutput pin, bool bFrontFace : SV_IsFrontFace)
 {
 	GBufferOutput output = (GBufferOutput) 0;
 
@@ -99,21 +114,28 @@ GBufferOutput PSmain(VSOutput pin)
 		Texture2D<float4> texture = ResourceDescriptorHeap[material.BaseColorIndex];
 		output.BaseColor = material.BaseColorFactor * texture.Sample(texSampler, pin.TexCoord);
 		
+#ifdef ALPHA_TEST
 		if (output.BaseColor.a < material.AlphaCutoff)
 		{
 			discard;
 		}
+#endif
 	}
 	
+#ifdef DOUBLE_SIDED
+	const float faceSign = bFrontFace ? 1.0f : -1.0f;
+#else
+	const float faceSign = 1.0f;
+#endif
+
+#ifdef NO_NORMAL_MAP
+	output.Normal = float4(faceSign * pin.Normal, 1.0f);
+#else
 	// Load and transform Normal texture
-	output.Normal = float4(pin.Normal, 1.0f);
-	if (material.NormalIndex > INVALID_INDEX)
-	{
-		Texture2D<float4> normalTexture = ResourceDescriptorHeap[material.NormalIndex];
-		float4 normalMap = normalize(2.0f * normalTexture.Sample(texSampler, pin.TexCoord) - float4(1.0f, 1.0f, 1.0f, 1.0f));
-		output.Normal = float4(normalize(mul(pin.TBN, normalMap.xyz)), normalMap.w);
-	
-	}
+	Texture2D<float4> normalTexture = ResourceDescriptorHeap[material.NormalIndex];
+	float4 normalMap = normalize(2.0f * normalTexture.Sample(texSampler, pin.TexCoord) - float4(1.0f, 1.0f, 1.0f, 1.0f));
+	output.Normal = float4(faceSign * normalize(mul(pin.TBN, normalMap.xyz)), normalMap.w);
+#endif
 	
 	// Load MetalRoughness texture
 	output.MetalRoughness = float4(0.0f, material.RoughnessFactor, material.MetallicFactor, 1.0f);
@@ -3,13 +3,13 @@
 
 #include "DeferredCommon.hlsli"
 #include "../Camera.hlsli"
+#include "../Cluster.hlsli"
 #include "../Lights.hlsli"
 
 struct LightsData
 {
 	DirectionalLight Directional;
-	PointLight Light[4];
-	//float4 padding[11];
+	ClusterInfo Clusters;
 };
 
 struct GBuffers
@@ -35,6 +35,10 @@ ConstantBuffer<LightsData> Lights : register(b1, space0);
 ConstantBuffer<GBuffers> GBufferIndices : register(b2, space0);
 ConstantBuffer<IBLTextures> IBL : register(b3, space0);
 
+StructuredBuffer<PointLight>	PointLights		: register(t0, space0);
+StructuredBuffer<ClusterRange>	ClusterRanges	: register(t1, space0);
+StructuredBuffer<uint>			LightIndices	: register(t2, space0);
+
 ScreenQuadOutput VSmain(uint VertexID : SV_VertexID)
 {
 	ScreenQuadOutput output = (ScreenQuadOutput) 0;
@@ -82,26 +86,36 @@ float4 PSmain(ScreenQuadOutput pin) : SV_TARGET
 	
 	float3 Lo = float3(0.0f, 0.0f, 0.0f);
 	
-	for (int i = 0; i < 4; ++i)
-	{
-		float3 L = normalize(Lights.Light[i].Position.xyz - worldPosition);
-		float3 H = normalize(V + L);
+	const float viewZ = mul(Camera.View, float4(worldPosition, 1.0f)).z;
+	const uint clusterIndex = GetClusterIndex(Lights.Clusters, position, viewZ);
 	
-		float NdotL = max(dot(N, L), 0.0f);
+	if (clusterIndex != INVALID_CLUSTER)
+	{
+		const ClusterRange cluster = ClusterRanges[clusterIndex];
+		
+		for (uint i = 0; i < cluster.Count; ++i)
+		{
+			const PointLight light = PointLights[LightIndices[cluster.Offset + i]];
 			
-		float distance = length(Lights.Light[i].Position.xyz - worldPosition);
-		float attenuation = 1.0f / (distance * distance + 1.0f);
-		float3 radiance = Lights.Light[i].Ambient.rgb * (attenuation * Lights.Light[i].Range);
-
-		// Cook-Torrance BRDF
-		float NDF = GetDistributionGGX(N, H, roughness);
-		float G = GetGeometrySmith(N, V, L, roughness);
-
-		float3	numerator = NDF * G * F;
-		float	denominator = 4.0f * NdotV * NdotL;
-		float3	specular = numerator / max(denominator, Epsilon);
+			float3 L = normalize(light.Position.xyz - worldPosition);
+			float3 H = normalize(V + L);
 		
-		Lo += Lights.Light[i].Visibility * ((kD * (baseColor.rgb / PI)) + specular) * radiance * NdotL;
+			float NdotL = max(dot(N, L), 0.0f);
+				
+			float distance = length(light.Position.xyz - worldPosition);
+			float attenuation = GetRangeWindow(distance, light.Range) / (distance * distance + 1.0f);
+			float3 radiance = light.Ambient.rgb * (attenuation * light.Range);
+
+			// Cook-Torrance BRDF
+			float NDF = GetDistributionGGX(N, H, roughness);
+			float G = GetGeometrySmith(N, V, L, roughness);
+
+			float3	numerator = NDF * G * F;
+			float	denominator = 4.0f * NdotV * NdotL;
+			float3	specular = numerator / max(denominator, Epsilon);
+			
+			Lo += light.Visibility * ((kD * (baseColor.rgb / PI)) + specular) * radiance * NdotL;
+		}
 	}
 	
 	float3 directional = float3(0.0f, 0.0f, 0.0f);
@@ -5,8 +5,10 @@
 
 namespace lde::editor
 {
-	void DrawFloat3(std::string_view Label, DirectX::XMFLOAT3& Float3, float ResetValue)
+	bool DrawFloat3(std::string_view Label, DirectX::XMFLOAT3& Float3, float ResetValue)
 	{
+		bool bChanged = false;
+
 		if (ImGui::BeginTable("XYZ", 2, ImGuiTableFlags_BordersInner | ImGuiTableFlags_Resizable))
 		{
 			ImGui::PushID(Label.data());
@@ -27,12 +29,13 @@ namespace lde::editor
 				if (ImGui::Button("X"))
 				{
 					Float3.x = ResetValue;
+					bChanged = true;
 				}
 
 				ImGui::PopStyleColor(3);
 
 				ImGui::SameLine();
-				ImGui::DragFloat("##X", &Float3.x);
+				bChanged |= ImGui::DragFloat("##X", &Float3.x);
 				ImGui::PopItemWidth();
 				ImGui::SameLine();
 			}
@@ -44,12 +47,13 @@ namespace lde::editor
 				if (ImGui::Button("Y"))
 				{
 					Float3.y = ResetValue;
+					bChanged = true;
 				}
 
 				ImGui::PopStyleColor(3);
 
 				ImGui::SameLine();
-				ImGui::DragFloat("##Y", &Float3.y);
+				bChanged |= ImGui::DragFloat("##Y", &Float3.y);
 				ImGui::PopItemWidth();
 				ImGui::SameLine();
 			}
@@ -61,12 +65,13 @@ namespace lde::editor
 				if (ImGui::Button("Z"))
 				{
 					Float3.z = ResetValue;
+					bChanged = true;
 				}
 
 				ImGui::PopStyleColor(3);
 
 				ImGui::SameLine();
-				ImGui::DragFloat("##Z", &Float3.z);
+				bChanged |= ImGui::DragFloat("##Z", &Float3.z);
 				ImGui::PopItemWidth();
 			}
 
@@ -76,21 +81,23 @@ namespace lde::editor
 		}
 
 		ImGui::Separator();
+
+		return bChanged;
 	}
 
-	void DrawColorEdit(std::string_view Label, DirectX::XMFLOAT4& Float4)
+	bool DrawColorEdit(std::string_view Label, DirectX::XMFLOAT4& Float4)
 	{
 		float* color[4] = { &Float4.x, &Float4.y, &Float4.z, &Float4.w };
 		ImGui::Text(Label.data());
 		ImGui::SameLine();
-		ImGui::ColorEdit4("##Label", *color, ImGuiColorEditFlags_NoBorder);
+		return ImGui::ColorEdit4("##Label", *color, ImGuiColorEditFlags_NoBorder);
 
 		//ImGui::Separator();
 	}
 
-	void DrawPointLight(std::string_view Label, PointLightComponent& LightComponent)
+	bool DrawPointLight(std::string_view Label, PointLightComponent& LightComponent)
 	{
-		DrawFloat3("Position", LightComponent.Position);
+		bool bChanged = DrawFloat3("Position", LightComponent.Position);
 		if (ImGui::BeginTable("XYZ", 2, ImGuiTableFlags_Resizable)) // ImGuiTableFlags_BordersInner |
 		{
 			ImGui::PushID(Label.data());
@@ -100,7 +107,7 @@ namespace lde::editor
 
 			ImGui::Text("Visibility");
 			ImGui::TableNextColumn();
-			ImGui::SliderFloat("##Visibility", &LightComponent.Visibility, 0.0f, 1.0f);
+			bChanged |= ImGui::SliderFloat("##Visibility", &LightComponent.Visibility, 0.0f, 1.0f);
 
 			ImGui::TableNextRow();
 			ImGui::TableNextColumn();
@@ -108,18 +115,20 @@ namespace lde::editor
 
 			ImGui::TableNextColumn();
 			float* color[4] = { &LightComponent.Ambient.x, &LightComponent.Ambient.y, &LightComponent.Ambient.z, &LightComponent.Ambient.w };
-			ImGui::ColorEdit4("##Ambient", *color, ImGuiColorEditFlags_NoBorder);
+			bChanged |= ImGui::ColorEdit4("##Ambient", *color, ImGuiColorEditFlags_NoBorder);
 
 			ImGui::TableNextRow();
 			ImGui::TableNextColumn();
 			ImGui::Text("Range");
 			ImGui::TableNextColumn();
-			ImGui::DragFloat("##Range", &LightComponent.Range, 1.0f, 0.0f, 100.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+			bChanged |= ImGui::DragFloat("##Range", &LightComponent.Range, 1.0f, 0.0f, 100.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 
 			ImGui::PopID();
 			ImGui::EndTable();
 			ImGui::Separator();
 		}
+
+		return bChanged;
 	}
 
 } //namespace lde::editor
@@ -10,10 +10,12 @@ namespace lde
 
 namespace lde::editor
 {
-	extern void DrawFloat3(std::string_view Label, DirectX::XMFLOAT3& Float3, float ResetValue = 0.0f);
+	// Draw functions return true if value was changed.
 
-	extern void DrawColorEdit(std::string_view Label, DirectX::XMFLOAT4& Float4);
+	extern bool DrawFloat3(std::string_view Label, DirectX::XMFLOAT3& Float3, float ResetValue = 0.0f);
+
+	extern bool DrawColorEdit(std::string_view Label, DirectX::XMFLOAT4& Float4);
 	
-	extern void DrawPointLight(std::string_view Label, PointLightComponent& LightComponent);
+	extern bool DrawPointLight(std::string_view Label, PointLightComponent& LightComponent);
 
 } // namespace lde::editor
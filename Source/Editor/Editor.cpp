@@ -9,10 +9,13 @@
 #include "EditorTheme.hpp"
 #include <Engine/Core/Logger.hpp>
 #include <Engine/Core/Utility.hpp>
+#include <Engine/Graphics/MeshRegistry.hpp>
 #include <Engine/RHI/RHICommon.hpp>
 #include <Engine/Scene/Components/CameraComponent.hpp>
 #include <Engine/Scene/Components/NameComponent.hpp>
 #include <Engine/Scene/Components/TransformComponent.hpp>
+#include <Engine/Scene/ScenePicker.hpp>
+#include <Engine/Scene/SceneSerializer.hpp>
 #include <FontAwesome/IconsFontAwesome6.h>
 #include <ImGui/imgui_internal.h>
 
@@ -24,6 +27,7 @@ namespace lde::editor
 
 	constexpr auto EDITOR_FONT		= "Assets/Fonts/CascadiaCode-SemiBold.ttf";
 	constexpr auto ICONS_FONT		= "Assets/Fonts/fa-solid-900.ttf";
+	constexpr auto SCENE_SNAPSHOT	= "scene.ldescene";
 
 	Editor::Editor(D3D12RHI* pGfx, Renderer* pRenderer, Timer* pTimer)
 		: m_Gfx(pGfx), m_Renderer(pRenderer), m_Timer(pTimer)
@@ -85,6 +89,8 @@ namespace lde::editor
 		m_EditorViewport = ImGui::GetMainViewport();
 		m_EditorViewport->Flags |= ImGuiViewportFlags_TopMost;
 		m_EditorViewport->Flags |= ImGuiViewportFlags_OwnedByApp;
+
+		m_Picker = std::make_unique<ScenePicker>();
 		
 		LOG_INFO("Editor: Editor layer initialized.");
 	}
@@ -187,17 +193,26 @@ namespace lde::editor
 
 		DrawProperties<PointLightComponent>(Entity, [&](auto& Component)
 			{
-				DrawPointLight(tag.Name, Component);	
+				// Lets SceneLighting upload only edited lights.
+				if (DrawPointLight(tag.Name, Component))
+				{
+					Entity.PatchComponent<PointLightComponent>();
+				}
 			});
 
 		DrawProperties<DirectionalLightComponent>(Entity, [&](auto& Component)
 			{
-				DrawFloat3("Direction", Component.Direction);
-				DrawColorEdit("Ambient", Component.Ambient);
+				bool bChanged = DrawFloat3("Direction", Component.Direction);
+				bChanged |= DrawColorEdit("Ambient", Component.Ambient);
 				ImGui::Text("Visibility");
 				ImGui::SameLine();
-				ImGui::SliderFloat("##Visibility", &Component.Visibility, 0.0f, 1.0f);
+				bChanged |= ImGui::SliderFloat("##Visibility", &Component.Visibility, 0.0f, 1.0f);
 				ImGui::Text("Casts shadows");
+
+				if (bChanged)
+				{
+					Entity.PatchComponent<DirectionalLightComponent>();
+				}
 			});
 	}
 
@@ -274,19 +289,23 @@ namespace lde::editor
 
 			if (ImGui::MenuItem(ICON_FA_FOLDER_OPEN" Open", "Ctrl+O"))
 			{
-
+				// Scene buffers are in use by current frame; snapshot is loaded before next one.
+				m_SelectedEntity = Entity();
+				m_Picker->Reset();
+				m_ActiveScene->PendingSnapshot = SCENE_SNAPSHOT;
 			}
 
 			if (ImGui::MenuItem(ICON_FA_FLOPPY_DISK" Save", "Ctrl+S"))
 			{
-				
+				SceneSerializer::Save(m_ActiveScene, SCENE_SNAPSHOT);
 			}
 
 			ImGui::SeparatorText("Exit");
 
 			if (ImGui::MenuItem(ICON_FA_POWER_OFF" Save and Exit"))
 			{
-			
+				SceneSerializer::Save(m_ActiveScene, SCENE_SNAPSHOT);
+				::PostQuitMessage(0);
 			}
 			if (ImGui::MenuItem(ICON_FA_POWER_OFF" Exit"))
 			{
@@ -400,14 +419,37 @@ namespace lde::editor
 		auto viewportSize{ ImGui::GetContentRegionAvail() };
 		ImGui::Image((ImTextureID)m_Renderer->GetRenderTarget(), viewportSize);
 
+		if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+		{
+			PickEntity(ImGui::GetMousePos(), ImGui::GetItemRectMin(), ImGui::GetItemRectSize());
+		}
+
 		ImGui::End();
 	}
 
+	void Editor::PickEntity(ImVec2 MousePosition, ImVec2 ImageMin, ImVec2 ImageSize)
+	{
+		if (ImageSize.x <= 0.0f || ImageSize.y <= 0.0f)
+		{
+			return;
+		}
+
+		// Image is stretched over whole window, so cursor maps straight into NDC.
+		const float ndcX = ((MousePosition.x - ImageMin.x) / ImageSize.x) * 2.0f - 1.0f;
+		const float ndcY = 1.0f - ((MousePosition.y - ImageMin.y) / ImageSize.y) * 2.0f;
+
+		const auto ray = ScenePicker::GetRay(m_ActiveScene->GetCamera(), ndcX, ndcY);
+		const auto result = m_Picker->Pick(m_ActiveScene, ray);
+
+		m_SelectedEntity = result.IsValid() ? Entity(m_ActiveScene->World(), result.Entity) : Entity();
+	}
+
 	void Editor::DrawHierarchy()
 	{
 		ImGui::Begin("Hierarchy");
 
 		DrawSceneProperties(); 
+		DrawWorldPartition();
 		ImGui::Separator();
 
 		auto view = m_ActiveScene->Registry()->view<NameComponent>();
@@ -476,11 +518,151 @@ namespace lde::editor
 				ImGui::EndTable();
 			}
 
+			ImGui::SeparatorText("Stats");
+
+			const auto& stats = m_Renderer->m_GBufferPass->GetStats();
+			ImGui::Text("Draws: %d Instances: %d", stats.Draws, stats.Instances);
+			ImGui::Text("Binds: %d (skipped: %d)", stats.TotalBinds(), stats.SkippedBinds);
+			ImGui::Text("Pipelines: %d Command Lists: %d", stats.PipelineBinds, stats.Chunks);
+			ImGui::Text("Vertex Buffers: %d Index Buffers: %d Materials: %d", stats.VertexBufferBinds, stats.IndexBufferBinds, stats.MaterialBinds);
+
+			const auto& clusterStats = m_Renderer->m_LightPass->GetClusterStats();
+			ImGui::Text("Point Lights: %d Light Indices: %d Uploaded: %d", clusterStats.Lights, clusterStats.Indices, m_Renderer->m_LightPass->GetUploadedLights());
+			ImGui::Text("Active Clusters: %d Max per Cluster: %d Overflows: %d", clusterStats.ActiveClusters, clusterStats.MaxPerCluster, clusterStats.Overflows);
+			ImGui::Text("Light Binning: %.3f ms", clusterStats.BuildTimeMs);
+
+			ImGui::Checkbox("Shadow Setup", &m_Renderer->m_LightPass->bShadows);
+			if (m_Renderer->m_LightPass->bShadows)
+			{
+				const auto& shadowMap = m_Renderer->m_LightPass->GetShadowMap();
+				const auto& shadowStats = shadowMap.GetStats();
+				for (uint32 i = 0; i < shadowMap.GetCascadeCount(); ++i)
+				{
+					const auto& cascade = shadowMap.GetCascade(i);
+					ImGui::Text("Cascade %d: [%.1f, %.1f] Casters: %d / %d", i, cascade.SplitNear, cascade.SplitFar, shadowStats.CascadeCasters[i], shadowStats.Casters);
+				}
+				ImGui::Text("Shadow Setup: %.3f ms", shadowStats.BuildTimeMs);
+			}
+
+			const auto meshStats = MeshRegistry::GetInstance().GetStats();
+			ImGui::Text("Mesh Assets: %d Models: %d (shared requests: %d / %d)", meshStats.Assets, meshStats.References, meshStats.Hits, meshStats.Requests);
+			ImGui::Text("Geometry Buffers: %d for %d meshes", meshStats.Geometries, meshStats.Meshes);
+			ImGui::Text("Mesh Memory: CPU %.1f MB GPU %.1f MB Geometry reloads: %d",
+				static_cast<double>(meshStats.CpuBytes) / (1024.0 * 1024.0),
+				static_cast<double>(meshStats.GpuBytes) / (1024.0 * 1024.0),
+				meshStats.GeometryReloads);
+
+			const auto srvStats = m_Gfx->Device->GetShaderResourceHeap()->GetStats();
+			ImGui::Text("SRV Heap: %d / %d (peak: %d) Free ranges: %d Largest: %d Fragmentation: %.1f%%",
+				srvStats.Used, srvStats.Capacity, srvStats.Peak, srvStats.FreeRanges, srvStats.LargestFreeRange, srvStats.Fragmentation * 100.0f);
+
+			const auto transientStats = m_Gfx->Device->GetShaderResourceHeap()->GetTransientStats();
+			ImGui::Text("Transient Descriptors: %d / %d (peak: %d) Failed: %d",
+				transientStats.LastFrame, transientStats.PerFrame, transientStats.Peak, transientStats.FailedAllocations);
+
+			const auto& graphStats = m_Renderer->GetRenderGraph().GetStats();
+			ImGui::Text("Render Graph: %d passes (culled: %d) Barriers: %d Compile: %.3f ms", graphStats.Passes, graphStats.CulledPasses, graphStats.Barriers, graphStats.CompileTimeMs);
+			ImGui::Text("Transient Memory: %.1f MB aliased into %.1f MB (%d resources, %d slots)",
+				static_cast<double>(graphStats.TransientBytes) / (1024.0 * 1024.0),
+				static_cast<double>(graphStats.AllocatedBytes) / (1024.0 * 1024.0),
+				graphStats.TransientResources, graphStats.MemorySlots);
+
+			const auto barrierStats = m_Gfx->Device->GetStateTracker()->GetStats();
+			ImGui::Text("Barriers: %d in %d batches (requested: %d skipped: %d merged: %d) Tracked: %d",
+				barrierStats.Issued, barrierStats.Batches, barrierStats.Requested, barrierStats.Skipped, barrierStats.Merged, barrierStats.Tracked);
+
+			const auto& pipelineStats = m_Gfx->Device->GetPipelineCache()->GetStats();
+			ImGui::Text("Pipelines: %d (requested: %d shared: %d from library: %d compiled: %d)",
+				pipelineStats.Pipelines, pipelineStats.Requests, pipelineStats.MemoryHits, pipelineStats.LibraryHits, pipelineStats.Created);
+
+			const auto& permutationStats = m_Renderer->m_GBufferPass->GetPermutationStats();
+			ImGui::Text("GBuffer Permutations: %d of %d (%.1f ms)", permutationStats.Compiled, permutationStats.Declared, permutationStats.CompileTimeMs);
+
+			const auto& shaderStats = ShaderCompiler::GetInstance().GetStats();
+			ImGui::Text("Shaders: %d (cached: %d compiled: %d in %.1f ms)",
+				shaderStats.Requests, shaderStats.CacheHits, shaderStats.Compiled, shaderStats.CompileTimeMs);
+
+			const auto& pickStats = m_Picker->GetStats();
+			ImGui::Text("Last Pick: %.3f ms (BVH: %.3f ms) Meshes: %d Triangles: %d", pickStats.PickTimeMs, pickStats.BuildTimeMs, pickStats.Meshes, pickStats.Triangles);
+
+			if (m_Renderer->m_LightPass->bShadows)
+			{
+				const auto& atlasStats = m_Renderer->m_LightPass->GetShadowAtlas().GetStats();
+				ImGui::Text("Shadow Atlas: %.1f%% Tiles: %d (rendered: %d cached: %d)", atlasStats.Occupancy * 100.0f, atlasStats.Allocated, atlasStats.Rendered, atlasStats.Cached);
+				ImGui::Text("Downsized: %d Rejected: %d Moved: %d Bias: %d", atlasStats.Downsized, atlasStats.Rejected, atlasStats.Moved, atlasStats.LevelBias);
+			}
+
 			ImGui::TreePop();
 		}
 
 	}
 
+	void Editor::DrawWorldPartition()
+	{
+		auto& partition = m_ActiveScene->Partition;
+		if (partition.IsEmpty())
+		{
+			return;
+		}
+
+		if (ImGui::TreeNodeEx("World Partition", ImGuiTreeNodeFlags_FramePadding))
+		{
+			const auto& stats = partition.GetStats();
+			ImGui::Text("Cells: %d Loaded: %d Loading: %d Unloading: %d", stats.Cells, stats.Loaded, stats.Loading, stats.Unloading);
+			ImGui::Text("Resident: %.1f / %.1f MB Over budget: %d",
+				static_cast<double>(stats.ResidentBytes) / (1024.0 * 1024.0),
+				static_cast<double>(partition.BudgetBytes) / (1024.0 * 1024.0),
+				stats.OverBudget);
+			ImGui::Text("Commit: %.3f ms", stats.CommitTimeMs);
+
+			// Top-down view centered on the camera, sized to fit UnloadRadius.
+			constexpr float mapSize = 200.0f;
+			const float cellSize = partition.GetCellSize();
+			const float scale = mapSize / (2.0f * (partition.UnloadRadius + cellSize));
+
+			const auto camera = m_ActiveScene->Camera->GetPositionFloat();
+			const ImVec2 origin = ImGui::GetCursorScreenPos();
+			const ImVec2 center = ImVec2(origin.x + mapSize * 0.5f, origin.y + mapSize * 0.5f);
+
+			auto toMap = [&](float X, float Z) {
+				return ImVec2(center.x + (X - camera.x) * scale, center.y - (Z - camera.z) * scale);
+			};
+
+			auto* drawList = ImGui::GetWindowDrawList();
+			drawList->PushClipRect(origin, ImVec2(origin.x + mapSize, origin.y + mapSize), true);
+			drawList->AddRectFilled(origin, ImVec2(origin.x + mapSize, origin.y + mapSize), ImGui::GetColorU32(Colors::DarkHeader));
+
+			for (const auto& cell : partition.GetCells())
+			{
+				ImU32 color = IM_COL32(80, 80, 80, 255);
+				switch (cell.State)
+				{
+				case CellState::eLoading:	[[fallthrough]];
+				case CellState::eReady:		color = IM_COL32(230, 180, 40, 255); break;
+				case CellState::eLoaded:	color = IM_COL32(60, 190, 90, 255); break;
+				case CellState::eUnloading:	color = IM_COL32(200, 60, 60, 255); break;
+				default: break;
+				}
+
+				const float x = static_cast<float>(cell.X) * cellSize;
+				const float z = static_cast<float>(cell.Z) * cellSize;
+				// Z grows upwards on the map.
+				const ImVec2 min = toMap(x, z + cellSize);
+				const ImVec2 max = toMap(x + cellSize, z);
+				drawList->AddRectFilled(ImVec2(min.x + 1.0f, min.y + 1.0f), ImVec2(max.x - 1.0f, max.y - 1.0f), color);
+			}
+
+			drawList->AddCircle(center, partition.LoadRadius * scale, IM_COL32(255, 255, 255, 160));
+			drawList->AddCircle(center, partition.UnloadRadius * scale, IM_COL32(255, 255, 255, 70));
+			drawList->AddCircleFilled(center, 3.0f, IM_COL32(255, 255, 255, 255));
+			drawList->PopClipRect();
+
+			ImGui::Dummy(ImVec2(mapSize, mapSize));
+
+			ImGui::TreePop();
+		}
+	}
+
 	void Editor::PrintLogs()
 	{
 		for (const auto& log : Logger::Logs)
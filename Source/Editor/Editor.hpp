@@ -13,6 +13,7 @@ namespace lde
 	class Renderer;
 	class Timer;
 	class Scene;
+	class ScenePicker;
 	class Entity;
 }
 
@@ -46,6 +47,8 @@ namespace lde::editor
 		void DrawLogs();
 
 		void DrawSceneProperties();
+		/// @brief Map of streamed cells around the camera.
+		void DrawWorldPartition();
 	
 	private:
 		void Initialize(D3D12RHI* pGfx, Timer* pTimer);
@@ -60,6 +63,14 @@ namespace lde::editor
 		void PrintLogs();
 		void ClearLogs();
 
+		/**
+		 * @brief Selects Model under the cursor, or clears selection if there's none.
+		 * @param MousePosition Cursor in screen space.
+		 * @param ImageMin Top-left corner of scene image.
+		 * @param ImageSize Size of scene image.
+		 */
+		void PickEntity(ImVec2 MousePosition, ImVec2 ImageMin, ImVec2 ImageSize);
+
 	private:
 		D3D12RHI*	m_Gfx	= nullptr;
 		Timer*			m_Timer	= nullptr;
@@ -78,6 +89,8 @@ namespace lde::editor
 
 		std::unique_ptr<D3D12DescriptorHeap> m_EditorHeap;
 
+		std::unique_ptr<ScenePicker> m_Picker;
+
 	};
 
 } // namespace lde::editor
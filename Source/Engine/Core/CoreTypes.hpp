@@ -5,6 +5,7 @@
 	Aliases for commonly used types.
 */
 
+#include <cstddef>
 #include <cstdint>
 //#include <type_traits>
 
@@ -1,4 +1,5 @@
 #include "FileSystem.hpp"
+#include <fstream>
 
 namespace lde::Files
 {
@@ -23,4 +24,48 @@ namespace lde::Files
 		
 		return ImageExtension::eInvalid;
     }
+
+	bool ReadBinary(const Filepath& Path, std::vector<uint8>& OutData)
+	{
+		std::ifstream stream(Path, std::ios::binary | std::ios::ate);
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		OutData.resize(static_cast<usize>(stream.tellg()));
+		stream.seekg(0);
+		stream.read(reinterpret_cast<char*>(OutData.data()), static_cast<std::streamsize>(OutData.size()));
+
+		return stream.good() || stream.eof();
+	}
+
+	bool WriteBinary(const Filepath& Path, std::span<const uint8> Data)
+	{
+		std::error_code error;
+		if (Path.has_parent_path())
+		{
+			std::filesystem::create_directories(Path.parent_path(), error);
+		}
+
+		Filepath temporary = Path;
+		temporary += ".tmp";
+
+		{
+			std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+			if (!stream.is_open())
+			{
+				return false;
+			}
+
+			stream.write(reinterpret_cast<const char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+			if (!stream.good())
+			{
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary, Path, error);
+		return !error;
+	}
 } // namespace lde::Files
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "Core/CoreTypes.hpp"
 #include <filesystem>
+#include <span>
+#include <vector>
 
 using Filepath = std::filesystem::path;
 
@@ -55,4 +58,13 @@ namespace lde::Files
 
 	ImageExtension ImageExtToEnum(std::string_view Filepath);
 
+	/// @brief Reads whole file. @return False if it can't be opened.
+	bool ReadBinary(const Filepath& Path, std::vector<uint8>& OutData);
+
+	/**
+	 * @brief Writes Data to a temporary file next to Path and renames it over Path,
+	 * so a crash mid-write never leaves a truncated file behind. Creates missing directories.
+	 */
+	bool WriteBinary(const Filepath& Path, std::span<const uint8> Data);
+
 } // namespace lde::Files
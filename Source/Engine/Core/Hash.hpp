@@ -0,0 +1,42 @@
+#pragma once
+
+/*
+	Core/Hash.hpp
+	Non-cryptographic hashing of raw memory.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <span>
+
+namespace lde::Hash
+{
+	constexpr uint64 FNV_OFFSET_BASIS	= 14695981039346656037ULL;
+	constexpr uint64 FNV_PRIME			= 1099511628211ULL;
+
+	/// @brief 64-bit FNV-1a. Pass previous result as Seed to hash multiple ranges.
+	inline uint64 FNV1a(const void* pData, usize Size, uint64 Seed = FNV_OFFSET_BASIS)
+	{
+		const auto* bytes = static_cast<const uint8*>(pData);
+		uint64 hash = Seed;
+		for (usize i = 0; i < Size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= FNV_PRIME;
+		}
+
+		return hash;
+	}
+
+	template<typename T>
+	inline uint64 FNV1a(std::span<const T> Data, uint64 Seed = FNV_OFFSET_BASIS)
+	{
+		return FNV1a(Data.data(), Data.size_bytes(), Seed);
+	}
+
+	/// @brief Mixes two hashes; order dependent.
+	inline uint64 Combine(uint64 Lhs, uint64 Rhs)
+	{
+		return Lhs ^ (Rhs + 0x9E3779B97F4A7C15ULL + (Lhs << 6) + (Lhs >> 2));
+	}
+
+} // namespace lde::Hash
@@ -2,6 +2,7 @@
 #include "Logger.hpp"
 #include "Platform/Platform.hpp"
 #include "String.hpp"
+#include <iostream>
 
 namespace lde
 {
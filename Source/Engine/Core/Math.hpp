@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CoreTypes.hpp"
 #include <cmath>
 
 namespace lde
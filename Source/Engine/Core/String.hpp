@@ -15,6 +15,18 @@ namespace lde::String
 		return std::wstring(Text.begin(), Text.end());
 	}
 
+	/// @brief Counterpart of ToWide; meant for ASCII text like entry points and compiler arguments.
+	inline std::string ToNarrow(std::wstring_view Text)
+	{
+		std::string result;
+		result.reserve(Text.size());
+		for (const wchar_t c : Text)
+		{
+			result.push_back(static_cast<char>(c));
+		}
+		return result;
+	}
+
 	inline const char* WCharToChar(wchar_t* Text)
 	{
 		size_t length = wcslen(Text) + 1;
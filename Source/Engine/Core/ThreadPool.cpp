@@ -0,0 +1,138 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace lde
+{
+	namespace
+	{
+		// Set on worker threads, so nested ParallelFor doesn't wait for itself.
+		thread_local bool t_bWorkerThread = false;
+	}
+
+	ThreadPool::ThreadPool(uint32 WorkerCount)
+	{
+		if (WorkerCount == 0)
+		{
+			WorkerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		}
+
+		m_Workers.reserve(WorkerCount);
+		for (uint32 i = 0; i < WorkerCount; ++i)
+		{
+			m_Workers.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bStop = true;
+		}
+		m_Condition.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::ParallelFor(uint32 Count, uint32 BatchSize, const std::function<void(uint32, uint32)>& Task)
+	{
+		if (Count == 0)
+		{
+			return;
+		}
+
+		BatchSize = std::max(BatchSize, 1u);
+		const uint32 batches = (Count + BatchSize - 1) / BatchSize;
+
+		if (batches == 1 || m_Workers.empty() || t_bWorkerThread)
+		{
+			Task(0, Count);
+			return;
+		}
+
+		// Helpers may be dequeued after the call returned; they only touch shared counters then.
+		struct State
+		{
+			std::atomic<uint32> Next{ 0 };
+			std::atomic<uint32> Done{ 0 };
+			uint32 Batches		= 0;
+			uint32 Count		= 0;
+			uint32 BatchSize	= 0;
+			const std::function<void(uint32, uint32)>* pTask = nullptr;
+		};
+
+		auto state = std::make_shared<State>();
+		state->Batches		= batches;
+		state->Count		= Count;
+		state->BatchSize	= BatchSize;
+		state->pTask		= &Task;
+
+		auto runBatches = [](State& Shared)
+			{
+				uint32 batch = 0;
+				while ((batch = Shared.Next.fetch_add(1, std::memory_order_relaxed)) < Shared.Batches)
+				{
+					const uint32 begin = batch * Shared.BatchSize;
+					const uint32 end = std::min(begin + Shared.BatchSize, Shared.Count);
+					(*Shared.pTask)(begin, end);
+
+					if (Shared.Done.fetch_add(1, std::memory_order_acq_rel) + 1 == Shared.Batches)
+					{
+						Shared.Done.notify_all();
+					}
+				}
+			};
+
+		const uint32 helpers = std::min(batches - 1, GetWorkerCount());
+		for (uint32 i = 0; i < helpers; ++i)
+		{
+			Enqueue([state, runBatches]() { runBatches(*state); });
+		}
+
+		runBatches(*state);
+
+		uint32 done = 0;
+		while ((done = state->Done.load(std::memory_order_acquire)) < batches)
+		{
+			state->Done.wait(done, std::memory_order_acquire);
+		}
+	}
+
+	void ThreadPool::Enqueue(std::function<void()>&& Task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Tasks.emplace_back(std::move(Task));
+		}
+		m_Condition.notify_one();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		t_bWorkerThread = true;
+
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [this]() { return m_bStop || !m_Tasks.empty(); });
+
+				if (m_bStop && m_Tasks.empty())
+				{
+					return;
+				}
+
+				task = std::move(m_Tasks.front());
+				m_Tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+} // namespace lde
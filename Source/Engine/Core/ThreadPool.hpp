@@ -0,0 +1,75 @@
+#pragma once
+
+/*
+	Core/ThreadPool.hpp
+	Persistent worker threads for CPU side jobs.
+*/
+
+#include "CoreTypes.hpp"
+#include "Singleton.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace lde
+{
+	class ThreadPool : public Singleton<ThreadPool>
+	{
+		friend class Singleton<ThreadPool>;
+	public:
+		/**
+		 * @param WorkerCount 0 spawns one worker per hardware thread, except the calling one.
+		 */
+		explicit ThreadPool(uint32 WorkerCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * @brief Queues single task.
+		 * @return Future holding result of the task.
+		 */
+		template<typename Task>
+		auto Submit(Task&& InTask) -> std::future<std::invoke_result_t<Task>>
+		{
+			using ResultType = std::invoke_result_t<Task>;
+
+			auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Task>(InTask));
+			auto future = task->get_future();
+
+			Enqueue([task]() { (*task)(); });
+
+			return future;
+		}
+
+		/**
+		 * @brief Splits [0, Count) into batches and runs them on workers and calling thread.
+		 * Returns once every batch is done. Called from a worker, runs serially.
+		 * @param Count Number of items.
+		 * @param BatchSize Items per batch.
+		 * @param Task Invoked with [Begin, End) range of a batch.
+		 */
+		void ParallelFor(uint32 Count, uint32 BatchSize, const std::function<void(uint32 Begin, uint32 End)>& Task);
+
+		uint32 GetWorkerCount() const { return static_cast<uint32>(m_Workers.size()); }
+
+	private:
+		void Enqueue(std::function<void()>&& Task);
+		void WorkerLoop();
+
+		std::vector<std::thread>			m_Workers;
+		std::deque<std::function<void()>>	m_Tasks;
+
+		std::mutex				m_Mutex;
+		std::condition_variable m_Condition;
+		bool					m_bStop = false;
+
+	};
+} // namespace lde
@@ -42,6 +42,21 @@ namespace lde
 	{
 		m_Gfx = pGfx;
 
+		ImportedModel imported = ImportGeometry(Filepath);
+
+		if (!imported.IsValid())
+		{
+			::MessageBoxA(nullptr, imported.Error.c_str(), "Import Error", MB_OK);
+			throw std::runtime_error(imported.Error);
+		}
+
+		CreateTextures(pGfx, imported);
+
+		InStaticMeshes.insert(InStaticMeshes.end(), std::make_move_iterator(imported.StaticMeshes.begin()), std::make_move_iterator(imported.StaticMeshes.end()));
+	}
+
+	ImportedModel AssetManager::ImportGeometry(std::string_view Filepath)
+	{
 		constexpr int32 LoadFlags =
 			aiProcess_Triangulate |
 			aiProcess_ConvertToLeftHanded |
@@ -51,23 +66,85 @@ namespace lde
 			aiProcess_GenBoundingBoxes |
 			aiProcess_ImproveCacheLocality;
 
+		ImportedModel model{};
+		model.Filepath = std::string(Filepath);
+
+		// Importer owns the scene, so separate calls don't share any state.
 		Assimp::Importer importer;
-		const aiScene* scene = importer.ReadFile(Filepath.data(), (uint32)LoadFlags);
+		const aiScene* scene = importer.ReadFile(model.Filepath.c_str(), (uint32)LoadFlags);
 
 		if (!scene || !scene->mRootNode || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
 		{
-			::MessageBoxA(nullptr, importer.GetErrorString(), "Import Error", MB_OK);
-			throw std::runtime_error(importer.GetErrorString());
+			model.Error = importer.GetErrorString();
+			if (model.Error.empty())
+			{
+				model.Error = std::format("Failed to import: {0}", model.Filepath);
+			}
+			return model;
+		}
+
+		LoadStaticMesh(scene, model);
+
+		return model;
+	}
+
+	void AssetManager::CreateTextures(D3D12RHI* pGfx, ImportedModel& InModel, std::vector<int32>* pCreated)
+	{
+		auto& textureManager = TextureManager::GetInstance();
+
+		auto createTexture = [&](const std::string& Path, uint32& OutIndex)
+			{
+				if (Path.empty())
+				{
+					return;
+				}
+
+				const int32 index = textureManager.Create(pGfx, Path);
+				OutIndex = static_cast<uint32>(index);
+
+				if (pCreated && index >= 0)
+				{
+					pCreated->push_back(index);
+				}
+			};
+
+		for (usize i = 0; i < InModel.StaticMeshes.size(); ++i)
+		{
+			auto& material = InModel.StaticMeshes.at(i).Material;
+			const auto& textures = InModel.Textures.at(i);
+
+			createTexture(textures.BaseColor,		material.BaseColorIndex);
+			createTexture(textures.Normal,			material.NormalIndex);
+			createTexture(textures.MetalRoughness,	material.MetalRoughnessIndex);
+			createTexture(textures.Emissive,		material.EmissiveIndex);
 		}
+	}
 
-		m_Filepath = Filepath.data();
+	ImportedModel AssetManager::Import(std::string_view Filepath)
+	{
+		return ImportGeometry(Filepath);
+	}
+
+	void AssetManager::CreateTextures(ImportedModel& InModel, std::vector<int32>& Created)
+	{
+		CreateTextures(m_Gfx, InModel, &Created);
+	}
 
-		LoadStaticMesh(scene, InStaticMeshes);
+	void AssetManager::DestroyTexture(int32 Texture)
+	{
+		TextureManager::GetInstance().Destroy(Texture);
+	}
 
+	uint64 AssetManager::GetTextureSize(int32 Texture) const
+	{
+		return TextureManager::GetInstance().GetMemorySize(Texture);
 	}
 
-	void AssetManager::LoadStaticMesh(const aiScene* pScene, std::vector<StaticMesh>& InStaticMeshes)
+	void AssetManager::LoadStaticMesh(const aiScene* pScene, ImportedModel& InModel)
 	{
+		InModel.StaticMeshes.reserve(InModel.StaticMeshes.size() + pScene->mNumMeshes);
+		InModel.Textures.reserve(InModel.Textures.size() + pScene->mNumMeshes);
+
 		for (uint32_t i = 0; i < pScene->mNumMeshes; ++i)
 		{
 			const auto& mesh = pScene->mMeshes[i];
@@ -126,13 +203,15 @@ namespace lde
 			meshData.NumVertices = static_cast<uint32>(meshData.Vertices.size());
 			meshData.NumIndices	 = static_cast<uint32>(meshData.Indices.size());
 
-			LoadMaterial(pScene, mesh, meshData);
+			MaterialTextures textures{};
+			LoadMaterial(pScene, mesh, InModel.Filepath, meshData, textures);
 
-			InStaticMeshes.push_back(meshData);
+			InModel.StaticMeshes.push_back(std::move(meshData));
+			InModel.Textures.push_back(std::move(textures));
 		}
 	}
 
-	void AssetManager::LoadMaterial(const aiScene* pScene, const aiMesh* pMesh, StaticMesh& InStaticMesh)
+	void AssetManager::LoadMaterial(const aiScene* pScene, const aiMesh* pMesh, std::string_view Filepath, StaticMesh& InStaticMesh, MaterialTextures& InTextures)
 	{
 		Material newMaterial{};
 
@@ -143,16 +222,14 @@ namespace lde
 			return;
 		}
 
-		auto& textureManager = TextureManager::GetInstance();
+		const std::string filepath(Filepath);
 
 		aiMaterial* material = pScene->mMaterials[pMesh->mMaterialIndex];
 
 		aiString materialPath{};
 		if (material->GetTexture(aiTextureType_DIFFUSE, 0, &materialPath) == aiReturn_SUCCESS || material->GetTexture(aiTextureType_BASE_COLOR, 0, &materialPath) == aiReturn_SUCCESS)
 		{
-			auto texPath = Files::GetTexturePath(m_Filepath.data(), std::string(materialPath.C_Str()));
-
-			newMaterial.BaseColorIndex = textureManager.Create(m_Gfx, texPath);
+			InTextures.BaseColor = Files::GetTexturePath(filepath, std::string(materialPath.C_Str()));
 
 			aiColor4D colorFactor{};
 			aiGetMaterialColor(material, AI_MATKEY_BASE_COLOR, &colorFactor);
@@ -161,23 +238,17 @@ namespace lde
 
 		if (material->GetTexture(aiTextureType_NORMALS, 0, &materialPath) == aiReturn_SUCCESS)
 		{
-			auto texPath = Files::GetTexturePath(m_Filepath.data(), std::string(materialPath.C_Str()));
-
-			newMaterial.NormalIndex = textureManager.Create(m_Gfx, texPath);
+			InTextures.Normal = Files::GetTexturePath(filepath, std::string(materialPath.C_Str()));
 		}
 
 		if (material->GetTexture(aiTextureType_METALNESS, 0, &materialPath) == aiReturn_SUCCESS)
 		{
-			auto texPath = Files::GetTexturePath(m_Filepath.data(), std::string(materialPath.C_Str()));
-
-			newMaterial.MetalRoughnessIndex = textureManager.Create(m_Gfx, texPath);
+			InTextures.MetalRoughness = Files::GetTexturePath(filepath, std::string(materialPath.C_Str()));
 		}
 
 		if (material->GetTexture(aiTextureType_EMISSIVE, 0, &materialPath) == aiReturn_SUCCESS)
 		{
-			auto texPath = Files::GetTexturePath(m_Filepath.data(), std::string(materialPath.C_Str()));
-
-			newMaterial.EmissiveIndex = textureManager.Create(m_Gfx, texPath);
+			InTextures.Emissive = Files::GetTexturePath(filepath, std::string(materialPath.C_Str()));
 
 			aiColor4D colorFactor{};
 			aiGetMaterialColor(material, AI_MATKEY_COLOR_EMISSIVE, &colorFactor);
@@ -187,6 +258,28 @@ namespace lde
 		aiGetMaterialFloat(material, AI_MATKEY_METALLIC_FACTOR, &newMaterial.MetallicFactor);
 		aiGetMaterialFloat(material, AI_MATKEY_ROUGHNESS_FACTOR, &newMaterial.RoughnessFactor);
 		aiGetMaterialFloat(material, AI_MATKEY_GLTF_ALPHACUTOFF, &newMaterial.AlphaCutoff);
+
+		// Formats without alpha mode keep being alpha tested, as they were before permutations.
+		newMaterial.AlphaMode = MaterialAlphaMode::eMask;
+		aiString alphaMode{};
+		if (aiGetMaterialString(material, AI_MATKEY_GLTF_ALPHAMODE, &alphaMode) == aiReturn_SUCCESS)
+		{
+			const std::string_view mode(alphaMode.C_Str());
+			if (mode == "OPAQUE")
+			{
+				newMaterial.AlphaMode = MaterialAlphaMode::eOpaque;
+			}
+			else if (mode == "BLEND")
+			{
+				newMaterial.AlphaMode = MaterialAlphaMode::eBlend;
+			}
+		}
+
+		int32 bTwoSided = 0;
+		if (aiGetMaterialInteger(material, AI_MATKEY_TWOSIDED, &bTwoSided) == aiReturn_SUCCESS)
+		{
+			newMaterial.bDoubleSided = bTwoSided != 0 ? 1 : 0;
+		}
 		
 		InStaticMesh.Material = newMaterial;
 	}
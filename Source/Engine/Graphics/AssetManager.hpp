@@ -1,6 +1,8 @@
 #pragma once
 #include "Core/CoreTypes.hpp"
 #include "Core/String.hpp"
+#include "MeshRegistry.hpp"
+#include "Scene/Model/Mesh.hpp"
 #include <DirectXMath.h>
 #include <vector>
 
@@ -23,7 +25,29 @@ namespace lde
 	class World;
 	struct Node;
 
-	class AssetManager
+	/// @brief Texture paths of a Material, turned into SRV indices by AssetManager::CreateTextures.
+	struct MaterialTextures
+	{
+		std::string BaseColor;
+		std::string Normal;
+		std::string MetalRoughness;
+		std::string Emissive;
+	};
+
+	/// @brief CPU side result of an import. Holds no GPU resources, so it can be produced off the main thread.
+	struct ImportedModel
+	{
+		std::string Filepath;
+		std::vector<StaticMesh> StaticMeshes;
+		// One per StaticMesh.
+		std::vector<MaterialTextures> Textures;
+		// Empty on success.
+		std::string Error;
+
+		bool IsValid() const { return Error.empty(); }
+	};
+
+	class AssetManager : public MeshImporter
 	{
 		static AssetManager* m_Instance;
 	public:
@@ -37,14 +61,37 @@ namespace lde
 			m_Gfx = pGfx;
 		}
 
+		/// @brief Imports geometry and creates its textures. Shows message box and throws on failure.
 		void Import(D3D12RHI* pGfx, std::string_view Filepath, std::vector<StaticMesh>& InStaticMeshes);
 
+		/**
+		 * @brief Reads geometry and material data without touching GPU.
+		 * Safe to call from worker threads.
+		 * @return Model with Error set if file couldn't be imported.
+		 */
+		static ImportedModel ImportGeometry(std::string_view Filepath);
+
+		/**
+		 * @brief Creates textures referenced by imported materials and stores their indices in Materials.
+		 * Main thread only; Graphics command list has to be open.
+		 * @param pCreated Optional, receives indices of created textures.
+		 */
+		void CreateTextures(D3D12RHI* pGfx, ImportedModel& InModel, std::vector<int32>* pCreated = nullptr);
+
 		void ImportGLTF(D3D12RHI* pGfx, std::string_view Filepath, Mesh& pInMesh);
 
-		void LoadStaticMesh(const aiScene* pScene, std::vector<StaticMesh>& InStaticMeshes);
-		void LoadMaterial(const aiScene* pScene, const aiMesh* pMesh, StaticMesh& InStaticMesh);
+		/* ================================= MeshImporter ================================= */
+
+		ImportedModel Import(std::string_view Filepath) override;
+		/// @brief Needs Initialize to be called first.
+		void CreateTextures(ImportedModel& InModel, std::vector<int32>& Created) override;
+		void DestroyTexture(int32 Texture) override;
+		uint64 GetTextureSize(int32 Texture) const override;
 
 	private:
+		static void LoadStaticMesh(const aiScene* pScene, ImportedModel& InModel);
+		static void LoadMaterial(const aiScene* pScene, const aiMesh* pMesh, std::string_view Filepath, StaticMesh& InStaticMesh, MaterialTextures& InTextures);
+
 		[[maybe_unused]]
 		void ProcessNode(const aiScene* pScene, Mesh* pInMesh, const aiNode* pNode, Node* ParentNode, DirectX::XMMATRIX ParentMatrix);
 
@@ -54,8 +101,6 @@ namespace lde
 		// For access to Device and CommandList
 		D3D12RHI* m_Gfx = nullptr;
 	
-		std::string m_Filepath;
-	
 		aiScene* m_Scene = nullptr;
 
 	};
@@ -0,0 +1,118 @@
+#include "Core/Hash.hpp"
+#include "GeometryCache.hpp"
+#include <cstring>
+#include <format>
+#include <fstream>
+
+namespace lde
+{
+	namespace
+	{
+		// Precedes Vertices and Indices in every cache entry.
+		struct EntryHeader
+		{
+			uint32 Magic		= 0x4347444C; // "LDGC"
+			uint32 Version		= GeometryCache::Version;
+			uint64 Hash			= 0;
+			uint32 NumVertices	= 0;
+			uint32 NumIndices	= 0;
+		};
+
+		uint64 GetEntrySize(const EntryHeader& Header)
+		{
+			return sizeof(EntryHeader) + static_cast<uint64>(Header.NumVertices) * sizeof(Vertex) + static_cast<uint64>(Header.NumIndices) * sizeof(uint32);
+		}
+
+		bool IsValid(const EntryHeader& Header, uint64 Hash, uint32 NumVertices, uint32 NumIndices)
+		{
+			const EntryHeader expected{};
+			return Header.Magic == expected.Magic && Header.Version == expected.Version && Header.Hash == Hash
+				&& Header.NumVertices == NumVertices && Header.NumIndices == NumIndices;
+		}
+	} // namespace
+
+	GeometryCache::GeometryCache(Filepath Directory)
+		: m_Directory(std::move(Directory))
+	{
+	}
+
+	uint64 GeometryCache::ComputeHash(std::span<const Vertex> Vertices, std::span<const uint32> Indices)
+	{
+		return Hash::FNV1a(Indices, Hash::FNV1a(Vertices));
+	}
+
+	bool GeometryCache::Load(uint64 Hash, uint32 NumVertices, uint32 NumIndices, std::vector<Vertex>& OutVertices, std::vector<uint32>& OutIndices)
+	{
+		std::vector<uint8> file;
+		EntryHeader header{};
+
+		bool bValid = Files::ReadBinary(GetEntryPath(Hash), file) && file.size() >= sizeof(EntryHeader);
+		if (bValid)
+		{
+			std::memcpy(&header, file.data(), sizeof(header));
+			bValid = IsValid(header, Hash, NumVertices, NumIndices) && GetEntrySize(header) == file.size();
+		}
+
+		if (bValid)
+		{
+			const uint8* pVertices	= file.data() + sizeof(EntryHeader);
+			const uint8* pIndices	= pVertices + static_cast<usize>(NumVertices) * sizeof(Vertex);
+
+			std::vector<Vertex> vertices(NumVertices);
+			std::vector<uint32> indices(NumIndices);
+			std::memcpy(vertices.data(), pVertices, vertices.size() * sizeof(Vertex));
+			std::memcpy(indices.data(), pIndices, indices.size() * sizeof(uint32));
+
+			bValid = ComputeHash(vertices, indices) == Hash;
+			if (bValid)
+			{
+				OutVertices = std::move(vertices);
+				OutIndices	= std::move(indices);
+			}
+		}
+
+		++(bValid ? m_Stats.Hits : m_Stats.Misses);
+
+		return bValid;
+	}
+
+	bool GeometryCache::Store(uint64 Hash, std::span<const Vertex> Vertices, std::span<const uint32> Indices)
+	{
+		const uint32 numVertices	= static_cast<uint32>(Vertices.size());
+		const uint32 numIndices		= static_cast<uint32>(Indices.size());
+
+		// Header is enough to tell; content is verified on load anyway.
+		if (std::ifstream stream(GetEntryPath(Hash), std::ios::binary); stream.is_open())
+		{
+			EntryHeader header{};
+			if (stream.read(reinterpret_cast<char*>(&header), sizeof(header)) && IsValid(header, Hash, numVertices, numIndices))
+			{
+				return true;
+			}
+		}
+
+		EntryHeader header{};
+		header.Hash			= Hash;
+		header.NumVertices	= numVertices;
+		header.NumIndices	= numIndices;
+
+		std::vector<uint8> file(GetEntrySize(header));
+		std::memcpy(file.data(), &header, sizeof(header));
+		std::memcpy(file.data() + sizeof(EntryHeader), Vertices.data(), Vertices.size_bytes());
+		std::memcpy(file.data() + sizeof(EntryHeader) + Vertices.size_bytes(), Indices.data(), Indices.size_bytes());
+
+		if (!Files::WriteBinary(GetEntryPath(Hash), file))
+		{
+			return false;
+		}
+
+		++m_Stats.Stores;
+		return true;
+	}
+
+	Filepath GeometryCache::GetEntryPath(uint64 Hash) const
+	{
+		return m_Directory / std::format("{:016X}.bin", Hash);
+	}
+
+} // namespace lde
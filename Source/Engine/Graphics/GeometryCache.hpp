@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+	Graphics/GeometryCache.hpp
+	Disk cache of cooked mesh geometry.
+	Lets MeshRegistry drop CPU geometry after upload and restore it later without importing source file again.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Core/FileSystem.hpp"
+#include "Scene/Model/Mesh.hpp"
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	struct GeometryCacheStats
+	{
+		uint32 Hits		= 0;
+		uint32 Misses	= 0;
+		// Geometry written to disk.
+		uint32 Stores	= 0;
+	};
+
+	/**
+	 * @brief Vertices and Indices of a mesh stored as Directory/<GeometryHash>.bin.
+	 * Entries are addressed by content, so meshes with equal geometry share one, whichever file they came from.
+	 * Loaded geometry is hashed again; damaged or colliding entries are misses.
+	 */
+	class GeometryCache
+	{
+	public:
+		// Bumped whenever Vertex or file layout changes.
+		static constexpr uint32 Version = 1;
+
+		explicit GeometryCache(Filepath Directory);
+
+		/// @brief Hash of vertex and index data; StaticMesh::GeometryHash.
+		static uint64 ComputeHash(std::span<const Vertex> Vertices, std::span<const uint32> Indices);
+
+		/// @return False on a miss, or if stored geometry doesn't hash to Hash or has other counts.
+		bool Load(uint64 Hash, uint32 NumVertices, uint32 NumIndices, std::vector<Vertex>& OutVertices, std::vector<uint32>& OutIndices);
+
+		/**
+		 * @brief Writes geometry unless an entry of the same hash and counts already exists.
+		 * @return True if entry can be loaded afterwards.
+		 */
+		bool Store(uint64 Hash, std::span<const Vertex> Vertices, std::span<const uint32> Indices);
+
+		const Filepath& GetDirectory() const { return m_Directory; }
+		GeometryCacheStats GetStats() const { return m_Stats; }
+
+	private:
+		Filepath GetEntryPath(uint64 Hash) const;
+
+		Filepath			m_Directory;
+		GeometryCacheStats	m_Stats{};
+	};
+} // namespace lde
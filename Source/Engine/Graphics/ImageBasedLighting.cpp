@@ -57,6 +57,13 @@ namespace lde
 
 	void ImageBasedLighting::CreateComputeStates()
 	{
+		// Shaders compile while Root Signatures are built
+		auto& shaderManager = ShaderCompiler::GetInstance();
+		auto equirect2CubeCS	 = shaderManager.CompileAsync("Shaders/Sky/EquirectangularToCube.hlsl", ShaderStage::eCompute, L"CSmain");
+		auto diffuseIrradianceCS = shaderManager.CompileAsync("Shaders/Sky/IrradianceCS.hlsl", ShaderStage::eCompute, L"CSmain");
+		auto specularCS			 = shaderManager.CompileAsync("Shaders/Sky/SpecularCS.hlsl", ShaderStage::eCompute, L"CSmain");
+		auto brdfLookUpCS		 = shaderManager.CompileAsync("Shaders/Sky/SpecularBRDF.hlsl", ShaderStage::eCompute, L"CSmain");
+
 		// Common Root Signature
 		{
 			m_Pipelines.ComputeRS = new D3D12RootSignature();
@@ -90,11 +97,10 @@ namespace lde
 
 		// Shaders
 		{
-			auto& shaderManager = ShaderCompiler::GetInstance();
-			m_Shaders.Equirect2CubeCS = new Shader(shaderManager.Compile("Shaders/Sky/EquirectangularToCube.hlsl", ShaderStage::eCompute, L"CSmain"));
-			m_Shaders.DiffuseIrradianceCS = new Shader(shaderManager.Compile("Shaders/Sky/IrradianceCS.hlsl", ShaderStage::eCompute, L"CSmain"));
-			m_Shaders.SpecularCS = new Shader(shaderManager.Compile("Shaders/Sky/SpecularCS.hlsl", ShaderStage::eCompute, L"CSmain"));
-			m_Shaders.BRDFLookUpCS	= new Shader(shaderManager.Compile("Shaders/Sky/SpecularBRDF.hlsl", ShaderStage::eCompute, L"CSmain"));
+			m_Shaders.Equirect2CubeCS = new Shader(equirect2CubeCS.get());
+			m_Shaders.DiffuseIrradianceCS = new Shader(diffuseIrradianceCS.get());
+			m_Shaders.SpecularCS = new Shader(specularCS.get());
+			m_Shaders.BRDFLookUpCS	= new Shader(brdfLookUpCS.get());
 		}
 		
 		// Equirectangular to Cube
@@ -102,7 +108,7 @@ namespace lde
 			D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
 			psoDesc.pRootSignature = m_Pipelines.ComputeRS->Get();
 			psoDesc.CS = m_Shaders.Equirect2CubeCS->Bytecode(); 
-			DX_CALL(m_Gfx->Device->GetDevice()->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&m_Pipelines.ComputePSO)));
+			DX_CALL(m_Gfx->Device->GetPipelineCache()->GetCompute(psoDesc, m_Pipelines.ComputeRS, m_Pipelines.ComputePSO));
 		}
 		
 		// Diffuse irradiance
@@ -110,7 +116,7 @@ namespace lde
 			D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
 			psoDesc.pRootSignature = m_Pipelines.IrradianceRS->Get();
 			psoDesc.CS = m_Shaders.DiffuseIrradianceCS->Bytecode();
-			DX_CALL(m_Gfx->Device->GetDevice()->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&m_Pipelines.DiffusePSO)));
+			DX_CALL(m_Gfx->Device->GetPipelineCache()->GetCompute(psoDesc, m_Pipelines.IrradianceRS, m_Pipelines.DiffusePSO));
 		}
 
 		// Specular
@@ -118,7 +124,7 @@ namespace lde
 			D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
 			psoDesc.pRootSignature = m_Pipelines.SpecularRS->Get();
 			psoDesc.CS = m_Shaders.SpecularCS->Bytecode();
-			DX_CALL(m_Gfx->Device->GetDevice()->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&m_Pipelines.SpecularPSO)));
+			DX_CALL(m_Gfx->Device->GetPipelineCache()->GetCompute(psoDesc, m_Pipelines.SpecularRS, m_Pipelines.SpecularPSO));
 		}
 
 		// BRDF LUT
@@ -289,6 +295,7 @@ namespace lde
 		m_Gfx->Device->CreateSRV(pSkybox->TextureCube->Texture.Get(), pSkybox->TextureCube->SRV, 6, 1);
 		TextureManager::GetInstance().Generate3D(pSkybox->TextureCube);
 
+		m_Gfx->Device->GetStateTracker()->Forget(tempCube.Get());
 		SAFE_RELEASE(tempCube);
 
 	}
@@ -0,0 +1,376 @@
+#include "AssetManager.hpp"
+#include "Core/Logger.hpp"
+#include "MeshRegistry.hpp"
+#include "RHI/Device.hpp"
+#include <filesystem>
+#include <stdexcept>
+
+namespace lde
+{
+	MeshRegistry* MeshRegistry::m_Instance = nullptr;
+
+	MeshRegistry::MeshRegistry()
+	{
+		m_Instance = this;
+		LOG_DEBUG("MeshRegistry initialized.");
+	}
+
+	MeshRegistry::~MeshRegistry()
+	{
+		Release();
+		LOG_DEBUG("MeshRegistry released.");
+	}
+
+	MeshRegistry& MeshRegistry::GetInstance()
+	{
+		if (!m_Instance)
+		{
+			m_Instance = new MeshRegistry();
+			LOG_DEBUG("MeshRegistry instance recreated!");
+		}
+
+		return *m_Instance;
+	}
+
+	void MeshRegistry::Release()
+	{
+		for (auto& [key, asset] : m_Assets)
+		{
+			Destroy(*asset);
+		}
+		m_Assets.clear();
+	}
+
+	std::shared_ptr<MeshAsset> MeshRegistry::Load(std::string_view Filepath, GeometryResidency Residency)
+	{
+		if (auto asset = Find(Filepath))
+		{
+			++m_Requests;
+			++m_Hits;
+			RequestGeometry(*asset, Residency);
+			return asset;
+		}
+
+		ImportedModel imported = Import(Filepath);
+
+		if (!imported.IsValid())
+		{
+			LOG_ERROR(imported.Error.c_str());
+			throw std::runtime_error(imported.Error);
+		}
+
+		return Create(imported, Residency);
+	}
+
+	ImportedModel MeshRegistry::Import(std::string_view Filepath) const
+	{
+		if (!m_Importer)
+		{
+			ImportedModel model{};
+			model.Filepath	= std::string(Filepath);
+			model.Error		= std::format("No importer to load {0} with.", model.Filepath);
+			return model;
+		}
+
+		return m_Importer->Import(Filepath);
+	}
+
+	std::shared_ptr<MeshAsset> MeshRegistry::Create(ImportedModel& InModel, GeometryResidency Residency)
+	{
+		++m_Requests;
+
+		const std::string key = GetKey(InModel.Filepath);
+		if (auto it = m_Assets.find(key); it != m_Assets.end())
+		{
+			++m_Hits;
+			RequestGeometry(*it->second, Residency);
+			return it->second;
+		}
+
+		auto asset = std::make_shared<MeshAsset>();
+		asset->Filepath = InModel.Filepath;
+
+		if (m_Importer)
+		{
+			m_Importer->CreateTextures(InModel, asset->Textures);
+		}
+		asset->StaticMeshes = std::move(InModel.StaticMeshes);
+
+		Upload(*asset);
+		TrimGeometry(*asset, Residency);
+
+		m_Assets.emplace(key, asset);
+
+		return asset;
+	}
+
+	bool MeshRegistry::RequestGeometry(MeshAsset& Asset, GeometryResidency Residency)
+	{
+		if (Asset.Residency >= Residency)
+		{
+			return true;
+		}
+
+		// Read everything first, so a miss leaves the asset as it was.
+		std::vector<std::vector<Vertex>> vertices(Asset.StaticMeshes.size());
+		std::vector<std::vector<uint32>> indices(Asset.StaticMeshes.size());
+
+		for (usize i = 0; i < Asset.StaticMeshes.size(); ++i)
+		{
+			const auto& mesh = Asset.StaticMeshes.at(i);
+			if (!m_GeometryCache.Load(mesh.GeometryHash, mesh.NumVertices, mesh.NumIndices, vertices.at(i), indices.at(i)))
+			{
+				LOG_WARN(std::format("Couldn't restore geometry of {0}; cooked geometry is missing or damaged.", Asset.Filepath).c_str());
+				return false;
+			}
+		}
+
+		for (usize i = 0; i < Asset.StaticMeshes.size(); ++i)
+		{
+			auto& mesh = Asset.StaticMeshes.at(i);
+			mesh.Vertices	= std::move(vertices.at(i));
+			mesh.Indices	= std::move(indices.at(i));
+			mesh.Positions	= {};
+		}
+
+		Asset.Residency = GeometryResidency::eFull;
+		++m_GeometryReloads;
+
+		TrimGeometry(Asset, Residency);
+
+		return true;
+	}
+
+	std::shared_ptr<MeshAsset> MeshRegistry::Find(std::string_view Filepath) const
+	{
+		auto it = m_Assets.find(GetKey(Filepath));
+		return (it != m_Assets.end()) ? it->second : nullptr;
+	}
+
+	bool MeshRegistry::Contains(std::string_view Filepath) const
+	{
+		return m_Assets.contains(GetKey(Filepath));
+	}
+
+	uint32 MeshRegistry::ReleaseUnused()
+	{
+		uint32 released = 0;
+
+		// Registry holds the only reference left.
+		std::erase_if(m_Assets, [&](auto& Entry) {
+			if (Entry.second.use_count() > 1)
+			{
+				return false;
+			}
+
+			Destroy(*Entry.second);
+			++released;
+			return true;
+		});
+
+		return released;
+	}
+
+	MeshRegistryStats MeshRegistry::GetStats() const
+	{
+		MeshRegistryStats stats{};
+		stats.Assets	= static_cast<uint32>(m_Assets.size());
+		stats.Requests	= m_Requests;
+		stats.Hits		= m_Hits;
+		stats.GeometryReloads = m_GeometryReloads;
+
+		for (const auto& [key, asset] : m_Assets)
+		{
+			stats.References += static_cast<uint32>(asset.use_count() - 1);
+			stats.CpuBytes += asset->CpuBytes;
+			stats.Meshes += static_cast<uint32>(asset->StaticMeshes.size());
+
+			for (auto texture : asset->Textures)
+			{
+				stats.GpuBytes += m_Importer->GetTextureSize(texture);
+			}
+		}
+
+		// Unshared buffers of colliding meshes are left out.
+		stats.Geometries = static_cast<uint32>(m_Geometry.size());
+		for (const auto& [hash, geometry] : m_Geometry)
+		{
+			stats.GpuBytes += geometry.Bytes;
+		}
+
+		return stats;
+	}
+
+	std::string MeshRegistry::GetKey(std::string_view Filepath)
+	{
+		return std::filesystem::path(Filepath).lexically_normal().generic_string();
+	}
+
+	void MeshRegistry::Upload(MeshAsset& Asset)
+	{
+		Asset.GpuBytes = 0;
+
+		for (auto& mesh : Asset.StaticMeshes)
+		{
+			mesh.GeometryHash = GeometryCache::ComputeHash(mesh.Vertices, mesh.Indices);
+
+			// Shared buffers count fully towards every asset using them, as assets count for World cells.
+			Asset.GpuBytes += AcquireBuffers(mesh);
+		}
+
+		Asset.Residency = GeometryResidency::eFull;
+		Asset.CpuBytes	= GetCpuBytes(Asset);
+
+		for (auto texture : Asset.Textures)
+		{
+			Asset.GpuBytes += m_Importer->GetTextureSize(texture);
+		}
+	}
+
+	void MeshRegistry::Destroy(MeshAsset& Asset)
+	{
+		for (auto& mesh : Asset.StaticMeshes)
+		{
+			ReleaseBuffers(mesh);
+		}
+
+		for (auto texture : Asset.Textures)
+		{
+			m_Importer->DestroyTexture(texture);
+		}
+		Asset.Textures.clear();
+	}
+
+	uint64 MeshRegistry::AcquireBuffers(StaticMesh& Mesh)
+	{
+		auto [it, bCreated] = m_Geometry.try_emplace(Mesh.GeometryHash);
+		auto& geometry = it->second;
+
+		// Hash collision; mesh gets buffers of its own that aren't shared.
+		const bool bCollision = !bCreated && (geometry.NumVertices != Mesh.NumVertices || geometry.NumIndices != Mesh.NumIndices);
+
+		if (bCreated || bCollision)
+		{
+			GeometryBuffers buffers{};
+			buffers.NumVertices = Mesh.NumVertices;
+			buffers.NumIndices	= Mesh.NumIndices;
+			buffers.Bytes		= Mesh.Vertices.size() * sizeof(Vertex) + Mesh.Indices.size() * sizeof(uint32);
+
+			buffers.VertexBuffer = m_Device->CreateBuffer(
+				BufferDesc{
+					BufferUsage::eStructured,
+					Mesh.Vertices.data(),
+					Mesh.NumVertices,
+					Mesh.NumVertices * sizeof(Mesh.Vertices.at(0)),
+					static_cast<uint32>(sizeof(Mesh.Vertices.at(0))),
+					true
+				});
+
+			buffers.IndexBuffer = m_Device->CreateBuffer(
+				BufferDesc{
+					BufferUsage::eIndex,
+					Mesh.Indices.data(),
+					Mesh.NumIndices,
+					Mesh.NumIndices * sizeof(Mesh.Indices.at(0)),
+					static_cast<uint32>(sizeof(Mesh.Indices.at(0)))
+				});
+
+			if (bCollision)
+			{
+				LOG_WARN(std::format("Geometry hash collision ({0:X}); mesh isn't shared.", Mesh.GeometryHash).c_str());
+				Mesh.VertexBuffer	= buffers.VertexBuffer;
+				Mesh.IndexBuffer	= buffers.IndexBuffer;
+				return buffers.Bytes;
+			}
+
+			geometry = buffers;
+		}
+
+		Mesh.VertexBuffer	= geometry.VertexBuffer;
+		Mesh.IndexBuffer	= geometry.IndexBuffer;
+		++geometry.References;
+
+		return geometry.Bytes;
+	}
+
+	void MeshRegistry::ReleaseBuffers(StaticMesh& Mesh)
+	{
+		auto it = m_Geometry.find(Mesh.GeometryHash);
+		if (it != m_Geometry.end() && it->second.VertexBuffer == Mesh.VertexBuffer)
+		{
+			if (--it->second.References == 0)
+			{
+				m_Device->DestroyBuffer(it->second.VertexBuffer);
+				m_Device->DestroyBuffer(it->second.IndexBuffer);
+				m_Geometry.erase(it);
+			}
+		}
+		else
+		{
+			m_Device->DestroyBuffer(Mesh.VertexBuffer);
+			m_Device->DestroyBuffer(Mesh.IndexBuffer);
+		}
+
+		Mesh.VertexBuffer	= UINT32_MAX;
+		Mesh.IndexBuffer	= UINT32_MAX;
+	}
+
+	void MeshRegistry::TrimGeometry(MeshAsset& Asset, GeometryResidency Residency)
+	{
+		if (Residency >= Asset.Residency)
+		{
+			return;
+		}
+
+		// Only full geometry is cooked; lower residencies were cooked when they were entered.
+		if (Asset.Residency == GeometryResidency::eFull)
+		{
+			for (const auto& mesh : Asset.StaticMeshes)
+			{
+				if (!m_GeometryCache.Store(mesh.GeometryHash, mesh.Vertices, mesh.Indices))
+				{
+					LOG_WARN(std::format("Couldn't cook geometry of {0} to {1}; CPU geometry is kept.",
+						Asset.Filepath, m_GeometryCache.GetDirectory().string()).c_str());
+					return;
+				}
+			}
+		}
+
+		// Assigning empty vectors frees their memory; clear() would keep it.
+		for (auto& mesh : Asset.StaticMeshes)
+		{
+			if (Residency == GeometryResidency::ePositions)
+			{
+				mesh.Positions.resize(mesh.Vertices.size());
+				for (usize i = 0; i < mesh.Vertices.size(); ++i)
+				{
+					mesh.Positions[i] = mesh.Vertices[i].Position;
+				}
+				mesh.Vertices = {};
+			}
+			else
+			{
+				mesh.Vertices	= {};
+				mesh.Indices	= {};
+				mesh.Positions	= {};
+			}
+		}
+
+		Asset.Residency = Residency;
+		Asset.CpuBytes	= GetCpuBytes(Asset);
+	}
+
+	uint64 MeshRegistry::GetCpuBytes(const MeshAsset& Asset)
+	{
+		uint64 bytes = 0;
+		for (const auto& mesh : Asset.StaticMeshes)
+		{
+			bytes += mesh.Vertices.capacity() * sizeof(Vertex);
+			bytes += mesh.Indices.capacity() * sizeof(uint32);
+			bytes += mesh.Positions.capacity() * sizeof(DirectX::XMFLOAT3);
+		}
+
+		return bytes;
+	}
+
+} // namespace lde
@@ -0,0 +1,172 @@
+#pragma once
+
+/*
+	Graphics/MeshRegistry.hpp
+	Owner of imported MeshAssets. Every file is imported and uploaded once;
+	Models loading the same path share the asset and its GPU buffers.
+	Meshes with equal geometry share buffers across assets as well.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "GeometryCache.hpp"
+#include "Scene/Model/Mesh.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	class Device;
+	struct ImportedModel;
+
+	/**
+	 * @brief Source of mesh files and their textures for MeshRegistry.
+	 * Implemented by AssetManager; headless runs register geometry through Create and may have none.
+	 */
+	class MeshImporter
+	{
+	public:
+		virtual ~MeshImporter() = default;
+
+		/// @brief Reads geometry and materials; Error is set on failure. Must be safe to call from worker threads.
+		virtual ImportedModel Import(std::string_view Filepath) = 0;
+
+		/// @brief Creates textures of imported Materials, stores their indices in Materials and appends them to Created.
+		virtual void CreateTextures(ImportedModel& InModel, std::vector<int32>& Created) = 0;
+		virtual void DestroyTexture(int32 Texture) = 0;
+		virtual uint64 GetTextureSize(int32 Texture) const = 0;
+	};
+
+	struct MeshRegistryStats
+	{
+		uint32 Assets		= 0;
+		// Models holding an asset.
+		uint32 References	= 0;
+		uint32 Requests		= 0;
+		// Requests served by already registered asset.
+		uint32 Hits			= 0;
+		uint64 CpuBytes		= 0;
+		// Buffers shared by several meshes are counted once.
+		uint64 GpuBytes		= 0;
+		// Distinct geometry buffers and meshes drawing from them.
+		uint32 Geometries	= 0;
+		uint32 Meshes		= 0;
+		// Assets whose dropped CPU geometry was restored from GeometryCache.
+		uint32 GeometryReloads = 0;
+	};
+
+	class MeshRegistry
+	{
+		static MeshRegistry* m_Instance;
+	public:
+		MeshRegistry();
+		MeshRegistry(const MeshRegistry&) = delete;
+		MeshRegistry& operator=(const MeshRegistry&) = delete;
+		~MeshRegistry();
+
+		static MeshRegistry& GetInstance();
+
+		/**
+		 * @brief Buffers are created on given Device.
+		 * @param pImporter Optional; without it files can't be loaded and textures are skipped, i.e. for headless runs.
+		 */
+		void Initialize(Device* pDevice, MeshImporter* pImporter = nullptr)
+		{
+			m_Device	= pDevice;
+			m_Importer	= pImporter;
+		}
+
+		/// @brief Releases every asset. GPU must be idle.
+		void Release();
+
+		/**
+		 * @brief Asset of given file; imported and uploaded on first request.
+		 * Logs and throws if file can't be imported.
+		 * @param Residency CPU geometry to keep after upload. Already registered asset is only ever raised to it.
+		 */
+		std::shared_ptr<MeshAsset> Load(std::string_view Filepath, GeometryResidency Residency);
+		std::shared_ptr<MeshAsset> Load(std::string_view Filepath) { return Load(Filepath, DefaultResidency); }
+
+		/// @brief Imports file through the importer without registering it. Safe to call from worker threads.
+		/// @return Model with Error set if there is no importer or file couldn't be imported.
+		ImportedModel Import(std::string_view Filepath) const;
+
+		/**
+		 * @brief Registers geometry imported elsewhere, i.e. on worker thread. Graphics command list has to be open.
+		 * @return Already registered asset if Filepath is known; InModel is left untouched then.
+		 */
+		std::shared_ptr<MeshAsset> Create(ImportedModel& InModel, GeometryResidency Residency);
+		std::shared_ptr<MeshAsset> Create(ImportedModel& InModel) { return Create(InModel, DefaultResidency); }
+
+		/**
+		 * @brief Makes sure asset holds at least given CPU geometry.
+		 * Dropped geometry is read back from GeometryCache; source file isn't touched. Meant for rare requests, like picking.
+		 * Doesn't reallocate StaticMeshes; references to them stay valid.
+		 * @return False if geometry couldn't be restored; asset is unchanged then.
+		 */
+		bool RequestGeometry(MeshAsset& Asset, GeometryResidency Residency);
+
+		/// @return Registered asset or nullptr.
+		std::shared_ptr<MeshAsset> Find(std::string_view Filepath) const;
+		bool Contains(std::string_view Filepath) const;
+
+		/**
+		 * @brief Releases assets that no Model references anymore. GPU must not be using them.
+		 * @return Number of released assets.
+		 */
+		uint32 ReleaseUnused();
+
+		MeshRegistryStats GetStats() const;
+
+		/// @brief Geometry is cooked to Directory before it's dropped; Cache/Geometry by default.
+		void SetGeometryCache(Filepath Directory) { m_GeometryCache = GeometryCache(std::move(Directory)); }
+		const GeometryCache& GetGeometryCache() const { return m_GeometryCache; }
+
+		/// @brief Used by Load and Create when no residency is given. Lower residencies are opted into per call.
+		GeometryResidency DefaultResidency = GeometryResidency::eFull;
+
+	private:
+		/// @brief Path spelled the same way for every request of the file.
+		static std::string GetKey(std::string_view Filepath);
+
+		void Upload(MeshAsset& Asset);
+		void Destroy(MeshAsset& Asset);
+
+		/// @brief Points mesh at buffers of equal geometry, creating them on first use.
+		/// @return Bytes of the buffers.
+		uint64 AcquireBuffers(StaticMesh& Mesh);
+		void ReleaseBuffers(StaticMesh& Mesh);
+
+		/// @brief Drops CPU geometry above given residency once it's cooked; kept as is if cooking fails.
+		void TrimGeometry(MeshAsset& Asset, GeometryResidency Residency);
+		static uint64 GetCpuBytes(const MeshAsset& Asset);
+
+		Device*			m_Device	= nullptr;
+		MeshImporter*	m_Importer	= nullptr;
+
+		std::unordered_map<std::string, std::shared_ptr<MeshAsset>> m_Assets;
+
+		GeometryCache m_GeometryCache{ "Cache/Geometry" };
+
+		struct GeometryBuffers
+		{
+			BufferHandle VertexBuffer	= UINT32_MAX;
+			BufferHandle IndexBuffer	= UINT32_MAX;
+			uint32 NumVertices	= 0;
+			uint32 NumIndices	= 0;
+			uint64 Bytes		= 0;
+			// Meshes using the buffers; released with the last one.
+			uint32 References	= 0;
+		};
+
+		// Keyed by GeometryHash.
+		std::unordered_map<uint64, GeometryBuffers> m_Geometry;
+
+		uint32 m_Requests	= 0;
+		uint32 m_Hits		= 0;
+		uint32 m_GeometryReloads = 0;
+
+	};
+} // namespace lde
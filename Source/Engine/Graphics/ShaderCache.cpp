@@ -0,0 +1,354 @@
+#include "Core/Hash.hpp"
+#include "ShaderCache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <set>
+
+namespace lde
+{
+	namespace
+	{
+		// Precedes bytecode in every cache entry.
+		struct EntryHeader
+		{
+			uint32 Magic	= 0x4353444C; // "LDSC"
+			uint32 Version	= ShaderCache::Version;
+			uint64 Key		= 0;
+			uint64 Size		= 0;
+		};
+
+		std::string GetPathKey(const Filepath& Path)
+		{
+			return Path.lexically_normal().generic_string();
+		}
+
+		// Length prefixed, so adjacent strings can't run into each other.
+		uint64 HashString(uint64 Seed, std::string_view Text)
+		{
+			const uint64 length = Text.size();
+			return Hash::FNV1a(Text.data(), Text.size(), Hash::FNV1a(&length, sizeof(length), Seed));
+		}
+
+		std::string_view TrimLeft(std::string_view Text)
+		{
+			const usize first = Text.find_first_not_of(" \t");
+			return first == std::string_view::npos ? std::string_view{} : Text.substr(first);
+		}
+
+		// Line must already be stripped of comments.
+		std::optional<std::string> ParseDirective(std::string_view Line)
+		{
+			Line = TrimLeft(Line);
+			if (!Line.starts_with('#'))
+			{
+				return std::nullopt;
+			}
+
+			Line = TrimLeft(Line.substr(1));
+			if (!Line.starts_with("include"))
+			{
+				return std::nullopt;
+			}
+
+			Line = TrimLeft(Line.substr(7));
+			if (Line.empty())
+			{
+				return std::nullopt;
+			}
+
+			const char close = Line.front() == '"' ? '"' : (Line.front() == '<' ? '>' : '\0');
+			if (close == '\0')
+			{
+				return std::nullopt;
+			}
+
+			const usize end = Line.find(close, 1);
+			if (end == std::string_view::npos || end == 1)
+			{
+				return std::nullopt;
+			}
+
+			return std::string(Line.substr(1, end - 1));
+		}
+	} // namespace
+
+	ShaderIncludeScanner::ShaderIncludeScanner(std::vector<Filepath> IncludeDirs)
+		: m_IncludeDirs(std::move(IncludeDirs))
+	{
+	}
+
+	std::vector<std::string> ShaderIncludeScanner::ParseIncludes(std::string_view Source)
+	{
+		std::vector<std::string> includes;
+
+		std::string line;
+		bool bBlockComment = false;
+
+		for (usize i = 0; i <= Source.size(); ++i)
+		{
+			const char c = i < Source.size() ? Source[i] : '\n';
+			const char next = i + 1 < Source.size() ? Source[i + 1] : '\0';
+
+			if (c == '\n')
+			{
+				if (auto include = ParseDirective(line))
+				{
+					includes.push_back(std::move(*include));
+				}
+				line.clear();
+				continue;
+			}
+
+			if (bBlockComment)
+			{
+				if (c == '*' && next == '/')
+				{
+					bBlockComment = false;
+					++i;
+				}
+				continue;
+			}
+
+			if (c == '/' && next == '/')
+			{
+				// Skip to the end of line, which is handled above.
+				while (i + 1 < Source.size() && Source[i + 1] != '\n')
+				{
+					++i;
+				}
+				continue;
+			}
+
+			if (c == '/' && next == '*')
+			{
+				bBlockComment = true;
+				// Comment counts as a single space.
+				line.push_back(' ');
+				++i;
+				continue;
+			}
+
+			if (c == '"')
+			{
+				// Copied whole, so slashes inside quotes aren't taken for comments.
+				line.push_back(c);
+				while (i + 1 < Source.size() && Source[i + 1] != '\n')
+				{
+					line.push_back(Source[++i]);
+					if (Source[i] == '"')
+					{
+						break;
+					}
+				}
+				continue;
+			}
+
+			line.push_back(c == '\r' ? ' ' : c);
+		}
+
+		return includes;
+	}
+
+	std::vector<Filepath> ShaderIncludeScanner::GetDependencies(const Filepath& Path)
+	{
+		std::set<std::string> visited{ GetPathKey(Path) };
+		std::vector<Filepath> pending{ Path };
+		std::vector<Filepath> dependencies;
+
+		while (!pending.empty())
+		{
+			const Filepath current = std::move(pending.back());
+			pending.pop_back();
+
+			// Copied, as scanning further files may grow the map.
+			const std::vector<Filepath> includes = Scan(current).Includes;
+			for (const Filepath& include : includes)
+			{
+				// Also guards against include cycles.
+				if (visited.insert(GetPathKey(include)).second)
+				{
+					dependencies.push_back(include);
+					pending.push_back(include);
+				}
+			}
+		}
+
+		std::ranges::sort(dependencies, {}, [](const Filepath& Dependency) { return GetPathKey(Dependency); });
+		return dependencies;
+	}
+
+	uint64 ShaderIncludeScanner::GetFileHash(const Filepath& Path)
+	{
+		return Scan(Path).Hash;
+	}
+
+	void ShaderIncludeScanner::Invalidate()
+	{
+		m_Files.clear();
+	}
+
+	const ShaderIncludeScanner::FileInfo& ShaderIncludeScanner::Scan(const Filepath& Path)
+	{
+		const std::string key = GetPathKey(Path);
+		if (auto it = m_Files.find(key); it != m_Files.end())
+		{
+			return it->second;
+		}
+
+		FileInfo info{};
+
+		std::vector<uint8> contents;
+		if (Files::ReadBinary(Path, contents))
+		{
+			info.bExists = true;
+			info.Hash = Hash::FNV1a(contents.data(), contents.size());
+
+			const std::string_view source(reinterpret_cast<const char*>(contents.data()), contents.size());
+			for (const std::string& include : ParseIncludes(source))
+			{
+				// Unresolved includes fail compilation anyway.
+				if (auto resolved = Resolve(Path, include))
+				{
+					info.Includes.push_back(std::move(*resolved));
+				}
+			}
+		}
+
+		return m_Files.emplace(key, std::move(info)).first->second;
+	}
+
+	std::optional<Filepath> ShaderIncludeScanner::Resolve(const Filepath& Includer, const std::string& Include) const
+	{
+		std::error_code error;
+
+		const Filepath local = (Includer.parent_path() / Include).lexically_normal();
+		if (std::filesystem::is_regular_file(local, error))
+		{
+			return local;
+		}
+
+		for (const Filepath& directory : m_IncludeDirs)
+		{
+			const Filepath candidate = (directory / Include).lexically_normal();
+			if (std::filesystem::is_regular_file(candidate, error))
+			{
+				return candidate;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	ShaderCache::ShaderCache(Filepath Directory, std::vector<Filepath> IncludeDirs)
+		: m_Directory(std::move(Directory)), m_Scanner(std::move(IncludeDirs))
+	{
+	}
+
+	uint64 ShaderCache::ComputeKey(const ShaderCacheKeyDesc& Desc)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		const uint64 sourceHash = m_Scanner.GetFileHash(Desc.Path);
+		if (sourceHash == 0)
+		{
+			return 0;
+		}
+
+		uint64 key = Hash::FNV1a(&Version, sizeof(Version));
+		key = HashString(key, GetPathKey(Desc.Path));
+		key = Hash::Combine(key, sourceHash);
+
+		const std::vector<Filepath> dependencies = m_Scanner.GetDependencies(Desc.Path);
+		const uint64 count = dependencies.size();
+		key = Hash::FNV1a(&count, sizeof(count), key);
+		for (const Filepath& dependency : dependencies)
+		{
+			key = HashString(key, GetPathKey(dependency));
+			key = Hash::Combine(key, m_Scanner.GetFileHash(dependency));
+		}
+
+		key = HashString(key, Desc.EntryPoint);
+		key = HashString(key, Desc.Profile);
+
+		const uint64 defines = Desc.Defines.size();
+		key = Hash::FNV1a(&defines, sizeof(defines), key);
+		for (const std::string& define : Desc.Defines)
+		{
+			key = HashString(key, define);
+		}
+
+		const uint64 arguments = Desc.Arguments.size();
+		key = Hash::FNV1a(&arguments, sizeof(arguments), key);
+		for (const std::string& argument : Desc.Arguments)
+		{
+			key = HashString(key, argument);
+		}
+
+		key = HashString(key, Desc.CompilerVersion);
+
+		// 0 is reserved for "not cacheable".
+		return key != 0 ? key : 1;
+	}
+
+	bool ShaderCache::Load(uint64 Key, std::vector<uint8>& OutBytecode)
+	{
+		std::vector<uint8> file;
+		bool bValid = Key != 0 && Files::ReadBinary(GetEntryPath(Key), file) && file.size() >= sizeof(EntryHeader);
+
+		if (bValid)
+		{
+			EntryHeader header{};
+			std::memcpy(&header, file.data(), sizeof(header));
+
+			const EntryHeader expected{};
+			bValid = header.Magic == expected.Magic && header.Version == expected.Version && header.Key == Key
+				&& header.Size != 0 && header.Size == file.size() - sizeof(EntryHeader);
+		}
+
+		if (bValid)
+		{
+			OutBytecode.assign(file.begin() + sizeof(EntryHeader), file.end());
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		++(bValid ? m_Stats.Hits : m_Stats.Misses);
+
+		return bValid;
+	}
+
+	void ShaderCache::Store(uint64 Key, std::span<const uint8> Bytecode)
+	{
+		if (Key == 0 || Bytecode.empty())
+		{
+			return;
+		}
+
+		EntryHeader header{};
+		header.Key	= Key;
+		header.Size = Bytecode.size();
+
+		std::vector<uint8> file(sizeof(EntryHeader) + Bytecode.size());
+		std::memcpy(file.data(), &header, sizeof(header));
+		std::memcpy(file.data() + sizeof(EntryHeader), Bytecode.data(), Bytecode.size());
+
+		// Same shader compiled twice at once would otherwise share the temporary file.
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (Files::WriteBinary(GetEntryPath(Key), file))
+		{
+			++m_Stats.Stores;
+		}
+	}
+
+	ShaderCacheStats ShaderCache::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Stats;
+	}
+
+	Filepath ShaderCache::GetEntryPath(uint64 Key) const
+	{
+		return m_Directory / std::format("{:016X}.bin", Key);
+	}
+
+} // namespace lde
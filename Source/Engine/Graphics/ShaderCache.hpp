@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+	Graphics/ShaderCache.hpp
+	Disk cache of compiled shader bytecode and scanner of HLSL include dependencies.
+	Uses no graphics API headers, so it works wherever DXC does.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Core/FileSystem.hpp"
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	/**
+	 * @brief Resolves #include directives of HLSL files, transitively.
+	 * Includes are looked up next to the including file first, then in include directories,
+	 * for both quoted and angled forms. Preprocessor conditions aren't evaluated,
+	 * so an include under #if counts as a dependency either way.
+	 * Parsed files are remembered until Invalidate().
+	 */
+	class ShaderIncludeScanner
+	{
+	public:
+		explicit ShaderIncludeScanner(std::vector<Filepath> IncludeDirs = {});
+
+		/// @return Include names in order of appearance; commented out directives are skipped.
+		static std::vector<std::string> ParseIncludes(std::string_view Source);
+
+		/// @return Every existing file Path includes directly or indirectly, sorted and without duplicates.
+		std::vector<Filepath> GetDependencies(const Filepath& Path);
+
+		/// @return FNV-1a of file's contents; 0 if it can't be read.
+		uint64 GetFileHash(const Filepath& Path);
+
+		/// @brief Forgets parsed files, so next calls see changes made on disk.
+		void Invalidate();
+
+	private:
+		struct FileInfo
+		{
+			uint64 Hash = 0;
+			bool bExists = false;
+			std::vector<Filepath> Includes;
+		};
+
+		const FileInfo& Scan(const Filepath& Path);
+		std::optional<Filepath> Resolve(const Filepath& Includer, const std::string& Include) const;
+
+		std::vector<Filepath> m_IncludeDirs;
+		std::unordered_map<std::string, FileInfo> m_Files;
+	};
+
+	/// @brief Everything that affects compiled bytecode.
+	struct ShaderCacheKeyDesc
+	{
+		Filepath Path;
+		std::string EntryPoint;
+		// Target, i.e. ps_6_6.
+		std::string Profile;
+		// NAME or NAME=VALUE; order matters as it does to the compiler.
+		std::vector<std::string> Defines;
+		// Remaining compiler arguments, i.e. optimization level.
+		std::vector<std::string> Arguments;
+		std::string CompilerVersion;
+	};
+
+	struct ShaderCacheStats
+	{
+		uint32 Hits		= 0;
+		uint32 Misses	= 0;
+		// Bytecode written to disk.
+		uint32 Stores	= 0;
+	};
+
+	/**
+	 * @brief Compiled shaders stored as Directory/<key>.bin.
+	 * Key covers source file, contents of all its transitive includes and the compile settings,
+	 * so editing a header invalidates only shaders that include it; stale entries are simply never read again.
+	 * Safe to use from multiple threads.
+	 */
+	class ShaderCache
+	{
+	public:
+		// Bumped whenever key derivation or file layout changes.
+		static constexpr uint32 Version = 1;
+
+		ShaderCache(Filepath Directory, std::vector<Filepath> IncludeDirs = {});
+
+		/// @return 0 if source file can't be read; such shaders aren't cached.
+		uint64 ComputeKey(const ShaderCacheKeyDesc& Desc);
+
+		/// @return False on a miss or if stored entry is damaged.
+		bool Load(uint64 Key, std::vector<uint8>& OutBytecode);
+		void Store(uint64 Key, std::span<const uint8> Bytecode);
+
+		/// @brief Not synchronized; use only while nothing compiles.
+		ShaderIncludeScanner& GetScanner() { return m_Scanner; }
+		ShaderCacheStats GetStats() const;
+
+	private:
+		Filepath GetEntryPath(uint64 Key) const;
+
+		Filepath				m_Directory;
+		// Guards scanner, stats and writes of entries.
+		mutable std::mutex		m_Mutex;
+		ShaderIncludeScanner	m_Scanner;
+		ShaderCacheStats		m_Stats{};
+	};
+} // namespace lde
@@ -1,15 +1,36 @@
 #include "Core/FileSystem.hpp"
 #include "Core/Logger.hpp"
 #include "Core/String.hpp"
+#include "Core/ThreadPool.hpp"
 #include "RHI/D3D12/D3D12Utility.hpp"
 #include "ShaderCompiler.hpp"
 #include <AgilitySDK/d3d12.h>
+#include <array>
+#include <chrono>
+#include <span>
 #include <vector>
 
 #pragma comment(lib, "dxcompiler")
 
 namespace lde
 {
+	namespace
+	{
+		// Arguments that affect generated code, besides entry point, target and defines.
+		const std::array CodegenArguments = {
+			// HLSL version: 2021 is latest
+			L"-HV 2021",
+			DXC_ARG_ALL_RESOURCES_BOUND,
+	#if defined (_DEBUG)
+			DXC_ARG_DEBUG,
+			DXC_ARG_DEBUG_NAME_FOR_SOURCE,
+			DXC_ARG_SKIP_OPTIMIZATIONS,
+	#else
+			DXC_ARG_OPTIMIZATION_LEVEL3
+	#endif
+		};
+	} // namespace
+
 	ShaderCompiler* ShaderCompiler::m_Instance = nullptr;
 
 	ShaderCompiler::ShaderCompiler()
@@ -36,28 +57,98 @@ namespace lde
 
 	void ShaderCompiler::Initialize()
 	{
-		DX_CALL(DxcCreateInstance(CLSID_DxcCompiler,	IID_PPV_ARGS(&m_DxcCompiler)));
-		DX_CALL(DxcCreateInstance(CLSID_DxcUtils,		IID_PPV_ARGS(&m_DxcUtils)));
 		DX_CALL(DxcCreateInstance(CLSID_DxcLibrary,		IID_PPV_ARGS(&m_DxcLibrary)));
-		DX_CALL(m_DxcUtils->CreateDefaultIncludeHandler(&m_DxcIncludeHandler));
+
+		m_CompilerVersion = QueryCompilerVersion(GetContext());
+		m_Cache = std::make_unique<ShaderCache>("Cache/Shaders", std::vector<Filepath>{ "Shaders" });
+
 		m_Instance = this;
 	}
 
 	void ShaderCompiler::Release()
 	{
+		{
+			std::unique_lock<std::mutex> lock(m_PendingMutex);
+			m_PendingCondition.wait(lock, [this]() { return m_PendingCompiles == 0; });
+		}
+
+		m_Cache.reset();
+
+		{
+			std::lock_guard<std::mutex> lock(m_ContextMutex);
+			m_Contexts.clear();
+		}
+
 		SAFE_RELEASE(m_DxcLibrary);
-		SAFE_RELEASE(m_DxcIncludeHandler);
-		SAFE_RELEASE(m_DxcUtils);
-		SAFE_RELEASE(m_DxcCompiler);
 	}
 
-	Shader ShaderCompiler::Compile(const std::string_view& Filepath, ShaderStage eType, std::wstring EntryPoint)
+	ShaderCompiler::DxcContext& ShaderCompiler::GetContext()
 	{
+		std::lock_guard<std::mutex> lock(m_ContextMutex);
+
+		auto& context = m_Contexts[std::this_thread::get_id()];
+		if (!context)
+		{
+			context = std::make_unique<DxcContext>();
+			DX_CALL(DxcCreateInstance(CLSID_DxcCompiler,	IID_PPV_ARGS(&context->Compiler)));
+			DX_CALL(DxcCreateInstance(CLSID_DxcUtils,		IID_PPV_ARGS(&context->Utils)));
+			DX_CALL(context->Utils->CreateDefaultIncludeHandler(&context->IncludeHandler));
+		}
+
+		return *context;
+	}
+
+	ShaderCompilerStats ShaderCompiler::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_StatsMutex);
+		return m_Stats;
+	}
+
+	Shader ShaderCompiler::Compile(const std::string_view& Filepath, ShaderStage eType, std::wstring EntryPoint, const std::vector<std::wstring>& Defines)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_StatsMutex);
+			++m_Stats.Requests;
+		}
+
+		DxcContext& context = GetContext();
+
+		auto shaderType = ShaderEnumToType(eType);
+
+		ShaderCacheKeyDesc keyDesc{};
+		keyDesc.Path			= std::filesystem::path(Filepath);
+		keyDesc.EntryPoint		= String::ToNarrow(EntryPoint);
+		keyDesc.Profile			= String::ToNarrow(shaderType);
+		keyDesc.CompilerVersion = m_CompilerVersion;
+		for (const std::wstring& define : Defines)
+		{
+			keyDesc.Defines.push_back(String::ToNarrow(define));
+		}
+		for (const wchar_t* argument : CodegenArguments)
+		{
+			keyDesc.Arguments.push_back(String::ToNarrow(argument));
+		}
+
+		const uint64 key = m_Cache->ComputeKey(keyDesc);
+
+		std::vector<uint8> bytecode;
+		if (m_Cache->Load(key, bytecode))
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_StatsMutex);
+				++m_Stats.CacheHits;
+			}
+
+			IDxcBlobEncoding* cachedBlob = nullptr;
+			DX_CALL(context.Utils->CreateBlob(bytecode.data(), static_cast<uint32>(bytecode.size()), DXC_CP_ACP, &cachedBlob));
+
+			return Shader(cachedBlob, eType);
+		}
+
 		uint32_t codePage = DXC_CP_ACP;
 		IDxcBlobEncoding* sourceBlob{};
-		DX_CALL(m_DxcUtils->LoadFile(String::ToWide(Filepath).c_str(), &codePage, &sourceBlob));
+		DX_CALL(context.Utils->LoadFile(String::ToWide(Filepath).c_str(), &codePage, &sourceBlob));
 	
-		auto shaderType = ShaderEnumToType(eType);
 		std::wstring parentPath = String::ToWide(Files::GetParentPath(Filepath));
 
 		std::vector<LPCWSTR> arguments = {
@@ -68,21 +159,27 @@ namespace lde
 			// Include paths: without them, it can cause issues when trying to do includes inside hlsl
 			L"-I Shaders/",
 			L"-I ", parentPath.c_str(),
-			// HLSL version: 2021 is latest
-			L"-HV 2021",
-			DXC_ARG_ALL_RESOURCES_BOUND,
-	#if defined (_DEBUG)
-			DXC_ARG_DEBUG,
-			DXC_ARG_DEBUG_NAME_FOR_SOURCE,
-			DXC_ARG_SKIP_OPTIMIZATIONS,
-	#else
-			DXC_ARG_OPTIMIZATION_LEVEL3
-	#endif
 		};
+
+		for (const std::wstring& define : Defines)
+		{
+			arguments.push_back(L"-D");
+			arguments.push_back(define.c_str());
+		}
+
+		arguments.insert(arguments.end(), CodegenArguments.begin(), CodegenArguments.end());
 	
+		const auto start = std::chrono::high_resolution_clock::now();
+
 		DxcBuffer buffer{ sourceBlob->GetBufferPointer(), sourceBlob->GetBufferSize(), DXC_CP_ACP };
 		IDxcResult* result = nullptr;
-		DX_CALL(m_DxcCompiler.Get()->Compile(&buffer, arguments.data(), static_cast<uint32>(arguments.size()), m_DxcIncludeHandler.Get(), IID_PPV_ARGS(&result)));
+		DX_CALL(context.Compiler->Compile(&buffer, arguments.data(), static_cast<uint32>(arguments.size()), context.IncludeHandler.Get(), IID_PPV_ARGS(&result)));
+
+		{
+			std::lock_guard<std::mutex> lock(m_StatsMutex);
+			m_Stats.CompileTimeMs += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			++m_Stats.Compiled;
+		}
 	
 		IDxcBlobUtf8* errors = nullptr;
 		IDxcBlobUtf16* outputName = nullptr;
@@ -96,7 +193,66 @@ namespace lde
 	
 		IDxcBlob* blob = nullptr;
 		DX_CALL(result->GetResult(&blob));
+
+		m_Cache->Store(key, std::span(static_cast<const uint8*>(blob->GetBufferPointer()), blob->GetBufferSize()));
 	
 		return Shader(blob, eType);
 	}
+
+	std::future<Shader> ShaderCompiler::CompileAsync(std::string Filepath, ShaderStage eType, std::wstring EntryPoint, std::vector<std::wstring> Defines)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_PendingMutex);
+			++m_PendingCompiles;
+		}
+
+		return ThreadPool::GetInstance().Submit(
+			[this, path = std::move(Filepath), eType, entryPoint = std::move(EntryPoint), defines = std::move(Defines)]()
+			{
+				// Also reached when Compile throws.
+				struct PendingScope
+				{
+					ShaderCompiler* Compiler;
+					~PendingScope()
+					{
+						{
+							std::lock_guard<std::mutex> lock(Compiler->m_PendingMutex);
+							--Compiler->m_PendingCompiles;
+						}
+						Compiler->m_PendingCondition.notify_all();
+					}
+				} scope{ this };
+
+				return Compile(path, eType, entryPoint, defines);
+			});
+	}
+
+	std::string ShaderCompiler::QueryCompilerVersion(DxcContext& Context) const
+	{
+		std::string version = "unknown";
+
+		Ref<IDxcVersionInfo> versionInfo;
+		if (SUCCEEDED(Context.Compiler->QueryInterface(IID_PPV_ARGS(&versionInfo))))
+		{
+			UINT32 major = 0;
+			UINT32 minor = 0;
+			versionInfo->GetVersion(&major, &minor);
+			version = std::format("{}.{}", major, minor);
+		}
+
+		// Distinguishes builds sharing a version number.
+		Ref<IDxcVersionInfo2> commitInfo;
+		if (SUCCEEDED(Context.Compiler->QueryInterface(IID_PPV_ARGS(&commitInfo))))
+		{
+			UINT32 commitCount = 0;
+			char* commitHash = nullptr;
+			if (SUCCEEDED(commitInfo->GetCommitInfo(&commitCount, &commitHash)) && commitHash)
+			{
+				version += std::format("-{}-{}", commitCount, commitHash);
+				::CoTaskMemFree(commitHash);
+			}
+		}
+
+		return version;
+	}
 } // namespace lde
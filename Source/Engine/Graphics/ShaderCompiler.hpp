@@ -7,7 +7,17 @@
 
 #include "Core/RefPtr.hpp"
 #include "RHI/Types.hpp"
+#include "ShaderCache.hpp"
 #include <dxcapi.h>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace lde
 {
@@ -16,6 +26,24 @@ namespace lde
 	public:
 		Shader() {}
 		Shader(IDxcBlob* pSource, ShaderStage eStage) : BinaryData(pSource), Stage(eStage) { }
+		// Owns a reference to the blob; copies would release it twice.
+		Shader(const Shader&) = delete;
+		Shader& operator=(const Shader&) = delete;
+		Shader(Shader&& Other) noexcept
+			: BinaryData(std::exchange(Other.BinaryData, nullptr)), Stage(Other.Stage) { }
+		Shader& operator=(Shader&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				if (BinaryData != nullptr)
+				{
+					BinaryData->Release();
+				}
+				BinaryData	= std::exchange(Other.BinaryData, nullptr);
+				Stage		= Other.Stage;
+			}
+			return *this;
+		}
 		~Shader()
 		{
 			if (BinaryData != nullptr)
@@ -47,7 +75,21 @@ namespace lde
 		
 	};
 
-	/// @brief Singleton
+	struct ShaderCompilerStats
+	{
+		uint32 Requests		= 0;
+		// Loaded from ShaderCache.
+		uint32 CacheHits	= 0;
+		// Compiled by DXC.
+		uint32 Compiled		= 0;
+		// Spent in DXC, summed over all threads.
+		float CompileTimeMs	= 0.0f;
+	};
+
+	/**
+	 * @brief Singleton
+	 * Every thread that compiles gets its own DXC instances, so Compile may be called concurrently.
+	 */
 	class ShaderCompiler
 	{
 	public:
@@ -60,15 +102,54 @@ namespace lde
 		void Initialize();
 		void Release();
 	
-		Shader Compile(const std::string_view& Filepath, ShaderStage eType, std::wstring EntryPoint = L"main");
+		/**
+		 * @brief Bytecode is looked up in ShaderCache first; DXC runs only if the source, any file it includes,
+		 * entry point, target, Defines or compiler version changed since it was last cached.
+		 * @param Defines NAME or NAME=VALUE, passed as -D.
+		 */
+		Shader Compile(const std::string_view& Filepath, ShaderStage eType, std::wstring EntryPoint = L"main", const std::vector<std::wstring>& Defines = {});
+
+		/**
+		 * @brief Runs Compile on ThreadPool. Start every compile a pipeline needs first and wait
+		 * only when creating it, so they overlap. Compile errors are rethrown by get().
+		 * Don't wait on the result from a pool worker; it may be queued behind the waiting task.
+		 */
+		std::future<Shader> CompileAsync(std::string Filepath, ShaderStage eType, std::wstring EntryPoint = L"main", std::vector<std::wstring> Defines = {});
 	
 		static ShaderCompiler& GetInstance();
 
+		ShaderCache* GetCache() const { return m_Cache.get(); }
+		ShaderCompilerStats GetStats() const;
+
 	private:
-		Ref<IDxcCompiler3>		m_DxcCompiler;
-		Ref<IDxcUtils>			m_DxcUtils;
-		Ref<IDxcIncludeHandler>	m_DxcIncludeHandler;
+		struct DxcContext
+		{
+			Ref<IDxcCompiler3>		Compiler;
+			Ref<IDxcUtils>			Utils;
+			Ref<IDxcIncludeHandler>	IncludeHandler;
+		};
+
+		/// @brief Instances of calling thread; created on first use.
+		DxcContext& GetContext();
+
+		/// @return DXC version and commit; part of every cache key, so updating DXC recompiles everything.
+		std::string QueryCompilerVersion(DxcContext& Context) const;
+
 		Ref<IDxcLibrary>		m_DxcLibrary;
+
+		std::mutex m_ContextMutex;
+		std::unordered_map<std::thread::id, std::unique_ptr<DxcContext>> m_Contexts;
+
+		// Release waits for compiles queued by CompileAsync, as they use this instance.
+		std::mutex				m_PendingMutex;
+		std::condition_variable	m_PendingCondition;
+		uint32					m_PendingCompiles = 0;
+
+		std::unique_ptr<ShaderCache>	m_Cache;
+		std::string						m_CompilerVersion;
+
+		mutable std::mutex		m_StatsMutex;
+		ShaderCompilerStats		m_Stats{};
 	
 		static ShaderCompiler* m_Instance;
 	};
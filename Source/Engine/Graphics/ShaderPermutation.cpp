@@ -0,0 +1,46 @@
+#include "ShaderPermutation.hpp"
+#include <cassert>
+
+namespace lde
+{
+	ShaderFeatureSet::ShaderFeatureSet(std::vector<std::wstring> Defines)
+		: m_Defines(std::move(Defines))
+	{
+		assert(m_Defines.size() <= MaxFeatures);
+	}
+
+	std::vector<std::wstring> ShaderFeatureSet::GetDefines(PermutationKey Key) const
+	{
+		std::vector<std::wstring> defines;
+		for (uint32 bit = 0; bit < GetFeatureCount(); ++bit)
+		{
+			if (Key & (1u << bit))
+			{
+				defines.push_back(m_Defines.at(bit));
+			}
+		}
+
+		return defines;
+	}
+
+	std::string ShaderFeatureSet::GetName(PermutationKey Key) const
+	{
+		std::string name;
+		for (const std::wstring& define : GetDefines(Key))
+		{
+			if (!name.empty())
+			{
+				name.push_back('|');
+			}
+
+			// Defines are plain ASCII.
+			for (const wchar_t c : define)
+			{
+				name.push_back(static_cast<char>(c));
+			}
+		}
+
+		return name.empty() ? "BASE" : name;
+	}
+
+} // namespace lde
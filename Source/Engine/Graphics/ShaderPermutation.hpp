@@ -0,0 +1,54 @@
+#pragma once
+
+/*
+	Graphics/ShaderPermutation.hpp
+	Variants of a single shader selected by a bitmask of compile-time features.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <string>
+#include <vector>
+
+namespace lde
+{
+	/// @brief Bit i enables i-th feature of a ShaderFeatureSet.
+	using PermutationKey = uint32;
+
+	/**
+	 * @brief Features a shader declares; each one is a define the shader tests with #ifdef.
+	 * Permutation for a key is the shader compiled with defines of its enabled bits,
+	 * so replacing runtime branches with features costs nothing per pixel.
+	 */
+	class ShaderFeatureSet
+	{
+	public:
+		// Sort key has 12 pipeline bits.
+		static constexpr uint32 MaxFeatures = 12;
+
+		explicit ShaderFeatureSet(std::vector<std::wstring> Defines);
+
+		/// @return Defines of enabled bits in bit order, so a key always maps to the same shader cache entry.
+		std::vector<std::wstring> GetDefines(PermutationKey Key) const;
+
+		/// @return Readable name, i.e. "ALPHA_TEST|NO_NORMAL_MAP"; "BASE" for key 0.
+		std::string GetName(PermutationKey Key) const;
+
+		uint32 GetFeatureCount() const { return static_cast<uint32>(m_Defines.size()); }
+		/// @return Number of possible keys; not all of them are ever compiled.
+		uint32 GetPermutationCount() const { return 1u << GetFeatureCount(); }
+		PermutationKey GetMask() const { return GetPermutationCount() - 1; }
+
+	private:
+		std::vector<std::wstring> m_Defines;
+	};
+
+	struct ShaderPermutationStats
+	{
+		// Possible keys of the feature set.
+		uint32 Declared			= 0;
+		// Keys used by some material and compiled.
+		uint32 Compiled			= 0;
+		// Time spent waiting for permutations to compile and their pipelines to be created.
+		float  CompileTimeMs	= 0.0f;
+	};
+} // namespace lde
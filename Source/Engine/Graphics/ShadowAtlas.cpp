@@ -0,0 +1,502 @@
+#include "ShadowAtlas.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace lde
+{
+	namespace
+	{
+		// Morton decode; every other bit.
+		inline uint32 CompactBits(uint32 Value)
+		{
+			Value &= 0x55555555;
+			Value = (Value | (Value >> 1)) & 0x33333333;
+			Value = (Value | (Value >> 2)) & 0x0F0F0F0F;
+			Value = (Value | (Value >> 4)) & 0x00FF00FF;
+			Value = (Value | (Value >> 8)) & 0x0000FFFF;
+			return Value;
+		}
+
+		inline uint32 GetNodeCount(uint32 Level)
+		{
+			return 1u << (2 * Level);
+		}
+	}
+
+	ShadowAtlasAllocator::ShadowAtlasAllocator(uint32 AtlasSize, uint32 MinTileSize)
+	{
+		Initialize(AtlasSize, MinTileSize);
+	}
+
+	void ShadowAtlasAllocator::Initialize(uint32 AtlasSize, uint32 MinTileSize)
+	{
+		m_AtlasSize = std::bit_floor(std::max(AtlasSize, 1u));
+		const uint32 minTileSize = std::bit_floor(std::clamp(MinTileSize, 1u, m_AtlasSize));
+
+		// Morton index of deepest level has to fit in 32 bits.
+		m_LevelCount = std::min<uint32>(std::countr_zero(m_AtlasSize / minTileSize) + 1, 16);
+
+		m_FreeNodes.resize(m_LevelCount);
+		m_UsedNodes.resize(m_LevelCount);
+		for (uint32 level = 0; level < m_LevelCount; ++level)
+		{
+			const uint32 words = (GetNodeCount(level) + 63) / 64;
+			m_FreeNodes[level].assign(words, 0);
+			m_UsedNodes[level].assign(words, 0);
+		}
+
+		Reset();
+	}
+
+	void ShadowAtlasAllocator::Reset()
+	{
+		for (uint32 level = 0; level < m_LevelCount; ++level)
+		{
+			std::fill(m_FreeNodes[level].begin(), m_FreeNodes[level].end(), 0);
+			std::fill(m_UsedNodes[level].begin(), m_UsedNodes[level].end(), 0);
+		}
+
+		if (m_LevelCount > 0)
+		{
+			SetBit(m_FreeNodes[0], 0);
+		}
+		m_UsedArea = 0;
+	}
+
+	AtlasTile ShadowAtlasAllocator::Allocate(uint32 Level)
+	{
+		if (Level >= m_LevelCount)
+		{
+			return AtlasTile();
+		}
+
+		uint32 node = FindFirst(m_FreeNodes[Level]);
+		if (node == AtlasTile::InvalidNode)
+		{
+			if (Level == 0)
+			{
+				return AtlasTile();
+			}
+
+			// Split parent; first child is taken, remaining three become free.
+			const AtlasTile parent = Allocate(Level - 1);
+			if (!parent.IsValid())
+			{
+				return AtlasTile();
+			}
+			ClearBit(m_UsedNodes[Level - 1], parent.Node);
+			m_UsedArea -= static_cast<uint64>(parent.Size) * parent.Size;
+
+			node = parent.Node * 4;
+			for (uint32 i = 1; i < 4; ++i)
+			{
+				SetBit(m_FreeNodes[Level], node + i);
+			}
+		}
+		else
+		{
+			ClearBit(m_FreeNodes[Level], node);
+		}
+
+		SetBit(m_UsedNodes[Level], node);
+
+		const AtlasTile tile = MakeTile(Level, node);
+		m_UsedArea += static_cast<uint64>(tile.Size) * tile.Size;
+
+		return tile;
+	}
+
+	void ShadowAtlasAllocator::Free(const AtlasTile& Tile)
+	{
+		if (!Tile.IsValid() || Tile.Level >= m_LevelCount || !TestBit(m_UsedNodes[Tile.Level], Tile.Node))
+		{
+			return;
+		}
+
+		ClearBit(m_UsedNodes[Tile.Level], Tile.Node);
+		m_UsedArea -= static_cast<uint64>(Tile.Size) * Tile.Size;
+
+		uint32 level = Tile.Level;
+		uint32 node = Tile.Node;
+		SetBit(m_FreeNodes[level], node);
+
+		// Merge upwards while all four siblings are free.
+		while (level > 0)
+		{
+			const uint32 first = node & ~3u;
+			for (uint32 i = 0; i < 4; ++i)
+			{
+				if (!TestBit(m_FreeNodes[level], first + i))
+				{
+					return;
+				}
+			}
+
+			for (uint32 i = 0; i < 4; ++i)
+			{
+				ClearBit(m_FreeNodes[level], first + i);
+			}
+
+			--level;
+			node = first / 4;
+			SetBit(m_FreeNodes[level], node);
+		}
+	}
+
+	uint32 ShadowAtlasAllocator::GetLevel(uint32 Size) const
+	{
+		const uint32 size = std::bit_floor(std::clamp(Size, 1u, m_AtlasSize));
+		const uint32 level = static_cast<uint32>(std::countr_zero(m_AtlasSize / size));
+
+		return std::min(level, m_LevelCount - 1);
+	}
+
+	uint32 ShadowAtlasAllocator::GetLastAllocated(uint32 Level) const
+	{
+		if (Level >= m_LevelCount)
+		{
+			return AtlasTile::InvalidNode;
+		}
+
+		const auto& bits = m_UsedNodes[Level];
+		for (usize word = bits.size(); word-- > 0;)
+		{
+			if (bits[word] != 0)
+			{
+				return static_cast<uint32>(word * 64 + 63 - std::countl_zero(bits[word]));
+			}
+		}
+
+		return AtlasTile::InvalidNode;
+	}
+
+	uint32 ShadowAtlasAllocator::FindFirst(const std::vector<uint64>& Bits) const
+	{
+		for (usize word = 0; word < Bits.size(); ++word)
+		{
+			if (Bits[word] != 0)
+			{
+				return static_cast<uint32>(word * 64 + std::countr_zero(Bits[word]));
+			}
+		}
+
+		return AtlasTile::InvalidNode;
+	}
+
+	bool ShadowAtlasAllocator::TestBit(const std::vector<uint64>& Bits, uint32 Index)
+	{
+		return (Bits[Index / 64] >> (Index % 64)) & 1;
+	}
+
+	void ShadowAtlasAllocator::SetBit(std::vector<uint64>& Bits, uint32 Index)
+	{
+		Bits[Index / 64] |= (1ULL << (Index % 64));
+	}
+
+	void ShadowAtlasAllocator::ClearBit(std::vector<uint64>& Bits, uint32 Index)
+	{
+		Bits[Index / 64] &= ~(1ULL << (Index % 64));
+	}
+
+	AtlasTile ShadowAtlasAllocator::MakeTile(uint32 Level, uint32 Node) const
+	{
+		AtlasTile tile{};
+		tile.Size	= GetTileSize(Level);
+		tile.X		= CompactBits(Node) * tile.Size;
+		tile.Y		= CompactBits(Node >> 1) * tile.Size;
+		tile.Level	= Level;
+		tile.Node	= Node;
+
+		return tile;
+	}
+
+	ShadowAtlas::ShadowAtlas(uint32 AtlasSize, uint32 MaxTileSize, uint32 MinTileSize)
+	{
+		m_Allocator.Initialize(AtlasSize, MinTileSize);
+		m_MaxTileLevel = m_Allocator.GetLevel(MaxTileSize);
+		m_MinTileLevel = m_Allocator.GetLevelCount() - 1;
+	}
+
+	void ShadowAtlas::Update(std::span<const ShadowAtlasRequest> Requests)
+	{
+		m_Stats = ShadowAtlasStats{};
+		m_Stats.Requests = static_cast<uint32>(Requests.size());
+
+		for (auto& entry : m_Entries)
+		{
+			entry.bRequested = false;
+		}
+
+		// Match requests with entries of previous frame.
+		for (uint32 i = 0; i < static_cast<uint32>(Requests.size()); ++i)
+		{
+			const auto& request = Requests[i];
+
+			auto it = m_Lookup.find(request.Key);
+			if (it == m_Lookup.end())
+			{
+				it = m_Lookup.emplace(request.Key, static_cast<uint32>(m_Entries.size())).first;
+				m_Entries.emplace_back().Key = request.Key;
+			}
+
+			auto& entry = m_Entries[it->second];
+			entry.bRequested	= true;
+			entry.Request		= i;
+			entry.RequestedLevel = GetRequestedLevel(request);
+			entry.bDirty		= entry.bDirty || (entry.Version != request.Version);
+			entry.Version		= request.Version;
+		}
+
+		// Release tiles of views that are gone or have to shrink, before anything is allocated.
+		for (uint32 i = 0; i < static_cast<uint32>(m_Entries.size());)
+		{
+			if (!m_Entries[i].bRequested)
+			{
+				RemoveEntry(i);
+				continue;
+			}
+			++i;
+		}
+
+		UpdateLevelBias();
+
+		for (auto& entry : m_Entries)
+		{
+			entry.DesiredLevel = GetDesiredLevel(entry.RequestedLevel + static_cast<float>(m_LevelBias), entry.Tile);
+
+			// Shrinking always succeeds; growing is tried in priority order below.
+			if (entry.Tile.IsValid() && entry.Tile.Level < entry.DesiredLevel)
+			{
+				m_Allocator.Free(entry.Tile);
+				entry.Tile = AtlasTile();
+			}
+		}
+
+		// Biggest tiles first, so buddy blocks pack without holes; most important views first within a size.
+		m_Order.resize(m_Entries.size());
+		for (uint32 i = 0; i < static_cast<uint32>(m_Order.size()); ++i)
+		{
+			m_Order[i] = i;
+		}
+		std::stable_sort(m_Order.begin(), m_Order.end(), [&](uint32 Lhs, uint32 Rhs)
+			{
+				if (m_Entries[Lhs].DesiredLevel != m_Entries[Rhs].DesiredLevel)
+				{
+					return m_Entries[Lhs].DesiredLevel < m_Entries[Rhs].DesiredLevel;
+				}
+
+				const auto& lhs = Requests[m_Entries[Lhs].Request];
+				const auto& rhs = Requests[m_Entries[Rhs].Request];
+				return (lhs.Coverage * lhs.Importance) > (rhs.Coverage * rhs.Importance);
+			});
+
+		m_bFragmented = false;
+		for (uint32 index : m_Order)
+		{
+			auto& entry = m_Entries[index];
+			if (entry.Tile.IsValid())
+			{
+				if (entry.Tile.Level == entry.DesiredLevel)
+				{
+					continue;
+				}
+
+				// Too small; keep current tile and its cached content unless bigger one is available.
+				const AtlasTile tile = m_Allocator.Allocate(entry.DesiredLevel);
+				if (!tile.IsValid())
+				{
+					m_Stats.Downsized++;
+					m_bFragmented = true;
+					continue;
+				}
+
+				m_Allocator.Free(entry.Tile);
+				entry.Tile = tile;
+				entry.bDirty = true;
+				continue;
+			}
+
+			entry.Tile = AllocateTile(entry.DesiredLevel);
+			entry.bDirty = true;
+
+			if (!entry.Tile.IsValid())
+			{
+				m_Stats.Rejected++;
+				m_bFragmented = true;
+			}
+			else if (entry.Tile.Level != entry.DesiredLevel)
+			{
+				m_Stats.Downsized++;
+				m_bFragmented = true;
+			}
+		}
+
+		if (m_bFragmented)
+		{
+			Defragment();
+		}
+
+		m_Allocations.resize(Requests.size());
+		for (auto& entry : m_Entries)
+		{
+			auto& allocation = m_Allocations[entry.Request];
+			allocation.Tile		= entry.Tile;
+			allocation.bRender	= entry.Tile.IsValid() && entry.bDirty;
+
+			if (entry.Tile.IsValid())
+			{
+				m_Stats.Allocated++;
+				(allocation.bRender ? m_Stats.Rendered : m_Stats.Cached)++;
+				entry.bDirty = false;
+			}
+		}
+
+		const float atlasSize = static_cast<float>(m_Allocator.GetAtlasSize());
+		m_Stats.LevelBias = m_LevelBias;
+		m_Stats.Occupancy = static_cast<float>(m_Allocator.GetUsedArea()) / (atlasSize * atlasSize);
+	}
+
+	void ShadowAtlas::Reset()
+	{
+		m_Allocator.Reset();
+		m_Entries.clear();
+		m_Lookup.clear();
+		m_Allocations.clear();
+		m_LevelBias = 0;
+		m_Stats = ShadowAtlasStats{};
+	}
+
+	float ShadowAtlas::GetRequestedLevel(const ShadowAtlasRequest& Request) const
+	{
+		const float maxTileSize = static_cast<float>(m_Allocator.GetTileSize(m_MaxTileLevel));
+		const float coverage	= std::clamp(Request.Coverage, 0.0f, 1.0f);
+		const float importance	= std::clamp(Request.Importance, 0.0f, 1.0f);
+
+		// Texel density follows projected size, so area coverage maps to square root of it.
+		const float size = std::max(maxTileSize * std::sqrt(coverage) * importance, 1.0f);
+
+		return std::log2(static_cast<float>(m_Allocator.GetAtlasSize()) / size);
+	}
+
+	uint32 ShadowAtlas::GetDesiredLevel(float Level, const AtlasTile& Current) const
+	{
+		if (Current.IsValid())
+		{
+			const float currentLevel = static_cast<float>(Current.Level);
+			if (Level > currentLevel - 1.0f - Hysteresis && Level <= currentLevel + Hysteresis)
+			{
+				return Current.Level;
+			}
+		}
+
+		return ClampLevel(Level);
+	}
+
+	uint32 ShadowAtlas::ClampLevel(float Level) const
+	{
+		const uint32 level = static_cast<uint32>(std::ceil(std::max(Level, 0.0f)));
+		return std::clamp(level, m_MaxTileLevel, m_MinTileLevel);
+	}
+
+	void ShadowAtlas::UpdateLevelBias()
+	{
+		auto getArea = [&](uint32 Bias)
+			{
+				uint64 area = 0;
+				for (const auto& entry : m_Entries)
+				{
+					const uint64 size = m_Allocator.GetTileSize(ClampLevel(entry.RequestedLevel + static_cast<float>(Bias)));
+					area += size * size;
+				}
+				return area;
+			};
+
+		const uint64 atlasSize = m_Allocator.GetAtlasSize();
+		const uint64 capacity = atlasSize * atlasSize;
+
+		uint32 bias = 0;
+		while (bias < m_MinTileLevel && getArea(bias) > capacity)
+		{
+			++bias;
+		}
+
+		// Lowering the bias resizes nearly every tile; wait until there's clearly enough room.
+		if (bias < m_LevelBias && getArea(bias) * 4 > capacity * 3)
+		{
+			bias = m_LevelBias;
+		}
+
+		m_LevelBias = bias;
+	}
+
+	AtlasTile ShadowAtlas::AllocateTile(uint32 DesiredLevel)
+	{
+		for (uint32 level = DesiredLevel; level <= m_MinTileLevel; ++level)
+		{
+			const AtlasTile tile = m_Allocator.Allocate(level);
+			if (tile.IsValid())
+			{
+				return tile;
+			}
+		}
+
+		return AtlasTile();
+	}
+
+	void ShadowAtlas::RemoveEntry(uint32 Index)
+	{
+		m_Allocator.Free(m_Entries[Index].Tile);
+		m_Lookup.erase(m_Entries[Index].Key);
+
+		if (Index != m_Entries.size() - 1)
+		{
+			m_Entries[Index] = m_Entries.back();
+			m_Lookup[m_Entries[Index].Key] = Index;
+		}
+		m_Entries.pop_back();
+	}
+
+	void ShadowAtlas::Defragment()
+	{
+		// Moves last tile of a level into lowest free slot, so free space gathers at the end of Morton order
+		// where it merges into larger tiles. Biggest tiles first, as they are the hardest to place.
+		uint32 budget = DefragBudget;
+		for (uint32 level = m_MaxTileLevel; level <= m_MinTileLevel && budget > 0; ++level)
+		{
+			while (budget > 0)
+			{
+				const uint32 last = m_Allocator.GetLastAllocated(level);
+				if (last == AtlasTile::InvalidNode)
+				{
+					break;
+				}
+
+				const AtlasTile target = m_Allocator.Allocate(level);
+				if (!target.IsValid() || target.Node >= last)
+				{
+					m_Allocator.Free(target);
+					break;
+				}
+
+				auto it = std::find_if(m_Entries.begin(), m_Entries.end(), [&](const Entry& Entry)
+					{
+						return Entry.Tile.Level == level && Entry.Tile.Node == last;
+					});
+				if (it == m_Entries.end())
+				{
+					m_Allocator.Free(target);
+					break;
+				}
+
+				m_Allocator.Free(it->Tile);
+				it->Tile	= target;
+				it->bDirty	= true;
+
+				m_Stats.Moved++;
+				budget--;
+			}
+		}
+	}
+
+} // namespace lde
@@ -0,0 +1,200 @@
+#pragma once
+
+/*
+	Graphics/ShadowAtlas.hpp
+	Shared depth atlas for local light shadows.
+	Tiles are power of two squares handed out by quadtree allocator;
+	ShadowAtlas assigns them to shadow views every frame and keeps unchanged ones cached.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	/// @brief Square region of the atlas. Level 0 is whole atlas, each next level halves tile size.
+	struct AtlasTile
+	{
+		static constexpr uint32 InvalidNode = UINT32_MAX;
+
+		uint32 X	 = 0;
+		uint32 Y	 = 0;
+		uint32 Size	 = 0;
+		uint32 Level = 0;
+		// Morton index of the tile within its level.
+		uint32 Node	 = InvalidNode;
+
+		bool IsValid() const { return Node != InvalidNode; }
+	};
+
+	/**
+	 * @brief Quadtree (buddy) allocator over square area.
+	 * Free nodes are tracked as bitmask per level; freeing a node merges it with its three siblings once they are all free.
+	 * Operates on texel coordinates only.
+	 */
+	class ShadowAtlasAllocator
+	{
+	public:
+		ShadowAtlasAllocator() = default;
+		/**
+		 * @param AtlasSize Width and height of the atlas. Rounded down to power of two.
+		 * @param MinTileSize Smallest tile. Rounded down to power of two.
+		 */
+		ShadowAtlasAllocator(uint32 AtlasSize, uint32 MinTileSize);
+
+		void Initialize(uint32 AtlasSize, uint32 MinTileSize);
+
+		/// @brief Frees every tile.
+		void Reset();
+
+		/// @return Invalid tile if there is no free node at given level.
+		AtlasTile Allocate(uint32 Level);
+		void Free(const AtlasTile& Tile);
+
+		/// @brief Level of the largest tile not bigger than given size.
+		uint32 GetLevel(uint32 Size) const;
+		uint32 GetTileSize(uint32 Level) const { return m_AtlasSize >> Level; }
+
+		uint32 GetAtlasSize()	const { return m_AtlasSize; }
+		uint32 GetLevelCount()	const { return m_LevelCount; }
+		/// @brief Texels covered by allocated tiles.
+		uint64 GetUsedArea()	const { return m_UsedArea; }
+
+		/// @brief Highest Morton index of allocated tile at given level; InvalidNode if there is none.
+		uint32 GetLastAllocated(uint32 Level) const;
+
+	private:
+		uint32 FindFirst(const std::vector<uint64>& Bits) const;
+
+		static bool TestBit(const std::vector<uint64>& Bits, uint32 Index);
+		static void SetBit(std::vector<uint64>& Bits, uint32 Index);
+		static void ClearBit(std::vector<uint64>& Bits, uint32 Index);
+
+		AtlasTile MakeTile(uint32 Level, uint32 Node) const;
+
+		uint32 m_AtlasSize	= 0;
+		uint32 m_LevelCount = 0;
+		uint64 m_UsedArea	= 0;
+
+		std::vector<std::vector<uint64>> m_FreeNodes;
+		std::vector<std::vector<uint64>> m_UsedNodes;
+
+	};
+
+	/// @brief Single shadow view asking for space in the atlas; i.e. spot light or one face of point light.
+	struct ShadowAtlasRequest
+	{
+		// Stable identifier of a view across frames.
+		uint64 Key			= 0;
+		// Fraction of screen covered by light's volume, [0.0, 1.0].
+		float Coverage		= 0.0f;
+		// Scales tile size and priority, [0.0, 1.0].
+		float Importance	= 1.0f;
+		// Hash of anything that affects shadow content. Tile isn't redrawn as long as it doesn't change.
+		uint64 Version		= 0;
+	};
+
+	struct ShadowAtlasAllocation
+	{
+		AtlasTile Tile;
+		// Tile is new, moved, resized or its content is outdated.
+		bool bRender = false;
+	};
+
+	struct ShadowAtlasStats
+	{
+		uint32 Requests		= 0;
+		uint32 Allocated	= 0;
+		uint32 Rendered		= 0;
+		uint32 Cached		= 0;
+		// Got smaller tile than asked for.
+		uint32 Downsized	= 0;
+		// Got no tile at all.
+		uint32 Rejected		= 0;
+		// Tiles relocated by defragmentation.
+		uint32 Moved		= 0;
+		// Levels every tile was scaled down by to fit all requests.
+		uint32 LevelBias	= 0;
+		float Occupancy		= 0.0f;
+	};
+
+	class ShadowAtlas
+	{
+	public:
+		/**
+		 * @param AtlasSize Width and height of the atlas texture.
+		 * @param MaxTileSize Tile given to a view covering whole screen.
+		 * @param MinTileSize Smallest tile worth rendering.
+		 */
+		ShadowAtlas(uint32 AtlasSize = 8192, uint32 MaxTileSize = 1024, uint32 MinTileSize = 64);
+
+		/**
+		 * @brief Assigns tiles to requests. Tile size follows Coverage * Importance;
+		 * if all of them don't fit, every tile is scaled down by the same number of levels.
+		 * Views kept from previous frame keep their tiles; views not requested anymore release them.
+		 * If some view didn't get desired tile, up to DefragBudget tiles are moved towards start of the atlas.
+		 */
+		void Update(std::span<const ShadowAtlasRequest> Requests);
+
+		/// @brief Result of last Update, in request order.
+		std::span<const ShadowAtlasAllocation> GetAllocations() const { return m_Allocations; }
+
+		const ShadowAtlasStats& GetStats() const { return m_Stats; }
+		const ShadowAtlasAllocator& GetAllocator() const { return m_Allocator; }
+
+		/// @brief Frees every tile; everything is redrawn next Update.
+		void Reset();
+
+		/// @brief Tiles that can be moved per Update.
+		uint32 DefragBudget = 2;
+		/// @brief Fraction of a level size has to move past before tile is resized. Prevents flickering between sizes.
+		float Hysteresis = 0.25f;
+
+	private:
+		struct Entry
+		{
+			uint64		Key			= 0;
+			AtlasTile	Tile;
+			uint64		Version		= 0;
+			uint32		Request		= 0;
+			float		RequestedLevel = 0.0f;
+			uint32		DesiredLevel = 0;
+			bool		bRequested	= false;
+			bool		bDirty		= true;
+		};
+
+		/// @brief Unclamped, fractional level a request asks for.
+		float GetRequestedLevel(const ShadowAtlasRequest& Request) const;
+		/// @brief Level to allocate, keeping level of Current tile if it's still within hysteresis.
+		uint32 GetDesiredLevel(float Level, const AtlasTile& Current) const;
+		uint32 ClampLevel(float Level) const;
+
+		/// @brief Picks smallest bias at which all requested tiles fit into the atlas.
+		void UpdateLevelBias();
+
+		/// @brief Tries desired level, then smaller ones.
+		AtlasTile AllocateTile(uint32 DesiredLevel);
+
+		void RemoveEntry(uint32 Index);
+
+		void Defragment();
+
+		ShadowAtlasAllocator m_Allocator;
+		uint32 m_MaxTileLevel = 0;
+		uint32 m_MinTileLevel = 0;
+
+		std::vector<Entry> m_Entries;
+		std::unordered_map<uint64, uint32> m_Lookup;
+
+		std::vector<uint32> m_Order;
+		std::vector<ShadowAtlasAllocation> m_Allocations;
+
+		bool m_bFragmented = false;
+		uint32 m_LevelBias = 0;
+
+		ShadowAtlasStats m_Stats{};
+
+	};
+} // namespace lde
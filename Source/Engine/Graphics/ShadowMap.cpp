@@ -1,63 +1,362 @@
-#include "RHI/D3D12/D3D12Viewport.hpp"
-#include "RHI/D3D12/D3D12Device.hpp"
+#include "Core/ThreadPool.hpp"
 #include "ShadowMap.hpp"
-#include "Platform/Window.hpp"
-#include "RHI/D3D12/D3D12Utility.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
 
 namespace lde
 {
-	ShadowMap::ShadowMap(D3D12Device* /* pDevice */)
+	using namespace DirectX;
+
+	namespace
 	{
-		D3D12_RESOURCE_DESC desc{};
-		desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-		desc.Width = static_cast<uint64>(Window::Width);
-		desc.Height = Window::Height;
-		desc.MipLevels = 1;
-		desc.DepthOrArraySize = 1;
-		desc.SampleDesc = { 1, 0 };
-		desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+		// Objects per ParallelFor job.
+		constexpr uint32 CHUNK_SIZE = 256;
+
+		// Radius is rounded up to that fraction of unit,
+		// so floating point noise doesn't change texel size between frames.
+		constexpr float RADIUS_QUANTUM = 1.0f / 16.0f;
 
-		D3D12_CLEAR_VALUE clearValue{};
-		clearValue.Format = DXGI_FORMAT_D32_FLOAT;
-		clearValue.DepthStencil.Depth = D3D12_MAX_DEPTH;
-		clearValue.DepthStencil.Stencil = 0;
+		constexpr float MIN_DEPTH_RANGE = 0.01f;
 
-		//RHI::DX_CALL(pDevice->GetDevice()->CreateCommittedResource(
-		//	&RHI::D3D12Utility::HeapDefault,
-		//	D3D12_HEAP_FLAG_NONE,
-		//	&desc,
-		//	D3D12_RESOURCE_STATE_GENERIC_READ,
-		//	&clearValue,
-		//	IID_PPV_ARGS(&m_Resource)
-		//));
-		
+		inline void ResetBounds(auto& Bounds)
+		{
+			Bounds.Min = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+			Bounds.Max = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+			Bounds.Count = 0;
+		}
+
+		inline void MergeBounds(auto& Target, const auto& Source)
+		{
+			Target.Min.x = std::min(Target.Min.x, Source.Min.x);
+			Target.Min.y = std::min(Target.Min.y, Source.Min.y);
+			Target.Min.z = std::min(Target.Min.z, Source.Min.z);
+			Target.Max.x = std::max(Target.Max.x, Source.Max.x);
+			Target.Max.y = std::max(Target.Max.y, Source.Max.y);
+			Target.Max.z = std::max(Target.Max.z, Source.Max.z);
+			Target.Count += Source.Count;
+		}
 	}
 
-	ShadowMap::~ShadowMap()
+	ShadowMap::ShadowMap(uint32 Resolution, uint32 CascadeCount)
+		: m_Resolution(std::max(Resolution, 1u)),
+		m_CascadeCount(std::clamp(CascadeCount, 1u, MAX_SHADOW_CASCADES))
 	{
+		XMStoreFloat4x4(&m_LightView, XMMatrixIdentity());
 	}
 
-	void ShadowMap::Render(DirectX::XMFLOAT3 Position)
+	void ShadowMap::Update(FXMMATRIX View, CXMMATRIX Projection, float zNear, float zFar,
+		XMFLOAT3 LightDirection, std::span<const BoundingBox> Bounds)
 	{
-		m_View = DirectX::XMMatrixLookAtLH(XMLoadFloat3(&Position), m_Target, m_Up);
-		m_Projection = DirectX::XMMatrixPerspectiveFovLH(DirectX::XMConvertToRadians(45.0f), 1.0f, 0.1f, 50.0f);
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		XMVECTOR direction = XMLoadFloat3(&LightDirection);
+		direction = (XMVectorGetX(XMVector3LengthSq(direction)) > 1.0e-8f)
+			? XMVector3Normalize(direction)
+			: XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f);
+
+		// Fixed up vector keeps light rotation constant while direction is constant; required for snapping.
+		const XMVECTOR up = (std::abs(XMVectorGetY(direction)) > 0.99f)
+			? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f)
+			: XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+		XMStoreFloat4x4(&m_LightView, XMMatrixLookToLH(XMVectorZero(), direction, up));
+
+		XMFLOAT4X4 projection{};
+		XMStoreFloat4x4(&projection, Projection);
+		FitCascades(View, projection, zNear, std::min(zFar, MaxDistance));
+
+		const uint32 count = static_cast<uint32>(Bounds.size());
+		const XMMATRIX lightView = XMLoadFloat4x4(&m_LightView);
+
+		m_MinX.resize(count);
+		m_MinY.resize(count);
+		m_MinZ.resize(count);
+		m_MaxX.resize(count);
+		m_MaxY.resize(count);
+		m_MaxZ.resize(count);
+
+		const uint32 chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		m_ChunkReceivers.resize(chunkCount);
+		m_ChunkCasters.resize(chunkCount);
+
+		auto& threadPool = ThreadPool::GetInstance();
+
+		// Light space bounds and receivers.
+		threadPool.ParallelFor(chunkCount, 1, [&](uint32 Begin, uint32 End)
+			{
+				for (uint32 chunk = Begin; chunk < End; ++chunk)
+				{
+					const uint32 first	= chunk * CHUNK_SIZE;
+					const uint32 last	= std::min(first + CHUNK_SIZE, count);
+
+					for (uint32 i = first; i < last; ++i)
+					{
+						const BoundingBox bounds = TransformBounds(Bounds[i], lightView);
+						m_MinX[i] = bounds.Min.x;
+						m_MinY[i] = bounds.Min.y;
+						m_MinZ[i] = bounds.Min.z;
+						m_MaxX[i] = bounds.Max.x;
+						m_MaxY[i] = bounds.Max.y;
+						m_MaxZ[i] = bounds.Max.z;
+					}
+
+					GatherReceivers(chunk, first, last);
+				}
+			});
+
+		for (uint32 cascade = 0; cascade < m_CascadeCount; ++cascade)
+		{
+			ResetBounds(m_Receivers[cascade]);
+			for (uint32 chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				MergeBounds(m_Receivers[cascade], m_ChunkReceivers[chunk][cascade]);
+			}
+		}
+
+		threadPool.ParallelFor(chunkCount, 1, [&](uint32 Begin, uint32 End)
+			{
+				for (uint32 chunk = Begin; chunk < End; ++chunk)
+				{
+					const uint32 first = chunk * CHUNK_SIZE;
+					CullCasters(chunk, first, std::min(first + CHUNK_SIZE, count));
+				}
+			});
 
-		//DirectX::XMMATRIX T(
-		//	0.5f, 0.0f, 0.0f, 0.0f,
-		//	0.0f, -0.5f, 0.0f, 0.0f,
-		//	0.0f, 0.0f, 1.0f, 0.0f,
-		//	0.5f, 0.5f, 0.0f, 1.0f);
+		// Merge in chunk order, so lists are sorted by object index.
+		m_Stats = ShadowMapStats{};
+		m_Stats.Casters = count;
 
-		//Pre-transpose
-		DirectX::XMMATRIX T2(
-			0.5f, 0.0f, 0.0f, 0.5f,
-			0.0f, 0.5f, 0.0f, 0.5f,
-			0.0f, 0.0f, 0.5f, 0.5f,
-			0.0f, 0.0f, 0.0f, 1.0f
-		);
+		for (uint32 cascade = 0; cascade < m_CascadeCount; ++cascade)
+		{
+			auto& casters = m_Casters[cascade];
+			casters.clear();
 
-		//  
-		DirectX::XMMATRIX ViewProjection = DirectX::XMMatrixTranspose(DirectX::XMMatrixIdentity() * m_View * m_Projection) * T2;
+			for (uint32 chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				const auto& chunkCasters = m_ChunkCasters[chunk][cascade];
+				casters.insert(casters.end(), chunkCasters.begin(), chunkCasters.end());
+			}
 
+			auto& data = m_Cascades[cascade];
+			const auto& center = m_LightCenters[cascade];
+			const auto& receivers = m_Receivers[cascade];
+
+			if (receivers.Count > 0)
+			{
+				// Casters between light and receivers must not be clipped by near plane.
+				float casterNear = receivers.Min.z;
+				for (uint32 index : casters)
+				{
+					casterNear = std::min(casterNear, m_MinZ[index]);
+				}
+
+				// Nothing past furthest receiver can be shadowed.
+				data.LightNear	= casterNear;
+				data.LightFar	= std::max(receivers.Max.z, casterNear + MIN_DEPTH_RANGE);
+			}
+			else
+			{
+				data.LightNear	= center.z - data.Radius;
+				data.LightFar	= center.z + data.Radius;
+			}
+
+			const XMMATRIX cascadeProjection = XMMatrixOrthographicOffCenterLH(
+				center.x - data.Radius, center.x + data.Radius,
+				center.y - data.Radius, center.y + data.Radius,
+				data.LightNear, data.LightFar);
+
+			data.View = m_LightView;
+			XMStoreFloat4x4(&data.Projection, cascadeProjection);
+			XMStoreFloat4x4(&data.ViewProjection, lightView * cascadeProjection);
+
+			m_Stats.CascadeCasters[cascade]		= static_cast<uint32>(casters.size());
+			m_Stats.CascadeReceivers[cascade]	= receivers.Count;
+		}
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		m_Stats.BuildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 	}
-}
+
+	void ShadowMap::ComputeSplits(float zNear, float zFar, float Lambda, std::span<float> Splits)
+	{
+		if (Splits.empty())
+		{
+			return;
+		}
+
+		const uint32 cascadeCount = static_cast<uint32>(Splits.size()) - 1;
+		const float nearPlane	= std::max(zNear, 1.0e-4f);
+		const float farPlane	= std::max(zFar, nearPlane);
+		const float lambda		= std::clamp(Lambda, 0.0f, 1.0f);
+
+		Splits[0] = nearPlane;
+		for (uint32 i = 1; i < cascadeCount; ++i)
+		{
+			const float fraction	= static_cast<float>(i) / static_cast<float>(cascadeCount);
+			const float logSplit	= nearPlane * std::pow(farPlane / nearPlane, fraction);
+			const float uniformSplit = nearPlane + (farPlane - nearPlane) * fraction;
+
+			Splits[i] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+		}
+		Splits[cascadeCount] = farPlane;
+	}
+
+	BoundingBox ShadowMap::TransformBounds(const BoundingBox& Bounds, FXMMATRIX Matrix)
+	{
+		XMFLOAT4X4 matrix{};
+		XMStoreFloat4x4(&matrix, Matrix);
+
+		const float center[3] = {
+			(Bounds.Min.x + Bounds.Max.x) * 0.5f,
+			(Bounds.Min.y + Bounds.Max.y) * 0.5f,
+			(Bounds.Min.z + Bounds.Max.z) * 0.5f };
+		const float extent[3] = {
+			(Bounds.Max.x - Bounds.Min.x) * 0.5f,
+			(Bounds.Max.y - Bounds.Min.y) * 0.5f,
+			(Bounds.Max.z - Bounds.Min.z) * 0.5f };
+
+		// Row vectors: out = in * M.
+		float outCenter[3]{};
+		float outExtent[3]{};
+		for (uint32 column = 0; column < 3; ++column)
+		{
+			outCenter[column] = matrix.m[3][column];
+			for (uint32 row = 0; row < 3; ++row)
+			{
+				outCenter[column] += center[row] * matrix.m[row][column];
+				outExtent[column] += extent[row] * std::abs(matrix.m[row][column]);
+			}
+		}
+
+		BoundingBox result{};
+		result.Min = XMFLOAT3(outCenter[0] - outExtent[0], outCenter[1] - outExtent[1], outCenter[2] - outExtent[2]);
+		result.Max = XMFLOAT3(outCenter[0] + outExtent[0], outCenter[1] + outExtent[1], outCenter[2] + outExtent[2]);
+		return result;
+	}
+
+	void ShadowMap::FitCascades(FXMMATRIX View, const XMFLOAT4X4& Projection, float zNear, float zFar)
+	{
+		std::array<float, MAX_SHADOW_CASCADES + 1> splits{};
+		ComputeSplits(zNear, zFar, SplitLambda, std::span<float>(splits.data(), m_CascadeCount + 1));
+
+		// Squared tangent of half of frustum diagonal angle.
+		const float tanX = 1.0f / Projection._11;
+		const float tanY = 1.0f / Projection._22;
+		const float diagonalSq = tanX * tanX + tanY * tanY;
+
+		const XMMATRIX inverseView	= XMMatrixInverse(nullptr, View);
+		const XMVECTOR eye			= inverseView.r[3];
+		const XMVECTOR forward		= XMVector3Normalize(inverseView.r[2]);
+
+		const XMMATRIX lightView		= XMLoadFloat4x4(&m_LightView);
+		const XMMATRIX inverseLightView	= XMMatrixTranspose(lightView);
+
+		for (uint32 cascade = 0; cascade < m_CascadeCount; ++cascade)
+		{
+			const float sliceNear	= splits[cascade];
+			const float sliceFar	= splits[cascade + 1];
+
+			// Minimal sphere around frustum slice. Depends only on slice shape, not on camera orientation,
+			// so its radius stays the same while camera rotates.
+			float centerDepth = 0.5f * (sliceNear + sliceFar) * (1.0f + diagonalSq);
+			float radius = 0.0f;
+			if (centerDepth >= sliceFar)
+			{
+				centerDepth = sliceFar;
+				radius = sliceFar * std::sqrt(diagonalSq);
+			}
+			else
+			{
+				const float offset = centerDepth - sliceNear;
+				radius = std::sqrt(offset * offset + sliceNear * sliceNear * diagonalSq);
+			}
+			radius = std::ceil(radius / RADIUS_QUANTUM) * RADIUS_QUANTUM;
+
+			const float texelSize = (2.0f * radius) / static_cast<float>(m_Resolution);
+
+			// Move center in whole texel steps of light space, so rasterized shadow doesn't shimmer.
+			const XMVECTOR worldCenter = XMVectorMultiplyAdd(forward, XMVectorReplicate(centerDepth), eye);
+			XMFLOAT3 lightCenter{};
+			XMStoreFloat3(&lightCenter, XMVector3TransformCoord(worldCenter, lightView));
+			lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+			lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+			m_LightCenters[cascade] = lightCenter;
+
+			auto& data = m_Cascades[cascade];
+			data.SplitNear	= sliceNear;
+			data.SplitFar	= sliceFar;
+			data.Radius		= radius;
+			data.TexelSize	= texelSize;
+			XMStoreFloat3(&data.Center, XMVector3TransformCoord(XMLoadFloat3(&lightCenter), inverseLightView));
+		}
+	}
+
+	void ShadowMap::GatherReceivers(uint32 Chunk, uint32 Begin, uint32 End)
+	{
+		auto& chunkReceivers = m_ChunkReceivers[Chunk];
+
+		for (uint32 cascade = 0; cascade < m_CascadeCount; ++cascade)
+		{
+			auto& receivers = chunkReceivers[cascade];
+			ResetBounds(receivers);
+
+			const auto& center	= m_LightCenters[cascade];
+			const float radius	= m_Cascades[cascade].Radius;
+			const float radiusSq = radius * radius;
+
+			for (uint32 i = Begin; i < End; ++i)
+			{
+				// Sphere vs AABB; sphere bounds visible part of cascade.
+				const float dx = std::max({ m_MinX[i] - center.x, 0.0f, center.x - m_MaxX[i] });
+				const float dy = std::max({ m_MinY[i] - center.y, 0.0f, center.y - m_MaxY[i] });
+				const float dz = std::max({ m_MinZ[i] - center.z, 0.0f, center.z - m_MaxZ[i] });
+				if (dx * dx + dy * dy + dz * dz > radiusSq)
+				{
+					continue;
+				}
+
+				// Only part of receiver inside of cascade box matters.
+				receivers.Min.x = std::min(receivers.Min.x, std::max(m_MinX[i], center.x - radius));
+				receivers.Min.y = std::min(receivers.Min.y, std::max(m_MinY[i], center.y - radius));
+				receivers.Min.z = std::min(receivers.Min.z, std::max(m_MinZ[i], center.z - radius));
+				receivers.Max.x = std::max(receivers.Max.x, std::min(m_MaxX[i], center.x + radius));
+				receivers.Max.y = std::max(receivers.Max.y, std::min(m_MaxY[i], center.y + radius));
+				receivers.Max.z = std::max(receivers.Max.z, std::min(m_MaxZ[i], center.z + radius));
+				receivers.Count++;
+			}
+		}
+	}
+
+	void ShadowMap::CullCasters(uint32 Chunk, uint32 Begin, uint32 End)
+	{
+		auto& chunkCasters = m_ChunkCasters[Chunk];
+
+		for (uint32 cascade = 0; cascade < m_CascadeCount; ++cascade)
+		{
+			auto& casters = chunkCasters[cascade];
+			casters.clear();
+
+			const auto& receivers = m_Receivers[cascade];
+			if (receivers.Count == 0)
+			{
+				continue;
+			}
+
+			// Caster has to overlap receivers when projected along light direction
+			// and start before the furthest of them. Distance towards light is unbounded.
+			for (uint32 i = Begin; i < End; ++i)
+			{
+				if (m_MaxX[i] < receivers.Min.x || m_MinX[i] > receivers.Max.x ||
+					m_MaxY[i] < receivers.Min.y || m_MinY[i] > receivers.Max.y ||
+					m_MinZ[i] > receivers.Max.z)
+				{
+					continue;
+				}
+
+				casters.push_back(i);
+			}
+		}
+	}
+
+} // namespace lde
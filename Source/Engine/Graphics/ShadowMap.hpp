@@ -1,33 +1,139 @@
 #pragma once
 
-#include "RHI/D3D12/D3D12Texture.hpp"
+/*
+	Graphics/ShadowMap.hpp
+	CPU side of cascaded shadow maps for directional light.
+	Camera frustum is split into cascades, each cascade is fitted with a stable, texel snapped
+	orthographic projection and gets its own list of shadow casters.
+	Has no device dependency, so it can be run against any given frustum.
+*/
 
-namespace lde::RHI
-{
-	class D3D12Device;
-	//class D3D12Viewport;
-}
+#include "Core/CoreTypes.hpp"
+#include "Scene/Model/BoundingBox.hpp"
+#include <DirectXMath.h>
+#include <array>
+#include <span>
+#include <vector>
 
 namespace lde
-{ 
+{
+	constexpr uint32 MAX_SHADOW_CASCADES = 4;
+
+	struct ShadowCascade
+	{
+		// Light rotation; shared by all cascades.
+		DirectX::XMFLOAT4X4 View{};
+		DirectX::XMFLOAT4X4 Projection{};
+		DirectX::XMFLOAT4X4 ViewProjection{};
+
+		// Camera view depth range covered by this cascade.
+		float SplitNear	= 0.0f;
+		float SplitFar	= 0.0f;
+
+		// Bounding sphere of frustum slice, center snapped to texel grid.
+		DirectX::XMFLOAT3 Center{};
+		float Radius	= 0.0f;
+		// World units per shadow map texel.
+		float TexelSize	= 0.0f;
+
+		// Light space depth range, extended to casters and clipped to receivers.
+		float LightNear	= 0.0f;
+		float LightFar	= 0.0f;
+	};
+
+	struct ShadowMapStats
+	{
+		uint32 Casters = 0;
+		std::array<uint32, MAX_SHADOW_CASCADES> CascadeCasters{};
+		std::array<uint32, MAX_SHADOW_CASCADES> CascadeReceivers{};
+		double BuildTimeMs = 0.0;
+	};
+
 	class ShadowMap
 	{
 	public:
-		ShadowMap(D3D12Device* pDevice);
-		~ShadowMap();
+		/**
+		 * @param Resolution Width and height of a single cascade in texels.
+		 * @param CascadeCount Clamped to [1, MAX_SHADOW_CASCADES].
+		 */
+		ShadowMap(uint32 Resolution = 2048, uint32 CascadeCount = MAX_SHADOW_CASCADES);
+		~ShadowMap() = default;
+
+		/**
+		 * @brief Fits cascades to a given camera and culls casters for each of them.
+		 * Caster lists are built in parallel on ThreadPool.
+		 * @param View Camera view.
+		 * @param Projection Symmetric, left-handed perspective projection.
+		 * @param zNear Camera near plane.
+		 * @param zFar Camera far plane; clamped to MaxDistance.
+		 * @param LightDirection Direction light travels in, world space.
+		 * @param Bounds World space AABBs of objects; each is both a caster and a receiver.
+		 */
+		void Update(DirectX::FXMMATRIX View, DirectX::CXMMATRIX Projection, float zNear, float zFar,
+			DirectX::XMFLOAT3 LightDirection, std::span<const BoundingBox> Bounds);
+
+		/**
+		 * @brief Practical split scheme; blend of logarithmic and uniform distribution.
+		 * @param Lambda 0.0 - uniform, 1.0 - logarithmic.
+		 * @param Splits Receives CascadeCount + 1 distances; first is zNear, last is zFar.
+		 */
+		static void ComputeSplits(float zNear, float zFar, float Lambda, std::span<float> Splits);
+
+		/// @brief AABB of a box transformed by given matrix.
+		static BoundingBox TransformBounds(const BoundingBox& Bounds, DirectX::FXMMATRIX Matrix);
+
+		uint32 GetResolution()		const { return m_Resolution; }
+		uint32 GetCascadeCount()	const { return m_CascadeCount; }
+
+		const ShadowCascade& GetCascade(uint32 Index) const { return m_Cascades.at(Index); }
+
+		/// @brief Indices into Bounds of last Update that cast shadow into given cascade.
+		std::span<const uint32> GetCasters(uint32 Cascade) const { return m_Casters.at(Cascade); }
+
+		const ShadowMapStats& GetStats() const { return m_Stats; }
+
+		/// @brief Split distribution, see ComputeSplits.
+		float SplitLambda = 0.75f;
+		/// @brief Shadows are not drawn further than that from camera.
+		float MaxDistance = 200.0f;
 
-		void Render(DirectX::XMFLOAT3 Position);
-		void Resize(uint32 Width, uint32 Height);
-		
 	private:
-		D3D12RenderTexture m_RenderTexture;
-		//D3D12Viewport		m_Viewport;
-		//Ref<ID3D12Resource>		m_Resource;
-
-		DirectX::XMVECTOR m_Target		= DirectX::XMVECTOR();
-		DirectX::XMVECTOR m_Up			= DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-		DirectX::XMMATRIX m_View		= DirectX::XMMatrixIdentity();
-		DirectX::XMMATRIX m_Projection	= DirectX::XMMatrixIdentity();
+		/// @brief Bounding sphere and light space projection of every cascade.
+		void FitCascades(DirectX::FXMMATRIX View, const DirectX::XMFLOAT4X4& Projection, float zNear, float zFar);
+
+		/// @brief Gathers receivers overlapping cascades for a range of objects.
+		void GatherReceivers(uint32 Chunk, uint32 Begin, uint32 End);
+		/// @brief Tests a range of objects against tightened cascade bounds.
+		void CullCasters(uint32 Chunk, uint32 Begin, uint32 End);
+
+		uint32 m_Resolution		= 2048;
+		uint32 m_CascadeCount	= MAX_SHADOW_CASCADES;
+
+		std::array<ShadowCascade, MAX_SHADOW_CASCADES> m_Cascades{};
+		std::array<std::vector<uint32>, MAX_SHADOW_CASCADES> m_Casters;
+
+		DirectX::XMFLOAT4X4 m_LightView{};
+		// Snapped sphere centers in light space.
+		std::array<DirectX::XMFLOAT3, MAX_SHADOW_CASCADES> m_LightCenters{};
+
+		// Light space AABBs of objects, SoA per axis.
+		std::vector<float> m_MinX, m_MinY, m_MinZ;
+		std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+
+		// Light space bounds of receivers.
+		struct ReceiverBounds
+		{
+			DirectX::XMFLOAT3 Min;
+			DirectX::XMFLOAT3 Max;
+			uint32 Count;
+		};
+
+		// Per-chunk results written by workers, merged afterwards.
+		std::vector<std::array<ReceiverBounds, MAX_SHADOW_CASCADES>>		m_ChunkReceivers;
+		std::vector<std::array<std::vector<uint32>, MAX_SHADOW_CASCADES>>	m_ChunkCasters;
+		std::array<ReceiverBounds, MAX_SHADOW_CASCADES> m_Receivers{};
+
+		ShadowMapStats m_Stats{};
 
 	};
 } // namespace lde
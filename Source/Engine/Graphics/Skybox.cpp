@@ -1,6 +1,7 @@
 #include "Scene/SceneCamera.hpp"
 #include "Skybox.hpp"
 #include "Core/CoreTypes.hpp"
+#include "Core/Logger.hpp"
 #include "RHI/D3D12/D3D12RHI.hpp"
 #include "Graphics/TextureManager.hpp"
 #include "Scene/Components/TransformComponent.hpp"
@@ -45,15 +46,12 @@ namespace lde
             }
         );
 
-        m_ConstBuffer = pRHI->GetDevice()->CreateConstantBuffer(&m_cbPerObject, sizeof(m_cbPerObject));
-
     }
 
     void Skybox::Draw(int32 , SceneCamera* pCamera)
     {
         auto* commandList = m_Device->GetGfxCommandList();
-        auto* indexBuffer = m_Device->Buffers.at(m_IndexBuffer);
-        auto* constBuffer = m_Device->ConstantBuffers.at(m_ConstBuffer);
+        auto* indexBuffer = m_Device->GetBuffer(m_IndexBuffer);
 
         commandList->Get()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
         commandList->BindIndexBuffer(indexBuffer);
@@ -68,8 +66,13 @@ namespace lde
         // Bind constant buffers
         m_cbPerObject.WVP   = XMMatrixTranspose(transforms.WorldMatrix * pCamera->GetViewProjection());
         m_cbPerObject.World = XMMatrixTranspose(transforms.WorldMatrix);
-        constBuffer->Update(&m_cbPerObject);
-        commandList->BindConstantBuffer(0, constBuffer);
+        const auto constants = m_Device->GetFrameAllocator()->Upload(m_cbPerObject);
+        if (!constants)
+        {
+            LOG_WARN("Frame allocator is full. Skipping skybox.");
+            return;
+        }
+        commandList->BindConstantBuffer(0, constants);
 
         struct indices { uint32 index; } textures{ TextureCube->SRV.Index() };
         commandList->PushConstants(1, 1, &textures);
@@ -46,8 +46,7 @@ namespace lde
 		D3D12Device* m_Device = nullptr;
 		
 		BufferHandle m_IndexBuffer = (uint32)INVALID_HANDLE;
-		// Per object
-		BufferHandle m_ConstBuffer = (uint32)INVALID_HANDLE;
+		// Per object; uploaded through frame allocator
 		cbPerObject m_cbPerObject{};
 		
 		int32 m_TextureIndex = -1;
@@ -78,8 +78,35 @@ namespace lde
 			return -1;
 		}
 		
-		m_Gfx->Device->CreateTexture(newTexture);
-		return static_cast<uint32>(newTexture->SRV.Index());
+		const TextureHandle handle = m_Gfx->Device->CreateTexture(newTexture);
+		const int32 index = static_cast<int32>(newTexture->SRV.Index());
+		m_Textures[index] = handle;
+
+		return index;
+	}
+
+	void TextureManager::Destroy(int32 Index)
+	{
+		auto it = m_Textures.find(Index);
+		if (it == m_Textures.end())
+		{
+			return;
+		}
+
+		m_Gfx->Device->DestroyTexture(it->second);
+		m_Textures.erase(it);
+	}
+
+	uint64 TextureManager::GetMemorySize(int32 Index) const
+	{
+		auto it = m_Textures.find(Index);
+		if (it == m_Textures.end())
+		{
+			return 0;
+		}
+
+		const auto desc = m_Gfx->Device->GetTexture(it->second)->Texture->GetDesc();
+		return m_Gfx->Device->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
 	}
 
 	void TextureManager::Create2D(D3D12RHI* pGfx, std::string_view Filepath, D3D12Texture* pTarget, bool bMipMaps)
@@ -248,13 +275,16 @@ namespace lde
 
 	void TextureManager::InitializeMipGenerator()
 	{
+		auto computeShader	 = ShaderCompiler::GetInstance().CompileAsync("Shaders/Compute/MipMap2D.hlsl", ShaderStage::eCompute, L"CSmain");
+		auto computeShader3D = ShaderCompiler::GetInstance().CompileAsync("Shaders/Compute/MipMap3D.hlsl", ShaderStage::eCompute, L"CSmain");
+
 		// 2D
 		{
 			m_RootSignature.AddConstants(8, 0);
 			m_RootSignature.AddStaticSampler(0, 0, D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT, D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_COMPARISON_FUNC_NEVER);
 			m_RootSignature.Build(m_Gfx->Device.get(), PipelineType::eCompute, "MipMap2D Root Signature");
 
-			m_ComputeShader = ShaderCompiler::GetInstance().Compile("Shaders/Compute/MipMap2D.hlsl", ShaderStage::eCompute, L"CSmain");
+			m_ComputeShader = computeShader.get();
 
 			D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
 			psoDesc.pRootSignature = m_RootSignature.Get();
@@ -262,7 +292,7 @@ namespace lde
 			psoDesc.NodeMask = 0;
 			psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-			DX_CALL(m_Gfx->Device->GetDevice()->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&m_ComputePipeline.PipelineState)));
+			DX_CALL(m_Gfx->Device->GetPipelineCache()->GetCompute(psoDesc, &m_RootSignature, m_ComputePipeline.PipelineState));
 			m_ComputePipeline.Type = PipelineType::eCompute;
 			m_ComputePipeline.PipelineState->SetName(L"MipMap2D Compute Pipeline State");
 		}
@@ -273,7 +303,7 @@ namespace lde
 			m_RootSignature3D.AddStaticSampler(0, 0, D3D12_FILTER_ANISOTROPIC, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
 			m_RootSignature3D.Build(m_Gfx->Device.get(), PipelineType::eCompute, "MipMap3D Root Signature");
 
-			m_ComputeShader3D = ShaderCompiler::GetInstance().Compile("Shaders/Compute/MipMap3D.hlsl", ShaderStage::eCompute, L"CSmain");
+			m_ComputeShader3D = computeShader3D.get();
 
 			D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
 			psoDesc.pRootSignature = m_RootSignature3D.Get();
@@ -281,7 +311,7 @@ namespace lde
 			psoDesc.NodeMask = 0;
 			psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-			DX_CALL(m_Gfx->Device->GetDevice()->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&m_ComputePipeline3D.PipelineState)));
+			DX_CALL(m_Gfx->Device->GetPipelineCache()->GetCompute(psoDesc, &m_RootSignature3D, m_ComputePipeline3D.PipelineState));
 			m_ComputePipeline3D.Type = PipelineType::eCompute;
 			m_ComputePipeline3D.PipelineState->SetName(L"MipMap3D Compute Pipeline State");
 		}
@@ -322,14 +352,21 @@ namespace lde
 			DirectX::XMFLOAT2 TexelSize;
 		} mipGenCB{};
 
-		((D3D12Device*)m_Gfx->GetDevice())->Allocate(HeapType::eSRV, pTexture->UAV, pTexture->MipLevels);
+		auto heap = ((D3D12Device*)m_Gfx->GetDevice())->GetShaderResourceHeap();
+
+		// One UAV per generated mip; only needed while the chain is recorded.
+		D3D12Descriptor uavDescriptor = heap->AllocateTransient(pTexture->MipLevels - 1u);
+		if (!uavDescriptor.IsValid())
+		{
+			LOG_WARN("No transient descriptors left. Skipping generating 2D mip chain.");
+			return;
+		}
 
 		m_Gfx->SetPipeline(&m_ComputePipeline);
 		m_Gfx->SetRootSignature(&m_RootSignature);
 
 		mipGenCB.IsSRGB = srcResourceDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ? 1 : 0;
 		
-		auto heap = ((D3D12Device*)m_Gfx->GetDevice())->GetShaderResourceHeap();
 		for (uint32 srcMip = 0; srcMip < (uint32)(pTexture->MipLevels - 1); ++srcMip)
 		{
 			uint64 srcWidth		= srcResourceDesc.Width >> srcMip;
@@ -371,13 +408,13 @@ namespace lde
 
 				m_Gfx->Device->GetDevice()->CreateUnorderedAccessView(
 					uavResource.Get(), nullptr, &uavDesc,
-					{ pTexture->UAV.GetCpuHandle().ptr + ((srcMip + mip) * m_Gfx->Device->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)) });
+					{ uavDescriptor.GetCpuHandle().ptr + ((srcMip + mip) * m_Gfx->Device->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)) });
 			}
 
 			m_Gfx->Device->GetGfxCommandList()->Get()->SetDescriptorHeaps(1, heap->GetAddressOf());
 
 			mipGenCB.SrcMipIndex = heap->GetIndexFromOffset(pTexture->SRV, 0);
-			mipGenCB.DestMipIndex = heap->GetIndexFromOffset(pTexture->UAV, srcMip);
+			mipGenCB.DestMipIndex = heap->GetIndexFromOffset(uavDescriptor, srcMip);
 
 			m_Gfx->Device->GetGfxCommandList()->Get()->SetComputeRoot32BitConstants(0, 8, &mipGenCB, 0);
 
@@ -391,9 +428,6 @@ namespace lde
 		}
 
 		m_Gfx->Device->ExecuteCommandList(CommandType::eGraphics, true);
-		// Reset UAV; they are not necessary after mip creation for now
-		pTexture->UAV = {};
-		
 	}
 		
 	void TextureManager::Generate3D(D3D12Texture* pTexture)
@@ -413,11 +447,10 @@ namespace lde
 		const auto srcDesc = pTexture->Texture->GetDesc();
 		ID3D12Resource* uavResource = pTexture->Texture.Get();
 
+		auto heap = m_Gfx->Device->GetShaderResourceHeap();
+
 		// Ensure that the Heap is set before mipmapping
-		m_Gfx->Device->GetGfxCommandList()->Get()->SetDescriptorHeaps(1, m_Gfx->Device->GetShaderResourceHeap()->GetAddressOf());
-		
-		D3D12Descriptor srvResourceDesc;
-		m_Gfx->Device->Allocate(HeapType::eSRV, srvResourceDesc, 1);
+		m_Gfx->Device->GetGfxCommandList()->Get()->SetDescriptorHeaps(1, heap->GetAddressOf());
 
 		struct
 		{
@@ -431,6 +464,16 @@ namespace lde
 
 		for (uint32 arraySlice = 0; arraySlice < 6; ++arraySlice)
 		{
+			// Views live only until this slice is executed; UAV range covers every offset written or read below.
+			const uint32 uavCount = std::max(2u * pTexture->MipLevels - 1u, pTexture->MipLevels + 6u) + arraySlice;
+			D3D12Descriptor srvResourceDesc = heap->AllocateTransient(1);
+			D3D12Descriptor uavDescriptor	= heap->AllocateTransient(uavCount);
+			if (!srvResourceDesc.IsValid() || !uavDescriptor.IsValid())
+			{
+				LOG_WARN("No transient descriptors left. Skipping generating 3D mip chain.");
+				return;
+			}
+
 			m_Gfx->Device->GetGfxCommandList()->Get()->SetComputeRootSignature(m_RootSignature3D.Get());
 			m_Gfx->Device->GetGfxCommandList()->Get()->SetPipelineState(m_ComputePipeline3D.Get());
 
@@ -458,8 +501,6 @@ namespace lde
 
 				m_Gfx->Device->GetDevice()->CreateShaderResourceView(uavResource, &srvDesc, srvResourceDesc.GetCpuHandle());
 
-				m_Gfx->Device->Allocate(HeapType::eSRV, pTexture->UAV, srcDesc.MipLevels); //  * 6
-
 				for (uint32_t mip = 0; mip < pTexture->MipLevels; ++mip)
 				{
 					D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc{};
@@ -472,11 +513,11 @@ namespace lde
 
 					m_Gfx->Device->GetDevice()->CreateUnorderedAccessView(
 						uavResource, nullptr, &uavDesc,
-						{ pTexture->UAV.GetCpuHandle().ptr + ((srcMip + mip + arraySlice) * m_Gfx->Device->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV))});
+						{ uavDescriptor.GetCpuHandle().ptr + ((srcMip + mip + arraySlice) * m_Gfx->Device->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV))});
 				}
 
-				cbMipData.SrcMipIndex = m_Gfx->Device->GetShaderResourceHeap()->GetIndexFromOffset(srvResourceDesc, 0);
-				cbMipData.DestMipIndex = m_Gfx->Device->GetShaderResourceHeap()->GetIndexFromOffset(pTexture->UAV, srcMip + arraySlice + 6);
+				cbMipData.SrcMipIndex = heap->GetIndexFromOffset(srvResourceDesc, 0);
+				cbMipData.DestMipIndex = heap->GetIndexFromOffset(uavDescriptor, srcMip + arraySlice + 6);
 
 				m_Gfx->Device->GetGfxCommandList()->Get()->SetComputeRoot32BitConstants(0, 8, &cbMipData, 0);
 
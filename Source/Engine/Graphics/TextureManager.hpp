@@ -3,6 +3,7 @@
 #include "Core/CoreMinimal.hpp"
 #include "RHI/D3D12/D3D12Texture.hpp"
 #include "ShaderCompiler.hpp"
+#include <unordered_map>
 #include <vector>
 
 namespace lde
@@ -36,6 +37,16 @@ namespace lde
 		 */
 		int32 Create(D3D12RHI* pGfx, std::string_view Filepath, bool bGenerateMipMaps = true);
 
+		/**
+		 * @brief Releases texture made by Create. GPU must not be using it anymore.
+		 * Its SRV and UAV slots go back to the heap, so Index may be returned by later Create.
+		 * @param Index Value returned by Create.
+		 */
+		void Destroy(int32 Index);
+
+		/// @return Size of texture made by Create in video memory, in bytes. 0 if Index is unknown.
+		uint64 GetMemorySize(int32 Index) const;
+
 		//int32 CreateFromDesc(D3D12RHI* pGfx, std::string_view Filepath, D3D12_RESOURCE_DESC& Desc);
 		
 		// Generate mip chain for 2D texture
@@ -58,6 +69,9 @@ namespace lde
 		
 	private:
 		D3D12RHI* m_Gfx = nullptr;
+
+		// SRV index -> Device texture.
+		std::unordered_map<int32, TextureHandle> m_Textures;
 		
 		void InitializeMipGenerator();
 		
@@ -6,11 +6,10 @@
 	#endif
 	#include <Windows.h>
 	#include "Core/Utility.hpp"
+	#include "Timer.hpp"
 	//#include <dwmapi.h>
 #endif
 
-#include "Timer.hpp"
-
 
 #if defined (_WIN64) || (_WINDOWS)
 	#define PLATFORM_WIN64 1
@@ -3,6 +3,7 @@
 #include "BufferConstants.hpp"
 #include "RHI/Types.hpp"
 
+// Slot index and generation; see RHI/HandlePool.hpp.
 using BufferHandle  = uint32;
 using TextureHandle = uint32;
 
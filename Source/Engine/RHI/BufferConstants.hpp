@@ -18,6 +18,13 @@ namespace lde
 		float				zFar;
 	};
 
+	// Per instance transforms; read by GBuffer shader at SV_InstanceID.
+	struct InstanceData
+	{
+		DirectX::XMMATRIX WVP	= DirectX::XMMatrixIdentity();
+		DirectX::XMMATRIX World = DirectX::XMMatrixIdentity();
+	};
+
 	struct PerObject
 	{
 		DirectX::XMMATRIX World = DirectX::XMMatrixIdentity();
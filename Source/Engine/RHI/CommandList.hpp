@@ -21,14 +21,18 @@ namespace lde
 		virtual void DrawIndexedInstanced(uint32 Instances, uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) = 0;
 		// Draw vertices
 		virtual void Draw(uint32 VertexCount) = 0;
+		// Draw multiple instances of vertices
+		virtual void DrawInstanced(uint32 Instances, uint32 VertexCount, uint32 BaseVertex) = 0;
 
 		//virtual void DrawIndirect(uint32 IndexCount, uint32 VertexCount) = 0;
 
+		virtual void BindPipeline(PipelineState* pPipeline) = 0;
+
 		virtual void BindVertexBuffer(Buffer* pBuffer) = 0;
 		virtual void BindIndexBuffer(Buffer* pBuffer) = 0;
 		virtual void BindConstantBuffer(uint32 Slot, ConstantBuffer* pBuffer) = 0;
 
-		virtual void PushConstants(uint32 Slot, uint32 Count, void* pData, uint32 Offset = 0) = 0;
+		virtual void PushConstants(uint32 Slot, uint32 Count, const void* pData, uint32 Offset = 0) = 0;
 
 		//void ResourceBarrier(Ref<ID3D12Resource> ppResource, ResourceState Before, ResourceState After);
 		//void UploadResource(Ref<ID3D12Resource> ppSrc, Ref<ID3D12Resource> ppDst, d3d12Subresource);
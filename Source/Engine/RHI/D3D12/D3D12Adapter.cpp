@@ -53,15 +53,27 @@ namespace lde
 
 	void D3D12Device::Release()
 	{
+		// Waits for copies still in flight.
+		m_Uploader.reset();
+
 		for (usize i = 0; i < FRAME_COUNT; ++i)
 		{
 			delete m_FrameResources[i].GraphicsCommandList;
 			//delete m_FrameResources[i].ComputeCommandList;
 		}
 
+		m_WorkerCommandLists.reset();
+
 		delete GraphicsQueue;
 		//delete ComputeQueue;
 
+		m_StateTracker.reset();
+		// Writes Pipeline Library for the next run.
+		m_PipelineCache.reset();
+
+		m_FrameAllocator.reset();
+		m_UploadHeap.reset();
+
 		m_DepthStencilHeap.reset();
 		m_RenderTargetHeap.reset();
 		m_ShaderResourceHeap.reset();
@@ -135,8 +147,8 @@ namespace lde
 	
 	void D3D12Device::CreateDescriptorHeaps()
 	{
-		// Needs to be bigger as is also meant for generating mip chains.
-		m_ShaderResourceHeap	= std::make_unique<D3D12DescriptorHeap>(this, HeapType::eSRV, 65536, "D3D12 ShaderResourceView Descriptor Heap");
+		// Last 4096 slots of every frame in flight are transient; i.e. for generating mip chains.
+		m_ShaderResourceHeap	= std::make_unique<D3D12DescriptorHeap>(this, HeapType::eSRV, 65536, "D3D12 ShaderResourceView Descriptor Heap", 4096);
 		m_RenderTargetHeap		= std::make_unique<D3D12DescriptorHeap>(this, HeapType::eRTV, 64,    "D3D12 RenderTargetView Descriptor Heap");
 		m_DepthStencilHeap		= std::make_unique<D3D12DescriptorHeap>(this, HeapType::eDSV, 32,    "D3D12 DepthStencilView Descriptor Heap");
 	}
@@ -49,37 +49,57 @@ namespace lde
 
 		D3D12Memory::Allocate(m_Buffer, desc, AllocType::eCopyDst);
 
-		AllocatedResource uploadBuffer;
-		D3D12Memory::Allocate(uploadBuffer, desc, AllocType::eUpload);
-
-		D3D12_SUBRESOURCE_DATA subresource{};
-		subresource.pData		= Desc.pData;
-		subresource.RowPitch	= static_cast<LONG_PTR>(Desc.Size);
-		subresource.SlicePitch	= subresource.RowPitch;
-
-		auto* commandList = pDevice->GetGfxCommandList();
-
-		commandList->UploadResource(uploadBuffer.Resource, m_Buffer.Resource, subresource);
-
+		ResourceState state = ResourceState::eGeneralUsage;
 		switch (Desc.eType)
 		{
 		case BufferUsage::eVertex:
 			[[fallthrough]];
 		case BufferUsage::eConstant:
-			commandList->ResourceBarrier(m_Buffer.Resource, ResourceState::eCopyDst, ResourceState::eVertexOrConstantBuffer);
+			state = ResourceState::eVertexOrConstantBuffer;
 			break;
 		case BufferUsage::eIndex:
-			commandList->ResourceBarrier(m_Buffer.Resource, ResourceState::eCopyDst, ResourceState::eIndexBuffer);
+			state = ResourceState::eIndexBuffer;
 			break;
 		case BufferUsage::eStructured:
-			commandList->ResourceBarrier(m_Buffer.Resource, ResourceState::eCopyDst, ResourceState::eAllShaderResource);
+			state = ResourceState::eAllShaderResource;
 			break;
 		}
 
-		pDevice->ExecuteCommandList(CommandType::eGraphics, true);
+		// Open Copy Queue batch takes the upload; buffer is then promoted to its read state on first use.
+		bool bQueued = pDevice->GetUploader()->QueueBufferUpload(m_Buffer.Resource, Desc.pData, Desc.Size);
+
+		auto* uploadHeap = pDevice->GetUploadHeap();
+		if (!bQueued && Desc.Size <= uploadHeap->GetAllocator().GetSize())
+		{
+			bQueued = uploadHeap->QueueBufferUpload(m_Buffer.Resource, Desc.pData, Desc.Size, StateEnumToType(state));
+			if (!bQueued)
+			{
+				// Ring is full of copies that are queued or still in flight.
+				pDevice->ExecuteCommandList(CommandType::eGraphics, true);
+				bQueued = uploadHeap->QueueBufferUpload(m_Buffer.Resource, Desc.pData, Desc.Size, StateEnumToType(state));
+			}
+		}
 
-		SAFE_RELEASE(uploadBuffer.Allocation);
-		SAFE_RELEASE(uploadBuffer.Resource);
+		if (!bQueued)
+		{
+			// Doesn't fit the ring at all; dedicated staging buffer has to outlive the copy.
+			AllocatedResource uploadBuffer;
+			D3D12Memory::Allocate(uploadBuffer, desc, AllocType::eUpload);
+
+			D3D12_SUBRESOURCE_DATA subresource{};
+			subresource.pData		= Desc.pData;
+			subresource.RowPitch	= static_cast<LONG_PTR>(Desc.Size);
+			subresource.SlicePitch	= subresource.RowPitch;
+
+			auto* commandList = pDevice->GetGfxCommandList();
+			commandList->UploadResource(uploadBuffer.Resource, m_Buffer.Resource, subresource);
+			commandList->ResourceBarrier(m_Buffer.Resource, ResourceState::eCopyDst, state);
+
+			pDevice->ExecuteCommandList(CommandType::eGraphics, true);
+
+			SAFE_RELEASE(uploadBuffer.Allocation);
+			SAFE_RELEASE(uploadBuffer.Resource);
+		}
 
 		m_Desc = Desc;
 
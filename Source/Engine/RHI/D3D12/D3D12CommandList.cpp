@@ -1,7 +1,9 @@
 #include "D3D12Buffer.hpp"
 #include "D3D12CommandList.hpp"
 #include "D3D12Device.hpp"
+#include "D3D12PipelineState.hpp"
 #include "D3D12RootSignature.hpp"
+#include "D3D12StateTracker.hpp"
 #include "D3D12Utility.hpp"
 #include "RHI/Types.hpp"
 #include <AgilitySDK/d3dx12/d3dx12_resource_helpers.h>
@@ -55,6 +57,7 @@ namespace lde
 		SET_D3D12_NAME(m_GraphicsCommandList, DebugName);
 		//SET_D3D12_NAME(*m_Allocator, (DebugName + ": Allocator"));
 
+		m_StateTracker = pDevice->GetStateTracker();
 		m_Type = eType;
 	}
 
@@ -95,19 +98,28 @@ namespace lde
 
 	void D3D12CommandList::DrawIndexed(uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex)
 	{
+		FlushBarriers();
 		m_GraphicsCommandList->DrawIndexedInstanced(IndexCount, 1, BaseIndex, BaseVertex, 0);
 	}
 
 	void D3D12CommandList::DrawIndexedInstanced(uint32 Instances, uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex)
 	{
+		FlushBarriers();
 		m_GraphicsCommandList->DrawIndexedInstanced(IndexCount, Instances, BaseIndex, BaseVertex, 0);
 	}
 
 	void D3D12CommandList::Draw(uint32 VertexCount)
 	{
+		FlushBarriers();
 		m_GraphicsCommandList->DrawInstanced(VertexCount, 1, 0, 0);
 	}
 
+	void D3D12CommandList::DrawInstanced(uint32 Instances, uint32 VertexCount, uint32 BaseVertex)
+	{
+		FlushBarriers();
+		m_GraphicsCommandList->DrawInstanced(VertexCount, Instances, BaseVertex, 0);
+	}
+
 	void D3D12CommandList::DrawIndirect()
 	{
 		//m_GraphicsCommandList->ExecuteIndirect()
@@ -115,14 +127,21 @@ namespace lde
 
 	void D3D12CommandList::DispatchRays(const D3D12_DISPATCH_RAYS_DESC& Desc)
 	{
+		FlushBarriers();
 		m_GraphicsCommandList->DispatchRays(&Desc);
 	}
 
 	void D3D12CommandList::DispatchMesh(uint32 DispatchX, uint32 DispatchY, uint32 DispatchZ)
 	{
+		FlushBarriers();
 		m_GraphicsCommandList->DispatchMesh(DispatchX, DispatchY, DispatchZ);
 	}
 
+	void D3D12CommandList::BindPipeline(PipelineState* pPipeline)
+	{
+		m_GraphicsCommandList->SetPipelineState(static_cast<D3D12PipelineState*>(pPipeline)->Get());
+	}
+
 	void D3D12CommandList::BindVertexBuffer(Buffer* pBuffer)
 	{
 		const auto& view = GetVertexView((D3D12Buffer*)pBuffer);
@@ -148,7 +167,31 @@ namespace lde
 		}
 	}
 
-	void D3D12CommandList::PushConstants(uint32 Slot, uint32 Count, void* pData, uint32 Offset)
+	void D3D12CommandList::BindConstantBuffer(uint32 Slot, D3D12_GPU_VIRTUAL_ADDRESS Address)
+	{
+		if (m_Type == CommandType::eGraphics)
+		{
+			m_GraphicsCommandList->SetGraphicsRootConstantBufferView(Slot, Address);
+		}
+		else if (m_Type == CommandType::eCompute)
+		{
+			m_GraphicsCommandList->SetComputeRootConstantBufferView(Slot, Address);
+		}
+	}
+
+	void D3D12CommandList::BindShaderResource(uint32 Slot, D3D12_GPU_VIRTUAL_ADDRESS Address)
+	{
+		if (m_Type == CommandType::eGraphics)
+		{
+			m_GraphicsCommandList->SetGraphicsRootShaderResourceView(Slot, Address);
+		}
+		else if (m_Type == CommandType::eCompute)
+		{
+			m_GraphicsCommandList->SetComputeRootShaderResourceView(Slot, Address);
+		}
+	}
+
+	void D3D12CommandList::PushConstants(uint32 Slot, uint32 Count, const void* pData, uint32 Offset)
 	{
 		if (m_Type == CommandType::eGraphics)
 		{
@@ -176,6 +219,14 @@ namespace lde
 		m_GraphicsCommandList->ResourceBarrier(static_cast<uint32>(Barriers.size()), Barriers.data());
 	}
 
+	void D3D12CommandList::FlushBarriers()
+	{
+		if (m_StateTracker)
+		{
+			m_StateTracker->Flush(this);
+		}
+	}
+
 	void D3D12CommandList::UploadResource(Ref<ID3D12Resource> ppSrc, Ref<ID3D12Resource> ppDst, D3D12_SUBRESOURCE_DATA& Subresource)
 	{
 		::UpdateSubresources(m_GraphicsCommandList.Get(), ppDst.Get(), ppSrc.Get(), 0, 0, 1, &Subresource);
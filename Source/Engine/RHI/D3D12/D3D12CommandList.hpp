@@ -15,6 +15,7 @@ namespace lde
 	enum class CommandType;
 	class D3D12Device;
 	class D3D12RootSignature;
+	class D3D12StateTracker;
 	
 	class D3D12CommandAllocator
 	{
@@ -68,25 +69,38 @@ namespace lde
 		void DrawIndexed(uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) override;
 		void DrawIndexedInstanced(uint32 Instances, uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) override;
 		void Draw(uint32 VertexCount) override;
+		void DrawInstanced(uint32 Instances, uint32 VertexCount, uint32 BaseVertex) override;
 		void DrawIndirect();
 
 		void DispatchRays(const D3D12_DISPATCH_RAYS_DESC& Desc);
 		void DispatchMesh(uint32 DispatchX, uint32 DispatchY, uint32 DispatchZ);
 
+		// Expects D3D12PipelineState.
+		void BindPipeline(PipelineState* pPipeline) override;
+
 		void BindVertexBuffer(Buffer* pBuffer) override;
 		void BindIndexBuffer(Buffer* pBuffer) override;
 		void BindConstantBuffer(uint32 Slot, ConstantBuffer* pBuffer) override;
+		// Bind transient constants, i.e. from D3D12LinearAllocator.
+		void BindConstantBuffer(uint32 Slot, D3D12_GPU_VIRTUAL_ADDRESS Address);
+		// Bind raw or structured buffer as root SRV.
+		void BindShaderResource(uint32 Slot, D3D12_GPU_VIRTUAL_ADDRESS Address);
 
-		void PushConstants(uint32 Slot, uint32 Count, void* pData, uint32 Offset = 0) override;
+		void PushConstants(uint32 Slot, uint32 Count, const void* pData, uint32 Offset = 0) override;
 
 		void ResourceBarrier(Ref<ID3D12Resource> ppResource, ResourceState Before, ResourceState After);
 		// Change state of multiple resources
 		void ResourceBarriers(std::span<D3D12_RESOURCE_BARRIER> Barriers);
+		// Record transitions queued in Device's state tracker. Draws and dispatches do it on their own.
+		void FlushBarriers();
+		// Lists recorded on worker threads don't share the tracker; nullptr disables flushing.
+		void SetStateTracker(D3D12StateTracker* pStateTracker) { m_StateTracker = pStateTracker; }
 		void UploadResource(Ref<ID3D12Resource> ppSrc, Ref<ID3D12Resource> ppDst, D3D12_SUBRESOURCE_DATA& Subresource);
 
 	private:
 		Ref<ID3D12GraphicsCommandList8> m_GraphicsCommandList;
 		D3D12CommandAllocator*			m_Allocator;
+		D3D12StateTracker*				m_StateTracker = nullptr;
 		
 	};
 	
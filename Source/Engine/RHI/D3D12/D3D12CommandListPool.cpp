@@ -0,0 +1,59 @@
+#include "D3D12CommandList.hpp"
+#include "D3D12CommandListPool.hpp"
+#include "D3D12Device.hpp"
+#include "D3D12Utility.hpp"
+#include <format>
+
+namespace lde
+{
+	D3D12CommandListPool::D3D12CommandListPool(D3D12Device* pDevice, CommandType eType)
+		: m_Device(pDevice), m_Type(eType)
+	{
+	}
+
+	D3D12CommandListPool::~D3D12CommandListPool()
+	{
+		Release();
+	}
+
+	void D3D12CommandListPool::BeginFrame()
+	{
+		m_Used = 0;
+	}
+
+	std::span<D3D12CommandList*> D3D12CommandListPool::Acquire(uint32 Count)
+	{
+		auto& lists = m_Lists.at(FRAME_INDEX);
+
+		while (lists.size() < m_Used + Count)
+		{
+			auto commandList = std::make_unique<D3D12CommandList>(m_Device, m_Type, std::format("D3D12 Worker Command List #{}:{}", FRAME_INDEX, lists.size()));
+			commandList->SetStateTracker(nullptr);
+			lists.push_back(std::move(commandList));
+		}
+
+		m_Acquired.clear();
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			auto* commandList = lists.at(m_Used + i).get();
+			DX_CALL(commandList->Open());
+			m_Acquired.push_back(commandList);
+		}
+
+		m_Used += Count;
+
+		return m_Acquired;
+	}
+
+	void D3D12CommandListPool::Release()
+	{
+		for (auto& lists : m_Lists)
+		{
+			lists.clear();
+		}
+
+		m_Acquired.clear();
+		m_Used = 0;
+	}
+
+} // namespace lde
@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+	RHI/D3D12/D3D12CommandListPool.hpp
+	Direct command lists, each with own allocator, for recording on worker threads.
+*/
+
+#include "Core/CoreMinimal.hpp"
+#include "RHI/RHICommon.hpp"
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	enum class CommandType;
+	class D3D12CommandList;
+	class D3D12Device;
+
+	/**
+	 * @brief Set of lists per frame in flight; list i is meant for chunk i of a parallel recording,
+	 * so submission order doesn't depend on which thread finished first.
+	 * Lists don't flush Device's state tracker, as it isn't thread safe;
+	 * barriers have to be recorded on Graphics command list before they're submitted.
+	 */
+	class D3D12CommandListPool
+	{
+	public:
+		D3D12CommandListPool(D3D12Device* pDevice, CommandType eType);
+		D3D12CommandListPool(const D3D12CommandListPool&) = delete;
+		D3D12CommandListPool& operator=(const D3D12CommandListPool&) = delete;
+		~D3D12CommandListPool();
+
+		/// @brief Makes every list of current frame available again; their allocators are no longer used by GPU at this point.
+		void BeginFrame();
+
+		/**
+		 * @brief Opens Count lists of current frame; grows the pool if needed.
+		 * Has to be called from the main thread, lists can be recorded from any.
+		 */
+		std::span<D3D12CommandList*> Acquire(uint32 Count);
+
+		/// @return Lists created for a single frame.
+		uint32 GetCapacity() const { return static_cast<uint32>(m_Lists.at(FRAME_INDEX).size()); }
+
+		void Release();
+
+	private:
+		D3D12Device*	m_Device = nullptr;
+		CommandType		m_Type;
+
+		std::array<std::vector<std::unique_ptr<D3D12CommandList>>, FRAME_COUNT> m_Lists;
+		// Lists handed out this frame.
+		std::vector<D3D12CommandList*> m_Acquired;
+		uint32 m_Used = 0;
+
+	};
+} // namespace lde
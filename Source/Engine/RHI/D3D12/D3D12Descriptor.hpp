@@ -19,6 +19,8 @@ namespace lde
 			this->m_CpuHandle	= Other.m_CpuHandle;
 			this->m_GpuHandle	= Other.m_GpuHandle;
 			this->m_Index		= Other.m_Index;
+			this->m_Count		= Other.m_Count;
+			this->m_Generation	= Other.m_Generation;
 		}
 
 		constexpr inline bool IsValid() const
@@ -51,9 +53,21 @@ namespace lde
 			return m_Index;
 		}
 
+		/// @brief Slots taken in the heap, starting at Index.
+		inline uint32 Count() const
+		{
+			return m_Count;
+		}
+
 		uint32 m_Index = UINT32_MAX;
 
 	private:
+		friend class D3D12DescriptorHeap;
+
+		// Set by the heap; lets it tell stale copies from live allocation on Free.
+		uint32 m_Count		= 0;
+		uint32 m_Generation = 0;
+
 		D3D12_CPU_DESCRIPTOR_HANDLE m_CpuHandle{};
 		D3D12_GPU_DESCRIPTOR_HANDLE m_GpuHandle{};
 
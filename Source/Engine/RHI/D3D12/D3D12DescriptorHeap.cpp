@@ -1,10 +1,14 @@
 #include "D3D12DescriptorHeap.hpp"
 #include "D3D12Device.hpp"
 #include "D3D12Utility.hpp"
+#include "Core/Logger.hpp"
+#include "RHI/RHICommon.hpp"
+#include <algorithm>
+#include <cassert>
 
 namespace lde
 {
-	D3D12DescriptorHeap::D3D12DescriptorHeap(D3D12Device* pDevice, HeapType eType, uint32 MaxCapacity, std::string_view DebugName)
+	D3D12DescriptorHeap::D3D12DescriptorHeap(D3D12Device* pDevice, HeapType eType, uint32 MaxCapacity, std::string_view DebugName, uint32 TransientPerFrame)
 	{
 		D3D12_DESCRIPTOR_HEAP_DESC desc{};
 		desc.NodeMask = 0;
@@ -26,8 +30,8 @@ namespace lde
 		}
 
 		m_Capacity = MaxCapacity;
-		m_AllocationsLeft = m_Capacity;
 		m_DescriptorSize = pDevice->GetDevice()->GetDescriptorHandleIncrementSize(desc.Type);
+		m_DebugName = DebugName;
 		Type = eType;
 
 		DX_CALL(pDevice->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_Heap)));
@@ -35,11 +39,16 @@ namespace lde
 		if (!DebugName.empty())
 			m_Heap->SetName(String::ToWide(DebugName).c_str());
 
-		// First handle
-		m_AvailableCpuPtr = static_cast<uint64>(m_Heap->GetCPUDescriptorHandleForHeapStart().ptr) + m_DescriptorSize;
-		if (desc.Flags == D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE)
+		const uint32 transientSlots = TransientPerFrame * FRAME_COUNT;
+		assert(transientSlots < m_Capacity);
+
+		m_TransientStart	= m_Capacity - transientSlots;
+		m_TransientPerFrame = TransientPerFrame;
+
+		m_Allocator.Initialize(m_TransientStart, 1);
+		if (TransientPerFrame > 0)
 		{
-			m_AvailableGpuPtr = static_cast<uint64>(m_Heap->GetGPUDescriptorHandleForHeapStart().ptr) + m_DescriptorSize;
+			m_Transient.Initialize(TransientPerFrame, FRAME_COUNT, 1);
 		}
 	}
 
@@ -51,63 +60,120 @@ namespace lde
 
 	D3D12Descriptor D3D12DescriptorHeap::Allocate(uint32 Count)
 	{
-		if (!CanAllocate())
+		D3D12Descriptor outputDesc;
+
+		const DescriptorRange range = m_Allocator.Allocate(Count);
+		if (!range.IsValid())
 		{
-			// Warn
+			LOG_ERROR(std::format("{0}: no free range of {1} descriptors; {2} of {3} in use.", m_DebugName, Count, m_Allocator.GetUsed(), m_Capacity).c_str());
+			return outputDesc;
 		}
 
-		D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = (D3D12_CPU_DESCRIPTOR_HANDLE)(m_AvailableCpuPtr);
-		m_AvailableCpuPtr += ((usize)Count * m_DescriptorSize);
+		outputDesc.m_Index		= range.Index;
+		outputDesc.m_Count		= range.Count;
+		outputDesc.m_Generation = range.Generation;
 
-		D3D12Descriptor outputDesc;
-		outputDesc.SetCpuHandle(cpuHandle);
+		Override(outputDesc);
 
-		outputDesc.m_Index = GetIndex(outputDesc);
+		return outputDesc;
+	}
 
-		if (Type == HeapType::eSRV)
+	void D3D12DescriptorHeap::Allocate(D3D12Descriptor& Descriptor, uint32 Count)
+	{
+		if (Descriptor.IsValid())
 		{
-			D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = (D3D12_GPU_DESCRIPTOR_HANDLE)(m_AvailableGpuPtr);
-			m_AvailableGpuPtr += ((usize)Count * m_DescriptorSize);
-
-			outputDesc.SetGpuHandle(gpuHandle);
+			Override(Descriptor);
+			return;
 		}
 
-		return outputDesc;
+		Descriptor = Allocate(Count);
 	}
 
-	void D3D12DescriptorHeap::Allocate(D3D12Descriptor& Descriptor, uint32 Count)
+	void D3D12DescriptorHeap::Free(D3D12Descriptor& Descriptor)
 	{
-		if (!CanAllocate())
+		if (!Descriptor.IsValid())
 		{
-			// Warning
 			return;
 		}
 
-		if (Descriptor.IsValid())
+		if (Descriptor.m_Index >= m_TransientStart)
 		{
-			Override(Descriptor);
+			Descriptor = D3D12Descriptor();
 			return;
 		}
 
-		D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = (D3D12_CPU_DESCRIPTOR_HANDLE)(m_AvailableCpuPtr);
-		m_AvailableCpuPtr += ((size_t)Count * m_DescriptorSize);
+		const DescriptorRange range{ Descriptor.m_Index, Descriptor.m_Count, Descriptor.m_Generation };
+		if (!m_Allocator.Free(range))
+		{
+			LOG_WARN(std::format("{0}: descriptor {1} was already freed.", m_DebugName, Descriptor.m_Index).c_str());
+		}
 
-		Descriptor.SetCpuHandle(cpuHandle);
+		Descriptor = D3D12Descriptor();
+	}
 
-		Descriptor.m_Index = GetIndex(Descriptor);
+	D3D12Descriptor D3D12DescriptorHeap::AllocateTransient(uint32 Count)
+	{
+		D3D12Descriptor outputDesc;
 
-		if (Type == HeapType::eSRV)
+		const uint64 offset = (m_TransientPerFrame > 0) ? m_Transient.Allocate(Count) : LinearAllocator::InvalidOffset;
+		if (offset == LinearAllocator::InvalidOffset)
+		{
+			LOG_ERROR(std::format("{0}: no room for {1} transient descriptors; {2} of {3} used this frame.",
+				m_DebugName, Count, m_Transient.GetUsedSize(), m_TransientPerFrame).c_str());
+			return outputDesc;
+		}
+
+		m_TransientUsed += Count;
+		m_TransientPeak = std::max(m_TransientPeak, m_TransientUsed);
+
+		outputDesc.m_Index = m_TransientStart + static_cast<uint32>(offset);
+		outputDesc.m_Count = Count;
+
+		Override(outputDesc);
+
+		return outputDesc;
+	}
+
+	void D3D12DescriptorHeap::BeginFrame(uint32 FrameIndex, uint64 CompletedFenceValue)
+	{
+		if (m_TransientPerFrame > 0 && !m_Transient.BeginFrame(FrameIndex, CompletedFenceValue))
+		{
+			LOG_WARN(std::format("{0}: transient region of frame {1} is still in use by GPU.", m_DebugName, FrameIndex).c_str());
+		}
+	}
+
+	void D3D12DescriptorHeap::EndFrame(uint64 FenceValue)
+	{
+		if (m_TransientPerFrame > 0)
 		{
-			D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = (D3D12_GPU_DESCRIPTOR_HANDLE)(m_AvailableGpuPtr);
-			m_AvailableGpuPtr += ((size_t)Count * m_DescriptorSize);
+			m_Transient.EndFrame(FenceValue);
+		}
+
+		m_TransientLastFrame = m_TransientUsed;
+		m_TransientUsed = 0;
+	}
 
-			Descriptor.SetGpuHandle(gpuHandle);
+	void D3D12DescriptorHeap::RetireTransient(uint64 CompletedFenceValue)
+	{
+		if (m_TransientPerFrame > 0)
+		{
+			m_Transient.BeginFrame(m_Transient.GetCurrentFrame(), CompletedFenceValue);
 		}
 	}
 
+	TransientDescriptorStats D3D12DescriptorHeap::GetTransientStats() const
+	{
+		return TransientDescriptorStats{
+			.PerFrame	= m_TransientPerFrame,
+			.LastFrame	= m_TransientLastFrame,
+			.Peak		= m_TransientPeak,
+			.FailedAllocations = m_Transient.GetFailedAllocations()
+		};
+	}
+
 	void D3D12DescriptorHeap::Override(D3D12Descriptor& Descriptor) const
 	{
-		uint32 offset = GetIndex(Descriptor);
+		const uint64 offset = Descriptor.m_Index;
 		D3D12_CPU_DESCRIPTOR_HANDLE cpu = (D3D12_CPU_DESCRIPTOR_HANDLE)(CpuStartHandle().ptr + (offset * m_DescriptorSize));
 		Descriptor.SetCpuHandle(cpu);
 
@@ -155,13 +221,6 @@ namespace lde
 
 	void D3D12DescriptorHeap::Reset()
 	{
-		m_AllocationsLeft = m_Capacity;
-
-		m_AvailableCpuPtr = static_cast<uint64>(m_Heap->GetCPUDescriptorHandleForHeapStart().ptr) + m_DescriptorSize;
-
-		if (Type == HeapType::eSRV)
-		{
-			m_AvailableGpuPtr = static_cast<uint64>(m_Heap->GetGPUDescriptorHandleForHeapStart().ptr) + m_DescriptorSize;
-		}
+		m_Allocator.Reset();
 	}
 }
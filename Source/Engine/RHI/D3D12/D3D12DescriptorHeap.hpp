@@ -2,6 +2,8 @@
 
 #include "Core/CoreMinimal.hpp"
 #include "D3D12Descriptor.hpp"
+#include "RHI/DescriptorAllocator.hpp"
+#include "RHI/LinearAllocator.hpp"
 
 namespace lde
 {
@@ -15,16 +17,53 @@ namespace lde
 
 	class D3D12Device;
 
+	struct TransientDescriptorStats
+	{
+		// Slots available to each frame in flight.
+		uint32 PerFrame		= 0;
+		// Slots taken by the last finished frame.
+		uint32 LastFrame	= 0;
+		uint32 Peak			= 0;
+		uint32 FailedAllocations = 0;
+	};
+
 	class D3D12DescriptorHeap
 	{
 	public:
-		D3D12DescriptorHeap(D3D12Device* pDevice, HeapType eType, uint32 MaxCapacity, std::string_view DebugName = "");
+		/**
+		 * @param TransientPerFrame Slots at the end of the heap set aside for AllocateTransient, for each frame in flight.
+		 * Remaining slots are persistent.
+		 */
+		D3D12DescriptorHeap(D3D12Device* pDevice, HeapType eType, uint32 MaxCapacity, std::string_view DebugName = "", uint32 TransientPerFrame = 0);
 		~D3D12DescriptorHeap();
 
+		/// @return Invalid descriptor if heap has no free range of given size.
 		D3D12Descriptor Allocate(uint32 Count = 1);
 
+		/// @brief Already valid Descriptor keeps its slots; only its handles are recomputed.
 		void Allocate(D3D12Descriptor& Descriptor, uint32 Count = 1);
 
+		/**
+		 * @brief Returns Descriptor's slots to the heap and invalidates it. GPU must not be using them anymore.
+		 * Copies of Descriptor freed already are ignored, as are transient descriptors.
+		 */
+		void Free(D3D12Descriptor& Descriptor);
+
+		/**
+		 * @brief Contiguous slots valid until GPU finishes current frame; meant for views written during recording.
+		 * Never freed by hand; whole frame's region is recycled once its fence value is reached.
+		 * @return Invalid descriptor if frame's region is full.
+		 */
+		D3D12Descriptor AllocateTransient(uint32 Count = 1);
+
+		/// @brief Makes transient region of given frame current. Same rules as Frame Allocator.
+		void BeginFrame(uint32 FrameIndex, uint64 CompletedFenceValue);
+		/// @brief Tags current transient region with fence value signaled after its frame is submitted.
+		void EndFrame(uint64 FenceValue);
+
+		/// @brief Recycles current transient region early. Called once GPU is idle, i.e. after loading work was executed.
+		void RetireTransient(uint64 CompletedFenceValue);
+
 		void Override(D3D12Descriptor& Descriptor) const;
 
 		ID3D12DescriptorHeap* Get();
@@ -41,20 +80,32 @@ namespace lde
 
 		D3D12_GPU_DESCRIPTOR_HANDLE GpuStartHandle() const;
 
+		/// @brief Frees every descriptor at once.
 		void Reset();
 
+		DescriptorAllocatorStats GetStats() const { return m_Allocator.GetStats(); }
+		TransientDescriptorStats GetTransientStats() const;
+
 		HeapType Type{};
 
 	private:
 		Ref<ID3D12DescriptorHeap> m_Heap;
 		uint32 m_Capacity = 0;
-		uint32 m_AllocationsLeft = 0;
 		uint32 m_DescriptorSize = 0;
 
-		uint64 m_AvailableCpuPtr = 0;
-		uint64 m_AvailableGpuPtr = 0;
+		// First slot is never handed out; index 0 is left as null descriptor.
+		DescriptorAllocator m_Allocator;
+
+		// Slots from m_TransientStart on; one region per frame in flight.
+		LinearAllocator m_Transient;
+		uint32 m_TransientStart		= 0;
+		uint32 m_TransientPerFrame	= 0;
+		// Slots taken since last EndFrame; early retires don't reset it.
+		uint32 m_TransientUsed		= 0;
+		uint32 m_TransientLastFrame = 0;
+		uint32 m_TransientPeak		= 0;
 
-		inline bool CanAllocate() const { return (m_AllocationsLeft > 0); }
+		std::string m_DebugName;
 
 	};
 } // namespace lde
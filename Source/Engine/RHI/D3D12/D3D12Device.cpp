@@ -2,6 +2,7 @@
 #include "D3D12Device.hpp"
 #include "D3D12RootSignature.hpp"
 #include "D3D12Utility.hpp"
+#include "Core/Logger.hpp"
 
 namespace lde
 {
@@ -77,11 +78,16 @@ namespace lde
 			throw std::runtime_error("");
 		}
 	
+		m_UploadHeap->Flush(commandList);
+		m_StateTracker->Flush(commandList);
+
 		DX_CALL(commandList->Close());
 		
 		ID3D12CommandList* commandLists[] = { commandList->Get() };
 		
 		commandQueue->ExecuteCommandLists(1, commandLists);
+
+		m_UploadHeap->Signal(GetGfxQueue());
 		
 		if (bResetAllocator)
 		{
@@ -89,12 +95,18 @@ namespace lde
 		}
 		
 		WaitForGPU(eType);
+
+		// Everything recorded so far is done; i.e. views made for mip generation while loading don't pile up until next frame.
+		m_ShaderResourceHeap->RetireTransient(GraphicsQueue->GetFence().Get()->GetCompletedValue());
 	}
 
 	void D3D12Device::ExecuteAllCommandLists(bool bResetAllocators)
 	{
 		ID3D12CommandList* commandLists[FRAME_COUNT]{};
 
+		m_UploadHeap->Flush(GetGfxCommandList());
+		m_StateTracker->Flush(GetGfxCommandList());
+
 		for (usize frame = 0; frame < FRAME_COUNT; ++frame)
 		{
 			auto commandList = m_FrameResources[frame].GraphicsCommandList;
@@ -110,12 +122,45 @@ namespace lde
 		}
 
 		GetGfxQueue()->Get()->ExecuteCommandLists(_countof(commandLists), commandLists);
+		m_UploadHeap->Signal(GetGfxQueue());
 
 		WaitForGPU(CommandType::eGraphics);
+
+		m_ShaderResourceHeap->RetireTransient(GraphicsQueue->GetFence().Get()->GetCompletedValue());
+	}
+
+	void D3D12Device::ExecuteWithWorkerLists(std::span<D3D12CommandList*> Lists)
+	{
+		auto* commandList = GetGfxCommandList();
+
+		// Barriers of the worker lists' targets are recorded here, as worker lists don't flush.
+		m_UploadHeap->Flush(commandList);
+		m_StateTracker->Flush(commandList);
+
+		DX_CALL(commandList->Close());
+
+		std::vector<ID3D12CommandList*> commandLists;
+		commandLists.reserve(Lists.size() + 1);
+		commandLists.push_back(commandList->Get());
+
+		for (auto* workerList : Lists)
+		{
+			DX_CALL(workerList->Close());
+			commandLists.push_back(workerList->Get());
+		}
+
+		GetGfxQueue()->Get()->ExecuteCommandLists(static_cast<uint32>(commandLists.size()), commandLists.data());
+		m_UploadHeap->Signal(GetGfxQueue());
+
+		// List can be reset while in flight; allocator keeps both parts until the frame's fence is reached.
+		commandList->ResetList();
 	}
 
 	void D3D12Device::CreateFrameResources()
 	{
+		// Command lists keep pointer to it.
+		m_StateTracker = std::make_unique<D3D12StateTracker>();
+
 		for (usize frame = 0; frame < FRAME_COUNT; frame++)
 		{
 			m_FrameResources[frame].GraphicsCommandList = new D3D12CommandList(this, CommandType::eGraphics, std::format("D3D12 Graphics Command List #{}", frame).c_str());
@@ -123,9 +168,20 @@ namespace lde
 			//m_FrameResources[frame].ComputeCommandList = new D3D12CommandList(this, CommandType::eCompute, std::format("D3D12 Compute Command List #{}", frame).c_str());
 		}
 
+		m_WorkerCommandLists = std::make_unique<D3D12CommandListPool>(this, CommandType::eGraphics);
+		m_PipelineCache = std::make_unique<D3D12PipelineCache>(this, "Cache/Pipelines.bin");
+
 		GraphicsQueue = new D3D12Queue(this, CommandType::eGraphics);
 		//ComputeQueue = new D3D12Queue(this, CommandType::eCompute);
 
+		// Holds instance transforms of GBuffer draws too.
+		constexpr uint64 frameAllocatorSize = 16 * 1024 * 1024;
+		m_FrameAllocator = std::make_unique<D3D12LinearAllocator>(this, frameAllocatorSize);
+
+		constexpr uint64 uploadHeapSize = 64 * 1024 * 1024;
+		m_UploadHeap = std::make_unique<D3D12UploadHeap>(this, uploadHeapSize);
+		m_Uploader = std::make_unique<D3D12Uploader>(this, uploadHeapSize);
+
 		// Open first command list to allow pre-loading of assets - models and skybox + ibl.
 		m_FrameResources[0].GraphicsCommandList->Open();
 		//m_FrameResources[0].ComputeCommandList->Reset();
@@ -147,75 +203,96 @@ namespace lde
 		}
 	}
 
-	D3D12Buffer* D3D12Device::GetBuffer(uint32 Index)
+	D3D12Buffer* D3D12Device::GetBuffer(BufferHandle Handle)
 	{
-		return Buffers.at(Index);
+		return Buffers.Get(Handle);
 	}
 
-	D3D12ConstantBuffer* D3D12Device::GetConstantBuffer(uint32 Index)
+	Buffer* D3D12Device::LookupBuffer(BufferHandle Handle)
 	{
-		return ConstantBuffers.at(Index);
+		return Buffers.Get(Handle);
 	}
 
-	D3D12Texture* D3D12Device::GetTexture(uint32 Index)
+	D3D12ConstantBuffer* D3D12Device::GetConstantBuffer(BufferHandle Handle)
 	{
-		return Textures.at(Index);
+		return ConstantBuffers.Get(Handle);
+	}
+
+	D3D12Texture* D3D12Device::GetTexture(TextureHandle Handle)
+	{
+		return Textures.Get(Handle);
 	}
 
 	BufferHandle D3D12Device::CreateBuffer(BufferDesc Desc)
 	{
-		BufferHandle handle = static_cast<BufferHandle>(Buffers.size());
+		auto buffer = std::make_unique<D3D12Buffer>(this, Desc);
 
-		Buffers.push_back(new D3D12Buffer(this, Desc));
-		
-		return handle;
+		const D3D12BufferHotData hot{
+			.GpuAddress				= buffer->GetGpuAddress(),
+			.ShaderResourceIndex	= buffer->ShaderResource.Index()
+		};
+
+		return Buffers.Insert(std::move(buffer), hot);
 	}
 	
 	BufferHandle D3D12Device::CreateConstantBuffer(void* pData, usize Size)
 	{
-		BufferHandle handle = static_cast<BufferHandle>(ConstantBuffers.size());
-
-		ConstantBuffers.push_back(new D3D12ConstantBuffer(pData, Size));
-
-		return handle;
+		return ConstantBuffers.Insert(std::make_unique<D3D12ConstantBuffer>(pData, Size));
 	}
 
 	TextureHandle D3D12Device::CreateTexture(D3D12Texture* pTexture)
 	{
-		TextureHandle handle = static_cast<TextureHandle>(Textures.size());
-
-		Textures.push_back(pTexture);
+		const D3D12TextureHotData hot{ .ShaderResourceIndex = pTexture->SRV.Index() };
 
-		return handle;
+		return Textures.Insert(std::unique_ptr<D3D12Texture>(pTexture), hot);
 	}
 
-	TextureHandle D3D12Device::CreateTexture(TextureDesc Desc)
+	TextureHandle D3D12Device::CreateTexture(TextureDesc /* Desc */)
 	{
-		TextureHandle handle = static_cast<TextureHandle>(Textures.size());
-
-		D3D12Texture* texture;
-
-		Textures.push_back(texture);
-
-		return handle;
+		// Not implemented yet; registers empty texture.
+		return Textures.Insert(std::make_unique<D3D12Texture>());
 	}
 
 	void D3D12Device::DestroyBuffer(BufferHandle Handle)
 	{
-		Buffers.at(Handle)->Release();
-		delete Buffers.at(Handle);
+		auto* buffer = Buffers.Get(Handle);
+		if (!buffer)
+		{
+			LOG_WARN(std::format("DestroyBuffer: handle {0:#x} is stale.", Handle).c_str());
+			return;
+		}
+
+		m_ShaderResourceHeap->Free(buffer->ShaderResource);
+		buffer->Release();
+		Buffers.Remove(Handle);
 	}
 
 	void D3D12Device::DestroyConstantBuffer(BufferHandle Handle)
 	{
-		ConstantBuffers.at(Handle)->Release();
-		delete ConstantBuffers.at(Handle);
+		auto* buffer = ConstantBuffers.Get(Handle);
+		if (!buffer)
+		{
+			LOG_WARN(std::format("DestroyConstantBuffer: handle {0:#x} is stale.", Handle).c_str());
+			return;
+		}
+
+		buffer->Release();
+		ConstantBuffers.Remove(Handle);
 	}
 
 	void D3D12Device::DestroyTexture(TextureHandle Handle)
 	{
-		Textures.at(Handle)->Release();
-		delete Textures.at(Handle);
+		auto* texture = Textures.Get(Handle);
+		if (!texture)
+		{
+			LOG_WARN(std::format("DestroyTexture: handle {0:#x} is stale.", Handle).c_str());
+			return;
+		}
+
+		m_ShaderResourceHeap->Free(texture->SRV);
+		m_ShaderResourceHeap->Free(texture->UAV);
+		texture->Release();
+		Textures.Remove(Handle);
 	}
 
 	void D3D12Device::CreateSRV(ID3D12Resource* pResource, D3D12Descriptor& Descriptor, uint32 Mips, uint32 Count)
@@ -8,11 +8,18 @@
 #include "Core/CoreMinimal.hpp"
 
 #include "RHI/D3D12/D3D12CommandList.hpp"
+#include "RHI/D3D12/D3D12CommandListPool.hpp"
 #include "RHI/D3D12/D3D12DescriptorHeap.hpp"
 #include "RHI/D3D12/D3D12Fence.hpp"
+#include "RHI/D3D12/D3D12LinearAllocator.hpp"
 #include "RHI/D3D12/D3D12Memory.hpp"
+#include "RHI/D3D12/D3D12PipelineCache.hpp"
 #include "RHI/D3D12/D3D12Queue.hpp"
+#include "RHI/D3D12/D3D12StateTracker.hpp"
 #include "RHI/D3D12/D3D12Texture.hpp"
+#include "RHI/D3D12/D3D12UploadHeap.hpp"
+#include "RHI/D3D12/D3D12Uploader.hpp"
+#include "RHI/HandlePool.hpp"
 #include "RHI/Types.hpp"
 
 #if DEBUG_MODE
@@ -25,6 +32,18 @@ namespace lde
 	class D3D12Buffer;
 	class D3D12ConstantBuffer;
 
+	/// @brief Buffer fields read per draw; kept next to pool's generations instead of behind the object pointer.
+	struct D3D12BufferHotData
+	{
+		D3D12_GPU_VIRTUAL_ADDRESS GpuAddress = 0;
+		uint32 ShaderResourceIndex = UINT32_MAX;
+	};
+
+	struct D3D12TextureHotData
+	{
+		uint32 ShaderResourceIndex = UINT32_MAX;
+	};
+
 	struct D3D12Debug
 	{
 		Ref<IDXGIDebug1>		DXGIDebug;
@@ -84,6 +103,14 @@ namespace lde
 
 		void ExecuteAllCommandLists(bool bResetAllocators = false);
 
+		/**
+		 * @brief Closes and submits Graphics command list followed by Lists, in given order, without waiting.
+		 * Graphics command list is reopened on the same allocator, so none of its state carries over;
+		 * descriptor heaps, viewport, targets and topology have to be set again.
+		 * @param Lists Open lists of Worker Command List pool.
+		 */
+		void ExecuteWithWorkerLists(std::span<D3D12CommandList*> Lists);
+
 		//D3D12Fence* GetFence() { return m_Fence.get(); }
 		
 		// One per frame buffer
@@ -106,6 +133,19 @@ namespace lde
 		D3D12Queue*			 GetComputeQueue()		{ return ComputeQueue;  }
 
 		D3D12CommandList*	 GetGfxCommandList()	{ return m_FrameResources[FRAME_INDEX].GraphicsCommandList; }
+
+		// Transient per-frame constants.
+		D3D12LinearAllocator* GetFrameAllocator()	{ return m_FrameAllocator.get(); }
+		// Staging for buffer uploads; flushed whenever Graphics command list is executed.
+		D3D12UploadHeap*	 GetUploadHeap()		{ return m_UploadHeap.get(); }
+		// Copy Queue uploads; used instead of Upload Heap while a batch is open.
+		D3D12Uploader*		 GetUploader()			{ return m_Uploader.get(); }
+		// Known states of render targets and backbuffers; flushed before draws and when Graphics command list is executed.
+		D3D12StateTracker*	 GetStateTracker()		{ return m_StateTracker.get(); }
+		// Graphics lists for parallel recording; submitted by ExecuteWithWorkerLists.
+		D3D12CommandListPool* GetWorkerCommandLists() { return m_WorkerCommandLists.get(); }
+		// Shared Pipeline State Objects; persisted between runs.
+		D3D12PipelineCache*	 GetPipelineCache()		{ return m_PipelineCache.get(); }
 		//D3D12CommandList*	 GetComputeCommandList(){ return m_FrameResources[FRAME_INDEX].ComputeCommandList; }
 
 		D3D12DescriptorHeap* GetShaderResourceHeap()	{ return m_ShaderResourceHeap.get(); }
@@ -136,6 +176,13 @@ namespace lde
 		std::unique_ptr<D3D12DescriptorHeap> m_RenderTargetHeap;
 		std::unique_ptr<D3D12DescriptorHeap> m_DepthStencilHeap;
 
+		std::unique_ptr<D3D12LinearAllocator> m_FrameAllocator;
+		std::unique_ptr<D3D12UploadHeap> m_UploadHeap;
+		std::unique_ptr<D3D12Uploader> m_Uploader;
+		std::unique_ptr<D3D12StateTracker> m_StateTracker;
+		std::unique_ptr<D3D12CommandListPool> m_WorkerCommandLists;
+		std::unique_ptr<D3D12PipelineCache> m_PipelineCache;
+
 	private:
 		void Create();
 		void Release();
@@ -152,13 +199,14 @@ namespace lde
 #endif
 
 	public:
-		std::vector<D3D12Buffer*>			Buffers;
-		std::vector<D3D12ConstantBuffer*>	ConstantBuffers;
-		std::vector<D3D12Texture*>			Textures;
+		HandlePool<D3D12Buffer, D3D12BufferHotData>		Buffers;
+		HandlePool<D3D12ConstantBuffer>					ConstantBuffers;
+		HandlePool<D3D12Texture, D3D12TextureHotData>	Textures;
 
-		D3D12Buffer*			GetBuffer(uint32 Index);
-		D3D12ConstantBuffer*	GetConstantBuffer(uint32 Index);
-		D3D12Texture*			GetTexture(uint32 Index);
+		/// @return nullptr if Handle was destroyed.
+		D3D12Buffer*			GetBuffer(BufferHandle Handle);
+		D3D12ConstantBuffer*	GetConstantBuffer(BufferHandle Handle);
+		D3D12Texture*			GetTexture(TextureHandle Handle);
 
 
 		void CreateSRV(ID3D12Resource* pResource, D3D12Descriptor& Descriptor, uint32 Mips, uint32 Count);
@@ -171,11 +219,12 @@ namespace lde
 
 		BufferHandle	CreateBuffer(BufferDesc Desc) override final;
 		BufferHandle	CreateConstantBuffer(void* pData, usize Size) override final;
-		// Temporal
+		Buffer*			LookupBuffer(BufferHandle Handle) override final;
+		// Temporal. Takes ownership of pTexture.
 		TextureHandle	CreateTexture(D3D12Texture* pTexture);
 		TextureHandle	CreateTexture(TextureDesc Desc);
 
-		void			DestroyBuffer(BufferHandle Handle);
+		void			DestroyBuffer(BufferHandle Handle) override final;
 		void			DestroyConstantBuffer(BufferHandle Handle);
 		void			DestroyTexture(TextureHandle Handle);
 
@@ -0,0 +1,78 @@
+#include "D3D12LinearAllocator.hpp"
+#include "D3D12Buffer.hpp"
+#include "D3D12Device.hpp"
+#include "D3D12Utility.hpp"
+#include "Core/Logger.hpp"
+
+namespace lde
+{
+	D3D12LinearAllocator::D3D12LinearAllocator(D3D12Device* pDevice, uint64 SizePerFrame)
+	{
+		m_Allocator.Initialize(SizePerFrame, FRAME_COUNT, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+		const auto desc = CreateBufferDesc(m_Allocator.GetTotalSize());
+
+		DX_CALL(pDevice->GetDevice()->CreateCommittedResource(
+			&D3D12Utility::HeapUpload,
+			D3D12_HEAP_FLAG_NONE,
+			&desc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(&m_Buffer)));
+		SET_D3D12_NAME(m_Buffer, "D3D12 Linear Allocator");
+
+		// Persistent mapping
+		const D3D12_RANGE readRange(0, 0);
+		DX_CALL(m_Buffer->Map(0, &readRange, reinterpret_cast<void**>(&m_pData)));
+		m_GpuAddress = m_Buffer->GetGPUVirtualAddress();
+	}
+
+	D3D12LinearAllocator::~D3D12LinearAllocator()
+	{
+		Release();
+	}
+
+	void D3D12LinearAllocator::BeginFrame(uint32 FrameIndex, uint64 CompletedFenceValue)
+	{
+		if (!m_Allocator.BeginFrame(FrameIndex, CompletedFenceValue))
+		{
+			LOG_WARN(std::format("D3D12LinearAllocator: frame {} is still in use by GPU.", FrameIndex).c_str());
+		}
+	}
+
+	void D3D12LinearAllocator::EndFrame(uint64 FenceValue)
+	{
+		m_Allocator.EndFrame(FenceValue);
+	}
+
+	D3D12LinearAllocation D3D12LinearAllocator::Allocate(uint64 Size, uint64 Alignment)
+	{
+		const uint64 offset = m_Allocator.Allocate(Size, Alignment);
+		if (offset == LinearAllocator::InvalidOffset)
+		{
+			LOG_ERROR(std::format("D3D12LinearAllocator: failed to allocate {} bytes; {} of {} bytes used.",
+				Size, m_Allocator.GetUsedSize(), m_Allocator.GetRegionSize()).c_str());
+			return D3D12LinearAllocation();
+		}
+
+		return D3D12LinearAllocation{
+			.pCpuAddress	= m_pData + offset,
+			.GpuAddress		= m_GpuAddress + offset,
+			.Size			= Size,
+			.pResource		= m_Buffer.Get(),
+			.Offset			= offset
+		};
+	}
+
+	void D3D12LinearAllocator::Release()
+	{
+		if (m_Buffer.Get() && m_pData)
+		{
+			m_Buffer->Unmap(0, nullptr);
+			m_pData = nullptr;
+		}
+
+		SAFE_RELEASE(m_Buffer);
+	}
+
+} // namespace lde
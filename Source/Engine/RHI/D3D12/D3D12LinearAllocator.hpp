@@ -0,0 +1,102 @@
+#pragma once
+
+/*
+	RHI/D3D12/D3D12LinearAllocator.hpp
+	Per-frame transient constants on a single persistently mapped upload buffer.
+*/
+
+#include <AgilitySDK/d3d12.h>
+#include "Core/CoreMinimal.hpp"
+#include "RHI/LinearAllocator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+namespace lde
+{
+	class D3D12Device;
+
+	struct D3D12LinearAllocation
+	{
+		void*						pCpuAddress = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS	GpuAddress	= 0;
+		uint64						Size		= 0;
+		// For use as copy source.
+		ID3D12Resource*				pResource	= nullptr;
+		uint64						Offset		= 0;
+
+		bool IsValid() const { return pCpuAddress != nullptr; }
+	};
+
+	class D3D12LinearAllocator
+	{
+	public:
+		/**
+		 * @param pDevice
+		 * @param SizePerFrame Bytes available to each frame in flight.
+		 */
+		D3D12LinearAllocator(D3D12Device* pDevice, uint64 SizePerFrame);
+		~D3D12LinearAllocator();
+
+		void BeginFrame(uint32 FrameIndex, uint64 CompletedFenceValue);
+		void EndFrame(uint64 FenceValue);
+
+		/**
+		 * @brief Bump allocation valid until GPU finishes current frame.
+		 * @param Size
+		 * @param Alignment Defaults to Constant Buffer placement alignment.
+		 * @return Invalid allocation if frame's space is exhausted.
+		 */
+		D3D12LinearAllocation Allocate(uint64 Size, uint64 Alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+		/**
+		 * @brief Allocates and copies given data.
+		 * @return GPU address to bind as root CBV; 0 if frame's space is exhausted, which must not be bound.
+		 */
+		template<typename T>
+		D3D12_GPU_VIRTUAL_ADDRESS Upload(const T& Data)
+		{
+			const auto allocation = Allocate(sizeof(T));
+			if (!allocation.IsValid())
+			{
+				return 0;
+			}
+
+			std::memcpy(allocation.pCpuAddress, &Data, sizeof(T));
+			return allocation.GpuAddress;
+		}
+
+		/**
+		 * @brief Allocates and copies array, i.e. for root SRV of a structured buffer.
+		 * Empty array still gets one element, so it has a valid address too.
+		 * @return 0 if frame's space is exhausted, which must not be bound.
+		 */
+		template<typename T>
+		D3D12_GPU_VIRTUAL_ADDRESS UploadArray(std::span<const T> Data)
+		{
+			const auto allocation = Allocate(std::max<uint64>(Data.size_bytes(), sizeof(T)));
+			if (!allocation.IsValid())
+			{
+				return 0;
+			}
+
+			if (!Data.empty())
+			{
+				std::memcpy(allocation.pCpuAddress, Data.data(), Data.size_bytes());
+			}
+			return allocation.GpuAddress;
+		}
+
+		const LinearAllocator& GetAllocator() const { return m_Allocator; }
+
+		void Release();
+
+	private:
+		Ref<ID3D12Resource> m_Buffer;
+		uint8*						m_pData			= nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS	m_GpuAddress	= 0;
+
+		LinearAllocator m_Allocator;
+
+	};
+} // namespace lde
@@ -0,0 +1,228 @@
+#include "Core/Logger.hpp"
+#include "D3D12Device.hpp"
+#include "D3D12PipelineCache.hpp"
+#include "D3D12RootSignature.hpp"
+#include "D3D12Utility.hpp"
+#include <format>
+
+namespace lde
+{
+	namespace
+	{
+		uint64 HashShader(const D3D12_SHADER_BYTECODE& Bytecode)
+		{
+			return PipelineKey::HashBlob(Bytecode.pShaderBytecode, Bytecode.BytecodeLength);
+		}
+	} // namespace
+
+	D3D12PipelineCache::D3D12PipelineCache(D3D12Device* pDevice, Filepath Path)
+		: m_Device(pDevice), m_Path(std::move(Path))
+	{
+		OpenLibrary();
+	}
+
+	D3D12PipelineCache::~D3D12PipelineCache()
+	{
+		Save();
+
+		m_Cache.Clear();
+		SAFE_RELEASE(m_Library);
+	}
+
+	template<typename Desc, typename CreateFn, typename LoadFn>
+	HRESULT D3D12PipelineCache::Get(const Desc& PipelineDesc, uint64 Key, Ref<ID3D12PipelineState>& OutPipeline, CreateFn&& Create, LoadFn&& Load)
+	{
+		HRESULT result = S_OK;
+
+		const PipelineSource source = m_Cache.Get(Key, OutPipeline,
+			[&](uint64 Hash, Ref<ID3D12PipelineState>& Pipeline)
+			{
+				// Fails with E_INVALIDARG if the name is unknown or stored desc differs.
+				return m_Library.Get() && SUCCEEDED(Load(std::format(L"{:016X}", Hash).c_str(), PipelineDesc, Pipeline));
+			},
+			[&](Ref<ID3D12PipelineState>& Pipeline)
+			{
+				result = Create(PipelineDesc, Pipeline);
+				return SUCCEEDED(result);
+			},
+			[&](uint64 Hash, const Ref<ID3D12PipelineState>& Pipeline)
+			{
+				if (!m_Library.Get())
+				{
+					return false;
+				}
+
+				if (FAILED(m_Library->StorePipeline(std::format(L"{:016X}", Hash).c_str(), Pipeline.Get())))
+				{
+					LOG_WARN(std::format("Failed to store pipeline {:016X} in Pipeline Library.", Hash).c_str());
+					return false;
+				}
+
+				return true;
+			});
+
+		return (source == PipelineSource::eFailed) ? result : S_OK;
+	}
+
+	HRESULT D3D12PipelineCache::GetGraphics(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, D3D12RootSignature* pRootSignature, Ref<ID3D12PipelineState>& OutPipeline)
+	{
+		auto* device = m_Device->GetDevice();
+
+		// Key doesn't cover input layouts and stream output; engine uses neither, so such pipelines just aren't cached.
+		if (Desc.InputLayout.NumElements != 0 || Desc.StreamOutput.NumEntries != 0)
+		{
+			return device->CreateGraphicsPipelineState(&Desc, IID_PPV_ARGS(&OutPipeline));
+		}
+
+		const uint64 key = PipelineKey::Compute(ToPipelineDesc(Desc, pRootSignature->GetHash()));
+
+		return Get(Desc, key, OutPipeline,
+			[&](const D3D12_GRAPHICS_PIPELINE_STATE_DESC& PipelineDesc, Ref<ID3D12PipelineState>& Pipeline)
+			{
+				return device->CreateGraphicsPipelineState(&PipelineDesc, IID_PPV_ARGS(&Pipeline));
+			},
+			[&](LPCWSTR Name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& PipelineDesc, Ref<ID3D12PipelineState>& Pipeline)
+			{
+				return m_Library->LoadGraphicsPipeline(Name, &PipelineDesc, IID_PPV_ARGS(&Pipeline));
+			});
+	}
+
+	HRESULT D3D12PipelineCache::GetCompute(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, D3D12RootSignature* pRootSignature, Ref<ID3D12PipelineState>& OutPipeline)
+	{
+		auto* device = m_Device->GetDevice();
+
+		const uint64 key = PipelineKey::Compute(ToPipelineDesc(Desc, pRootSignature->GetHash()));
+
+		return Get(Desc, key, OutPipeline,
+			[&](const D3D12_COMPUTE_PIPELINE_STATE_DESC& PipelineDesc, Ref<ID3D12PipelineState>& Pipeline)
+			{
+				return device->CreateComputePipelineState(&PipelineDesc, IID_PPV_ARGS(&Pipeline));
+			},
+			[&](LPCWSTR Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& PipelineDesc, Ref<ID3D12PipelineState>& Pipeline)
+			{
+				return m_Library->LoadComputePipeline(Name, &PipelineDesc, IID_PPV_ARGS(&Pipeline));
+			});
+	}
+
+	void D3D12PipelineCache::Save()
+	{
+		if (!m_Cache.IsDirty() || !m_Library.Get())
+		{
+			return;
+		}
+
+		std::vector<uint8> blob(m_Library->GetSerializedSize());
+		if (FAILED(m_Library->Serialize(blob.data(), blob.size())))
+		{
+			LOG_WARN("Failed to serialize Pipeline Library.");
+			return;
+		}
+
+		if (!PipelineLibraryFile::Write(m_Path, blob))
+		{
+			LOG_WARN(std::format("Failed to write Pipeline Library to {}.", m_Path.string()).c_str());
+			return;
+		}
+
+		m_Cache.MarkSaved();
+	}
+
+	void D3D12PipelineCache::OpenLibrary()
+	{
+		auto* device = m_Device->GetDevice();
+
+		if (PipelineLibraryFile::Read(m_Path, m_LibraryData))
+		{
+			// Rejected if written by another driver version or adapter.
+			const HRESULT result = device->CreatePipelineLibrary(m_LibraryData.data(), m_LibraryData.size(), IID_PPV_ARGS(&m_Library));
+			if (FAILED(result))
+			{
+				LOG_WARN(std::format("Pipeline Library {} is out of date; rebuilding it.", m_Path.string()).c_str());
+				m_LibraryData.clear();
+			}
+		}
+
+		if (!m_Library.Get())
+		{
+			if (FAILED(device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_Library))))
+			{
+				LOG_WARN("Pipeline Libraries are not supported; pipelines are deduplicated in memory only.");
+			}
+		}
+	}
+
+	PipelineStateDesc D3D12PipelineCache::ToPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, uint64 RootSignature)
+	{
+		PipelineStateDesc desc{};
+		desc.Type			= PipelineType::eGraphics;
+		desc.RootSignature	= RootSignature;
+
+		desc.Shaders.at(static_cast<usize>(PipelineShaderSlot::eVertex)) = HashShader(Desc.VS);
+		desc.Shaders.at(static_cast<usize>(PipelineShaderSlot::ePixel))	 = HashShader(Desc.PS);
+
+		const auto& raster = Desc.RasterizerState;
+		desc.Raster.FillMode				= static_cast<uint32>(raster.FillMode);
+		desc.Raster.CullMode				= static_cast<uint32>(raster.CullMode);
+		desc.Raster.bFrontCounterClockwise	= raster.FrontCounterClockwise;
+		desc.Raster.DepthBias				= raster.DepthBias;
+		desc.Raster.DepthBiasClamp			= raster.DepthBiasClamp;
+		desc.Raster.SlopeScaledDepthBias	= raster.SlopeScaledDepthBias;
+		desc.Raster.bDepthClip				= raster.DepthClipEnable;
+		desc.Raster.bMultisample			= raster.MultisampleEnable;
+		desc.Raster.bAntialiasedLine		= raster.AntialiasedLineEnable;
+		desc.Raster.ForcedSampleCount		= raster.ForcedSampleCount;
+		desc.Raster.ConservativeRaster		= static_cast<uint32>(raster.ConservativeRaster);
+
+		const auto& depth = Desc.DepthStencilState;
+		desc.DepthStencil.bDepthEnable		= depth.DepthEnable;
+		desc.DepthStencil.DepthWriteMask	= static_cast<uint32>(depth.DepthWriteMask);
+		desc.DepthStencil.DepthFunc			= static_cast<uint32>(depth.DepthFunc);
+		desc.DepthStencil.bStencilEnable	= depth.StencilEnable;
+		desc.DepthStencil.StencilReadMask	= depth.StencilReadMask;
+		desc.DepthStencil.StencilWriteMask	= depth.StencilWriteMask;
+		desc.DepthStencil.FrontFace = { static_cast<uint32>(depth.FrontFace.StencilFailOp), static_cast<uint32>(depth.FrontFace.StencilDepthFailOp),
+										static_cast<uint32>(depth.FrontFace.StencilPassOp), static_cast<uint32>(depth.FrontFace.StencilFunc) };
+		desc.DepthStencil.BackFace	= { static_cast<uint32>(depth.BackFace.StencilFailOp), static_cast<uint32>(depth.BackFace.StencilDepthFailOp),
+										static_cast<uint32>(depth.BackFace.StencilPassOp), static_cast<uint32>(depth.BackFace.StencilFunc) };
+
+		desc.Blend.bAlphaToCoverage		= Desc.BlendState.AlphaToCoverageEnable;
+		desc.Blend.bIndependentBlend	= Desc.BlendState.IndependentBlendEnable;
+		for (uint32 i = 0; i < PipelineBlendDesc::MaxRenderTargets; ++i)
+		{
+			const auto& src = Desc.BlendState.RenderTarget[i];
+			auto& dst = desc.Blend.RenderTargets.at(i);
+			dst.bBlendEnable	= src.BlendEnable;
+			dst.bLogicOpEnable	= src.LogicOpEnable;
+			dst.SrcBlend		= static_cast<uint32>(src.SrcBlend);
+			dst.DestBlend		= static_cast<uint32>(src.DestBlend);
+			dst.BlendOp			= static_cast<uint32>(src.BlendOp);
+			dst.SrcBlendAlpha	= static_cast<uint32>(src.SrcBlendAlpha);
+			dst.DestBlendAlpha	= static_cast<uint32>(src.DestBlendAlpha);
+			dst.BlendOpAlpha	= static_cast<uint32>(src.BlendOpAlpha);
+			dst.LogicOp			= static_cast<uint32>(src.LogicOp);
+			dst.WriteMask		= src.RenderTargetWriteMask;
+
+			desc.RenderTargetFormats.at(i) = static_cast<uint32>(Desc.RTVFormats[i]);
+		}
+
+		desc.SampleMask			= Desc.SampleMask;
+		desc.PrimitiveTopology	= static_cast<uint32>(Desc.PrimitiveTopologyType);
+		desc.RenderTargetCount	= Desc.NumRenderTargets;
+		desc.DepthFormat		= static_cast<uint32>(Desc.DSVFormat);
+		desc.SampleCount		= Desc.SampleDesc.Count;
+		desc.SampleQuality		= Desc.SampleDesc.Quality;
+
+		return desc;
+	}
+
+	PipelineStateDesc D3D12PipelineCache::ToPipelineDesc(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, uint64 RootSignature)
+	{
+		PipelineStateDesc desc{};
+		desc.Type			= PipelineType::eCompute;
+		desc.RootSignature	= RootSignature;
+		desc.Shaders.at(static_cast<usize>(PipelineShaderSlot::eCompute)) = HashShader(Desc.CS);
+
+		return desc;
+	}
+
+} // namespace lde
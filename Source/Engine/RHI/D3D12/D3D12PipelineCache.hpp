@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+	RHI/D3D12/D3D12PipelineCache.hpp
+	Pipeline State Objects deduplicated by canonical hash and persisted through a Pipeline Library.
+*/
+
+#include <AgilitySDK/d3d12.h>
+#include "Core/CoreMinimal.hpp"
+#include "Core/FileSystem.hpp"
+#include "RHI/PipelineCache.hpp"
+#include "RHI/PipelineState.hpp"
+#include <vector>
+
+namespace lde
+{
+	class D3D12Device;
+	class D3D12RootSignature;
+
+	/**
+	 * @brief Pipelines are keyed by PipelineKey of their description, where shaders and Root Signature are
+	 * represented by hashes of their contents; equal descriptions share a single PSO.
+	 * New pipelines are stored in a Pipeline Library that is serialized to disk on release,
+	 * so later runs skip driver compilation. Library built by another driver or adapter is discarded.
+	 */
+	class D3D12PipelineCache
+	{
+	public:
+		D3D12PipelineCache(D3D12Device* pDevice, Filepath Path);
+		D3D12PipelineCache(const D3D12PipelineCache&) = delete;
+		D3D12PipelineCache& operator=(const D3D12PipelineCache&) = delete;
+		~D3D12PipelineCache();
+
+		HRESULT GetGraphics(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, D3D12RootSignature* pRootSignature, Ref<ID3D12PipelineState>& OutPipeline);
+		HRESULT GetCompute(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, D3D12RootSignature* pRootSignature, Ref<ID3D12PipelineState>& OutPipeline);
+
+		/// @brief Writes Pipeline Library to disk if anything was stored since it was loaded.
+		void Save();
+
+		const PipelineCacheStats& GetStats() const { return m_Cache.GetStats(); }
+
+		static PipelineStateDesc ToPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, uint64 RootSignature);
+		static PipelineStateDesc ToPipelineDesc(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, uint64 RootSignature);
+
+	private:
+		void OpenLibrary();
+
+		/// @brief Wraps PipelineCache::Get with library calls; returns result of Create if it failed.
+		template<typename Desc, typename CreateFn, typename LoadFn>
+		HRESULT Get(const Desc& PipelineDesc, uint64 Key, Ref<ID3D12PipelineState>& OutPipeline, CreateFn&& Create, LoadFn&& Load);
+
+		D3D12Device*	m_Device = nullptr;
+		Filepath		m_Path;
+
+		Ref<ID3D12PipelineLibrary1> m_Library;
+		// Library reads from it for its whole lifetime.
+		std::vector<uint8>			m_LibraryData;
+
+		PipelineCache<Ref<ID3D12PipelineState>> m_Cache;
+
+	};
+} // namespace lde
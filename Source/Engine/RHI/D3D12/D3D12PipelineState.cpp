@@ -41,17 +41,15 @@ namespace lde
 
 		desc.SampleMask = UINT_MAX;
 
-		auto& shaderCompiler = ShaderCompiler::GetInstance();
-
-		// Compile and set Shaders
-		if (!m_VS.Filepath.empty())
+		// Wait for Shaders started in SetVS and SetPS
+		if (m_VS.Pending.valid())
 		{
-			OutPipeline.VertexShader = new Shader(shaderCompiler.Compile(m_VS.Filepath, ShaderStage::eVertex, m_VS.EntryPoint));
+			OutPipeline.VertexShader = new Shader(m_VS.Pending.get());
 			desc.VS = OutPipeline.VertexShader->Bytecode();
 		}
-		if (!m_PS.Filepath.empty())
+		if (m_PS.Pending.valid())
 		{
-			OutPipeline.PixelShader = new Shader(shaderCompiler.Compile(m_PS.Filepath, ShaderStage::ePixel, m_PS.EntryPoint));
+			OutPipeline.PixelShader = new Shader(m_PS.Pending.get());
 			desc.PS = OutPipeline.PixelShader->Bytecode();
 		}
 
@@ -78,19 +76,21 @@ namespace lde
 		OutPipeline.Type = PipelineType::eGraphics;
 		OutPipeline.RootSignature = pRootSignature;
 
-		return m_Device->GetDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&OutPipeline.PipelineState));
+		return m_Device->GetPipelineCache()->GetGraphics(desc, pRootSignature, OutPipeline.PipelineState);
 	}
 	
-	void D3D12PipelineStateBuilder::SetVS(std::string_view Filepath, std::wstring EntryPoint)
+	void D3D12PipelineStateBuilder::SetVS(std::string_view Filepath, std::wstring EntryPoint, std::vector<std::wstring> Defines)
 	{
 		m_VS.Filepath	= Filepath;
 		m_VS.EntryPoint	= EntryPoint;
+		m_VS.Pending	= ShaderCompiler::GetInstance().CompileAsync(std::string(Filepath), ShaderStage::eVertex, EntryPoint, std::move(Defines));
 	}
 	
-	void D3D12PipelineStateBuilder::SetPS(std::string_view Filepath, std::wstring EntryPoint)
+	void D3D12PipelineStateBuilder::SetPS(std::string_view Filepath, std::wstring EntryPoint, std::vector<std::wstring> Defines)
 	{
 		m_PS.Filepath	= Filepath;
 		m_PS.EntryPoint = EntryPoint;
+		m_PS.Pending	= ShaderCompiler::GetInstance().CompileAsync(std::string(Filepath), ShaderStage::ePixel, EntryPoint, std::move(Defines));
 	}
 
 	void D3D12PipelineStateBuilder::SetCullMode(CullMode eMode)
@@ -189,7 +189,20 @@ namespace lde
 	// Mesh
 	HRESULT D3D12MeshPipelineBuilder::Build(D3D12Device* pDevice, D3D12PipelineState& OutPipeline, D3D12RootSignature* pRootSignature)
 	{
-		
+		if (m_PendingAS.valid())
+		{
+			m_AmplificationShader = new Shader(m_PendingAS.get());
+		}
+		if (m_PendingMS.valid())
+		{
+			m_MeshShader = new Shader(m_PendingMS.get());
+		}
+		if (m_PendingPS.valid())
+		{
+			m_PixelShader = new Shader(m_PendingPS.get());
+		}
+
+
 		//if (m_AmplificationShader)
 		//{
 		//	Desc.AS = m_AmplificationShader->Bytecode();
@@ -236,17 +249,17 @@ namespace lde
 
 	void D3D12MeshPipelineBuilder::SetAS(std::string_view Filepath, std::wstring EntryPoint)
 	{
-		m_AmplificationShader = new Shader(ShaderCompiler::GetInstance().Compile(Filepath, ShaderStage::eAmplification, EntryPoint));
+		m_PendingAS = ShaderCompiler::GetInstance().CompileAsync(std::string(Filepath), ShaderStage::eAmplification, EntryPoint);
 	}
 
 	void D3D12MeshPipelineBuilder::SetMS(std::string_view Filepath, std::wstring EntryPoint)
 	{
-		m_MeshShader = new Shader(ShaderCompiler::GetInstance().Compile(Filepath, ShaderStage::eMesh, EntryPoint));
+		m_PendingMS = ShaderCompiler::GetInstance().CompileAsync(std::string(Filepath), ShaderStage::eMesh, EntryPoint);
 	}
 
 	void D3D12MeshPipelineBuilder::SetPS(std::string_view Filepath, std::wstring EntryPoint)
 	{
-		m_PixelShader = new Shader(ShaderCompiler::GetInstance().Compile(Filepath, ShaderStage::ePixel, EntryPoint));
+		m_PendingPS = ShaderCompiler::GetInstance().CompileAsync(std::string(Filepath), ShaderStage::ePixel, EntryPoint);
 	}
 
 
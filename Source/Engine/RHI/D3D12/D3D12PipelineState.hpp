@@ -3,7 +3,9 @@
 #include <AgilitySDK/d3d12.h>
 #include "Core/CoreMinimal.hpp"
 #include "Graphics/ShaderCompiler.hpp"
+#include "RHI/PipelineState.hpp"
 #include "RHI/Types.hpp"
+#include <future>
 #include <span>
 #include <vector>
 #include <AgilitySDK/d3dx12/d3dx12_pipeline_state_stream.h>
@@ -16,7 +18,7 @@ namespace lde
 	// TODO: Move RootSignature here, so PSO holds specific RS
 
 	/// @brief Hold PSO, type of pipeline and shaders.
-	struct D3D12PipelineState
+	struct D3D12PipelineState : public PipelineState
 	{
 		~D3D12PipelineState();
 	
@@ -35,6 +37,7 @@ namespace lde
 	};
 
 	// Graphics Pipeline State builder class.
+	// Shaders start compiling when set; Build waits for them.
 	class D3D12PipelineStateBuilder
 	{
 		
@@ -44,8 +47,8 @@ namespace lde
 	
 		HRESULT Build(D3D12PipelineState& OutPipeline, D3D12RootSignature* pRootSignature);
 
-		void SetVS(std::string_view Filepath, std::wstring EntryPoint = L"main");
-		void SetPS(std::string_view Filepath, std::wstring EntryPoint = L"main");
+		void SetVS(std::string_view Filepath, std::wstring EntryPoint = L"main", std::vector<std::wstring> Defines = {});
+		void SetPS(std::string_view Filepath, std::wstring EntryPoint = L"main", std::vector<std::wstring> Defines = {});
 
 		void SetCullMode(CullMode eMode);
 	
@@ -70,6 +73,7 @@ namespace lde
 		{
 			std::string_view	Filepath;
 			std::wstring		EntryPoint;
+			std::future<Shader>	Pending;
 		};
 		ShaderInfo m_VS{};
 		ShaderInfo m_PS{};
@@ -122,6 +126,11 @@ namespace lde
 		Shader* m_MeshShader = nullptr;
 		Shader* m_PixelShader = nullptr;
 
+		// Compiled since Set*; resolved by Build.
+		std::future<Shader> m_PendingAS;
+		std::future<Shader> m_PendingMS;
+		std::future<Shader> m_PendingPS;
+
 		D3D12_RASTERIZER_DESC m_RasterizerDesc{};
 		D3D12_CULL_MODE m_CullMode = D3D12_CULL_MODE_BACK;
 		D3D12_FILL_MODE m_FillMode = D3D12_FILL_MODE_SOLID;
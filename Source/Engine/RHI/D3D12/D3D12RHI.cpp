@@ -4,6 +4,7 @@
 #include <AgilitySDK/d3dx12/d3dx12.h>
 #include "Core/Logger.hpp"
 #include "Platform/Window.hpp"
+#include <cassert>
 
 namespace lde
 {
@@ -19,9 +20,18 @@ namespace lde
 
 	void D3D12RHI::BeginFrame()
 	{
+		// MoveToNextFrame already waited for this frame's fence.
+		Device->GetFrameAllocator()->BeginFrame(FRAME_INDEX, Device->GraphicsQueue->GetFence().Get()->GetCompletedValue());
+		Device->GetShaderResourceHeap()->BeginFrame(FRAME_INDEX, Device->GraphicsQueue->GetFence().Get()->GetCompletedValue());
+		Device->GetStateTracker()->ResetStats();
+		Device->GetWorkerCommandLists()->BeginFrame();
+
 		OpenList(Device->GetGfxCommandList());
 
-		TransitResource(SwapChain->GetBackbuffer(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		// Buffers created between frames are copied before anything of this frame uses them.
+		Device->GetUploadHeap()->Flush(Device->GetGfxCommandList());
+
+		TransitResource(SwapChain->GetBackbuffer(), D3D12_RESOURCE_STATE_RENDER_TARGET);
 		SetViewport();
 
 		Device->GetGfxCommandList()->Get()->SetDescriptorHeaps(1, Device->GetShaderResourceHeap()->GetAddressOf());
@@ -46,11 +56,16 @@ namespace lde
 
 	void D3D12RHI::Present(bool bVSync)
 	{
-		TransitResource(SwapChain->GetBackbuffer(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
-		
+		// Recorded along with the rest of queued transitions when the list is executed.
+		TransitResource(SwapChain->GetBackbuffer(), D3D12_RESOURCE_STATE_PRESENT);
+
 		Device->ExecuteCommandList(CommandType::eGraphics, false);
 		SwapChain->Present(bVSync);
 
+		// Value signaled for this frame in MoveToNextFrame.
+		Device->GetFrameAllocator()->EndFrame(Device->GraphicsQueue->GetFence().GetCurrentValue());
+		Device->GetShaderResourceHeap()->EndFrame(Device->GraphicsQueue->GetFence().GetCurrentValue());
+
 		MoveToNextFrame();
 	}
 
@@ -79,21 +94,13 @@ namespace lde
 		SwapChain.reset();
 
 		// Release all resources before destroying Allocator
-		for (auto& texture : Device->Textures)
-		{
-			texture->Release();
-			delete texture;
-		}
-		for (auto& buffer : Device->ConstantBuffers)
-		{
-			buffer->Release();
-			delete buffer;
-		}
-		for (auto& buffer : Device->Buffers)
-		{
-			buffer->Release();
-			delete buffer;
-		}
+		Device->Textures.ForEach([](D3D12Texture& Texture) { Texture.Release(); });
+		Device->ConstantBuffers.ForEach([](D3D12ConstantBuffer& Buffer) { Buffer.Release(); });
+		Device->Buffers.ForEach([](D3D12Buffer& Buffer) { Buffer.Release(); });
+
+		Device->Textures.Clear();
+		Device->ConstantBuffers.Clear();
+		Device->Buffers.Clear();
 
 		SAFE_RELEASE(D3D12Memory::Allocator);
 		Device.reset();
@@ -157,6 +164,7 @@ namespace lde
 
 		const auto& depthHandle = SceneDepth->DSV().GetCpuHandle();
 
+		FlushBarriers();
 		Device->GetGfxCommandList()->Get()->OMSetRenderTargets(1, &rtvHandle, FALSE, &depthHandle);
 	}
 
@@ -165,6 +173,7 @@ namespace lde
 		D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = SwapChain->RTVHeap()->CpuStartHandle();
 		rtvHandle.ptr += static_cast<uint64>(FRAME_INDEX * SwapChain->RTVHeap()->GetDescriptorSize());
 		
+		FlushBarriers();
 		Device->GetGfxCommandList()->Get()->ClearRenderTargetView(rtvHandle, ClearColor.data(), 0, nullptr);
 
 	}
@@ -185,16 +194,19 @@ namespace lde
 
 	void D3D12RHI::SetRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE RtvCpuHandle, D3D12_CPU_DESCRIPTOR_HANDLE* DepthCpuHandle)
 	{
+		FlushBarriers();
 		Device->GetGfxCommandList()->Get()->OMSetRenderTargets(1, &RtvCpuHandle, FALSE, DepthCpuHandle);
 	}
 
 	void D3D12RHI::SetRenderTargets(std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& RtvCpuHandles, D3D12_CPU_DESCRIPTOR_HANDLE DepthCpuHandle)
 	{
+		FlushBarriers();
 		Device->GetGfxCommandList()->Get()->OMSetRenderTargets(static_cast<uint32>(RtvCpuHandles.size()), RtvCpuHandles.data(), FALSE, &DepthCpuHandle);
 	}
 
 	void D3D12RHI::ClearRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE RtvCpuHandle)
 	{
+		FlushBarriers();
 		Device->GetGfxCommandList()->Get()->ClearRenderTargetView(RtvCpuHandle, ClearColor.data(), 0, nullptr);
 	}
 
@@ -217,28 +229,35 @@ namespace lde
 
 	void D3D12RHI::TransitResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After)
 	{
-		D3D12_RESOURCE_BARRIER barrier{};
-		barrier.Type					= D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Flags					= D3D12_RESOURCE_BARRIER_FLAG_NONE;
-		barrier.Transition.pResource	= pResource;
-		barrier.Transition.StateBefore	= Before;
-		barrier.Transition.StateAfter	= After;
-		barrier.Transition.Subresource	= D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		auto* tracker = Device->GetStateTracker();
+
+		// Tracked state is authoritative; overriding it would hide a stale entry or a wrong Before.
+		if (tracker->IsTracked(pResource))
+		{
+			assert(tracker->GetState(pResource) == Before && "Before state doesn't match tracked state.");
+		}
+		else
+		{
+			tracker->Register(pResource, Before);
+		}
 
-		Device->GetGfxCommandList()->Get()->ResourceBarrier(1, &barrier);
+		tracker->Transition(pResource, After);
+		FlushBarriers();
 	}
 
 	void D3D12RHI::TransitResource(Ref<ID3D12Resource> pResource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After)
 	{
-		D3D12_RESOURCE_BARRIER barrier{};
-		barrier.Type					= D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Flags					= D3D12_RESOURCE_BARRIER_FLAG_NONE;
-		barrier.Transition.pResource	= pResource.Get();
-		barrier.Transition.StateBefore	= Before;
-		barrier.Transition.StateAfter	= After;
-		barrier.Transition.Subresource	= D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+		TransitResource(pResource.Get(), Before, After);
+	}
+
+	void D3D12RHI::TransitResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES After, uint32 Subresource)
+	{
+		Device->GetStateTracker()->Transition(pResource, After, Subresource);
+	}
 
-		Device->GetGfxCommandList()->Get()->ResourceBarrier(1, &barrier);
+	void D3D12RHI::FlushBarriers() const
+	{
+		Device->GetGfxCommandList()->FlushBarriers();
 	}
 
 	void D3D12RHI::UploadResource(ID3D12Resource* pDst, ID3D12Resource* pSrc, D3D12_SUBRESOURCE_DATA& Subresource)
@@ -272,7 +291,7 @@ namespace lde
 		Device->GetGfxCommandList()->Get()->IASetIndexBuffer(&view);
 	}
 
-	void D3D12RHI::BindIndexBuffer(D3D12_INDEX_BUFFER_VIEW& View) const
+	void D3D12RHI::BindIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& View) const
 	{
 		Device->GetGfxCommandList()->Get()->IASetIndexBuffer(&View);
 	}
@@ -300,7 +319,39 @@ namespace lde
 
 	void D3D12RHI::DrawIndexedInstanced(uint32 InstanceCount, uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) const
 	{
-		Device->GetGfxCommandList()->DrawIndexedInstanced(IndexCount, InstanceCount, BaseIndex, BaseVertex);
+		Device->GetGfxCommandList()->DrawIndexedInstanced(InstanceCount, IndexCount, BaseIndex, BaseVertex);
+	}
+
+	std::span<D3D12CommandList*> D3D12RHI::AcquireWorkerLists(uint32 Count, D3D12RootSignature* pRootSignature,
+		std::span<const D3D12_CPU_DESCRIPTOR_HANDLE> RtvCpuHandles, const D3D12_CPU_DESCRIPTOR_HANDLE* DepthCpuHandle) const
+	{
+		auto lists = Device->GetWorkerCommandLists()->Acquire(Count);
+
+		const auto viewport = SceneViewport->GetViewport();
+		const auto scissor  = SceneViewport->GetScissor();
+
+		for (auto* commandList : lists)
+		{
+			auto* list = commandList->Get();
+			list->SetDescriptorHeaps(1, Device->GetShaderResourceHeap()->GetAddressOf());
+			list->RSSetViewports(1, &viewport);
+			list->RSSetScissorRects(1, &scissor);
+			list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+			list->SetGraphicsRootSignature(pRootSignature->Get());
+			list->OMSetRenderTargets(static_cast<uint32>(RtvCpuHandles.size()), RtvCpuHandles.data(), FALSE, DepthCpuHandle);
+		}
+
+		return lists;
+	}
+
+	void D3D12RHI::ExecuteWorkerLists(std::span<D3D12CommandList*> Lists) const
+	{
+		Device->ExecuteWithWorkerLists(Lists);
+
+		auto* commandList = Device->GetGfxCommandList()->Get();
+		commandList->SetDescriptorHeaps(1, Device->GetShaderResourceHeap()->GetAddressOf());
+		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		SetViewport();
 	}
 
 	void D3D12RHI::BindConstantBuffer(ConstantBuffer* pConstBuffer, uint32 Slot)
@@ -308,4 +359,14 @@ namespace lde
 		Device->GetGfxCommandList()->BindConstantBuffer(Slot, ((D3D12ConstantBuffer*)pConstBuffer));
 	}
 
+	void D3D12RHI::BindConstantBuffer(D3D12_GPU_VIRTUAL_ADDRESS Address, uint32 Slot)
+	{
+		Device->GetGfxCommandList()->BindConstantBuffer(Slot, Address);
+	}
+
+	void D3D12RHI::BindShaderResource(D3D12_GPU_VIRTUAL_ADDRESS Address, uint32 Slot)
+	{
+		Device->GetGfxCommandList()->BindShaderResource(Slot, Address);
+	}
+
 }
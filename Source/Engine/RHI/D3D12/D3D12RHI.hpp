@@ -83,8 +83,17 @@ namespace lde
 		void SetRootSignature(D3D12RootSignature* pRootSignature) const;
 		void SetPipeline(D3D12PipelineState* pState) const;
 
+		// Explicit transition, recorded right away; resource's tracked state becomes After.
+		// Before must match tracked state; untracked resource is registered in Before.
 		void TransitResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After);
 		void TransitResource(Ref<ID3D12Resource> pResource, D3D12_RESOURCE_STATES Before, D3D12_RESOURCE_STATES After);
+		/**
+		 * @brief Queues transition of resource registered in Device's state tracker; before state is inferred.
+		 * Recorded with other queued transitions at next draw, render target bind or clear; or by FlushBarriers.
+		 */
+		void TransitResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES After, uint32 Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+		// Record queued transitions; needed before raw command list calls that depend on them.
+		void FlushBarriers() const;
 
 		void UploadResource(ID3D12Resource* pDst, ID3D12Resource* pSrc, D3D12_SUBRESOURCE_DATA& Subresource);
 		void UploadResource(ID3D12Resource** ppDst, ID3D12Resource** ppSrc, D3D12_SUBRESOURCE_DATA& Subresource);
@@ -94,15 +103,27 @@ namespace lde
 		void CopyResource(Ref<ID3D12Resource> ppDst, Ref<ID3D12Resource> ppSrc);
 
 		void BindIndexBuffer(Buffer* pIndexBuffer) const;
-		void BindIndexBuffer(D3D12_INDEX_BUFFER_VIEW& View) const;
+		void BindIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& View) const;
 		// For non-bindless only
 		void BindVertexBuffers(std::span<D3D12Buffer*> pIndexBuffers, uint32 StartSlot) const;
 		void BindConstantBuffer(ConstantBuffer* pConstBuffer, uint32 Slot);
+		void BindConstantBuffer(D3D12_GPU_VIRTUAL_ADDRESS Address, uint32 Slot);
+		void BindShaderResource(D3D12_GPU_VIRTUAL_ADDRESS Address, uint32 Slot);
 
 		void Draw(uint32 VertexCount) const;
 		void DrawIndexed(uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) const;
 		void DrawIndexedInstanced(uint32 InstanceCount, uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) const;
 
+		/**
+		 * @brief Opens worker lists for parallel recording of a pass and sets state each of them needs:
+		 * descriptor heap, viewport, topology, Root Signature and targets.
+		 * Barriers of the targets have to be queued or flushed on the Graphics command list beforehand.
+		 */
+		std::span<D3D12CommandList*> AcquireWorkerLists(uint32 Count, D3D12RootSignature* pRootSignature,
+			std::span<const D3D12_CPU_DESCRIPTOR_HANDLE> RtvCpuHandles, const D3D12_CPU_DESCRIPTOR_HANDLE* DepthCpuHandle = nullptr) const;
+		/// @brief Submits Graphics command list followed by Lists in given order; state set in BeginFrame is restored afterwards.
+		void ExecuteWorkerLists(std::span<D3D12CommandList*> Lists) const;
+
 
 	private:
 		
@@ -53,9 +53,13 @@ namespace lde
 	{
 		auto& shaderCompiler = ShaderCompiler::GetInstance();
 
-		Shaders.RayGen		= new Shader(shaderCompiler.Compile("Shaders/Raytracing/RayGen.hlsl", ShaderStage::eRaytracing, L"RayGen"));
-		Shaders.ClosestHit	= new Shader(shaderCompiler.Compile("Shaders/Raytracing/ClosestHit.hlsl", ShaderStage::eClosestHit, L"ClosestHit"));
-		Shaders.Miss		= new Shader(shaderCompiler.Compile("Shaders/Raytracing/Miss.hlsl", ShaderStage::eMiss, L"Miss"));
+		auto rayGen		= shaderCompiler.CompileAsync("Shaders/Raytracing/RayGen.hlsl", ShaderStage::eRaytracing, L"RayGen");
+		auto closestHit	= shaderCompiler.CompileAsync("Shaders/Raytracing/ClosestHit.hlsl", ShaderStage::eClosestHit, L"ClosestHit");
+		auto miss		= shaderCompiler.CompileAsync("Shaders/Raytracing/Miss.hlsl", ShaderStage::eMiss, L"Miss");
+
+		Shaders.RayGen		= new Shader(rayGen.get());
+		Shaders.ClosestHit	= new Shader(closestHit.get());
+		Shaders.Miss		= new Shader(miss.get());
 
 	}
 
@@ -398,8 +402,8 @@ namespace lde
 
 	void D3D12Raytracing::AddBLAS(Model* pModel)
 	{	
-		const auto vertexBuffer = m_Device->Buffers.at(pModel->GetMesh()->VertexBuffer);
-		const auto indexBuffer  = m_Device->Buffers.at(pModel->GetMesh()->IndexBuffer);
+		const auto vertexBuffer = m_Device->GetBuffer(pModel->GetMesh()->VertexBuffer);
+		const auto indexBuffer  = m_Device->GetBuffer(pModel->GetMesh()->IndexBuffer);
 		
 		D3D12RaytracingBLAS blas{};
 		
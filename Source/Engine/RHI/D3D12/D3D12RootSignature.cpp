@@ -2,6 +2,7 @@
 #include "D3D12RootSignature.hpp"
 #include "D3D12Device.hpp"
 #include "D3D12Utility.hpp"
+#include "RHI/PipelineState.hpp"
 
 namespace lde
 {
@@ -116,6 +117,8 @@ namespace lde
 		HRESULT result = pDevice->GetDevice()->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&m_RootSignature));
 		DX_CALL(result);
 
+		m_Hash = PipelineKey::HashBlob(signature->GetBufferPointer(), signature->GetBufferSize());
+
 		if (!DebugName.empty())
 		{
 			m_RootSignature->SetName(String::ToWide(DebugName).c_str());
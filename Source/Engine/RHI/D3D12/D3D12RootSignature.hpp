@@ -54,10 +54,14 @@ namespace lde
 		void Build(D3D12Device* pDevice, PipelineType eType, Shader* pShader, std::string DebugName = "");
 
 		void Release();
+
+		/// @return Hash of serialized Root Signature; identifies it in pipeline cache keys.
+		uint64 GetHash() const { return m_Hash; }
 	
 		PipelineType Type{};
 	private:
 		Ref<ID3D12RootSignature> m_RootSignature;
+		uint64 m_Hash = 0;
 
 		std::vector<D3D12_ROOT_PARAMETER1>		m_Parameters;
 		std::vector<D3D12_STATIC_SAMPLER_DESC1> m_StaticSamplers;
@@ -0,0 +1,105 @@
+#include "D3D12StateTracker.hpp"
+#include "D3D12CommandList.hpp"
+#include "Core/Logger.hpp"
+#include <AgilitySDK/d3dx12/d3dx12_core.h>
+#include <algorithm>
+
+namespace lde
+{
+	static_assert(ResourceStateTracker::AllSubresources == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+	static uint64 ToKey(ID3D12Resource* pResource)
+	{
+		return reinterpret_cast<uint64>(pResource);
+	}
+
+	void D3D12StateTracker::Register(ID3D12Resource* pResource, D3D12_RESOURCE_STATES State)
+	{
+		const auto desc = pResource->GetDesc();
+
+		uint32 subresources = 1;
+		if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+		{
+			const uint32 arraySize = (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) ? 1u : desc.DepthOrArraySize;
+
+			// Planar formats, i.e. D24S8 or D32S8, have a set of subresources per plane.
+			uint32 planes = 1;
+			Ref<ID3D12Device> device;
+			if (SUCCEEDED(pResource->GetDevice(IID_PPV_ARGS(&device))))
+			{
+				planes = std::max<uint32>(D3D12GetFormatPlaneCount(device.Get(), desc.Format), 1u);
+			}
+
+			subresources = desc.MipLevels * arraySize * planes;
+		}
+
+		m_Tracker.Register(ToKey(pResource), static_cast<uint32>(State), subresources);
+	}
+
+	void D3D12StateTracker::Forget(ID3D12Resource* pResource)
+	{
+		m_Tracker.Forget(ToKey(pResource));
+	}
+
+	bool D3D12StateTracker::IsTracked(ID3D12Resource* pResource) const
+	{
+		return m_Tracker.IsTracked(ToKey(pResource));
+	}
+
+	bool D3D12StateTracker::Transition(ID3D12Resource* pResource, D3D12_RESOURCE_STATES State, uint32 Subresource)
+	{
+		if (!m_Tracker.Transition(ToKey(pResource), static_cast<uint32>(State), Subresource))
+		{
+			LOG_WARN("Transition of untracked resource; Register it first.");
+			return false;
+		}
+
+		return true;
+	}
+
+	D3D12_RESOURCE_STATES D3D12StateTracker::GetState(ID3D12Resource* pResource, uint32 Subresource) const
+	{
+		return static_cast<D3D12_RESOURCE_STATES>(m_Tracker.GetState(ToKey(pResource), Subresource));
+	}
+
+	void D3D12StateTracker::Flush(D3D12CommandList* pCommandList)
+	{
+		if (!m_Tracker.HasPending())
+		{
+			return;
+		}
+
+		m_Transitions.clear();
+		m_Tracker.Flush(m_Transitions);
+
+		if (m_Transitions.empty())
+		{
+			return;
+		}
+
+		m_Barriers.clear();
+		m_Barriers.reserve(m_Transitions.size());
+
+		for (const auto& transition : m_Transitions)
+		{
+			D3D12_RESOURCE_BARRIER barrier{};
+			barrier.Type					= D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+			barrier.Flags					= D3D12_RESOURCE_BARRIER_FLAG_NONE;
+			barrier.Transition.pResource	= reinterpret_cast<ID3D12Resource*>(transition.Resource);
+			barrier.Transition.Subresource	= transition.Subresource;
+			barrier.Transition.StateBefore	= static_cast<D3D12_RESOURCE_STATES>(transition.Before);
+			barrier.Transition.StateAfter	= static_cast<D3D12_RESOURCE_STATES>(transition.After);
+			m_Barriers.push_back(barrier);
+		}
+
+		pCommandList->ResourceBarriers(m_Barriers);
+	}
+
+	void D3D12StateTracker::Reset()
+	{
+		m_Tracker.Reset();
+		m_Transitions.clear();
+		m_Barriers.clear();
+	}
+
+} // namespace lde
@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+	RHI/D3D12/D3D12StateTracker.hpp
+	Resource state tracking with barriers recorded in batches.
+*/
+
+#include <AgilitySDK/d3d12.h>
+#include "Core/CoreMinimal.hpp"
+#include "RHI/ResourceStateTracker.hpp"
+#include <vector>
+
+namespace lde
+{
+	class D3D12CommandList;
+
+	/**
+	 * @brief Device wide states of registered resources.
+	 * Transitions are queued and recorded as a single ResourceBarrier call by Flush,
+	 * which Command List does right before draws and dispatches, and Device before closing the list.
+	 */
+	class D3D12StateTracker
+	{
+	public:
+		/// @brief Resource is in State now; subresource count is taken from its desc, including every plane of its format.
+		void Register(ID3D12Resource* pResource, D3D12_RESOURCE_STATES State);
+
+		/// @brief Has to be called before resource is released, as its address may be reused by another resource.
+		void Forget(ID3D12Resource* pResource);
+
+		bool IsTracked(ID3D12Resource* pResource) const;
+
+		/**
+		 * @brief Queues transition into State; before state is inferred.
+		 * @return False if pResource isn't registered.
+		 */
+		bool Transition(ID3D12Resource* pResource, D3D12_RESOURCE_STATES State, uint32 Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+		/// @return State after pending transitions.
+		D3D12_RESOURCE_STATES GetState(ID3D12Resource* pResource, uint32 Subresource = 0) const;
+
+		/// @brief Records pending transitions in one ResourceBarrier call.
+		void Flush(D3D12CommandList* pCommandList);
+
+		bool HasPending() const { return m_Tracker.HasPending(); }
+
+		ResourceStateStats GetStats() const { return m_Tracker.GetStats(); }
+		void ResetStats() { m_Tracker.ResetStats(); }
+
+		void Reset();
+
+	private:
+		ResourceStateTracker m_Tracker;
+
+		std::vector<StateTransition>		m_Transitions;
+		std::vector<D3D12_RESOURCE_BARRIER> m_Barriers;
+
+	};
+} // namespace lde
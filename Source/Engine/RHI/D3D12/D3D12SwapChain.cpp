@@ -91,6 +91,8 @@ namespace lde
 			std::wstring debugName{ L"Backbuffer #" + std::to_wstring(i) };
 			m_Backbuffers.at(i).Get()->SetName(debugName.c_str());
 
+			m_Device->GetStateTracker()->Register(m_Backbuffers.at(i).Get(), D3D12_RESOURCE_STATE_PRESENT);
+
 			rtvHandle.ptr += m_DescriptorHeap->GetDescriptorSize();
 		}
 	}
@@ -99,6 +101,10 @@ namespace lde
 	{
 		for (uint32 i = 0; i < FRAME_COUNT; i++)
 		{
+			if (m_Backbuffers.at(i).Get())
+			{
+				m_Device->GetStateTracker()->Forget(m_Backbuffers.at(i).Get());
+			}
 			SAFE_RELEASE(m_Backbuffers.at(i));
 		}
 	}
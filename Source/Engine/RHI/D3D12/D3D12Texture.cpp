@@ -26,6 +26,7 @@ namespace lde
 	{
 		if (Texture.Get())
 		{
+			pGfx->Device->GetStateTracker()->Forget(Texture.Get());
 			SAFE_RELEASE(Texture);
 		}
 
@@ -54,6 +55,7 @@ namespace lde
 			D3D12_RESOURCE_STATE_GENERIC_READ,
 			&clearValue,
 			IID_PPV_ARGS(&Texture)));
+		pGfx->Device->GetStateTracker()->Register(Texture.Get(), D3D12_RESOURCE_STATE_GENERIC_READ);
 
 		if (DebugName.empty())
 		{
@@ -76,6 +78,7 @@ namespace lde
 	{
 		if (Texture.Get())
 		{
+			pGfx->Device->GetStateTracker()->Forget(Texture.Get());
 			SAFE_RELEASE(Texture);
 		}
 
@@ -103,6 +106,7 @@ namespace lde
 			D3D12_RESOURCE_STATE_GENERIC_READ,
 			&clearValue,
 			IID_PPV_ARGS(&Texture)));
+		pGfx->Device->GetStateTracker()->Register(Texture.Get(), D3D12_RESOURCE_STATE_GENERIC_READ);
 
 		Texture->SetName(String::ToWide(DebugName).c_str());
 
@@ -117,6 +121,7 @@ namespace lde
 	{
 		if (Texture.Get())
 		{
+			m_Gfx->Device->GetStateTracker()->Forget(Texture.Get());
 			SAFE_RELEASE(Texture);
 		}
 
@@ -144,6 +149,7 @@ namespace lde
 			D3D12_RESOURCE_STATE_GENERIC_READ,
 			&clearValue,
 			IID_PPV_ARGS(Texture.GetAddressOf())));
+		m_Gfx->Device->GetStateTracker()->Register(Texture.Get(), D3D12_RESOURCE_STATE_GENERIC_READ);
 
 		Texture->SetName(L"Light Pass Render Texture");
 
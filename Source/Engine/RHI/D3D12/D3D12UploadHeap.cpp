@@ -0,0 +1,128 @@
+#include "D3D12UploadHeap.hpp"
+#include "D3D12Buffer.hpp"
+#include "D3D12CommandList.hpp"
+#include "D3D12Device.hpp"
+#include "D3D12Queue.hpp"
+#include "D3D12Utility.hpp"
+#include "Core/Logger.hpp"
+#include <cstring>
+
+namespace lde
+{
+	D3D12UploadHeap::D3D12UploadHeap(D3D12Device* pDevice, uint64 Size)
+	{
+		m_Queue.Initialize(Size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+		const auto desc = CreateBufferDesc(m_Queue.GetAllocator().GetSize());
+
+		DX_CALL(pDevice->GetDevice()->CreateCommittedResource(
+			&D3D12Utility::HeapUpload,
+			D3D12_HEAP_FLAG_NONE,
+			&desc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(&m_Buffer)));
+		SET_D3D12_NAME(m_Buffer, "D3D12 Upload Heap");
+
+		// Persistent mapping
+		const D3D12_RANGE readRange(0, 0);
+		DX_CALL(m_Buffer->Map(0, &readRange, reinterpret_cast<void**>(&m_pData)));
+
+		DX_CALL(pDevice->GetDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_Fence)));
+	}
+
+	D3D12UploadHeap::~D3D12UploadHeap()
+	{
+		Release();
+	}
+
+	bool D3D12UploadHeap::QueueBufferUpload(Ref<ID3D12Resource> Destination, const void* pData, uint64 Size, D3D12_RESOURCE_STATES State)
+	{
+		Retire();
+
+		const uint64 offset = m_Queue.Queue(reinterpret_cast<uint64>(Destination.Get()), Size, static_cast<uint32>(State));
+		if (offset == RingAllocator::InvalidOffset)
+		{
+			return false;
+		}
+
+		if (pData)
+		{
+			std::memcpy(m_pData + offset, pData, Size);
+		}
+
+		m_Destinations.push_back(std::move(Destination));
+
+		return true;
+	}
+
+	void D3D12UploadHeap::Flush(D3D12CommandList* pCommandList)
+	{
+		if (!m_Queue.HasQueuedCopies())
+		{
+			return;
+		}
+
+		m_Copies.clear();
+		m_Queue.Flush(m_Copies);
+
+		m_Barriers.clear();
+		m_Barriers.reserve(m_Copies.size());
+
+		for (const auto& copy : m_Copies)
+		{
+			auto* destination = reinterpret_cast<ID3D12Resource*>(copy.Destination);
+			pCommandList->Get()->CopyBufferRegion(destination, 0, m_Buffer.Get(), copy.Offset, copy.Size);
+
+			D3D12_RESOURCE_BARRIER barrier{};
+			barrier.Type					= D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+			barrier.Transition.pResource	= destination;
+			barrier.Transition.Subresource	= D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+			barrier.Transition.StateBefore	= D3D12_RESOURCE_STATE_COPY_DEST;
+			barrier.Transition.StateAfter	= static_cast<D3D12_RESOURCE_STATES>(copy.State);
+			m_Barriers.push_back(barrier);
+		}
+
+		pCommandList->ResourceBarriers(m_Barriers);
+
+		// Command list holds its own references once recorded.
+		m_Destinations.clear();
+	}
+
+	void D3D12UploadHeap::Signal(D3D12Queue* pQueue)
+	{
+		// Copies queued after the last Flush share the open batch; whole batch gets tagged by a later Signal instead.
+		if (!m_Queue.NeedsSignal())
+		{
+			return;
+		}
+
+		++m_FenceValue;
+		DX_CALL(pQueue->Get()->Signal(m_Fence.Get(), m_FenceValue));
+		m_Queue.Submit(m_FenceValue);
+	}
+
+	void D3D12UploadHeap::Retire()
+	{
+		if (m_Queue.GetAllocator().GetPendingBatches() > 0)
+		{
+			m_Queue.Retire(m_Fence->GetCompletedValue());
+		}
+	}
+
+	void D3D12UploadHeap::Release()
+	{
+		m_Queue.Clear();
+		m_Destinations.clear();
+
+		if (m_Buffer.Get() && m_pData)
+		{
+			m_Buffer->Unmap(0, nullptr);
+			m_pData = nullptr;
+		}
+
+		SAFE_RELEASE(m_Buffer);
+		SAFE_RELEASE(m_Fence);
+	}
+
+} // namespace lde
@@ -0,0 +1,75 @@
+#pragma once
+
+/*
+	RHI/D3D12/D3D12UploadHeap.hpp
+	Batched buffer uploads staged through a single persistently mapped ring buffer.
+*/
+
+#include <AgilitySDK/d3d12.h>
+#include "Core/CoreMinimal.hpp"
+#include "RHI/UploadQueue.hpp"
+#include <vector>
+
+namespace lde
+{
+	class D3D12CommandList;
+	class D3D12Device;
+	class D3D12Queue;
+
+	/**
+	 * @brief Data is copied into the ring right away; copies and barriers are queued
+	 * and recorded at once by Flush, either when Device executes Graphics command list or at the start of a frame.
+	 * Ring space is given back when GPU signals the fence value of the batch that used it.
+	 * Copies queued while a frame is being recorded are executed at the end of that frame,
+	 * so such buffers are usable from the next frame on.
+	 */
+	class D3D12UploadHeap
+	{
+	public:
+		D3D12UploadHeap(D3D12Device* pDevice, uint64 Size);
+		D3D12UploadHeap(const D3D12UploadHeap&) = delete;
+		D3D12UploadHeap& operator=(const D3D12UploadHeap&) = delete;
+		~D3D12UploadHeap();
+
+		/**
+		 * @brief Stages data and queues its copy into Destination, followed by transition to given state.
+		 * @param Destination Buffer in COPY_DEST state. Kept alive until copy is recorded.
+		 * @param pData
+		 * @param Size
+		 * @param State State of Destination after the copy.
+		 * @return False if ring has no room left; list has to be executed before retrying.
+		 */
+		bool QueueBufferUpload(Ref<ID3D12Resource> Destination, const void* pData, uint64 Size, D3D12_RESOURCE_STATES State);
+
+		/// @brief Records queued copies, then all their barriers in a single call.
+		void Flush(D3D12CommandList* pCommandList);
+
+		/// @brief Tags flushed copies with a new fence value. Called after their command list was submitted to given queue.
+		void Signal(D3D12Queue* pQueue);
+
+		/// @brief Frees ring space of batches GPU is done with.
+		void Retire();
+
+		bool HasQueuedCopies() const { return m_Queue.HasQueuedCopies(); }
+
+		const RingAllocator& GetAllocator() const { return m_Queue.GetAllocator(); }
+		const UploadQueueStats& GetStats() const { return m_Queue.GetStats(); }
+
+		void Release();
+
+	private:
+		Ref<ID3D12Resource> m_Buffer;
+		uint8*				m_pData			= nullptr;
+
+		Ref<ID3D12Fence>	m_Fence;
+		uint64				m_FenceValue	= 0;
+
+		UploadQueue m_Queue;
+		// Queued destinations, in queue order; keeps them alive until their copies are recorded.
+		std::vector<Ref<ID3D12Resource>>	m_Destinations;
+
+		std::vector<BufferCopy>				m_Copies;
+		std::vector<D3D12_RESOURCE_BARRIER> m_Barriers;
+
+	};
+} // namespace lde
@@ -0,0 +1,215 @@
+#include "D3D12Uploader.hpp"
+#include "D3D12Buffer.hpp"
+#include "D3D12CommandList.hpp"
+#include "D3D12Device.hpp"
+#include "D3D12Queue.hpp"
+#include "D3D12Utility.hpp"
+#include "Core/Logger.hpp"
+#include <cstring>
+
+namespace lde
+{
+	D3D12Uploader::D3D12Uploader(D3D12Device* pDevice, uint64 StagingSize)
+		: m_Device(pDevice)
+	{
+		m_Queue = std::make_unique<D3D12Queue>(pDevice, CommandType::eUpload, "D3D12 Copy Queue");
+
+		// Created closed; opened by Begin with an allocator from the pool.
+		DX_CALL(pDevice->GetDevice()->CreateCommandList1(pDevice->NodeMask, D3D12_COMMAND_LIST_TYPE_COPY, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&m_CommandList)));
+		SET_D3D12_NAME(m_CommandList, "D3D12 Copy Command List");
+
+		DX_CALL(pDevice->GetDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_Fence)));
+		m_FenceEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+		m_Ring.Initialize(StagingSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+		const auto desc = CreateBufferDesc(m_Ring.GetSize());
+
+		DX_CALL(pDevice->GetDevice()->CreateCommittedResource(
+			&D3D12Utility::HeapUpload,
+			D3D12_HEAP_FLAG_NONE,
+			&desc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(&m_Staging)));
+		SET_D3D12_NAME(m_Staging, "D3D12 Copy Queue Staging");
+
+		// Persistent mapping
+		const D3D12_RANGE readRange(0, 0);
+		DX_CALL(m_Staging->Map(0, &readRange, reinterpret_cast<void**>(&m_pStagingData)));
+	}
+
+	D3D12Uploader::~D3D12Uploader()
+	{
+		Release();
+	}
+
+	void D3D12Uploader::Begin()
+	{
+		if (m_bOpen)
+		{
+			return;
+		}
+
+		Retire();
+
+		if (!m_Submissions.empty() && IsComplete(m_Submissions.front().FenceValue))
+		{
+			m_Open.Allocator = std::move(m_Submissions.front().Allocator);
+			m_Submissions.pop_front();
+			m_Open.Allocator->Reset();
+		}
+		else
+		{
+			m_Open.Allocator = std::make_unique<D3D12CommandAllocator>(m_Device, CommandType::eUpload);
+		}
+
+		DX_CALL(m_CommandList->Reset(m_Open.Allocator->Get(), nullptr));
+		m_bOpen = true;
+	}
+
+	bool D3D12Uploader::QueueBufferUpload(Ref<ID3D12Resource> Destination, const void* pData, uint64 Size)
+	{
+		if (!m_bOpen || Size > m_Ring.GetSize())
+		{
+			return false;
+		}
+
+		uint64 offset = m_Ring.Allocate(Size);
+		if (offset == RingAllocator::InvalidOffset)
+		{
+			// Hand queued copies over to GPU, then wait for the oldest batches until there is room.
+			Submit();
+			Begin();
+
+			while (offset == RingAllocator::InvalidOffset && m_Ring.GetPendingBatches() > 0)
+			{
+				Wait(m_Ring.GetOldestFenceValue());
+				Retire();
+				offset = m_Ring.Allocate(Size);
+			}
+
+			if (offset == RingAllocator::InvalidOffset)
+			{
+				return false;
+			}
+		}
+
+		if (pData)
+		{
+			std::memcpy(m_pStagingData + offset, pData, Size);
+		}
+
+		m_CommandList->CopyBufferRegion(Destination.Get(), 0, m_Staging.Get(), offset, Size);
+		++m_QueuedCopies;
+
+		return true;
+	}
+
+	uint64 D3D12Uploader::Submit()
+	{
+		if (!m_bOpen)
+		{
+			return GetLastSubmittedValue();
+		}
+
+		m_bOpen = false;
+		DX_CALL(m_CommandList->Close());
+
+		if (m_QueuedCopies == 0)
+		{
+			// Nothing was recorded; allocator can be reused right away.
+			m_Open.FenceValue = 0;
+			m_Submissions.push_front(std::move(m_Open));
+			return GetLastSubmittedValue();
+		}
+
+		ID3D12CommandList* commandLists[] = { m_CommandList.Get() };
+		m_Queue->Get()->ExecuteCommandLists(1, commandLists);
+
+		const uint64 value = m_NextValue++;
+		DX_CALL(m_Queue->Get()->Signal(m_Fence.Get(), value));
+
+		m_Ring.Submit(value);
+
+		m_Open.FenceValue = value;
+		m_Submissions.push_back(std::move(m_Open));
+		m_QueuedCopies = 0;
+
+		return value;
+	}
+
+	bool D3D12Uploader::IsComplete(uint64 FenceValue)
+	{
+		return FenceValue <= GetCompletedValue();
+	}
+
+	void D3D12Uploader::Wait(uint64 FenceValue)
+	{
+		if (IsComplete(FenceValue))
+		{
+			return;
+		}
+
+		DX_CALL(m_Fence->SetEventOnCompletion(FenceValue, m_FenceEvent));
+		::WaitForSingleObject(m_FenceEvent, INFINITE);
+	}
+
+	void D3D12Uploader::WaitOnQueue(D3D12Queue* pQueue, uint64 FenceValue)
+	{
+		if (IsComplete(FenceValue))
+		{
+			return;
+		}
+
+		DX_CALL(pQueue->Get()->Wait(m_Fence.Get(), FenceValue));
+	}
+
+	uint64 D3D12Uploader::GetCompletedValue()
+	{
+		return m_Fence->GetCompletedValue();
+	}
+
+	void D3D12Uploader::Retire()
+	{
+		if (m_Ring.GetPendingBatches() > 0)
+		{
+			m_Ring.Retire(GetCompletedValue());
+		}
+	}
+
+	void D3D12Uploader::Release()
+	{
+		if (!m_Fence.Get())
+		{
+			return;
+		}
+
+		if (m_bOpen)
+		{
+			Submit();
+		}
+		Wait(GetLastSubmittedValue());
+
+		m_Submissions.clear();
+		m_Open.Allocator.reset();
+
+		if (m_Staging.Get() && m_pStagingData)
+		{
+			m_Staging->Unmap(0, nullptr);
+			m_pStagingData = nullptr;
+		}
+
+		SAFE_RELEASE(m_Staging);
+		SAFE_RELEASE(m_CommandList);
+		SAFE_RELEASE(m_Fence);
+		m_Queue.reset();
+
+		if (m_FenceEvent)
+		{
+			::CloseHandle(m_FenceEvent);
+			m_FenceEvent = nullptr;
+		}
+	}
+
+} // namespace lde
@@ -0,0 +1,105 @@
+#pragma once
+
+/*
+	RHI/D3D12/D3D12Uploader.hpp
+	Buffer uploads on a dedicated Copy Queue, independent of Graphics Queue.
+*/
+
+#include <AgilitySDK/d3d12.h>
+#include "Core/CoreMinimal.hpp"
+#include "RHI/RingAllocator.hpp"
+#include <deque>
+#include <memory>
+
+namespace lde
+{
+	class D3D12CommandAllocator;
+	class D3D12Device;
+	class D3D12Queue;
+
+	/**
+	 * @brief Records copies between Begin() and Submit() into its own command list.
+	 * Every submitted batch gets next value of a monotonically increasing fence,
+	 * which consumers wait for either on GPU (WaitOnQueue) or by polling on CPU (IsComplete).
+	 * Buffers copied here decay to COMMON state and are implicitly promoted on first use on Graphics Queue,
+	 * so no barriers are recorded.
+	 */
+	class D3D12Uploader
+	{
+	public:
+		/**
+		 * @param pDevice
+		 * @param StagingSize Size of upload memory copies are staged in.
+		 */
+		D3D12Uploader(D3D12Device* pDevice, uint64 StagingSize);
+		D3D12Uploader(const D3D12Uploader&) = delete;
+		D3D12Uploader& operator=(const D3D12Uploader&) = delete;
+		~D3D12Uploader();
+
+		/// @brief Opens new batch. Copies go through Graphics Queue while no batch is open.
+		void Begin();
+
+		/**
+		 * @brief Stages data and records copy into Destination.
+		 * Submits the batch and waits for older ones if staging memory runs out.
+		 * @param Destination Buffer in COMMON or COPY_DEST state.
+		 * @return False if no batch is open or data can't fit staging memory at all.
+		 */
+		bool QueueBufferUpload(Ref<ID3D12Resource> Destination, const void* pData, uint64 Size);
+
+		/**
+		 * @brief Closes and executes open batch.
+		 * @return Fence value signaled once its copies are done; last submitted value if batch was empty.
+		 */
+		uint64 Submit();
+
+		bool IsOpen() const { return m_bOpen; }
+
+		/// @brief CPU polling; doesn't block.
+		bool IsComplete(uint64 FenceValue);
+
+		/// @brief Blocks CPU until given value is reached.
+		void Wait(uint64 FenceValue);
+
+		/// @brief Makes work submitted to given queue afterwards wait on GPU for given value. Doesn't block CPU.
+		void WaitOnQueue(D3D12Queue* pQueue, uint64 FenceValue);
+
+		uint64 GetCompletedValue();
+		uint64 GetLastSubmittedValue() const { return m_NextValue - 1; }
+
+		D3D12Queue* GetQueue() { return m_Queue.get(); }
+		const RingAllocator& GetAllocator() const { return m_Ring; }
+
+		void Release();
+
+	private:
+		/// @brief Frees staging memory and command allocators of finished batches.
+		void Retire();
+
+		D3D12Device* m_Device = nullptr;
+
+		std::unique_ptr<D3D12Queue>	m_Queue;
+		Ref<ID3D12GraphicsCommandList> m_CommandList;
+
+		struct Submission
+		{
+			std::unique_ptr<D3D12CommandAllocator> Allocator;
+			uint64 FenceValue = 0;
+		};
+
+		// Allocators of submitted batches, oldest first; reused once their fence value is reached.
+		std::deque<Submission>	m_Submissions;
+		Submission				m_Open;
+		bool					m_bOpen			= false;
+		uint32					m_QueuedCopies	= 0;
+
+		Ref<ID3D12Fence>	m_Fence;
+		::HANDLE			m_FenceEvent	= nullptr;
+		uint64				m_NextValue		= 1;
+
+		Ref<ID3D12Resource> m_Staging;
+		uint8*				m_pStagingData	= nullptr;
+		RingAllocator		m_Ring;
+
+	};
+} // namespace lde
@@ -0,0 +1,201 @@
+#include "DescriptorAllocator.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace lde
+{
+	DescriptorAllocator::DescriptorAllocator(uint32 Capacity, uint32 Reserved)
+	{
+		Initialize(Capacity, Reserved);
+	}
+
+	void DescriptorAllocator::Initialize(uint32 Capacity, uint32 Reserved)
+	{
+		assert(Reserved <= Capacity);
+
+		m_Capacity	= Capacity;
+		m_Reserved	= Reserved;
+
+		m_Generations.assign(Capacity, 0);
+		m_Counts.assign(Capacity, 0);
+
+		m_FailedAllocations = 0;
+		m_StaleFrees		= 0;
+		m_Peak				= 0;
+
+		Reset();
+	}
+
+	DescriptorRange DescriptorAllocator::Allocate(uint32 Count)
+	{
+		if (Count == 0)
+		{
+			return {};
+		}
+
+		uint32 index = DescriptorRange::InvalidIndex;
+
+		if (Count == 1 && !m_Singles.empty())
+		{
+			index = m_Singles.back();
+			m_Singles.pop_back();
+		}
+		else
+		{
+			auto it = m_FreeBySize.lower_bound({ Count, 0 });
+			if (it == m_FreeBySize.end() && !m_Singles.empty())
+			{
+				FlushSingles();
+				it = m_FreeBySize.lower_bound({ Count, 0 });
+			}
+
+			if (it == m_FreeBySize.end())
+			{
+				m_FailedAllocations++;
+				return {};
+			}
+
+			const auto [size, start] = *it;
+			EraseFree(m_FreeByIndex.find(start));
+
+			// Remainder stays where it was, so the range doesn't move in the heap.
+			if (size > Count)
+			{
+				InsertFree(start + Count, size - Count);
+			}
+
+			index = start;
+		}
+
+		m_Counts.at(index) = Count;
+		m_Used += Count;
+		m_Peak = std::max(m_Peak, m_Used);
+
+		return DescriptorRange{ index, Count, m_Generations.at(index) };
+	}
+
+	bool DescriptorAllocator::Free(const DescriptorRange& Range)
+	{
+		if (!IsAlive(Range))
+		{
+			m_StaleFrees++;
+			return false;
+		}
+
+		m_Generations.at(Range.Index)++;
+		m_Counts.at(Range.Index) = 0;
+		m_Used -= Range.Count;
+
+		if (Range.Count == 1)
+		{
+			m_Singles.push_back(Range.Index);
+		}
+		else
+		{
+			InsertFree(Range.Index, Range.Count);
+		}
+
+		return true;
+	}
+
+	void DescriptorAllocator::Reset()
+	{
+		m_FreeByIndex.clear();
+		m_FreeBySize.clear();
+		m_Singles.clear();
+
+		for (uint32 i = 0; i < m_Capacity; ++i)
+		{
+			if (m_Counts.at(i) != 0)
+			{
+				m_Generations.at(i)++;
+				m_Counts.at(i) = 0;
+			}
+		}
+
+		m_Used = 0;
+
+		if (m_Capacity > m_Reserved)
+		{
+			InsertFree(m_Reserved, m_Capacity - m_Reserved);
+		}
+	}
+
+	bool DescriptorAllocator::IsAlive(const DescriptorRange& Range) const
+	{
+		return Range.Index < m_Capacity
+			&& Range.Count != 0
+			&& m_Counts.at(Range.Index) == Range.Count
+			&& m_Generations.at(Range.Index) == Range.Generation;
+	}
+
+	DescriptorAllocatorStats DescriptorAllocator::GetStats() const
+	{
+		DescriptorAllocatorStats stats{};
+		stats.Capacity	= m_Capacity;
+		stats.Used		= m_Used;
+		stats.Peak		= m_Peak;
+		stats.FreeRanges = static_cast<uint32>(m_FreeByIndex.size() + m_Singles.size());
+		stats.FailedAllocations = m_FailedAllocations;
+		stats.StaleFrees = m_StaleFrees;
+
+		if (!m_FreeBySize.empty())
+		{
+			stats.LargestFreeRange = m_FreeBySize.rbegin()->first;
+		}
+		else if (!m_Singles.empty())
+		{
+			stats.LargestFreeRange = 1;
+		}
+
+		const uint32 free = m_Capacity - m_Reserved - m_Used;
+		if (free > 0)
+		{
+			stats.Fragmentation = 1.0f - static_cast<float>(stats.LargestFreeRange) / static_cast<float>(free);
+		}
+
+		return stats;
+	}
+
+	void DescriptorAllocator::InsertFree(uint32 Index, uint32 Count)
+	{
+		auto next = m_FreeByIndex.lower_bound(Index);
+
+		if (next != m_FreeByIndex.end() && Index + Count == next->first)
+		{
+			Count += next->second;
+			next = std::next(next);
+			EraseFree(std::prev(next));
+		}
+
+		if (next != m_FreeByIndex.begin())
+		{
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == Index)
+			{
+				Index = prev->first;
+				Count += prev->second;
+				EraseFree(prev);
+			}
+		}
+
+		m_FreeByIndex.emplace_hint(next, Index, Count);
+		m_FreeBySize.emplace(Count, Index);
+	}
+
+	void DescriptorAllocator::EraseFree(std::map<uint32, uint32>::iterator It)
+	{
+		m_FreeBySize.erase({ It->second, It->first });
+		m_FreeByIndex.erase(It);
+	}
+
+	void DescriptorAllocator::FlushSingles()
+	{
+		for (auto index : m_Singles)
+		{
+			InsertFree(index, 1);
+		}
+		m_Singles.clear();
+	}
+
+} // namespace lde
@@ -0,0 +1,109 @@
+#pragma once
+
+/*
+	RHI/DescriptorAllocator.hpp
+	API agnostic free-list allocator for descriptor heap slots.
+	Operates on indices only; backend owns the heap and writes the descriptors.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <map>
+#include <set>
+#include <vector>
+
+namespace lde
+{
+	/// @brief Contiguous range of slots. Generation of its first slot tells whether range is still alive.
+	struct DescriptorRange
+	{
+		static constexpr uint32 InvalidIndex = UINT32_MAX;
+
+		uint32 Index		= InvalidIndex;
+		uint32 Count		= 0;
+		uint32 Generation	= 0;
+
+		bool IsValid() const { return Index != InvalidIndex; }
+	};
+
+	struct DescriptorAllocatorStats
+	{
+		uint32 Capacity		= 0;
+		uint32 Used			= 0;
+		uint32 Peak			= 0;
+		// Separate free ranges, single slots waiting for reuse included.
+		uint32 FreeRanges	= 0;
+		uint32 LargestFreeRange = 0;
+		uint32 FailedAllocations = 0;
+		// Frees of ranges that were already freed or reset.
+		uint32 StaleFrees	= 0;
+		// 0 when all free slots are contiguous, close to 1 when they're scattered.
+		float Fragmentation = 0.0f;
+	};
+
+	/**
+	 * @brief Hands out slots of fixed size heap.
+	 * Single slots are reused LIFO in O(1); ranges are taken best-fit from free list ordered by index,
+	 * where freed neighbours merge back into one range.
+	 * Every free bumps generation of range's first slot, so handles kept past their free are detected.
+	 */
+	class DescriptorAllocator
+	{
+	public:
+		DescriptorAllocator() = default;
+		DescriptorAllocator(uint32 Capacity, uint32 Reserved = 0);
+
+		/**
+		 * @brief Drops every allocation.
+		 * @param Reserved Slots at the start of the heap that are never handed out.
+		 */
+		void Initialize(uint32 Capacity, uint32 Reserved = 0);
+
+		/// @return Invalid range if no free range is large enough.
+		DescriptorRange Allocate(uint32 Count = 1);
+
+		/**
+		 * @brief Returns range to the free list. GPU must not be using its slots anymore.
+		 * @return False if Range was already freed; nothing is freed then.
+		 */
+		bool Free(const DescriptorRange& Range);
+
+		/// @brief Frees every allocation at once; every range handed out so far becomes stale.
+		void Reset();
+
+		/// @return True if Range was allocated and not freed since.
+		bool IsAlive(const DescriptorRange& Range) const;
+
+		uint32 GetCapacity()	const { return m_Capacity; }
+		uint32 GetUsed()		const { return m_Used; }
+
+		DescriptorAllocatorStats GetStats() const;
+
+	private:
+		void InsertFree(uint32 Index, uint32 Count);
+		void EraseFree(std::map<uint32, uint32>::iterator It);
+
+		/// @brief Merges cached single slots back into free list, so they can form ranges again.
+		void FlushSingles();
+
+		// First slot -> slot count; used to merge neighbours.
+		std::map<uint32, uint32> m_FreeByIndex;
+		// (Count, first slot); used for best-fit lookup.
+		std::set<std::pair<uint32, uint32>> m_FreeBySize;
+		// Freed single slots, reused before touching the free list.
+		std::vector<uint32> m_Singles;
+
+		// Per slot; only first slot of a range is meaningful.
+		std::vector<uint32> m_Generations;
+		// Slot count of range allocated at given slot, 0 if none starts there.
+		std::vector<uint32> m_Counts;
+
+		uint32 m_Capacity	= 0;
+		uint32 m_Reserved	= 0;
+		uint32 m_Used		= 0;
+		uint32 m_Peak		= 0;
+
+		uint32 m_FailedAllocations	= 0;
+		uint32 m_StaleFrees			= 0;
+
+	};
+} // namespace lde
@@ -12,7 +12,9 @@ namespace lde
 	{
 		eDefault,
 		eD3D12,
-		eVulkan
+		eVulkan,
+		// Resources in plain memory, commands are only counted; for headless runs.
+		eNull
 	};
 
 	/**
@@ -41,6 +43,10 @@ namespace lde
 
 		virtual BufferHandle	CreateBuffer(BufferDesc Desc) = 0;
 		virtual BufferHandle	CreateConstantBuffer(void* pData, usize Size) = 0;
+		virtual void			DestroyBuffer(BufferHandle Handle) = 0;
+
+		/// @brief Backend agnostic access to created Buffer; nullptr if Handle was destroyed.
+		virtual Buffer*			LookupBuffer(BufferHandle Handle) = 0;
 		//virtual TextureHandle	CreateTexture(TextureDesc Desc) = 0;
 		//virtual Texture*		CreateTexture(TextureDesc Desc) = 0;
 
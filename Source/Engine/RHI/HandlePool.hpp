@@ -0,0 +1,172 @@
+#pragma once
+
+/*
+	RHI/HandlePool.hpp
+	Generational storage for resources referred to by BufferHandle and TextureHandle.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace lde
+{
+	/**
+	 * @brief Handles stay plain uint32: low bits are slot index, high bits generation of the slot.
+	 * UINT32_MAX never refers to a slot, so it keeps working as invalid handle.
+	 */
+	namespace ResourceHandle
+	{
+		constexpr uint32 IndexBits		= 20;
+		constexpr uint32 IndexMask		= (1u << IndexBits) - 1u;
+		constexpr uint32 GenerationMask = (1u << (32u - IndexBits)) - 1u;
+		// Last index is reserved, so UINT32_MAX is never handed out.
+		constexpr uint32 MaxSlots		= IndexMask;
+
+		constexpr uint32 Make(uint32 Index, uint32 Generation) { return (Generation << IndexBits) | (Index & IndexMask); }
+		constexpr uint32 GetIndex(uint32 Handle)		{ return Handle & IndexMask; }
+		constexpr uint32 GetGeneration(uint32 Handle)	{ return Handle >> IndexBits; }
+	}
+
+	/// @brief Default for pools without per-slot hot data.
+	struct NoHotData {};
+
+	/**
+	 * @brief Owns objects of type T in reusable slots.
+	 * Slot state is kept structure-of-arrays: generations, hot data and object pointers live in separate arrays,
+	 * so validation and per-draw reads of THot don't touch the objects themselves.
+	 * Destroyed slots are reused LIFO with bumped generation; handles to the old object stop resolving.
+	 * Slot whose generation would wrap is retired instead of reused.
+	 */
+	template<typename T, typename THot = NoHotData>
+	class HandlePool
+	{
+	public:
+		HandlePool() = default;
+		HandlePool(const HandlePool&) = delete;
+		HandlePool& operator=(const HandlePool&) = delete;
+
+		/// @return Handle of the object; UINT32_MAX if pool is full.
+		uint32 Insert(std::unique_ptr<T> pObject, const THot& Hot = THot())
+		{
+			uint32 index = 0;
+			if (!m_FreeSlots.empty())
+			{
+				index = m_FreeSlots.back();
+				m_FreeSlots.pop_back();
+			}
+			else
+			{
+				if (m_Objects.size() >= ResourceHandle::MaxSlots)
+				{
+					return UINT32_MAX;
+				}
+
+				index = static_cast<uint32>(m_Objects.size());
+				m_Generations.push_back(0);
+				m_Hot.emplace_back();
+				m_Objects.emplace_back();
+			}
+
+			m_Objects.at(index) = std::move(pObject);
+			m_Hot.at(index) = Hot;
+			++m_Alive;
+
+			return ResourceHandle::Make(index, m_Generations.at(index));
+		}
+
+		/// @brief Destroys the object. @return False if Handle was stale.
+		bool Remove(uint32 Handle)
+		{
+			if (!IsValid(Handle))
+			{
+				return false;
+			}
+
+			const uint32 index = ResourceHandle::GetIndex(Handle);
+			m_Objects.at(index).reset();
+			m_Hot.at(index) = THot();
+			--m_Alive;
+
+			if (m_Generations.at(index) < ResourceHandle::GenerationMask)
+			{
+				++m_Generations.at(index);
+				m_FreeSlots.push_back(index);
+			}
+			else
+			{
+				++m_Retired;
+			}
+
+			return true;
+		}
+
+		bool IsValid(uint32 Handle) const
+		{
+			const uint32 index = ResourceHandle::GetIndex(Handle);
+			return index < m_Generations.size()
+				&& m_Generations[index] == ResourceHandle::GetGeneration(Handle)
+				&& m_Objects[index] != nullptr;
+		}
+
+		/// @return nullptr if Handle is stale or invalid.
+		T* Get(uint32 Handle) const
+		{
+			return IsValid(Handle) ? m_Objects[ResourceHandle::GetIndex(Handle)].get() : nullptr;
+		}
+
+		/// @brief Handle has to be valid.
+		const THot& GetHot(uint32 Handle) const
+		{
+			assert(IsValid(Handle));
+			return m_Hot[ResourceHandle::GetIndex(Handle)];
+		}
+
+		THot& GetHot(uint32 Handle)
+		{
+			assert(IsValid(Handle));
+			return m_Hot[ResourceHandle::GetIndex(Handle)];
+		}
+
+		/// @brief Calls Func(T&) for every live object.
+		template<typename Fn>
+		void ForEach(Fn&& Func) const
+		{
+			for (const auto& object : m_Objects)
+			{
+				if (object)
+				{
+					Func(*object);
+				}
+			}
+		}
+
+		/// @brief Destroys every object; handles given out so far must not be used anymore.
+		void Clear()
+		{
+			m_Generations.clear();
+			m_Hot.clear();
+			m_Objects.clear();
+			m_FreeSlots.clear();
+			m_Alive		= 0;
+			m_Retired	= 0;
+		}
+
+		uint32 GetAliveCount()		const { return m_Alive; }
+		uint32 GetSlotCount()		const { return static_cast<uint32>(m_Objects.size()); }
+		uint32 GetFreeSlotCount()	const { return static_cast<uint32>(m_FreeSlots.size()); }
+		uint32 GetRetiredCount()	const { return m_Retired; }
+
+	private:
+		std::vector<uint32>				m_Generations;
+		std::vector<THot>				m_Hot;
+		std::vector<std::unique_ptr<T>> m_Objects;
+
+		std::vector<uint32> m_FreeSlots;
+
+		uint32 m_Alive		= 0;
+		uint32 m_Retired	= 0;
+
+	};
+} // namespace lde
@@ -0,0 +1,84 @@
+#include "LinearAllocator.hpp"
+#include "Core/Math.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace lde
+{
+	LinearAllocator::LinearAllocator(uint64 RegionSize, uint32 FrameCount, uint64 Alignment)
+	{
+		Initialize(RegionSize, FrameCount, Alignment);
+	}
+
+	void LinearAllocator::Initialize(uint64 RegionSize, uint32 FrameCount, uint64 Alignment)
+	{
+		assert(FrameCount > 0);
+		assert((Alignment & (Alignment - 1)) == 0);
+
+		m_Alignment  = Alignment;
+		// Keep every region start aligned.
+		m_RegionSize = Align(RegionSize, Alignment);
+
+		m_Regions.resize(FrameCount);
+		for (uint32 i = 0; i < FrameCount; ++i)
+		{
+			m_Regions.at(i) = Region{ .Begin = m_RegionSize * i, .Offset = 0, .FenceValue = 0 };
+		}
+
+		m_CurrentRegion		= 0;
+		m_bRegionReady		= true;
+		m_PeakSize			= 0;
+		m_FailedAllocations = 0;
+	}
+
+	bool LinearAllocator::BeginFrame(uint32 FrameIndex, uint64 CompletedFenceValue)
+	{
+		assert(FrameIndex < m_Regions.size());
+
+		m_CurrentRegion = FrameIndex;
+		auto& region = m_Regions.at(m_CurrentRegion);
+
+		m_bRegionReady = region.FenceValue <= CompletedFenceValue;
+		if (m_bRegionReady)
+		{
+			region.Offset = 0;
+		}
+
+		return m_bRegionReady;
+	}
+
+	void LinearAllocator::EndFrame(uint64 FenceValue)
+	{
+		m_Regions.at(m_CurrentRegion).FenceValue = FenceValue;
+	}
+
+	uint64 LinearAllocator::Allocate(uint64 Size, uint64 Alignment)
+	{
+		if (!m_bRegionReady || m_Regions.empty())
+		{
+			m_FailedAllocations++;
+			return InvalidOffset;
+		}
+
+		const uint64 alignment = (Alignment == 0) ? m_Alignment : std::max(Alignment, m_Alignment);
+		auto& region = m_Regions.at(m_CurrentRegion);
+
+		const uint64 offset = Align(region.Offset, alignment);
+		if (offset + Size > m_RegionSize)
+		{
+			m_FailedAllocations++;
+			return InvalidOffset;
+		}
+
+		region.Offset = offset + Size;
+		m_PeakSize = std::max(m_PeakSize, region.Offset);
+
+		return region.Begin + offset;
+	}
+
+	uint64 LinearAllocator::GetUsedSize() const
+	{
+		return m_Regions.empty() ? 0 : m_Regions.at(m_CurrentRegion).Offset;
+	}
+
+} // namespace lde
@@ -0,0 +1,81 @@
+#pragma once
+
+/*
+	RHI/LinearAllocator.hpp
+	API agnostic bump allocator for per-frame transient GPU data.
+	Operates on offsets only; backend owns actual memory.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <vector>
+
+namespace lde
+{
+	/**
+	 * @brief Splits single memory range into one region per frame in flight.
+	 * Allocations are bumped linearly inside current frame's region.
+	 * Region is reset at BeginFrame only once the fence value it was tagged with at EndFrame is completed.
+	 */
+	class LinearAllocator
+	{
+	public:
+		static constexpr uint64 DefaultAlignment = 256;
+		static constexpr uint64 InvalidOffset	 = UINT64_MAX;
+
+		LinearAllocator() = default;
+		LinearAllocator(uint64 RegionSize, uint32 FrameCount, uint64 Alignment = DefaultAlignment);
+
+		void Initialize(uint64 RegionSize, uint32 FrameCount, uint64 Alignment = DefaultAlignment);
+
+		/**
+		 * @brief Makes region of given frame current.
+		 * @param FrameIndex
+		 * @param CompletedFenceValue Last value reached by GPU.
+		 * @return False if GPU might still read from the region. Allocations fail until region is retired.
+		 */
+		bool BeginFrame(uint32 FrameIndex, uint64 CompletedFenceValue);
+
+		/**
+		 * @brief Tags current region with fence value signaled after its frame is submitted.
+		 * @param FenceValue
+		 */
+		void EndFrame(uint64 FenceValue);
+
+		/**
+		 * @brief Bump allocation inside current frame's region.
+		 * @param Size
+		 * @param Alignment 0 uses allocator's default alignment. Must be a power of two.
+		 * @return Offset from the start of the whole range, InvalidOffset if region is full or not retired.
+		 */
+		uint64 Allocate(uint64 Size, uint64 Alignment = 0);
+
+		uint64 GetTotalSize()		const { return m_RegionSize * static_cast<uint64>(m_Regions.size()); }
+		uint64 GetRegionSize()		const { return m_RegionSize; }
+		uint32 GetCurrentFrame()	const { return m_CurrentRegion; }
+		/// @brief Bytes used in current frame's region.
+		uint64 GetUsedSize()		const;
+		/// @brief Highest usage of any region since Initialize.
+		uint64 GetPeakSize()		const { return m_PeakSize; }
+		uint32 GetFailedAllocations() const { return m_FailedAllocations; }
+
+	private:
+		struct Region
+		{
+			uint64 Begin		= 0;
+			uint64 Offset		= 0;
+			// Fence value that must be completed before region can be reused.
+			uint64 FenceValue	= 0;
+		};
+
+		std::vector<Region> m_Regions;
+
+		uint64 m_RegionSize		= 0;
+		uint64 m_Alignment		= DefaultAlignment;
+		uint32 m_CurrentRegion	= 0;
+		bool   m_bRegionReady	= false;
+
+		uint64 m_PeakSize			= 0;
+		uint32 m_FailedAllocations	= 0;
+
+	};
+} // namespace lde
@@ -0,0 +1,147 @@
+#include "Core/Hash.hpp"
+#include "NullCommandList.hpp"
+#include <cstring>
+
+namespace lde
+{
+	NullCommandList::NullCommandList(CommandType eType)
+	{
+		m_Type = eType;
+	}
+
+	void NullCommandList::DrawIndexed(uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex)
+	{
+		DrawIndexedInstanced(1, IndexCount, BaseIndex, BaseVertex);
+	}
+
+	void NullCommandList::DrawIndexedInstanced(uint32 Instances, uint32 IndexCount, uint32 /* BaseIndex */, uint32 /* BaseVertex */)
+	{
+		FlushBarriers();
+		m_Stats.Draws++;
+		m_Stats.Instances	+= Instances;
+		m_Stats.Indices		+= static_cast<uint64>(IndexCount) * Instances;
+
+		if (m_bCaptureDraws)
+		{
+			CaptureDraw(Instances, IndexCount, true);
+		}
+	}
+
+	void NullCommandList::Draw(uint32 VertexCount)
+	{
+		DrawInstanced(1, VertexCount, 0);
+	}
+
+	void NullCommandList::DrawInstanced(uint32 Instances, uint32 VertexCount, uint32 /* BaseVertex */)
+	{
+		FlushBarriers();
+		m_Stats.Draws++;
+		m_Stats.Instances	+= Instances;
+		m_Stats.Vertices	+= static_cast<uint64>(VertexCount) * Instances;
+
+		if (m_bCaptureDraws)
+		{
+			CaptureDraw(Instances, VertexCount, false);
+		}
+	}
+
+	void NullCommandList::BindPipeline(PipelineState* pPipeline)
+	{
+		m_Pipeline = pPipeline;
+		m_Stats.PipelineBinds++;
+	}
+
+	void NullCommandList::BindVertexBuffer(Buffer* pBuffer)
+	{
+		m_VertexBuffer = pBuffer;
+		m_Stats.VertexBufferBinds++;
+	}
+
+	void NullCommandList::BindIndexBuffer(Buffer* pBuffer)
+	{
+		m_IndexBuffer = pBuffer;
+		m_Stats.IndexBufferBinds++;
+	}
+
+	void NullCommandList::BindConstantBuffer(uint32 /* Slot */, ConstantBuffer* /* pBuffer */)
+	{
+		m_Stats.ConstantBufferBinds++;
+	}
+
+	void NullCommandList::PushConstants(uint32 Slot, uint32 Count, const void* pData, uint32 Offset)
+	{
+		m_Stats.PushConstants++;
+		m_Stats.PushConstantBytes += Count * sizeof(uint32);
+
+		if (m_bCaptureDraws)
+		{
+			if (m_RootConstants.size() <= Slot)
+			{
+				m_RootConstants.resize(Slot + 1);
+			}
+
+			auto& constants = m_RootConstants.at(Slot);
+			if (constants.size() < Offset + Count)
+			{
+				constants.resize(Offset + Count);
+			}
+			std::memcpy(constants.data() + Offset, pData, Count * sizeof(uint32));
+		}
+	}
+
+	void NullCommandList::ResourceBarrier(Buffer* pBuffer, ResourceState Before, ResourceState After)
+	{
+		TrackResource(pBuffer, Before);
+		Transition(pBuffer, After);
+		FlushBarriers();
+	}
+
+	void NullCommandList::TrackResource(Buffer* pBuffer, ResourceState State)
+	{
+		m_StateTracker.Register(reinterpret_cast<uint64>(pBuffer), static_cast<uint32>(State));
+	}
+
+	bool NullCommandList::Transition(Buffer* pBuffer, ResourceState After)
+	{
+		return m_StateTracker.Transition(reinterpret_cast<uint64>(pBuffer), static_cast<uint32>(After));
+	}
+
+	void NullCommandList::FlushBarriers()
+	{
+		m_Transitions.clear();
+		m_StateTracker.Flush(m_Transitions);
+
+		if (m_Transitions.empty())
+		{
+			return;
+		}
+
+		m_Stats.Barriers += static_cast<uint32>(m_Transitions.size());
+		m_Stats.BarrierBatches++;
+		m_LastBarrierBatch.swap(m_Transitions);
+	}
+
+	void NullCommandList::Reset()
+	{
+		m_Stats = NullCommandStats();
+		m_Pipeline		= nullptr;
+		m_VertexBuffer	= nullptr;
+		m_IndexBuffer	= nullptr;
+		m_StateTracker.ResetStats();
+
+		m_Draws.clear();
+		m_RootConstants.clear();
+	}
+
+	void NullCommandList::CaptureDraw(uint32 Instances, uint32 Count, bool bIndexed)
+	{
+		uint64 constants = Hash::FNV_OFFSET_BASIS;
+		for (const auto& slot : m_RootConstants)
+		{
+			constants = Hash::FNV1a(std::span<const uint32>(slot), constants);
+		}
+
+		m_Draws.emplace_back(m_Pipeline, m_VertexBuffer, bIndexed ? m_IndexBuffer : nullptr, constants, Instances, Count);
+	}
+
+} // namespace lde
@@ -0,0 +1,143 @@
+#pragma once
+
+/*
+	RHI/Null/NullCommandList.hpp
+	Command list that records nothing; every call only updates counters.
+	Draws can be captured along with the state they were issued with, to compare recordings.
+*/
+
+#include "RHI/CommandList.hpp"
+#include "RHI/PipelineState.hpp"
+#include "RHI/ResourceStateTracker.hpp"
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	class Buffer;
+
+	/// @brief Stands in for a compiled pipeline; only identifies it.
+	class NullPipelineState : public PipelineState
+	{
+	public:
+		explicit NullPipelineState(uint32 ID = 0) : ID(ID) { }
+
+		uint32 ID = 0;
+	};
+
+	/// @brief Commands recorded since last Reset().
+	struct NullCommandStats
+	{
+		uint32 Draws				= 0;
+		uint32 Instances			= 0;
+		uint64 Indices				= 0;
+		uint64 Vertices				= 0;
+		uint32 PipelineBinds		= 0;
+		uint32 VertexBufferBinds	= 0;
+		uint32 IndexBufferBinds		= 0;
+		uint32 ConstantBufferBinds	= 0;
+		uint32 PushConstants		= 0;
+		uint64 PushConstantBytes	= 0;
+		uint32 Barriers				= 0;
+		// Flushes that recorded at least one barrier.
+		uint32 BarrierBatches		= 0;
+
+		NullCommandStats& operator+=(const NullCommandStats& Other)
+		{
+			Draws				+= Other.Draws;
+			Instances			+= Other.Instances;
+			Indices				+= Other.Indices;
+			Vertices			+= Other.Vertices;
+			PipelineBinds		+= Other.PipelineBinds;
+			VertexBufferBinds	+= Other.VertexBufferBinds;
+			IndexBufferBinds	+= Other.IndexBufferBinds;
+			ConstantBufferBinds += Other.ConstantBufferBinds;
+			PushConstants		+= Other.PushConstants;
+			PushConstantBytes	+= Other.PushConstantBytes;
+			Barriers			+= Other.Barriers;
+			BarrierBatches		+= Other.BarrierBatches;
+			return *this;
+		}
+	};
+
+	/// @brief State a draw was issued with; non-indexed draws have no index buffer.
+	struct NullDrawRecord
+	{
+		PipelineState*	Pipeline		= nullptr;
+		Buffer*			VertexBuffer	= nullptr;
+		Buffer*			IndexBuffer		= nullptr;
+		// Hash of every pushed root constant.
+		uint64			Constants		= 0;
+		uint32			Instances		= 0;
+		// Indices or vertices per instance.
+		uint32			Count			= 0;
+
+		bool operator==(const NullDrawRecord&) const = default;
+	};
+
+	class NullCommandList : public CommandList
+	{
+	public:
+		NullCommandList(CommandType eType = CommandType::eGraphics);
+
+		void DrawIndexed(uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) override;
+		void DrawIndexedInstanced(uint32 Instances, uint32 IndexCount, uint32 BaseIndex, uint32 BaseVertex) override;
+		void Draw(uint32 VertexCount) override;
+		void DrawInstanced(uint32 Instances, uint32 VertexCount, uint32 BaseVertex) override;
+
+		void BindPipeline(PipelineState* pPipeline) override;
+
+		void BindVertexBuffer(Buffer* pBuffer) override;
+		void BindIndexBuffer(Buffer* pBuffer) override;
+		void BindConstantBuffer(uint32 Slot, ConstantBuffer* pBuffer) override;
+
+		void PushConstants(uint32 Slot, uint32 Count, const void* pData, uint32 Offset = 0) override;
+
+		/// @brief Explicit transition; flushed right away, so it's counted as its own batch.
+		void ResourceBarrier(Buffer* pBuffer, ResourceState Before, ResourceState After);
+
+		/// @brief Starts tracking pBuffer in given state.
+		void TrackResource(Buffer* pBuffer, ResourceState State);
+		/// @brief Queues transition with inferred before state. @return False if pBuffer isn't tracked.
+		bool Transition(Buffer* pBuffer, ResourceState After);
+		/// @brief Counts queued transitions as one batch; draws do it on their own.
+		void FlushBarriers();
+
+		/// @brief Clears counters, bound pipeline and buffers; tracked states are kept.
+		void Reset();
+
+		/// @brief Keeps a NullDrawRecord of every draw until Reset. Off by default, as it allocates.
+		void SetCaptureDraws(bool bCapture) { m_bCaptureDraws = bCapture; }
+		std::span<const NullDrawRecord> GetDraws() const { return m_Draws; }
+
+		const ResourceStateTracker& GetStateTracker() const { return m_StateTracker; }
+		// Transitions of the last flush that recorded any.
+		std::span<const StateTransition> GetLastBarrierBatch() const { return m_LastBarrierBatch; }
+
+		const NullCommandStats& GetStats() const { return m_Stats; }
+
+		// Last bound pipeline and buffers; nullptr until bound.
+		PipelineState* GetPipeline() const { return m_Pipeline; }
+		Buffer* GetVertexBuffer() const { return m_VertexBuffer; }
+		Buffer* GetIndexBuffer() const { return m_IndexBuffer; }
+
+	private:
+		NullCommandStats m_Stats{};
+
+		PipelineState*	m_Pipeline		= nullptr;
+		Buffer*			m_VertexBuffer	= nullptr;
+		Buffer*			m_IndexBuffer	= nullptr;
+
+		void CaptureDraw(uint32 Instances, uint32 Count, bool bIndexed);
+
+		bool m_bCaptureDraws = false;
+		std::vector<NullDrawRecord>			m_Draws;
+		// Root constants by slot; only written while capturing.
+		std::vector<std::vector<uint32>>	m_RootConstants;
+
+		ResourceStateTracker			m_StateTracker;
+		std::vector<StateTransition>	m_Transitions;
+		std::vector<StateTransition>	m_LastBarrierBatch;
+
+	};
+} // namespace lde
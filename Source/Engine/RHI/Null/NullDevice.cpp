@@ -0,0 +1,163 @@
+#include "Core/Logger.hpp"
+#include "NullDevice.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace lde
+{
+	NullBuffer::NullBuffer(BufferDesc Desc, uint64 GpuAddress)
+		: m_GpuAddress(GpuAddress)
+	{
+		m_Data.resize(Desc.Size);
+		if (Desc.pData && Desc.Size > 0)
+		{
+			std::memcpy(m_Data.data(), Desc.pData, Desc.Size);
+		}
+
+		// Caller's data doesn't outlive creation.
+		Desc.pData = m_Data.data();
+		m_Desc = Desc;
+	}
+
+	NullConstantBuffer::NullConstantBuffer(void* pData, usize Size)
+	{
+		m_Data.resize(Size);
+		Update(pData);
+	}
+
+	void NullConstantBuffer::Update(void* pData)
+	{
+		if (pData && !m_Data.empty())
+		{
+			std::memcpy(m_Data.data(), pData, m_Data.size());
+		}
+	}
+
+	void NullConstantBuffer::Release()
+	{
+		m_Data = {};
+	}
+
+	NullTexture::NullTexture(uint32 Width, uint32 Height, Format eFormat, uint16 Mips)
+		: Width(Width), Height(Height), eFormat(eFormat), Mips(std::max<uint16>(Mips, 1))
+	{
+		usize size = 0;
+		for (uint16 mip = 0; mip < this->Mips; ++mip)
+		{
+			size += static_cast<usize>(std::max(Width >> mip, 1u)) * std::max(Height >> mip, 1u) * GetFormatSize(eFormat);
+		}
+		Data.resize(size);
+	}
+
+	NullDevice::NullDevice()
+	{
+		m_DeviceDesc.Backend			= BackendAPI::eNull;
+		m_DeviceDesc.bDebugMode			= false;
+		m_DeviceDesc.bEnableValidation	= false;
+		m_GpuType = DeviceType::eVirtual;
+	}
+
+	NullDevice::~NullDevice()
+	{
+		Release();
+	}
+
+	BufferHandle NullDevice::CreateBuffer(BufferDesc Desc)
+	{
+		const BufferHandle handle = m_Buffers.Insert(std::make_unique<NullBuffer>(Desc, m_NextGpuAddress));
+
+		// Keep addresses aligned like real placed resources.
+		m_NextGpuAddress += (std::max<uint64>(Desc.Size, 1) + 0xFFFF) & ~0xFFFFull;
+
+		return handle;
+	}
+
+	BufferHandle NullDevice::CreateConstantBuffer(void* pData, usize Size)
+	{
+		return m_ConstantBuffers.Insert(std::make_unique<NullConstantBuffer>(pData, Size));
+	}
+
+	void NullDevice::DestroyBuffer(BufferHandle Handle)
+	{
+		m_Buffers.Remove(Handle);
+	}
+
+	Buffer* NullDevice::LookupBuffer(BufferHandle Handle)
+	{
+		return GetBuffer(Handle);
+	}
+
+	TextureHandle NullDevice::CreateTexture(uint32 Width, uint32 Height, Format eFormat, uint16 Mips)
+	{
+		return m_Textures.Insert(std::make_unique<NullTexture>(Width, Height, eFormat, Mips));
+	}
+
+	void NullDevice::DestroyConstantBuffer(BufferHandle Handle)
+	{
+		m_ConstantBuffers.Remove(Handle);
+	}
+
+	void NullDevice::DestroyTexture(TextureHandle Handle)
+	{
+		m_Textures.Remove(Handle);
+	}
+
+	NullBuffer* NullDevice::GetBuffer(BufferHandle Handle)
+	{
+		return m_Buffers.Get(Handle);
+	}
+
+	NullConstantBuffer* NullDevice::GetConstantBuffer(BufferHandle Handle)
+	{
+		return m_ConstantBuffers.Get(Handle);
+	}
+
+	NullTexture* NullDevice::GetTexture(TextureHandle Handle)
+	{
+		return m_Textures.Get(Handle);
+	}
+
+	NullDeviceStats NullDevice::GetStats() const
+	{
+		NullDeviceStats stats{};
+
+		stats.Buffers			= m_Buffers.GetAliveCount();
+		stats.ConstantBuffers	= m_ConstantBuffers.GetAliveCount();
+		stats.Textures			= m_Textures.GetAliveCount();
+
+		m_Buffers.ForEach([&](const NullBuffer& Buffer) { stats.MemoryBytes += Buffer.Data().size(); });
+		m_ConstantBuffers.ForEach([&](const NullConstantBuffer& Buffer) { stats.MemoryBytes += Buffer.Data().size(); });
+		m_Textures.ForEach([&](const NullTexture& Texture) { stats.MemoryBytes += Texture.Data.size(); });
+
+		return stats;
+	}
+
+	void NullDevice::Release()
+	{
+		m_Buffers.Clear();
+		m_ConstantBuffers.Clear();
+		m_Textures.Clear();
+	}
+
+	uint32 GetFormatSize(Format eFormat)
+	{
+		switch (eFormat)
+		{
+		case Format::eRGBA8_UNORM:
+		case Format::eRGBA8_FLOAT:
+		case Format::eD32_FLOAT:
+		case Format::eD24S8_FLOAT:
+			return 4;
+		case Format::eRGBA16_UNORM:
+		case Format::eRGBA16_FLOAT:
+			return 8;
+		case Format::eRGBA32_UNORM:
+		case Format::eRGBA32_FLOAT:
+			return 16;
+		default:
+			LOG_WARN("Unknown Format; assuming 4 bytes per texel.");
+			return 4;
+		}
+	}
+
+} // namespace lde
@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+	RHI/Null/NullDevice.hpp
+	Device of the Null backend. Resources live in plain system memory
+	and nothing is ever sent to a GPU; used for headless runs and benchmarks.
+*/
+
+#include "RHI/Device.hpp"
+#include "RHI/HandlePool.hpp"
+#include "RHI/Types.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	/// @brief Buffer backed by system memory. Contents are copied on creation.
+	class NullBuffer : public Buffer
+	{
+	public:
+		NullBuffer(BufferDesc Desc, uint64 GpuAddress);
+
+		uint64 GetGpuAddress() const override { return m_GpuAddress; }
+
+		std::span<uint8> Data() { return m_Data; }
+		std::span<const uint8> Data() const { return m_Data; }
+
+	private:
+		std::vector<uint8> m_Data;
+		uint64 m_GpuAddress = 0;
+
+	};
+
+	class NullConstantBuffer : public ConstantBuffer
+	{
+	public:
+		NullConstantBuffer(void* pData, usize Size);
+
+		void Update(void* pData) override;
+		void Release() override;
+
+		std::span<const uint8> Data() const { return m_Data; }
+
+	private:
+		std::vector<uint8> m_Data;
+
+	};
+
+	class NullTexture : public Texture
+	{
+	public:
+		NullTexture(uint32 Width, uint32 Height, Format eFormat, uint16 Mips);
+
+		uint32	Width	= 0;
+		uint32	Height	= 0;
+		Format	eFormat = Format::eRGBA8_UNORM;
+		uint16	Mips	= 1;
+
+		std::vector<uint8> Data;
+
+	};
+
+	/// @brief Sizes of resources currently alive on the device.
+	struct NullDeviceStats
+	{
+		uint32 Buffers			= 0;
+		uint32 ConstantBuffers	= 0;
+		uint32 Textures			= 0;
+		uint64 MemoryBytes		= 0;
+	};
+
+	class NullDevice : public Device
+	{
+	public:
+		NullDevice();
+		NullDevice(const NullDevice&) = delete;
+		NullDevice& operator=(const NullDevice&) = delete;
+		~NullDevice();
+
+		BufferHandle	CreateBuffer(BufferDesc Desc) override final;
+		BufferHandle	CreateConstantBuffer(void* pData, usize Size) override final;
+		void			DestroyBuffer(BufferHandle Handle) override final;
+		Buffer*			LookupBuffer(BufferHandle Handle) override final;
+
+		TextureHandle	CreateTexture(uint32 Width, uint32 Height, Format eFormat, uint16 Mips = 1);
+
+		void			DestroyConstantBuffer(BufferHandle Handle);
+		void			DestroyTexture(TextureHandle Handle);
+
+		NullBuffer*			GetBuffer(BufferHandle Handle);
+		NullConstantBuffer* GetConstantBuffer(BufferHandle Handle);
+		NullTexture*		GetTexture(TextureHandle Handle);
+
+		NullDeviceStats GetStats() const;
+
+		void Release();
+
+	private:
+		HandlePool<NullBuffer>			m_Buffers;
+		HandlePool<NullConstantBuffer>	m_ConstantBuffers;
+		HandlePool<NullTexture>			m_Textures;
+
+		// Fake virtual addresses; unique per Buffer, never reused.
+		uint64 m_NextGpuAddress = 0x10000;
+
+	};
+
+	/// @return Size of single texel of given Format, in bytes.
+	extern uint32 GetFormatSize(Format eFormat);
+
+} // namespace lde
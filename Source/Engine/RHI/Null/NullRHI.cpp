@@ -0,0 +1,90 @@
+#include "Core/Logger.hpp"
+#include "NullRHI.hpp"
+#include "RHI/RHICommon.hpp"
+
+namespace lde
+{
+	NullRHI::NullRHI()
+	{
+		Device = std::make_unique<NullDevice>();
+		FRAME_INDEX = 0;
+		LOG_INFO("Null RHI initialized.");
+	}
+
+	NullRHI::~NullRHI()
+	{
+		Device.reset();
+		LOG_INFO("Null RHI released.");
+	}
+
+	void NullRHI::BeginFrame()
+	{
+		m_GfxCommandList.Reset();
+
+		for (uint32 i = 0; i < m_UsedWorkerLists; ++i)
+		{
+			m_WorkerLists.at(i)->Reset();
+		}
+		m_UsedWorkerLists = 0;
+	}
+
+	std::span<CommandList*> NullRHI::AcquireWorkerLists(uint32 Count)
+	{
+		while (m_WorkerLists.size() < m_UsedWorkerLists + Count)
+		{
+			m_WorkerLists.push_back(std::make_unique<NullCommandList>(CommandType::eGraphics));
+			m_WorkerLists.back()->SetCaptureDraws(m_bCaptureDraws);
+		}
+
+		m_AcquiredLists.clear();
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			m_AcquiredLists.push_back(m_WorkerLists.at(m_UsedWorkerLists + i).get());
+		}
+
+		m_UsedWorkerLists += Count;
+
+		return m_AcquiredLists;
+	}
+
+	NullCommandStats NullRHI::GetWorkerStats() const
+	{
+		NullCommandStats stats{};
+		for (uint32 i = 0; i < m_UsedWorkerLists; ++i)
+		{
+			stats += m_WorkerLists.at(i)->GetStats();
+		}
+
+		return stats;
+	}
+
+	void NullRHI::SetCaptureDraws(bool bCapture)
+	{
+		m_bCaptureDraws = bCapture;
+
+		m_GfxCommandList.SetCaptureDraws(bCapture);
+		for (auto& list : m_WorkerLists)
+		{
+			list->SetCaptureDraws(bCapture);
+		}
+	}
+
+	std::vector<NullDrawRecord> NullRHI::GetDraws() const
+	{
+		std::vector<NullDrawRecord> draws(m_GfxCommandList.GetDraws().begin(), m_GfxCommandList.GetDraws().end());
+		for (uint32 i = 0; i < m_UsedWorkerLists; ++i)
+		{
+			const auto workerDraws = m_WorkerLists.at(i)->GetDraws();
+			draws.insert(draws.end(), workerDraws.begin(), workerDraws.end());
+		}
+
+		return draws;
+	}
+
+	void NullRHI::Present(bool /* bVSync */)
+	{
+		FRAME_INDEX = (FRAME_INDEX + 1) % FRAME_COUNT;
+		++m_FrameCount;
+	}
+
+} // namespace lde
@@ -0,0 +1,74 @@
+#pragma once
+
+/*
+	RHI/Null/NullRHI.hpp
+	Headless backend. Needs neither window nor GPU, so CPU side of a frame
+	can be run and profiled on its own.
+*/
+
+#include "RHI/RHI.hpp"
+#include "NullCommandList.hpp"
+#include "NullDevice.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	class NullSwapChain : public SwapChain
+	{
+	};
+
+	class NullRHI : public RHI
+	{
+	public:
+		NullRHI();
+		NullRHI(const NullRHI&) = delete;
+		NullRHI& operator=(const NullRHI&) = delete;
+		~NullRHI();
+
+		/// @brief Resets command counters of the frame.
+		void BeginFrame() override;
+		void RecordCommandLists() override {}
+		void Update() override {}
+		void Render() override {}
+		void EndFrame() override {}
+		/// @brief Advances FRAME_INDEX, like swapping back buffers would.
+		void Present(bool bVSync) override;
+
+		lde::Device* GetDevice() override { return Device.get(); }
+		SwapChain* GetSwapChain() override { return &m_SwapChain; }
+
+		NullCommandList* GetGfxCommandList() { return &m_GfxCommandList; }
+
+		/**
+		 * @brief Lists for parallel recording, mirroring D3D12 worker command lists; grows on demand.
+		 * Lists handed out during a frame are reset in next BeginFrame.
+		 */
+		std::span<CommandList*> AcquireWorkerLists(uint32 Count);
+		/// @return Counters of lists acquired this frame, summed in acquisition order.
+		NullCommandStats GetWorkerStats() const;
+
+		/// @brief Captures draws on Graphics and worker command lists; see NullCommandList::SetCaptureDraws.
+		void SetCaptureDraws(bool bCapture);
+		/// @return Captured draws of this frame in submission order: Graphics command list, then worker lists in acquisition order.
+		std::vector<NullDrawRecord> GetDraws() const;
+
+		/// @brief Frames presented so far.
+		uint64 GetFrameCount() const { return m_FrameCount; }
+
+		std::unique_ptr<NullDevice> Device;
+
+	private:
+		NullCommandList m_GfxCommandList{ CommandType::eGraphics };
+		NullSwapChain	m_SwapChain;
+
+		std::vector<std::unique_ptr<NullCommandList>>	m_WorkerLists;
+		std::vector<CommandList*>						m_AcquiredLists;
+		uint32 m_UsedWorkerLists = 0;
+		bool m_bCaptureDraws = false;
+
+		uint64 m_FrameCount = 0;
+
+	};
+} // namespace lde
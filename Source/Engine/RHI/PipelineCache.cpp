@@ -0,0 +1,54 @@
+#include "PipelineCache.hpp"
+#include "PipelineState.hpp"
+#include <cstring>
+
+namespace lde::PipelineLibraryFile
+{
+	namespace
+	{
+		// Precedes serialized library.
+		struct Header
+		{
+			uint32 Magic	= 0x4C50444C; // "LDPL"
+			uint32 Version	= PipelineKey::Version;
+		};
+	} // namespace
+
+	bool Read(const Filepath& Path, std::vector<uint8>& OutBlob)
+	{
+		OutBlob.clear();
+
+		std::vector<uint8> file;
+		if (!Files::ReadBinary(Path, file) || file.size() <= sizeof(Header))
+		{
+			return false;
+		}
+
+		Header header{};
+		std::memcpy(&header, file.data(), sizeof(header));
+
+		if (header.Magic != Header{}.Magic || header.Version != PipelineKey::Version)
+		{
+			return false;
+		}
+
+		OutBlob.assign(file.begin() + sizeof(Header), file.end());
+
+		return true;
+	}
+
+	bool Write(const Filepath& Path, std::span<const uint8> Blob)
+	{
+		std::vector<uint8> file(sizeof(Header) + Blob.size());
+
+		const Header header{};
+		std::memcpy(file.data(), &header, sizeof(header));
+		if (!Blob.empty())
+		{
+			std::memcpy(file.data() + sizeof(Header), Blob.data(), Blob.size());
+		}
+
+		return Files::WriteBinary(Path, file);
+	}
+
+} // namespace lde::PipelineLibraryFile
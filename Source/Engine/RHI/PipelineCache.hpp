@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+	RHI/PipelineCache.hpp
+	API agnostic part of pipeline caching: lookup order, statistics and the file Pipeline Library is persisted in.
+	Backend supplies pipeline objects and the library itself.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Core/FileSystem.hpp"
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	struct PipelineCacheStats
+	{
+		uint32 Requests		= 0;
+		// Already created during this run.
+		uint32 MemoryHits	= 0;
+		// Loaded from Pipeline Library, stored by an earlier run.
+		uint32 LibraryHits	= 0;
+		// Compiled by the driver.
+		uint32 Created		= 0;
+		uint32 Pipelines	= 0;
+	};
+
+	enum class PipelineSource : uint8
+	{
+		eMemory,
+		eLibrary,
+		eCreated,
+		// Create failed; nothing was cached.
+		eFailed,
+	};
+
+	/**
+	 * @brief Pipelines of this run by PipelineKey; equal keys share a single pipeline object.
+	 * Missing pipelines are loaded from backend's library, or created and stored in it.
+	 * Library is dirty once anything was stored, until it's saved.
+	 */
+	template<typename Pipeline>
+	class PipelineCache
+	{
+	public:
+		/**
+		 * @brief Memory, then library, then Create; new pipelines are kept in both.
+		 * @param Load bool(uint64 Key, Pipeline&); false if library doesn't have Key, or has it for another description.
+		 * @param Create bool(Pipeline&)
+		 * @param Store bool(uint64 Key, const Pipeline&); false if library didn't take it.
+		 */
+		template<typename LoadFn, typename CreateFn, typename StoreFn>
+		PipelineSource Get(uint64 Key, Pipeline& OutPipeline, LoadFn&& Load, CreateFn&& Create, StoreFn&& Store)
+		{
+			++m_Stats.Requests;
+
+			if (auto it = m_Pipelines.find(Key); it != m_Pipelines.end())
+			{
+				OutPipeline = it->second;
+				++m_Stats.MemoryHits;
+				return PipelineSource::eMemory;
+			}
+
+			Pipeline pipeline{};
+			PipelineSource source = PipelineSource::eLibrary;
+
+			if (Load(Key, pipeline))
+			{
+				++m_Stats.LibraryHits;
+			}
+			else
+			{
+				if (!Create(pipeline))
+				{
+					return PipelineSource::eFailed;
+				}
+
+				++m_Stats.Created;
+				source = PipelineSource::eCreated;
+
+				if (Store(Key, static_cast<const Pipeline&>(pipeline)))
+				{
+					m_bDirty = true;
+				}
+			}
+
+			OutPipeline = pipeline;
+			m_Pipelines.emplace(Key, std::move(pipeline));
+			m_Stats.Pipelines = static_cast<uint32>(m_Pipelines.size());
+
+			return source;
+		}
+
+		bool IsDirty() const { return m_bDirty; }
+		/// @brief Library was written to disk.
+		void MarkSaved() { m_bDirty = false; }
+
+		void Clear()
+		{
+			m_Pipelines.clear();
+			m_Stats.Pipelines = 0;
+		}
+
+		const PipelineCacheStats& GetStats() const { return m_Stats; }
+
+	private:
+		std::unordered_map<uint64, Pipeline> m_Pipelines;
+		bool m_bDirty = false;
+
+		PipelineCacheStats m_Stats{};
+
+	};
+
+	/// @brief Serialized Pipeline Library on disk, behind a header tied to PipelineKey::Version.
+	namespace PipelineLibraryFile
+	{
+		/**
+		 * @brief Reads library blob; the blob itself is validated by the driver.
+		 * @return False if file is missing, empty, or written with another header or PipelineKey::Version.
+		 */
+		extern bool Read(const Filepath& Path, std::vector<uint8>& OutBlob);
+
+		extern bool Write(const Filepath& Path, std::span<const uint8> Blob);
+	} // namespace PipelineLibraryFile
+} // namespace lde
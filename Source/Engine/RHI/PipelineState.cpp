@@ -0,0 +1,179 @@
+#include "Core/Hash.hpp"
+#include "PipelineState.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace lde
+{
+	namespace
+	{
+		class CanonicalWriter
+		{
+		public:
+			explicit CanonicalWriter(std::vector<uint8>& Bytes) : m_Bytes(Bytes) {}
+
+			void Write(uint64 Value, uint32 Size)
+			{
+				for (uint32 i = 0; i < Size; ++i)
+				{
+					m_Bytes.push_back(static_cast<uint8>(Value >> (8 * i)));
+				}
+			}
+
+			void Write32(uint32 Value) { Write(Value, 4); }
+			void Write64(uint64 Value) { Write(Value, 8); }
+			void WriteBool(bool bValue) { Write(bValue ? 1u : 0u, 1); }
+
+			void WriteFloat(float Value)
+			{
+				if (std::isnan(Value))
+				{
+					Value = std::numeric_limits<float>::quiet_NaN();
+				}
+				else if (Value == 0.0f)
+				{
+					// Folds -0.0f.
+					Value = 0.0f;
+				}
+
+				Write32(std::bit_cast<uint32>(Value));
+			}
+
+		private:
+			std::vector<uint8>& m_Bytes;
+		};
+
+		void WriteStencilOp(CanonicalWriter& Writer, const PipelineStencilOpDesc& Desc)
+		{
+			Writer.Write32(Desc.FailOp);
+			Writer.Write32(Desc.DepthFailOp);
+			Writer.Write32(Desc.PassOp);
+			Writer.Write32(Desc.Func);
+		}
+
+		void WriteRaster(CanonicalWriter& Writer, const PipelineRasterDesc& Desc)
+		{
+			Writer.Write32(Desc.FillMode);
+			Writer.Write32(Desc.CullMode);
+			Writer.WriteBool(Desc.bFrontCounterClockwise);
+			Writer.Write32(static_cast<uint32>(Desc.DepthBias));
+			Writer.WriteFloat(Desc.DepthBiasClamp);
+			Writer.WriteFloat(Desc.SlopeScaledDepthBias);
+			Writer.WriteBool(Desc.bDepthClip);
+			Writer.WriteBool(Desc.bMultisample);
+			Writer.WriteBool(Desc.bAntialiasedLine);
+			Writer.Write32(Desc.ForcedSampleCount);
+			Writer.Write32(Desc.ConservativeRaster);
+		}
+
+		void WriteDepthStencil(CanonicalWriter& Writer, const PipelineDepthStencilDesc& Desc)
+		{
+			Writer.WriteBool(Desc.bDepthEnable);
+			Writer.Write32(Desc.bDepthEnable ? Desc.DepthWriteMask : 0);
+			Writer.Write32(Desc.bDepthEnable ? Desc.DepthFunc : 0);
+
+			Writer.WriteBool(Desc.bStencilEnable);
+			if (Desc.bStencilEnable)
+			{
+				Writer.Write(Desc.StencilReadMask, 1);
+				Writer.Write(Desc.StencilWriteMask, 1);
+				WriteStencilOp(Writer, Desc.FrontFace);
+				WriteStencilOp(Writer, Desc.BackFace);
+			}
+			else
+			{
+				Writer.Write(0, 1);
+				Writer.Write(0, 1);
+				WriteStencilOp(Writer, {});
+				WriteStencilOp(Writer, {});
+			}
+		}
+
+		void WriteTargetBlend(CanonicalWriter& Writer, const PipelineTargetBlendDesc& Desc)
+		{
+			const bool bBlend = Desc.bBlendEnable;
+
+			Writer.WriteBool(bBlend);
+			Writer.WriteBool(Desc.bLogicOpEnable);
+			Writer.Write32(bBlend ? Desc.SrcBlend		: 0);
+			Writer.Write32(bBlend ? Desc.DestBlend		: 0);
+			Writer.Write32(bBlend ? Desc.BlendOp		: 0);
+			Writer.Write32(bBlend ? Desc.SrcBlendAlpha	: 0);
+			Writer.Write32(bBlend ? Desc.DestBlendAlpha : 0);
+			Writer.Write32(bBlend ? Desc.BlendOpAlpha	: 0);
+			Writer.Write32(Desc.bLogicOpEnable ? Desc.LogicOp : 0);
+			Writer.Write(Desc.WriteMask, 1);
+		}
+	} // namespace
+
+	void PipelineKey::Canonicalize(const PipelineStateDesc& Desc, std::vector<uint8>& OutBytes)
+	{
+		OutBytes.clear();
+		CanonicalWriter writer(OutBytes);
+
+		writer.Write32(Version);
+		writer.Write32(static_cast<uint32>(Desc.Type));
+		writer.Write64(Desc.RootSignature);
+
+		if (Desc.Type == PipelineType::eCompute)
+		{
+			writer.Write64(Desc.Shaders.at(static_cast<usize>(PipelineShaderSlot::eCompute)));
+			return;
+		}
+
+		for (usize slot = 0; slot < Desc.Shaders.size(); ++slot)
+		{
+			const bool bGraphicsStage = slot != static_cast<usize>(PipelineShaderSlot::eCompute);
+			writer.Write64(bGraphicsStage ? Desc.Shaders.at(slot) : 0);
+		}
+
+		WriteRaster(writer, Desc.Raster);
+		WriteDepthStencil(writer, Desc.DepthStencil);
+
+		const uint32 targets = std::min(Desc.RenderTargetCount, PipelineBlendDesc::MaxRenderTargets);
+
+		writer.WriteBool(Desc.Blend.bAlphaToCoverage);
+		// With a single target both modes behave the same.
+		const bool bIndependent = Desc.Blend.bIndependentBlend && targets > 1;
+		writer.WriteBool(bIndependent);
+
+		// Without independent blend every target uses the first one's state; written once per target either way.
+		for (uint32 i = 0; i < targets; ++i)
+		{
+			WriteTargetBlend(writer, Desc.Blend.RenderTargets.at(bIndependent ? i : 0));
+		}
+
+		writer.Write32(Desc.SampleMask);
+		writer.Write32(Desc.PrimitiveTopology);
+		writer.Write32(targets);
+		for (uint32 i = 0; i < targets; ++i)
+		{
+			writer.Write32(Desc.RenderTargetFormats.at(i));
+		}
+		writer.Write32(Desc.DepthFormat);
+		writer.Write32(Desc.SampleCount);
+		writer.Write32(Desc.SampleQuality);
+	}
+
+	uint64 PipelineKey::Compute(const PipelineStateDesc& Desc)
+	{
+		std::vector<uint8> bytes;
+		bytes.reserve(512);
+		Canonicalize(Desc, bytes);
+
+		return Hash::FNV1a(bytes.data(), bytes.size());
+	}
+
+	uint64 PipelineKey::HashBlob(const void* pData, usize Size)
+	{
+		if (!pData || Size == 0)
+		{
+			return 0;
+		}
+
+		return Hash::FNV1a(pData, Size);
+	}
+
+} // namespace lde
@@ -1,6 +1,136 @@
 #pragma once
 
+/*
+	RHI/PipelineState.hpp
+	Backend agnostic description of a pipeline and its canonical hash.
+	Fields hold backend's enum values as plain integers, so hashing needs no API headers.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "RHI/Types.hpp"
+#include <array>
+#include <vector>
+
 namespace lde
 {
+	enum class PipelineShaderSlot : uint8
+	{
+		eVertex,
+		ePixel,
+		eCompute,
+		eAmplification,
+		eMesh,
+		COUNT
+	};
+
+	struct PipelineRasterDesc
+	{
+		uint32	FillMode				= 0;
+		uint32	CullMode				= 0;
+		bool	bFrontCounterClockwise	= false;
+		int32	DepthBias				= 0;
+		float	DepthBiasClamp			= 0.0f;
+		float	SlopeScaledDepthBias	= 0.0f;
+		bool	bDepthClip				= true;
+		bool	bMultisample			= false;
+		bool	bAntialiasedLine		= false;
+		uint32	ForcedSampleCount		= 0;
+		uint32	ConservativeRaster		= 0;
+	};
+
+	struct PipelineStencilOpDesc
+	{
+		uint32 FailOp		= 0;
+		uint32 DepthFailOp	= 0;
+		uint32 PassOp		= 0;
+		uint32 Func			= 0;
+	};
+
+	struct PipelineDepthStencilDesc
+	{
+		bool	bDepthEnable		= false;
+		uint32	DepthWriteMask		= 0;
+		uint32	DepthFunc			= 0;
+		bool	bStencilEnable		= false;
+		uint8	StencilReadMask		= 0xFF;
+		uint8	StencilWriteMask	= 0xFF;
+		PipelineStencilOpDesc FrontFace{};
+		PipelineStencilOpDesc BackFace{};
+	};
+
+	struct PipelineTargetBlendDesc
+	{
+		bool	bBlendEnable	= false;
+		bool	bLogicOpEnable	= false;
+		uint32	SrcBlend		= 0;
+		uint32	DestBlend		= 0;
+		uint32	BlendOp			= 0;
+		uint32	SrcBlendAlpha	= 0;
+		uint32	DestBlendAlpha	= 0;
+		uint32	BlendOpAlpha	= 0;
+		uint32	LogicOp			= 0;
+		uint8	WriteMask		= 0xF;
+	};
+
+	struct PipelineBlendDesc
+	{
+		static constexpr uint32 MaxRenderTargets = 8;
+
+		bool bAlphaToCoverage	= false;
+		bool bIndependentBlend	= false;
+		std::array<PipelineTargetBlendDesc, MaxRenderTargets> RenderTargets{};
+	};
+
+	struct PipelineStateDesc
+	{
+		PipelineType Type = PipelineType::eGraphics;
+
+		// Hash of serialized Root Signature.
+		uint64 RootSignature = 0;
+		// Hashes of shader bytecode per stage; 0 if stage is unused.
+		std::array<uint64, static_cast<usize>(PipelineShaderSlot::COUNT)> Shaders{};
+
+		PipelineRasterDesc			Raster{};
+		PipelineDepthStencilDesc	DepthStencil{};
+		PipelineBlendDesc			Blend{};
+
+		uint32 SampleMask			= UINT32_MAX;
+		uint32 PrimitiveTopology	= 0;
+		uint32 RenderTargetCount	= 0;
+		std::array<uint32, PipelineBlendDesc::MaxRenderTargets> RenderTargetFormats{};
+		uint32 DepthFormat			= 0;
+		uint32 SampleCount			= 1;
+		uint32 SampleQuality		= 0;
+	};
+
+	/**
+	 * @brief Canonical form of PipelineStateDesc: fields written one by one at fixed width in little-endian order,
+	 * so the result doesn't depend on struct layout, padding, compiler or host byte order.
+	 * Fields the pipeline ignores are written as zero, so descs differing only in them hash the same:
+	 * - graphics state of compute pipelines,
+	 * - depth write and function with depth disabled, stencil state with stencil disabled,
+	 * - blend factors with blending disabled, logic op with logic ops disabled,
+	 * - blend state and formats of targets past RenderTargetCount; targets past the first without independent blend.
+	 * Negative zero and NaN floats are folded to a single bit pattern.
+	 */
+	namespace PipelineKey
+	{
+		// Bumped whenever canonical form changes; invalidates keys persisted by older builds.
+		constexpr uint32 Version = 1;
+
+		extern void Canonicalize(const PipelineStateDesc& Desc, std::vector<uint8>& OutBytes);
+
+		/// @return 64-bit FNV-1a of canonical form.
+		extern uint64 Compute(const PipelineStateDesc& Desc);
+
+		/// @brief Hash of shader bytecode or serialized Root Signature.
+		extern uint64 HashBlob(const void* pData, usize Size);
+	} // namespace PipelineKey
 
+	/// @brief Base of backend pipeline objects; lets backend agnostic code bind them through CommandList.
+	class PipelineState
+	{
+	public:
+		virtual ~PipelineState() = default;
+	};
 } // namespace lde
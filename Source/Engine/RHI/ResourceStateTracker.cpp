@@ -0,0 +1,178 @@
+#include "ResourceStateTracker.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace lde
+{
+	void ResourceStateTracker::Register(uint64 Resource, uint32 State, uint32 SubresourceCount)
+	{
+		auto& resource = m_Resources[Resource];
+		resource.State				= State;
+		resource.SubresourceCount	= std::max(SubresourceCount, 1u);
+		resource.Subresources.clear();
+	}
+
+	void ResourceStateTracker::Forget(uint64 Resource)
+	{
+		if (m_Resources.erase(Resource) == 0)
+		{
+			return;
+		}
+
+		std::erase_if(m_Pending, [&](const StateTransition& Pending) { return Pending.Resource == Resource; });
+	}
+
+	bool ResourceStateTracker::Transition(uint64 Resource, uint32 State, uint32 Subresource)
+	{
+		auto it = m_Resources.find(Resource);
+		if (it == m_Resources.end())
+		{
+			return false;
+		}
+
+		++m_Stats.Requested;
+		auto& resource = it->second;
+
+		if (Subresource == AllSubresources)
+		{
+			if (resource.Subresources.empty())
+			{
+				Queue(Resource, AllSubresources, resource.State, State);
+			}
+			else
+			{
+				// Subresources diverged; each one needs its own before state.
+				for (uint32 i = 0; i < resource.SubresourceCount; ++i)
+				{
+					Queue(Resource, i, resource.Subresources.at(i), State);
+				}
+				resource.Subresources.clear();
+			}
+
+			resource.State = State;
+			return true;
+		}
+
+		assert(Subresource < resource.SubresourceCount);
+
+		if (resource.Subresources.empty())
+		{
+			if (resource.State == State)
+			{
+				++m_Stats.Skipped;
+				return true;
+			}
+
+			resource.Subresources.assign(resource.SubresourceCount, resource.State);
+		}
+
+		Queue(Resource, Subresource, resource.Subresources.at(Subresource), State);
+		resource.Subresources.at(Subresource) = State;
+
+		// Back to a single state once every subresource caught up.
+		if (std::all_of(resource.Subresources.begin(), resource.Subresources.end(), [&](uint32 Value) { return Value == State; }))
+		{
+			resource.State = State;
+			resource.Subresources.clear();
+		}
+
+		return true;
+	}
+
+	uint32 ResourceStateTracker::GetState(uint64 Resource, uint32 Subresource) const
+	{
+		auto it = m_Resources.find(Resource);
+		if (it == m_Resources.end())
+		{
+			return UINT32_MAX;
+		}
+
+		const auto& resource = it->second;
+		if (resource.Subresources.empty() || Subresource >= resource.SubresourceCount)
+		{
+			return resource.State;
+		}
+
+		return resource.Subresources.at(Subresource);
+	}
+
+	void ResourceStateTracker::Flush(std::vector<StateTransition>& OutTransitions)
+	{
+		const usize issued = OutTransitions.size();
+
+		for (const auto& pending : m_Pending)
+		{
+			// Round trips merged into Before == After.
+			if (pending.Before != pending.After)
+			{
+				OutTransitions.push_back(pending);
+			}
+		}
+
+		m_Pending.clear();
+
+		if (OutTransitions.size() > issued)
+		{
+			m_Stats.Issued += static_cast<uint32>(OutTransitions.size() - issued);
+			++m_Stats.Batches;
+		}
+	}
+
+	void ResourceStateTracker::Reset()
+	{
+		m_Resources.clear();
+		m_Pending.clear();
+	}
+
+	ResourceStateStats ResourceStateTracker::GetStats() const
+	{
+		ResourceStateStats stats = m_Stats;
+		stats.Tracked = static_cast<uint32>(m_Resources.size());
+		return stats;
+	}
+
+	void ResourceStateTracker::ResetStats()
+	{
+		m_Stats = {};
+	}
+
+	void ResourceStateTracker::Queue(uint64 Resource, uint32 Subresource, uint32 Before, uint32 After)
+	{
+		if (Before == After)
+		{
+			++m_Stats.Skipped;
+			return;
+		}
+
+		// Transitions of different subresources are independent, so the latest pending one of the same subresource
+		// may be extended past them. Whole resource transitions overlap every subresource; chain can't pass those.
+		for (auto it = m_Pending.rbegin(); it != m_Pending.rend(); ++it)
+		{
+			if (it->Resource != Resource)
+			{
+				continue;
+			}
+
+			if (it->Subresource == Subresource)
+			{
+				// Register may have overridden the state since; then the chain is broken.
+				if (it->After == Before)
+				{
+					it->After = After;
+					++m_Stats.Merged;
+					return;
+				}
+
+				break;
+			}
+
+			if (it->Subresource == AllSubresources || Subresource == AllSubresources)
+			{
+				break;
+			}
+		}
+
+		m_Pending.push_back(StateTransition{ Resource, Subresource, Before, After });
+	}
+
+} // namespace lde
@@ -0,0 +1,98 @@
+#pragma once
+
+/*
+	RHI/ResourceStateTracker.hpp
+	API agnostic resource state tracking.
+	Operates on opaque resource IDs and state values; backend turns resolved transitions into barriers.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	struct StateTransition
+	{
+		uint64 Resource		= 0;
+		uint32 Subresource	= 0;
+		uint32 Before		= 0;
+		uint32 After		= 0;
+	};
+
+	struct ResourceStateStats
+	{
+		uint32 Tracked		= 0;
+		// Transition calls since last ResetStats.
+		uint32 Requested	= 0;
+		// Requests for a state resource was already in.
+		uint32 Skipped		= 0;
+		// Requests folded into transition still pending for the same subresource.
+		uint32 Merged		= 0;
+		// Transitions handed to backend.
+		uint32 Issued		= 0;
+		// Flushes that issued at least one transition.
+		uint32 Batches		= 0;
+	};
+
+	/**
+	 * @brief Knows current state of every registered resource, per subresource when they differ.
+	 * Transition only needs target state; before state is inferred and transition is queued until Flush.
+	 * Requests for the same subresource collapse into one transition, round trips drop out entirely.
+	 * Subresource transitions merge past pending transitions of other subresources, but not past whole resource ones.
+	 * States are compared by value only; backend decides what they mean.
+	 */
+	class ResourceStateTracker
+	{
+	public:
+		static constexpr uint32 AllSubresources = UINT32_MAX;
+
+		/**
+		 * @brief Starts tracking Resource, or overrides its known state; all its subresources are in State.
+		 * Pending transitions of Resource are kept.
+		 */
+		void Register(uint64 Resource, uint32 State, uint32 SubresourceCount = 1);
+
+		/// @brief Stops tracking Resource and drops its pending transitions; i.e. when it's released.
+		void Forget(uint64 Resource);
+
+		bool IsTracked(uint64 Resource) const { return m_Resources.contains(Resource); }
+
+		/**
+		 * @brief Queues transition of Resource, or one of its subresources, into State.
+		 * @return False if Resource isn't registered; nothing is queued then.
+		 */
+		bool Transition(uint64 Resource, uint32 State, uint32 Subresource = AllSubresources);
+
+		/// @return State of the subresource after pending transitions; UINT32_MAX if Resource isn't registered.
+		uint32 GetState(uint64 Resource, uint32 Subresource = 0) const;
+
+		/// @brief Appends pending transitions, without no-ops, to OutTransitions in the order they have to be issued.
+		void Flush(std::vector<StateTransition>& OutTransitions);
+
+		bool HasPending() const { return !m_Pending.empty(); }
+
+		/// @brief Drops every resource and pending transition.
+		void Reset();
+
+		ResourceStateStats GetStats() const;
+		void ResetStats();
+
+	private:
+		struct TrackedResource
+		{
+			uint32 State			= 0;
+			uint32 SubresourceCount = 1;
+			// Empty while all subresources share State.
+			std::vector<uint32> Subresources;
+		};
+
+		void Queue(uint64 Resource, uint32 Subresource, uint32 Before, uint32 After);
+
+		std::unordered_map<uint64, TrackedResource> m_Resources;
+		std::vector<StateTransition> m_Pending;
+
+		ResourceStateStats m_Stats{};
+
+	};
+} // namespace lde
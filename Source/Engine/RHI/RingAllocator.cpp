@@ -0,0 +1,105 @@
+#include "RingAllocator.hpp"
+#include "Core/Math.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace lde
+{
+	RingAllocator::RingAllocator(uint64 Size, uint64 Alignment)
+	{
+		Initialize(Size, Alignment);
+	}
+
+	void RingAllocator::Initialize(uint64 Size, uint64 Alignment)
+	{
+		assert((Alignment & (Alignment - 1)) == 0);
+
+		m_Alignment = Alignment;
+		m_Size		= Size;
+
+		m_Batches.clear();
+		m_Head		= 0;
+		m_Tail		= 0;
+		m_Used		= 0;
+		m_OpenBytes = 0;
+
+		m_PeakSize			= 0;
+		m_FailedAllocations = 0;
+	}
+
+	uint64 RingAllocator::Allocate(uint64 Size, uint64 Alignment)
+	{
+		const uint64 alignment = (Alignment == 0) ? m_Alignment : std::max(Alignment, m_Alignment);
+
+		uint64 offset = Align(m_Head, alignment);
+		uint64 end = offset + Size;
+
+		// Free space is [Head, Size) + [0, Tail) when Head is ahead of Tail, [Head, Tail) otherwise.
+		const bool bWrapped = (m_Head < m_Tail) || (m_Head == m_Tail && m_Used > 0);
+		const uint64 limit = bWrapped ? m_Tail : m_Size;
+
+		if (end > limit)
+		{
+			// Skip the rest of the range and start over at 0; only possible before Tail.
+			if (bWrapped || Size > m_Tail)
+			{
+				m_FailedAllocations++;
+				return InvalidOffset;
+			}
+
+			offset	= 0;
+			end		= Size;
+		}
+
+		const uint64 bytes = (offset >= m_Head) ? (end - m_Head) : (m_Size - m_Head) + end;
+
+		m_Head		 = (end == m_Size) ? 0 : end;
+		m_Used		+= bytes;
+		m_OpenBytes += bytes;
+		m_PeakSize	 = std::max(m_PeakSize, m_Used);
+
+		return offset;
+	}
+
+	void RingAllocator::Submit(uint64 FenceValue)
+	{
+		if (m_OpenBytes == 0)
+		{
+			return;
+		}
+
+		assert(m_Batches.empty() || m_Batches.back().FenceValue <= FenceValue);
+
+		m_Batches.push_back(Batch{ .End = m_Head, .Bytes = m_OpenBytes, .FenceValue = FenceValue });
+		m_OpenBytes = 0;
+	}
+
+	uint32 RingAllocator::Retire(uint64 CompletedFenceValue)
+	{
+		uint32 retired = 0;
+
+		while (!m_Batches.empty() && m_Batches.front().FenceValue <= CompletedFenceValue)
+		{
+			const auto& batch = m_Batches.front();
+			m_Tail	= batch.End;
+			m_Used -= batch.Bytes;
+			m_Batches.pop_front();
+			++retired;
+		}
+
+		// Nothing in flight nor open; start from the beginning to keep allocations contiguous.
+		if (m_Used == 0)
+		{
+			m_Head = 0;
+			m_Tail = 0;
+		}
+
+		return retired;
+	}
+
+	uint64 RingAllocator::GetOldestFenceValue() const
+	{
+		return m_Batches.empty() ? 0 : m_Batches.front().FenceValue;
+	}
+
+} // namespace lde
@@ -0,0 +1,87 @@
+#pragma once
+
+/*
+	RHI/RingAllocator.hpp
+	API agnostic ring allocator for staging memory.
+	Operates on offsets only; backend owns actual memory and the fence.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <deque>
+
+namespace lde
+{
+	/**
+	 * @brief Allocates linearly around a circular range.
+	 * Allocations made between two Submit() calls form a batch tagged with a single fence value.
+	 * Batches are retired oldest-first once GPU reached their fence value, which frees their space.
+	 */
+	class RingAllocator
+	{
+	public:
+		static constexpr uint64 DefaultAlignment = 256;
+		static constexpr uint64 InvalidOffset	 = UINT64_MAX;
+
+		RingAllocator() = default;
+		RingAllocator(uint64 Size, uint64 Alignment = DefaultAlignment);
+
+		void Initialize(uint64 Size, uint64 Alignment = DefaultAlignment);
+
+		/**
+		 * @brief Contiguous allocation; never wraps in the middle. Space skipped at the end of the range counts as used until retired.
+		 * @param Size
+		 * @param Alignment 0 uses allocator's default alignment. Must be a power of two.
+		 * @return Offset from the start of the range, InvalidOffset if there is no room left until some batch retires.
+		 */
+		uint64 Allocate(uint64 Size, uint64 Alignment = 0);
+
+		/**
+		 * @brief Closes current batch.
+		 * @param FenceValue Value signaled once GPU is done with every allocation made since last Submit.
+		 */
+		void Submit(uint64 FenceValue);
+
+		/**
+		 * @brief Frees batches whose fence value was reached.
+		 * @param CompletedFenceValue Last value reached by GPU.
+		 * @return Number of retired batches.
+		 */
+		uint32 Retire(uint64 CompletedFenceValue);
+
+		/// @return Fence value of the oldest batch still in flight, 0 if there is none.
+		uint64 GetOldestFenceValue() const;
+
+		uint64 GetSize()			const { return m_Size; }
+		/// @brief Bytes allocated and not retired yet, including alignment and wrap padding.
+		uint64 GetUsedSize()		const { return m_Used; }
+		/// @brief Bytes allocated since last Submit.
+		uint64 GetOpenSize()		const { return m_OpenBytes; }
+		uint64 GetPeakSize()		const { return m_PeakSize; }
+		uint32 GetPendingBatches()	const { return static_cast<uint32>(m_Batches.size()); }
+		uint32 GetFailedAllocations() const { return m_FailedAllocations; }
+
+	private:
+		struct Batch
+		{
+			// Tail of the ring moves here once batch retires.
+			uint64 End			= 0;
+			uint64 Bytes		= 0;
+			uint64 FenceValue	= 0;
+		};
+
+		std::deque<Batch> m_Batches;
+
+		uint64 m_Size		= 0;
+		uint64 m_Alignment	= DefaultAlignment;
+
+		// Next allocation starts at Head, oldest live allocation at Tail.
+		uint64 m_Head		= 0;
+		uint64 m_Tail		= 0;
+		uint64 m_Used		= 0;
+		uint64 m_OpenBytes	= 0;
+
+		uint64 m_PeakSize			= 0;
+		uint32 m_FailedAllocations	= 0;
+
+	};
+} // namespace lde
@@ -0,0 +1,60 @@
+#include "UploadQueue.hpp"
+
+namespace lde
+{
+	UploadQueue::UploadQueue(uint64 Size, uint64 Alignment)
+	{
+		Initialize(Size, Alignment);
+	}
+
+	void UploadQueue::Initialize(uint64 Size, uint64 Alignment)
+	{
+		m_Ring.Initialize(Size, Alignment);
+		m_Copies.clear();
+		m_Stats = {};
+	}
+
+	uint64 UploadQueue::Queue(uint64 Destination, uint64 Size, uint32 State)
+	{
+		const uint64 offset = m_Ring.Allocate(Size);
+		if (offset == RingAllocator::InvalidOffset)
+		{
+			m_Stats.Rejected++;
+			return offset;
+		}
+
+		m_Copies.push_back(BufferCopy{ .Destination = Destination, .Offset = offset, .Size = Size, .State = State });
+		m_Stats.Queued++;
+
+		return offset;
+	}
+
+	void UploadQueue::Flush(std::vector<BufferCopy>& OutCopies)
+	{
+		if (m_Copies.empty())
+		{
+			return;
+		}
+
+		OutCopies.insert(OutCopies.end(), m_Copies.begin(), m_Copies.end());
+		m_Copies.clear();
+		m_Stats.Flushes++;
+	}
+
+	void UploadQueue::Submit(uint64 FenceValue)
+	{
+		if (!NeedsSignal())
+		{
+			return;
+		}
+
+		m_Ring.Submit(FenceValue);
+		m_Stats.Batches++;
+	}
+
+	uint32 UploadQueue::Retire(uint64 CompletedFenceValue)
+	{
+		return (m_Ring.GetPendingBatches() > 0) ? m_Ring.Retire(CompletedFenceValue) : 0;
+	}
+
+} // namespace lde
@@ -0,0 +1,86 @@
+#pragma once
+
+/*
+	RHI/UploadQueue.hpp
+	API agnostic batching of buffer uploads staged in a ring.
+	Operates on opaque destination IDs and state values; backend owns memory, records copies and signals the fence.
+*/
+
+#include "RHI/RingAllocator.hpp"
+#include <vector>
+
+namespace lde
+{
+	struct BufferCopy
+	{
+		uint64 Destination	= 0;
+		// Offset of staged data in the ring.
+		uint64 Offset		= 0;
+		uint64 Size			= 0;
+		// State of Destination after the copy.
+		uint32 State		= 0;
+	};
+
+	struct UploadQueueStats
+	{
+		// Copies queued since last ResetStats.
+		uint32 Queued		= 0;
+		// Queue calls that found no room in the ring.
+		uint32 Rejected		= 0;
+		// Flushes that handed at least one copy to backend.
+		uint32 Flushes		= 0;
+		// Batches tagged with a fence value.
+		uint32 Batches		= 0;
+	};
+
+	/**
+	 * @brief Copies are queued until Flush hands them to backend, which records them all, then all their barriers.
+	 * Once the list they were recorded to is submitted, backend signals a fence value and tags the batch with it by Submit.
+	 * Copies queued after a Flush share the open batch with flushed ones, so batch is only tagged once they were flushed too;
+	 * tagging it earlier would free their space as soon as the previous list completes.
+	 */
+	class UploadQueue
+	{
+	public:
+		UploadQueue() = default;
+		UploadQueue(uint64 Size, uint64 Alignment = RingAllocator::DefaultAlignment);
+
+		void Initialize(uint64 Size, uint64 Alignment = RingAllocator::DefaultAlignment);
+
+		/**
+		 * @brief Allocates ring space for data of Destination and queues its copy.
+		 * @return Offset to write data to, RingAllocator::InvalidOffset if ring has no room left until some batch retires.
+		 */
+		uint64 Queue(uint64 Destination, uint64 Size, uint32 State);
+
+		/// @brief Appends queued copies, in queue order, to OutCopies.
+		void Flush(std::vector<BufferCopy>& OutCopies);
+
+		/// @return True if every copy of the open batch was flushed; backend signals a fence value and passes it to Submit.
+		bool NeedsSignal() const { return m_Ring.GetOpenSize() > 0 && m_Copies.empty(); }
+
+		/// @brief Tags open batch with FenceValue. Ignored unless NeedsSignal.
+		void Submit(uint64 FenceValue);
+
+		/// @brief Frees ring space of batches that reached their fence value.
+		uint32 Retire(uint64 CompletedFenceValue);
+
+		/// @brief Drops queued copies; i.e. when backend releases its resources.
+		void Clear() { m_Copies.clear(); }
+
+		bool HasQueuedCopies()		const { return !m_Copies.empty(); }
+		uint32 GetQueuedCopies()	const { return static_cast<uint32>(m_Copies.size()); }
+
+		const RingAllocator& GetAllocator() const { return m_Ring; }
+
+		const UploadQueueStats& GetStats() const { return m_Stats; }
+		void ResetStats() { m_Stats = {}; }
+
+	private:
+		RingAllocator			m_Ring;
+		std::vector<BufferCopy> m_Copies;
+
+		UploadQueueStats m_Stats;
+
+	};
+} // namespace lde
@@ -0,0 +1,102 @@
+#include "Core/ThreadPool.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "RHI/Null/NullRHI.hpp"
+#include "Scene/Scene.hpp"
+#include "HeadlessRenderer.hpp"
+#include <chrono>
+
+namespace lde
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	static double ElapsedMs(Clock::time_point Start, Clock::time_point End)
+	{
+		return std::chrono::duration<double, std::milli>(End - Start).count();
+	}
+
+	HeadlessRenderer::HeadlessRenderer(NullRHI* pRHI, Scene* pScene)
+		: m_RHI(pRHI), m_Scene(pScene)
+	{
+		MeshRegistry::GetInstance().Initialize(pRHI->GetDevice());
+
+		m_Pipelines.reserve(SortKey::PipelineMask + 1);
+		for (uint32 pipeline = 0; pipeline <= SortKey::PipelineMask; ++pipeline)
+		{
+			m_PipelineTable.push_back(&m_Pipelines.emplace_back(pipeline));
+		}
+	}
+
+	void HeadlessRenderer::RenderFrame()
+	{
+		const auto frameStart = Clock::now();
+
+		m_RHI->BeginFrame();
+
+		m_Scene->Camera->Update();
+
+		// Nothing runs on the GPU, so streamed cells can be committed right away.
+		if (m_Scene->Partition.Update(m_Scene->Camera->GetPositionFloat()))
+		{
+			m_Scene->Partition.Commit(m_Scene);
+		}
+		const auto streamingEnd = Clock::now();
+
+		// Sorted by GBuffer permutation, as GBufferPass does.
+		m_RenderList.Gather(m_Scene, [](const StaticMesh& Mesh) { return GetMaterialFeatures(Mesh.Material); });
+		const auto gatherEnd = Clock::now();
+
+		const uint32 maxLists	= m_MaxRecordLists != 0 ? m_MaxRecordLists : ThreadPool::GetInstance().GetWorkerCount() + 1;
+		const uint32 lists		= m_RenderList.GetChunkCount(maxLists);
+
+		if (lists > 1)
+		{
+			m_RenderList.Record(m_RHI->GetDevice(), m_RHI->AcquireWorkerLists(lists), m_PipelineTable);
+		}
+		else
+		{
+			m_RenderList.Record(m_RHI->GetDevice(), m_RHI->GetGfxCommandList(), m_PipelineTable);
+		}
+		const auto recordEnd = Clock::now();
+
+		m_RHI->Present(false);
+
+		m_Stats.StreamingMs = ElapsedMs(frameStart, streamingEnd);
+		m_Stats.GatherMs	= ElapsedMs(streamingEnd, gatherEnd);
+		m_Stats.RecordMs	= ElapsedMs(gatherEnd, recordEnd);
+		m_Stats.FrameMs		= ElapsedMs(frameStart, Clock::now());
+		m_Stats.RecordLists	= lists;
+		m_Stats.List		= m_RenderList.GetStats();
+		m_Stats.Commands	= m_RHI->GetGfxCommandList()->GetStats();
+		m_Stats.Commands	+= m_RHI->GetWorkerStats();
+	}
+
+	HeadlessFrameStats HeadlessRenderer::Run(uint32 Frames)
+	{
+		HeadlessFrameStats total{};
+
+		for (uint32 frame = 0; frame < Frames; ++frame)
+		{
+			RenderFrame();
+
+			total.StreamingMs	+= m_Stats.StreamingMs;
+			total.GatherMs		+= m_Stats.GatherMs;
+			total.RecordMs		+= m_Stats.RecordMs;
+			total.FrameMs		+= m_Stats.FrameMs;
+		}
+
+		if (Frames > 0)
+		{
+			total.StreamingMs	/= Frames;
+			total.GatherMs		/= Frames;
+			total.RecordMs		/= Frames;
+			total.FrameMs		/= Frames;
+		}
+
+		total.RecordLists	= m_Stats.RecordLists;
+		total.List			= m_Stats.List;
+		total.Commands		= m_Stats.Commands;
+
+		return total;
+	}
+
+} // namespace lde
@@ -0,0 +1,70 @@
+#pragma once
+
+/*
+	Render/HeadlessRenderer.hpp
+	Frame loop over the Null RHI. Runs CPU side of a frame - camera, streaming,
+	draw list gathering and sorting, command recording - without window or GPU,
+	so each step can be timed on its own. Recording can be split across worker lists
+	to measure how it scales with threads.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "RHI/Null/NullCommandList.hpp"
+#include "RenderList.hpp"
+#include <vector>
+
+namespace lde
+{
+	class NullRHI;
+	class Scene;
+
+	/// @brief Timings are in milliseconds.
+	struct HeadlessFrameStats
+	{
+		double StreamingMs	= 0.0;
+		double GatherMs		= 0.0;
+		double RecordMs		= 0.0;
+		double FrameMs		= 0.0;
+
+		// Lists draws were recorded into; 1 when recorded on Graphics command list alone.
+		uint32 RecordLists	= 1;
+
+		RenderListStats		List{};
+		NullCommandStats	Commands{};
+	};
+
+	class HeadlessRenderer
+	{
+	public:
+		/// @brief Points MeshRegistry at the Null device; Scene content has to be loaded afterwards.
+		HeadlessRenderer(NullRHI* pRHI, Scene* pScene);
+
+		void RenderFrame();
+
+		/// @brief Renders given number of frames.
+		/// @return Per-step timings averaged over the frames; counters of the last one.
+		HeadlessFrameStats Run(uint32 Frames);
+
+		const HeadlessFrameStats& GetStats() const { return m_Stats; }
+
+		/**
+		 * @brief Upper bound of lists draws are split across; each is recorded on its own thread.
+		 * 0 uses every Thread Pool worker and the calling thread. Defaults to 1 - Graphics command list only.
+		 */
+		void SetRecordLists(uint32 Count) { m_MaxRecordLists = Count; }
+
+	private:
+		NullRHI*	m_RHI	= nullptr;
+		Scene*		m_Scene = nullptr;
+
+		RenderList m_RenderList;
+		uint32 m_MaxRecordLists = 1;
+
+		// One per value of the sort key's pipeline bits, as GBufferPass has one per permutation.
+		std::vector<NullPipelineState>	m_Pipelines;
+		std::vector<PipelineState*>		m_PipelineTable;
+
+		HeadlessFrameStats m_Stats{};
+
+	};
+} // namespace lde
@@ -0,0 +1,50 @@
+#include "LightBufferUpload.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace lde
+{
+	bool LightBufferUpload::AdvanceFrame()
+	{
+		return m_RetiredFrames > 0 && --m_RetiredFrames == 0;
+	}
+
+	LightBufferPlan LightBufferUpload::Prepare(uint32 Count, LightDirtyRange DirtyRange)
+	{
+		LightBufferPlan plan{};
+
+		if (!m_Pending.IsEmpty())
+		{
+			DirtyRange = DirtyRange.IsEmpty() ? m_Pending
+				: LightDirtyRange{ std::min(DirtyRange.Begin, m_Pending.Begin), std::max(DirtyRange.End, m_Pending.End) };
+		}
+		// Lights could have been removed since.
+		plan.Range = LightDirtyRange{ std::min(DirtyRange.Begin, Count), std::min(DirtyRange.End, Count) };
+
+		if (Count > m_Capacity || m_Capacity == 0)
+		{
+			// Buffer in use is kept for frames that may still read it.
+			if (m_Capacity > 0)
+			{
+				m_RetiredFrames = m_FramesInFlight;
+			}
+
+			m_Capacity		= std::max(MinCapacity, std::bit_ceil(Count));
+			plan.bGrow		= true;
+			plan.Capacity	= m_Capacity;
+			plan.Range		= LightDirtyRange{ 0, Count };
+		}
+
+		m_Pending = plan.Range;
+
+		return plan;
+	}
+
+	void LightBufferUpload::Reset()
+	{
+		m_Capacity		= 0;
+		m_RetiredFrames = 0;
+		m_Pending		= LightDirtyRange();
+	}
+
+} // namespace lde
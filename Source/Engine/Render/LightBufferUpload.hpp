@@ -0,0 +1,61 @@
+#pragma once
+
+/*
+	Render/LightBufferUpload.hpp
+	Bookkeeping of LightPass point light buffer: when it grows, which range is copied and when old buffer can go.
+	Holds no GPU resources, so upload failures can be exercised without a device.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Scene/SceneLighting.hpp"
+
+namespace lde
+{
+	/// @brief What LightPass has to do with its buffer this frame.
+	struct LightBufferPlan
+	{
+		// Buffer has to be created with Capacity lights; current one, if any, is retired.
+		bool	bGrow		= false;
+		uint32	Capacity	= 0;
+		// Lights to copy; stays pending until Commit.
+		LightDirtyRange Range{};
+	};
+
+	class LightBufferUpload
+	{
+	public:
+		static constexpr uint32 MinCapacity = 64;
+
+		/// @param FramesInFlight Frames retired buffer is kept alive for.
+		explicit LightBufferUpload(uint32 FramesInFlight) : m_FramesInFlight(FramesInFlight) { }
+
+		/**
+		 * @brief Call once per frame, before Prepare.
+		 * @return True once retired buffer is no longer used by any frame in flight and can be released.
+		 */
+		bool AdvanceFrame();
+
+		/**
+		 * @brief Range that couldn't be copied earlier is merged with DirtyRange and clamped to Count.
+		 * Growing buffer uploads every light, as new buffer starts out empty.
+		 */
+		LightBufferPlan Prepare(uint32 Count, LightDirtyRange DirtyRange);
+
+		/// @brief Copy of the last plan's range was recorded. Without it, the range is retried next Prepare.
+		void Commit() { m_Pending = LightDirtyRange(); }
+
+		/// @brief Buffers are released; next Prepare creates a new one.
+		void Reset();
+
+		uint32 GetCapacity() const { return m_Capacity; }
+		LightDirtyRange GetPending() const { return m_Pending; }
+		bool HasRetired() const { return m_RetiredFrames > 0; }
+
+	private:
+		uint32 m_FramesInFlight = 0;
+		uint32 m_Capacity		= 0;
+		uint32 m_RetiredFrames	= 0;
+		LightDirtyRange m_Pending{};
+
+	};
+} // namespace lde
@@ -0,0 +1,311 @@
+#include "Core/ThreadPool.hpp"
+#include "LightClusters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace lde
+{
+	using namespace DirectX;
+
+	namespace
+	{
+		constexpr uint32 CLUSTERS_PER_SLICE = CLUSTER_TILES_X * CLUSTER_TILES_Y;
+
+		// Padding lane that never intersects any cluster.
+		constexpr float PADDING_DEPTH = -1.0e30f;
+
+		inline uint32 AlignToFour(uint32 Value)
+		{
+			return (Value + 3u) & ~3u;
+		}
+	}
+
+	LightClusters::LightClusters()
+	{
+		m_MinX.resize(CLUSTER_COUNT);
+		m_MinY.resize(CLUSTER_COUNT);
+		m_MinZ.resize(CLUSTER_COUNT);
+		m_MaxX.resize(CLUSTER_COUNT);
+		m_MaxY.resize(CLUSTER_COUNT);
+		m_MaxZ.resize(CLUSTER_COUNT);
+		m_SliceNear.resize(CLUSTER_SLICES);
+		m_SliceFar.resize(CLUSTER_SLICES);
+
+		m_SliceIndices.resize(CLUSTER_SLICES);
+		m_SliceMaxCount.resize(CLUSTER_SLICES);
+		m_SliceOverflows.resize(CLUSTER_SLICES);
+
+		m_Ranges.resize(CLUSTER_COUNT);
+	}
+
+	void LightClusters::Build(FXMMATRIX View, CXMMATRIX Projection, float zNear, float MaxDistance,
+		uint32 Width, uint32 Height, std::span<const PointLightComponent> Lights)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		XMFLOAT4X4 projection{};
+		XMStoreFloat4x4(&projection, Projection);
+		UpdateBounds(projection, zNear, MaxDistance, Width, Height);
+
+		m_LightCount = static_cast<uint32>(Lights.size());
+		m_Info.LightCount = m_LightCount;
+
+		const uint32 paddedCount = AlignToFour(m_LightCount);
+		m_LightX.resize(paddedCount);
+		m_LightY.resize(paddedCount);
+		m_LightZ.resize(paddedCount);
+		m_LightRadius.resize(paddedCount);
+
+		for (uint32 i = 0; i < m_LightCount; ++i)
+		{
+			const auto& light = Lights[i];
+			XMFLOAT3 center{};
+			XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&light.Position), View));
+
+			m_LightX[i] = center.x;
+			m_LightY[i] = center.y;
+			m_LightZ[i] = center.z;
+			// Hidden lights take no slot in clusters.
+			m_LightRadius[i] = (light.Visibility > 0.0f) ? light.Range : -1.0f;
+		}
+
+		for (uint32 i = m_LightCount; i < paddedCount; ++i)
+		{
+			m_LightX[i] = 0.0f;
+			m_LightY[i] = 0.0f;
+			m_LightZ[i] = PADDING_DEPTH;
+			m_LightRadius[i] = -1.0f;
+		}
+
+		ThreadPool::GetInstance().ParallelFor(CLUSTER_SLICES, 1, [this](uint32 Begin, uint32 End)
+			{
+				for (uint32 slice = Begin; slice < End; ++slice)
+				{
+					CullSlice(slice);
+				}
+			});
+
+		// Merge slice lists into single index list.
+		m_Stats = LightClusterStats{};
+		m_Stats.Lights = m_LightCount;
+
+		uint32 totalIndices = 0;
+		for (uint32 slice = 0; slice < CLUSTER_SLICES; ++slice)
+		{
+			totalIndices += static_cast<uint32>(m_SliceIndices[slice].size());
+		}
+		m_Indices.resize(totalIndices);
+
+		uint32 base = 0;
+		for (uint32 slice = 0; slice < CLUSTER_SLICES; ++slice)
+		{
+			const auto& sliceIndices = m_SliceIndices[slice];
+			if (!sliceIndices.empty())
+			{
+				std::memcpy(m_Indices.data() + base, sliceIndices.data(), sliceIndices.size() * sizeof(uint32));
+			}
+
+			for (uint32 i = 0; i < CLUSTERS_PER_SLICE; ++i)
+			{
+				auto& range = m_Ranges[slice * CLUSTERS_PER_SLICE + i];
+				range.Offset += base;
+				m_Stats.ActiveClusters += (range.Count > 0) ? 1 : 0;
+			}
+
+			base += static_cast<uint32>(sliceIndices.size());
+			m_Stats.MaxPerCluster = std::max(m_Stats.MaxPerCluster, m_SliceMaxCount[slice]);
+			m_Stats.Overflows += m_SliceOverflows[slice];
+		}
+		m_Stats.Indices = totalIndices;
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		m_Stats.BuildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+	}
+
+	void LightClusters::UpdateBounds(const XMFLOAT4X4& Projection, float zNear, float MaxDistance, uint32 Width, uint32 Height)
+	{
+		m_Info.ScreenWidth	= static_cast<float>(std::max(Width, 1u));
+		m_Info.ScreenHeight = static_cast<float>(std::max(Height, 1u));
+
+		const float zFar = std::max(MaxDistance, zNear * 2.0f);
+
+		if (Projection._11 == m_CachedP00 && Projection._22 == m_CachedP11 && zNear == m_CachedNear && zFar == m_CachedFar)
+		{
+			return;
+		}
+
+		m_CachedP00		= Projection._11;
+		m_CachedP11		= Projection._22;
+		m_CachedNear	= zNear;
+		m_CachedFar		= zFar;
+
+		const float logRatio = std::log(zFar / zNear);
+		m_Info.SliceScale	= static_cast<float>(CLUSTER_SLICES) / logRatio;
+		m_Info.SliceBias	= static_cast<float>(CLUSTER_SLICES) * std::log(zNear) / logRatio;
+
+		for (uint32 slice = 0; slice < CLUSTER_SLICES; ++slice)
+		{
+			m_SliceNear[slice]	= zNear * std::pow(zFar / zNear, static_cast<float>(slice) / CLUSTER_SLICES);
+			m_SliceFar[slice]	= zNear * std::pow(zFar / zNear, static_cast<float>(slice + 1) / CLUSTER_SLICES);
+		}
+
+		// View space point at depth d for NDC (x, y) is (x * d / P00, y * d / P11, d).
+		const float invP00 = 1.0f / Projection._11;
+		const float invP11 = 1.0f / Projection._22;
+
+		for (uint32 slice = 0; slice < CLUSTER_SLICES; ++slice)
+		{
+			const float dNear = m_SliceNear[slice];
+			const float dFar  = m_SliceFar[slice];
+
+			for (uint32 y = 0; y < CLUSTER_TILES_Y; ++y)
+			{
+				// Tile rows go top to bottom, as SV_Position does.
+				const float ndcTop		= 1.0f - 2.0f * static_cast<float>(y) / CLUSTER_TILES_Y;
+				const float ndcBottom	= 1.0f - 2.0f * static_cast<float>(y + 1) / CLUSTER_TILES_Y;
+
+				for (uint32 x = 0; x < CLUSTER_TILES_X; ++x)
+				{
+					const float ndcLeft		= -1.0f + 2.0f * static_cast<float>(x) / CLUSTER_TILES_X;
+					const float ndcRight	= -1.0f + 2.0f * static_cast<float>(x + 1) / CLUSTER_TILES_X;
+
+					const uint32 cluster = x + y * CLUSTER_TILES_X + slice * CLUSTERS_PER_SLICE;
+
+					m_MinX[cluster] = std::min(ndcLeft * dNear, ndcLeft * dFar) * invP00;
+					m_MaxX[cluster] = std::max(ndcRight * dNear, ndcRight * dFar) * invP00;
+					m_MinY[cluster] = std::min(ndcBottom * dNear, ndcBottom * dFar) * invP11;
+					m_MaxY[cluster] = std::max(ndcTop * dNear, ndcTop * dFar) * invP11;
+					m_MinZ[cluster] = dNear;
+					m_MaxZ[cluster] = dFar;
+				}
+			}
+		}
+	}
+
+	void LightClusters::CullSlice(uint32 Slice)
+	{
+		// Lights overlapping slice depth range; reused by the thread between frames.
+		thread_local std::vector<float> candidateX, candidateY, candidateZ, candidateRadiusSq;
+		thread_local std::vector<uint32> candidateIDs;
+
+		candidateX.clear();
+		candidateY.clear();
+		candidateZ.clear();
+		candidateRadiusSq.clear();
+		candidateIDs.clear();
+
+		const float sliceNear = m_SliceNear[Slice];
+		const float sliceFar  = m_SliceFar[Slice];
+
+		for (uint32 i = 0; i < m_LightCount; ++i)
+		{
+			const float radius = m_LightRadius[i];
+			if (radius < 0.0f || m_LightZ[i] + radius < sliceNear || m_LightZ[i] - radius > sliceFar)
+			{
+				continue;
+			}
+
+			candidateX.push_back(m_LightX[i]);
+			candidateY.push_back(m_LightY[i]);
+			candidateZ.push_back(m_LightZ[i]);
+			candidateRadiusSq.push_back(radius * radius);
+			candidateIDs.push_back(i);
+		}
+
+		const uint32 candidateCount = static_cast<uint32>(candidateIDs.size());
+		const uint32 paddedCount = AlignToFour(candidateCount);
+		candidateX.resize(paddedCount, 0.0f);
+		candidateY.resize(paddedCount, 0.0f);
+		candidateZ.resize(paddedCount, PADDING_DEPTH);
+		candidateRadiusSq.resize(paddedCount, -1.0f);
+
+		auto& indices = m_SliceIndices[Slice];
+		indices.clear();
+
+		uint32 maxCount = 0;
+		uint32 overflows = 0;
+
+		const XMVECTOR zero = XMVectorZero();
+
+		for (uint32 tile = 0; tile < CLUSTERS_PER_SLICE; ++tile)
+		{
+			const uint32 cluster = Slice * CLUSTERS_PER_SLICE + tile;
+			auto& range = m_Ranges[cluster];
+			range.Offset = static_cast<uint32>(indices.size());
+			range.Count = 0;
+
+			if (candidateCount == 0)
+			{
+				continue;
+			}
+
+			const XMVECTOR minX = XMVectorReplicate(m_MinX[cluster]);
+			const XMVECTOR minY = XMVectorReplicate(m_MinY[cluster]);
+			const XMVECTOR minZ = XMVectorReplicate(m_MinZ[cluster]);
+			const XMVECTOR maxX = XMVectorReplicate(m_MaxX[cluster]);
+			const XMVECTOR maxY = XMVectorReplicate(m_MaxY[cluster]);
+			const XMVECTOR maxZ = XMVectorReplicate(m_MaxZ[cluster]);
+
+			uint32 count = 0;
+			bool bOverflow = false;
+
+			// Sphere vs AABB for four lights at once.
+			for (uint32 i = 0; i < paddedCount; i += 4)
+			{
+				const XMVECTOR x = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&candidateX[i]));
+				const XMVECTOR y = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&candidateY[i]));
+				const XMVECTOR z = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&candidateZ[i]));
+				const XMVECTOR radiusSq = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&candidateRadiusSq[i]));
+
+				const XMVECTOR dx = XMVectorMax(XMVectorMax(XMVectorSubtract(minX, x), XMVectorSubtract(x, maxX)), zero);
+				const XMVECTOR dy = XMVectorMax(XMVectorMax(XMVectorSubtract(minY, y), XMVectorSubtract(y, maxY)), zero);
+				const XMVECTOR dz = XMVectorMax(XMVectorMax(XMVectorSubtract(minZ, z), XMVectorSubtract(z, maxZ)), zero);
+
+				const XMVECTOR distanceSq = XMVectorMultiplyAdd(dx, dx, XMVectorMultiplyAdd(dy, dy, XMVectorMultiply(dz, dz)));
+
+				uint32 comparison = 0;
+				const XMVECTOR mask = XMVectorGreaterOrEqualR(&comparison, radiusSq, distanceSq);
+				if (XMComparisonAllFalse(comparison))
+				{
+					continue;
+				}
+
+				XMUINT4 lanes{};
+				XMStoreUInt4(&lanes, mask);
+				const uint32 laneMask[4] = { lanes.x, lanes.y, lanes.z, lanes.w };
+
+				for (uint32 lane = 0; lane < 4; ++lane)
+				{
+					if (!laneMask[lane])
+					{
+						continue;
+					}
+
+					if (count == MAX_LIGHTS_PER_CLUSTER)
+					{
+						bOverflow = true;
+						break;
+					}
+
+					indices.push_back(candidateIDs[i + lane]);
+					count++;
+				}
+
+				if (bOverflow)
+				{
+					break;
+				}
+			}
+
+			range.Count = count;
+			overflows += bOverflow ? 1 : 0;
+			maxCount = std::max(maxCount, count);
+		}
+
+		m_SliceMaxCount[Slice]	= maxCount;
+		m_SliceOverflows[Slice] = overflows;
+	}
+
+} // namespace lde
@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+	Render/LightClusters.hpp
+	CPU side clustered light assignment.
+	View frustum is split into froxels: screen tiles along X and Y, exponential slices along view depth.
+	Each froxel gets range into shared light index list. See Shaders/Cluster.hlsli for GPU side lookup.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Scene/Components/LightComponent.hpp"
+#include <DirectXMath.h>
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	constexpr uint32 CLUSTER_TILES_X			= 16;
+	constexpr uint32 CLUSTER_TILES_Y			= 9;
+	constexpr uint32 CLUSTER_SLICES				= 24;
+	constexpr uint32 CLUSTER_COUNT				= CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+	constexpr uint32 MAX_LIGHTS_PER_CLUSTER		= 256;
+
+	/// @brief Grid parameters for shader. Matches ClusterInfo in Shaders/Cluster.hlsli.
+	struct ClusterInfo
+	{
+		uint32	TilesX		= CLUSTER_TILES_X;
+		uint32	TilesY		= CLUSTER_TILES_Y;
+		uint32	Slices		= CLUSTER_SLICES;
+		uint32	LightCount	= 0;
+		float	ScreenWidth	= 1.0f;
+		float	ScreenHeight = 1.0f;
+		// Slice = log(ViewZ) * SliceScale - SliceBias
+		float	SliceScale	= 1.0f;
+		float	SliceBias	= 0.0f;
+	};
+
+	/// @brief Lights of a cluster are Indices[Offset, Offset + Count).
+	struct ClusterRange
+	{
+		uint32 Offset	= 0;
+		uint32 Count	= 0;
+	};
+
+	struct LightClusterStats
+	{
+		uint32 Lights			= 0;
+		uint32 Indices			= 0;
+		uint32 MaxPerCluster	= 0;
+		uint32 ActiveClusters	= 0;
+		// Clusters that had more lights than MAX_LIGHTS_PER_CLUSTER.
+		uint32 Overflows		= 0;
+		double BuildTimeMs		= 0.0;
+	};
+
+	class LightClusters
+	{
+	public:
+		LightClusters();
+
+		/**
+		 * @brief Assigns lights to clusters of a given view. Slices are culled in parallel on ThreadPool.
+		 * @param View
+		 * @param Projection Symmetric, left-handed perspective projection.
+		 * @param zNear Camera near plane.
+		 * @param MaxDistance Far bound of last slice; clustering up to camera far plane wastes slices.
+		 * @param Width Render target width.
+		 * @param Height Render target height.
+		 * @param Lights Point lights in world space. Range is used as sphere radius.
+		 */
+		void Build(DirectX::FXMMATRIX View, DirectX::CXMMATRIX Projection, float zNear, float MaxDistance,
+			uint32 Width, uint32 Height, std::span<const PointLightComponent> Lights);
+
+		const ClusterInfo& GetInfo() const { return m_Info; }
+
+		std::span<const ClusterRange>	GetRanges()		const { return m_Ranges; }
+		std::span<const uint32>			GetIndices()	const { return m_Indices; }
+
+		const LightClusterStats& GetStats() const { return m_Stats; }
+
+	private:
+		/// @brief Rebuilds view space AABBs of clusters, if projection or target size changed.
+		void UpdateBounds(const DirectX::XMFLOAT4X4& Projection, float zNear, float MaxDistance, uint32 Width, uint32 Height);
+
+		/// @brief Tests lights overlapping given slice against its clusters.
+		void CullSlice(uint32 Slice);
+
+		ClusterInfo m_Info{};
+
+		// Cluster AABBs in view space, SoA per axis.
+		std::vector<float> m_MinX, m_MinY, m_MinZ;
+		std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+		std::vector<float> m_SliceNear, m_SliceFar;
+
+		// View space light spheres, SoA padded to multiple of 4.
+		std::vector<float> m_LightX, m_LightY, m_LightZ, m_LightRadius;
+		uint32 m_LightCount = 0;
+
+		// Slice results written by workers, merged afterwards.
+		std::vector<std::vector<uint32>> m_SliceIndices;
+		std::vector<uint32> m_SliceMaxCount;
+		std::vector<uint32> m_SliceOverflows;
+
+		std::vector<ClusterRange>	m_Ranges;
+		std::vector<uint32>			m_Indices;
+
+		// Cached input of UpdateBounds.
+		float	m_CachedP00		= 0.0f;
+		float	m_CachedP11		= 0.0f;
+		float	m_CachedNear	= 0.0f;
+		float	m_CachedFar		= 0.0f;
+
+		LightClusterStats m_Stats{};
+
+	};
+} // namespace lde
@@ -0,0 +1,510 @@
+#include "RenderGraph.hpp"
+#include "RHI/ResourceStateTracker.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace lde
+{
+	namespace
+	{
+		inline uint64 AlignUp(uint64 Value, uint64 Alignment)
+		{
+			return (Value + Alignment - 1) & ~(Alignment - 1);
+		}
+
+		uint64 GetTextureSize(const RenderGraphTextureDesc& Desc)
+		{
+			uint64 size = 0;
+			for (uint32 mip = 0; mip < std::max(Desc.MipLevels, 1u); ++mip)
+			{
+				const uint64 width  = std::max(Desc.Width  >> mip, 1u);
+				const uint64 height = std::max(Desc.Height >> mip, 1u);
+				size += width * height * Desc.BytesPerPixel;
+			}
+
+			return AlignUp(size * std::max(Desc.ArraySize, 1u), RenderGraph::PlacementAlignment);
+		}
+	}
+
+	RenderGraphResource RenderGraph::CreateTexture(std::string_view Name, const RenderGraphTextureDesc& Desc)
+	{
+		RenderGraphTexture& texture = m_Resources.emplace_back();
+		texture.Name	= Name;
+		texture.Desc	= Desc;
+		texture.Size	= GetTextureSize(Desc);
+
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraph::Import(std::string_view Name, uint64 External, RenderGraphUsage InitialUsage)
+	{
+		RenderGraphTexture& texture = m_Resources.emplace_back();
+		texture.Name			= Name;
+		texture.External		= External;
+		texture.InitialUsage	= InitialUsage;
+		texture.bImported		= true;
+
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	void RenderGraph::MarkOutput(RenderGraphResource Resource)
+	{
+		m_Resources.at(Resource).bOutput = true;
+	}
+
+	uint32 RenderGraph::AddPass(std::string_view Name, std::function<void()> Execute)
+	{
+		RenderGraphPass& pass = m_Passes.emplace_back();
+		pass.Name		= Name;
+		pass.Execute	= std::move(Execute);
+
+		return static_cast<uint32>(m_Passes.size() - 1);
+	}
+
+	void RenderGraph::Read(uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Usage)
+	{
+		Access(Pass, Resource, Usage, false);
+	}
+
+	void RenderGraph::Write(uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Usage)
+	{
+		Access(Pass, Resource, Usage, true);
+	}
+
+	void RenderGraph::SetSideEffects(uint32 Pass)
+	{
+		m_Passes.at(Pass).bSideEffects = true;
+	}
+
+	void RenderGraph::Access(uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Usage, bool bWrite)
+	{
+		assert(Resource < m_Resources.size());
+
+		auto& accesses = m_Passes.at(Pass).Accesses;
+
+		// One access per resource; write wins.
+		auto it = std::find_if(accesses.begin(), accesses.end(), [&](const RenderGraphAccess& Access) { return Access.Resource == Resource; });
+		if (it != accesses.end())
+		{
+			if (bWrite || !it->bWrite)
+			{
+				it->Usage = Usage;
+			}
+			it->bWrite |= bWrite;
+			return;
+		}
+
+		accesses.push_back(RenderGraphAccess{ Resource, Usage, bWrite });
+	}
+
+	void RenderGraph::Compile()
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+
+		m_Stats = RenderGraphStats();
+		m_Stats.Passes		= static_cast<uint32>(m_Passes.size());
+		m_Stats.Resources	= static_cast<uint32>(m_Resources.size());
+
+		for (auto& pass : m_Passes)
+		{
+			pass.Barriers.clear();
+			pass.bCulled = false;
+		}
+
+		for (auto& resource : m_Resources)
+		{
+			resource.FirstUse		= UINT32_MAX;
+			resource.LastUse		= UINT32_MAX;
+			resource.MemorySlot		= UINT32_MAX;
+			resource.MemoryOffset	= 0;
+			resource.AliasedFrom	= InvalidResource;
+		}
+
+		BuildDependencies();
+		Cull();
+		Schedule();
+		ComputeLifetimes();
+		AssignMemory();
+		ComputeBarriers();
+
+		m_Stats.CompileTimeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void RenderGraph::Execute(const BarrierCallback& OnBarriers)
+	{
+		for (const uint32 index : m_Schedule)
+		{
+			const auto& pass = m_Passes.at(index);
+
+			if (OnBarriers && !pass.Barriers.empty())
+			{
+				OnBarriers(pass, pass.Barriers);
+			}
+
+			if (pass.Execute)
+			{
+				pass.Execute();
+			}
+		}
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_Passes.clear();
+		m_Resources.clear();
+		m_Schedule.clear();
+		m_Dependencies.clear();
+		m_Orderings.clear();
+		m_Stats = RenderGraphStats();
+	}
+
+	void RenderGraph::BuildDependencies()
+	{
+		m_Dependencies.assign(m_Passes.size(), {});
+		m_Orderings.assign(m_Passes.size(), {});
+
+		struct ResourceHistory
+		{
+			uint32 LastWriter = UINT32_MAX;
+			std::vector<uint32> Readers;
+		};
+		std::vector<ResourceHistory> history(m_Resources.size());
+
+		for (uint32 pass = 0; pass < m_Passes.size(); ++pass)
+		{
+			for (const auto& access : m_Passes.at(pass).Accesses)
+			{
+				auto& resource = history.at(access.Resource);
+
+				if (resource.LastWriter != UINT32_MAX)
+				{
+					// Writes usually keep what was there before, i.e. sky drawn over lit scene.
+					m_Dependencies.at(pass).push_back(resource.LastWriter);
+				}
+
+				if (access.bWrite)
+				{
+					for (const uint32 reader : resource.Readers)
+					{
+						if (reader != pass)
+						{
+							m_Orderings.at(pass).push_back(reader);
+						}
+					}
+
+					resource.Readers.clear();
+					resource.LastWriter = pass;
+				}
+				else
+				{
+					resource.Readers.push_back(pass);
+				}
+			}
+		}
+	}
+
+	void RenderGraph::Cull()
+	{
+		std::vector<uint32> stack;
+
+		for (uint32 pass = 0; pass < m_Passes.size(); ++pass)
+		{
+			auto& renderPass = m_Passes.at(pass);
+
+			const bool bWritesOutput = std::any_of(renderPass.Accesses.begin(), renderPass.Accesses.end(),
+				[&](const RenderGraphAccess& Access) { return Access.bWrite && m_Resources.at(Access.Resource).bOutput; });
+
+			renderPass.bCulled = !(renderPass.bSideEffects || bWritesOutput);
+			if (!renderPass.bCulled)
+			{
+				stack.push_back(pass);
+			}
+		}
+
+		while (!stack.empty())
+		{
+			const uint32 pass = stack.back();
+			stack.pop_back();
+
+			for (const uint32 dependency : m_Dependencies.at(pass))
+			{
+				if (m_Passes.at(dependency).bCulled)
+				{
+					m_Passes.at(dependency).bCulled = false;
+					stack.push_back(dependency);
+				}
+			}
+		}
+
+		m_Stats.CulledPasses = static_cast<uint32>(std::count_if(m_Passes.begin(), m_Passes.end(), [](const RenderGraphPass& Pass) { return Pass.bCulled; }));
+	}
+
+	void RenderGraph::Schedule()
+	{
+		m_Schedule.clear();
+
+		const uint32 passCount = static_cast<uint32>(m_Passes.size());
+
+		std::vector<uint32> pending(passCount, 0);
+		std::vector<std::vector<uint32>> dependents(passCount);
+
+		for (uint32 pass = 0; pass < passCount; ++pass)
+		{
+			if (m_Passes.at(pass).bCulled)
+			{
+				continue;
+			}
+
+			for (const auto* edges : { &m_Dependencies.at(pass), &m_Orderings.at(pass) })
+			{
+				for (const uint32 before : *edges)
+				{
+					if (!m_Passes.at(before).bCulled)
+					{
+						dependents.at(before).push_back(pass);
+						pending.at(pass)++;
+					}
+				}
+			}
+		}
+
+		// 1 + schedule position of the latest pass it waited for; 0 if none.
+		std::vector<uint32> latestInput(passCount, 0);
+		std::vector<uint32> ready;
+
+		for (uint32 pass = 0; pass < passCount; ++pass)
+		{
+			if (!m_Passes.at(pass).bCulled && pending.at(pass) == 0)
+			{
+				ready.push_back(pass);
+			}
+		}
+
+		while (!ready.empty())
+		{
+			// Consumer of what was just produced goes first, so transient lifetimes stay short;
+			// ties keep declaration order.
+			auto next = std::min_element(ready.begin(), ready.end(), [&](uint32 Lhs, uint32 Rhs)
+				{
+					if (latestInput.at(Lhs) != latestInput.at(Rhs))
+					{
+						return latestInput.at(Lhs) > latestInput.at(Rhs);
+					}
+					return Lhs < Rhs;
+				});
+
+			const uint32 pass = *next;
+			ready.erase(next);
+
+			m_Schedule.push_back(pass);
+			const uint32 position = static_cast<uint32>(m_Schedule.size());
+
+			for (const uint32 dependent : dependents.at(pass))
+			{
+				latestInput.at(dependent) = std::max(latestInput.at(dependent), position);
+				if (--pending.at(dependent) == 0)
+				{
+					ready.push_back(dependent);
+				}
+			}
+		}
+
+		// Edges only point from earlier to later declared passes, so there's no cycle to break.
+		assert(m_Schedule.size() == passCount - m_Stats.CulledPasses);
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		for (uint32 position = 0; position < m_Schedule.size(); ++position)
+		{
+			for (const auto& access : m_Passes.at(m_Schedule.at(position)).Accesses)
+			{
+				auto& resource = m_Resources.at(access.Resource);
+				if (resource.FirstUse == UINT32_MAX)
+				{
+					resource.FirstUse = position;
+				}
+				resource.LastUse = position;
+			}
+		}
+	}
+
+	void RenderGraph::AssignMemory()
+	{
+		std::vector<RenderGraphResource> transients;
+		for (RenderGraphResource resource = 0; resource < m_Resources.size(); ++resource)
+		{
+			const auto& texture = m_Resources.at(resource);
+			if (!texture.bImported && texture.FirstUse != UINT32_MAX)
+			{
+				transients.push_back(resource);
+				m_Stats.TransientBytes += texture.Size;
+			}
+		}
+
+		// Interval coloring: by start of lifetime, larger first on ties.
+		std::sort(transients.begin(), transients.end(), [&](RenderGraphResource Lhs, RenderGraphResource Rhs)
+			{
+				const auto& lhs = m_Resources.at(Lhs);
+				const auto& rhs = m_Resources.at(Rhs);
+				if (lhs.FirstUse != rhs.FirstUse)
+				{
+					return lhs.FirstUse < rhs.FirstUse;
+				}
+				if (lhs.Size != rhs.Size)
+				{
+					return lhs.Size > rhs.Size;
+				}
+				return Lhs < Rhs;
+			});
+
+		struct MemorySlot
+		{
+			uint64 Size		= 0;
+			uint32 LastUse	= 0;
+			RenderGraphResource Owner = InvalidResource;
+		};
+		std::vector<MemorySlot> slots;
+
+		for (const RenderGraphResource resource : transients)
+		{
+			auto& texture = m_Resources.at(resource);
+
+			// Best fit among slots free by now; if none is large enough, the largest one grows.
+			uint32 best = UINT32_MAX;
+			for (uint32 slot = 0; slot < slots.size(); ++slot)
+			{
+				if (slots.at(slot).LastUse >= texture.FirstUse)
+				{
+					continue;
+				}
+
+				if (best == UINT32_MAX)
+				{
+					best = slot;
+					continue;
+				}
+
+				const bool bFits	 = slots.at(slot).Size >= texture.Size;
+				const bool bBestFits = slots.at(best).Size >= texture.Size;
+
+				if (bFits != bBestFits)
+				{
+					best = bFits ? slot : best;
+				}
+				else if (bFits ? slots.at(slot).Size < slots.at(best).Size : slots.at(slot).Size > slots.at(best).Size)
+				{
+					best = slot;
+				}
+			}
+
+			if (best == UINT32_MAX)
+			{
+				best = static_cast<uint32>(slots.size());
+				slots.emplace_back();
+			}
+
+			auto& slot = slots.at(best);
+			texture.MemorySlot	= best;
+			texture.AliasedFrom = slot.Owner;
+
+			slot.Size		= std::max(slot.Size, texture.Size);
+			slot.LastUse	= texture.LastUse;
+			slot.Owner		= resource;
+		}
+
+		// Slots are laid out one after another in a single heap.
+		std::vector<uint64> offsets(slots.size(), 0);
+		uint64 offset = 0;
+		for (uint32 slot = 0; slot < slots.size(); ++slot)
+		{
+			offsets.at(slot) = offset;
+			offset += slots.at(slot).Size;
+		}
+
+		for (const RenderGraphResource resource : transients)
+		{
+			auto& texture = m_Resources.at(resource);
+			texture.MemoryOffset = offsets.at(texture.MemorySlot);
+		}
+
+		m_Stats.TransientResources	= static_cast<uint32>(transients.size());
+		m_Stats.MemorySlots			= static_cast<uint32>(slots.size());
+		m_Stats.AllocatedBytes		= offset;
+	}
+
+	void RenderGraph::ComputeBarriers()
+	{
+		ResourceStateTracker tracker;
+		std::vector<StateTransition> transitions;
+
+		for (RenderGraphResource resource = 0; resource < m_Resources.size(); ++resource)
+		{
+			const auto& texture = m_Resources.at(resource);
+			if (texture.bImported)
+			{
+				tracker.Register(resource, static_cast<uint32>(texture.InitialUsage));
+			}
+		}
+
+		for (uint32 position = 0; position < m_Schedule.size(); ++position)
+		{
+			auto& pass = m_Passes.at(m_Schedule.at(position));
+
+			for (const auto& access : pass.Accesses)
+			{
+				const auto& texture = m_Resources.at(access.Resource);
+
+				// Fresh transient starts in the state of its first use; only the memory changes hands.
+				if (!texture.bImported && texture.FirstUse == position)
+				{
+					tracker.Register(access.Resource, static_cast<uint32>(access.Usage));
+
+					if (texture.AliasedFrom != InvalidResource)
+					{
+						RenderGraphBarrier barrier{};
+						barrier.Resource	= access.Resource;
+						barrier.Type		= RenderGraphBarrierType::eAliasing;
+						barrier.Before		= access.Usage;
+						barrier.After		= access.Usage;
+						barrier.AliasedFrom = texture.AliasedFrom;
+						pass.Barriers.push_back(barrier);
+						m_Stats.AliasingBarriers++;
+					}
+					continue;
+				}
+
+				const auto state = static_cast<RenderGraphUsage>(tracker.GetState(access.Resource));
+				if (state == RenderGraphUsage::eUnorderedAccess && access.Usage == RenderGraphUsage::eUnorderedAccess)
+				{
+					RenderGraphBarrier barrier{};
+					barrier.Resource	= access.Resource;
+					barrier.Type		= RenderGraphBarrierType::eUnorderedAccess;
+					barrier.Before		= state;
+					barrier.After		= state;
+					pass.Barriers.push_back(barrier);
+					continue;
+				}
+
+				tracker.Transition(access.Resource, static_cast<uint32>(access.Usage));
+			}
+
+			transitions.clear();
+			tracker.Flush(transitions);
+
+			for (const auto& transition : transitions)
+			{
+				RenderGraphBarrier barrier{};
+				barrier.Resource	= static_cast<RenderGraphResource>(transition.Resource);
+				barrier.Type		= RenderGraphBarrierType::eTransition;
+				barrier.Before		= static_cast<RenderGraphUsage>(transition.Before);
+				barrier.After		= static_cast<RenderGraphUsage>(transition.After);
+				pass.Barriers.push_back(barrier);
+			}
+
+			m_Stats.Barriers += static_cast<uint32>(pass.Barriers.size());
+		}
+	}
+
+} // namespace lde
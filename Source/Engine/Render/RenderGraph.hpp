@@ -0,0 +1,185 @@
+#pragma once
+
+/*
+	Render/RenderGraph.hpp
+	Frame graph; passes declare resources they read and write, Compile culls, orders and plans barriers and memory.
+	Backend agnostic: imported resources carry opaque handle, transient ones are only described.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lde
+{
+	using RenderGraphResource = uint32;
+
+	/// @brief State resource has to be in while a pass uses it.
+	enum class RenderGraphUsage : uint8
+	{
+		eShaderRead,
+		eRenderTarget,
+		eDepthWrite,
+		eDepthRead,
+		eUnorderedAccess,
+		eCopySrc,
+		eCopyDst,
+		ePresent,
+	};
+
+	struct RenderGraphTextureDesc
+	{
+		uint32 Width			= 0;
+		uint32 Height			= 0;
+		uint32 BytesPerPixel	= 4;
+		uint32 MipLevels		= 1;
+		uint32 ArraySize		= 1;
+	};
+
+	enum class RenderGraphBarrierType : uint8
+	{
+		eTransition,
+		// Transient resource takes over memory of another one.
+		eAliasing,
+		// Consecutive unordered access writes.
+		eUnorderedAccess,
+	};
+
+	struct RenderGraphBarrier
+	{
+		RenderGraphResource		Resource	= UINT32_MAX;
+		RenderGraphBarrierType	Type		= RenderGraphBarrierType::eTransition;
+		RenderGraphUsage		Before		= RenderGraphUsage::eShaderRead;
+		RenderGraphUsage		After		= RenderGraphUsage::eShaderRead;
+		// Previous owner of the memory; aliasing barriers only.
+		RenderGraphResource		AliasedFrom = UINT32_MAX;
+	};
+
+	struct RenderGraphAccess
+	{
+		RenderGraphResource Resource	= UINT32_MAX;
+		RenderGraphUsage	Usage		= RenderGraphUsage::eShaderRead;
+		bool				bWrite		= false;
+	};
+
+	struct RenderGraphPass
+	{
+		std::string						Name;
+		std::function<void()>			Execute;
+		std::vector<RenderGraphAccess>	Accesses;
+		// Recorded before Execute; filled by Compile.
+		std::vector<RenderGraphBarrier> Barriers;
+		bool bSideEffects	= false;
+		bool bCulled		= false;
+	};
+
+	struct RenderGraphTexture
+	{
+		std::string				Name;
+		RenderGraphTextureDesc	Desc{};
+		// Imported only; i.e. ID3D12Resource pointer.
+		uint64					External		= 0;
+		RenderGraphUsage		InitialUsage	= RenderGraphUsage::eShaderRead;
+		// Transient only; aligned to RenderGraph::PlacementAlignment.
+		uint64					Size			= 0;
+		bool bImported	= false;
+		bool bOutput	= false;
+
+		// Positions in schedule of first and last pass using it; UINT32_MAX if no pass survived culling.
+		uint32 FirstUse		= UINT32_MAX;
+		uint32 LastUse		= UINT32_MAX;
+		// Transient only. Resources sharing a slot have disjoint lifetimes.
+		uint32 MemorySlot	= UINT32_MAX;
+		uint64 MemoryOffset	= 0;
+		RenderGraphResource AliasedFrom = UINT32_MAX;
+	};
+
+	struct RenderGraphStats
+	{
+		uint32 Passes				= 0;
+		uint32 CulledPasses			= 0;
+		uint32 Resources			= 0;
+		uint32 TransientResources	= 0;
+		uint32 Barriers				= 0;
+		uint32 AliasingBarriers		= 0;
+		uint32 MemorySlots			= 0;
+		// Transient memory without aliasing.
+		uint64 TransientBytes		= 0;
+		// Transient memory actually needed; sum of slot sizes.
+		uint64 AllocatedBytes		= 0;
+		float  CompileTimeMs		= 0.0f;
+	};
+
+	/**
+	 * @brief Passes are declared in submission order; dependencies come from that order:
+	 * reader depends on last writer, writer on last writer and readers before it.
+	 * Compile then
+	 * - culls passes whose results reach neither output resource nor pass with side effects,
+	 * - orders the rest topologically, preferring passes that consume what was just produced,
+	 * - plans transitions per pass,
+	 * - places transient textures in memory slots by interval coloring of their lifetimes.
+	 */
+	class RenderGraph
+	{
+	public:
+		static constexpr RenderGraphResource InvalidResource = UINT32_MAX;
+		// D3D12 default placement alignment.
+		static constexpr uint64 PlacementAlignment = 64 * 1024;
+
+		RenderGraphResource CreateTexture(std::string_view Name, const RenderGraphTextureDesc& Desc);
+		/// @param External Backend handle, handed back in barriers.
+		/// @param InitialUsage State resource is in before graph executes.
+		RenderGraphResource Import(std::string_view Name, uint64 External, RenderGraphUsage InitialUsage);
+		/// @brief Resource is consumed outside of the graph, i.e. displayed by Editor; its writers are never culled.
+		void MarkOutput(RenderGraphResource Resource);
+
+		uint32 AddPass(std::string_view Name, std::function<void()> Execute = {});
+		/// @brief Usage is the state pass needs; Read and Write only decide dependencies.
+		void Read(uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Usage = RenderGraphUsage::eShaderRead);
+		void Write(uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Usage = RenderGraphUsage::eRenderTarget);
+		/// @brief Pass is never culled; i.e. it writes outside of the graph.
+		void SetSideEffects(uint32 Pass);
+
+		void Compile();
+
+		using BarrierCallback = std::function<void(const RenderGraphPass&, std::span<const RenderGraphBarrier>)>;
+		/// @brief Runs scheduled passes; OnBarriers gets barriers of each pass before it runs.
+		void Execute(const BarrierCallback& OnBarriers = {});
+
+		/// @brief Drops passes and resources; capacity is kept for next frame.
+		void Reset();
+
+		std::span<const uint32>		GetSchedule() const { return m_Schedule; }
+		const RenderGraphPass&		GetPass(uint32 Pass) const { return m_Passes.at(Pass); }
+		const RenderGraphTexture&	GetResource(RenderGraphResource Resource) const { return m_Resources.at(Resource); }
+		const RenderGraphStats&		GetStats() const { return m_Stats; }
+
+		uint32 GetPassCount()		const { return static_cast<uint32>(m_Passes.size()); }
+		uint32 GetResourceCount()	const { return static_cast<uint32>(m_Resources.size()); }
+
+	private:
+		void Access(uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Usage, bool bWrite);
+
+		void BuildDependencies();
+		void Cull();
+		void Schedule();
+		void ComputeLifetimes();
+		void AssignMemory();
+		void ComputeBarriers();
+
+		std::vector<RenderGraphPass>	m_Passes;
+		std::vector<RenderGraphTexture> m_Resources;
+		std::vector<uint32>				m_Schedule;
+
+		// Per pass; passes whose results it consumes. They stay alive as long as it does.
+		std::vector<std::vector<uint32>> m_Dependencies;
+		// Per pass; passes that only have to run before it, i.e. readers of a resource it overwrites.
+		std::vector<std::vector<uint32>> m_Orderings;
+
+		RenderGraphStats m_Stats{};
+
+	};
+} // namespace lde
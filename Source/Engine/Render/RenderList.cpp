@@ -0,0 +1,336 @@
+#include "Core/Hash.hpp"
+#include "Core/ThreadPool.hpp"
+#include "RHI/CommandList.hpp"
+#include "RHI/Device.hpp"
+#include "Scene/Components/TransformComponent.hpp"
+#include "Scene/Scene.hpp"
+#include "RenderList.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace lde
+{
+	uint64 SortKey::Encode(RenderLayer Layer, uint32 Pipeline, uint32 Material, float ViewDepth)
+	{
+		// Bit pattern of non-negative float is monotonic, so top bits of it
+		// give logarithmic depth precision without knowing scene bounds.
+		const float depth = ViewDepth > 0.0f ? ViewDepth : 0.0f;
+		uint64 depthBits = (std::bit_cast<uint32>(depth) >> 7) & DepthMask;
+
+		// Transparent geometry must be drawn back-to-front.
+		if (Layer == RenderLayer::eTransparent)
+		{
+			depthBits = DepthMask - depthBits;
+		}
+
+		return ((static_cast<uint64>(Layer)	& LayerMask)	<< LayerShift)
+			|  ((static_cast<uint64>(Pipeline)	& PipelineMask)	<< PipelineShift)
+			|  ((static_cast<uint64>(Material)	& MaterialMask)	<< MaterialShift)
+			|  (depthBits << DepthShift);
+	}
+
+	void RenderList::Gather(Scene* pScene, uint32 Pipeline)
+	{
+		Gather(pScene, [Pipeline](const StaticMesh&) { return Pipeline; });
+	}
+
+	void RenderList::Gather(Scene* pScene, const PipelineSelector& SelectPipeline)
+	{
+		Clear();
+
+		auto* camera = pScene->GetCamera();
+		const DirectX::XMMATRIX view			= camera->GetView();
+		const DirectX::XMMATRIX viewProjection	= camera->GetViewProjection();
+
+		// Group meshes by geometry and material.
+		for (auto& model : pScene->Models)
+		{
+			auto& transform = model.GetComponent<TransformComponent>();
+
+			const DirectX::XMMATRIX WVP			= transform.WorldMatrix * viewProjection;
+			const DirectX::XMMATRIX worldView	= transform.WorldMatrix * view;
+			const InstanceData instance			= { DirectX::XMMatrixTranspose(WVP), DirectX::XMMatrixTranspose(transform.WorldMatrix) };
+
+			for (auto& mesh : model.GetStaticMeshes())
+			{
+				const DirectX::XMVECTOR center = DirectX::XMVectorScale(
+					DirectX::XMVectorAdd(DirectX::XMLoadFloat3(&mesh.AABB.Min), DirectX::XMLoadFloat3(&mesh.AABB.Max)), 0.5f);
+				const float viewDepth = DirectX::XMVectorGetZ(DirectX::XMVector3TransformCoord(center, worldView));
+
+				// MeshRegistry gives equal geometry the same buffers, so batches don't depend on which Model the mesh came from.
+				const uint64 groupKey = Hash::Combine(
+					Hash::FNV1a(&mesh.Material, sizeof(Material), mesh.GeometryHash),
+					(static_cast<uint64>(mesh.NumVertices) << 32) | mesh.NumIndices);
+
+				uint32 group = static_cast<uint32>(m_Groups.size());
+				if (auto it = m_GroupLookup.find(groupKey); it != m_GroupLookup.end())
+				{
+					// Guard against hash collisions; mismatching mesh gets its own group.
+					const StaticMesh* other = m_Groups.at(it->second).pMesh;
+					if (other->GeometryHash == mesh.GeometryHash &&
+						other->NumIndices == mesh.NumIndices &&
+						other->NumVertices == mesh.NumVertices &&
+						std::memcmp(&other->Material, &mesh.Material, sizeof(Material)) == 0)
+					{
+						group = it->second;
+					}
+				}
+				else
+				{
+					m_GroupLookup.emplace(groupKey, group);
+				}
+
+				if (group == m_Groups.size())
+				{
+					m_Groups.emplace_back(&mesh);
+				}
+
+				auto& instanceGroup = m_Groups.at(group);
+				instanceGroup.Count++;
+				instanceGroup.MinDepth = std::min(instanceGroup.MinDepth, viewDepth);
+
+				m_Pending.emplace_back(group, instance);
+			}
+		}
+
+		// Lay instances out contiguously per group.
+		uint32 offset = 0;
+		for (auto& group : m_Groups)
+		{
+			group.Offset = offset;
+			offset += group.Count;
+		}
+
+		m_Instances.resize(offset);
+		std::vector<uint32> cursors(m_Groups.size(), 0);
+		for (const auto& pending : m_Pending)
+		{
+			m_Instances.at(m_Groups.at(pending.Group).Offset + cursors.at(pending.Group)++) = pending.Data;
+		}
+
+		for (auto& group : m_Groups)
+		{
+			m_Items.emplace_back(
+				SortKey::Encode(RenderLayer::eOpaque, SelectPipeline(*group.pMesh), GetMaterialID(group.pMesh->Material), group.MinDepth),
+				group.pMesh,
+				group.Offset,
+				group.Count);
+		}
+
+		RadixSort(m_Items, m_Scratch);
+	}
+
+	std::vector<uint32> RenderList::GetPipelines() const
+	{
+		std::vector<uint32> pipelines;
+		for (const auto& item : m_Items)
+		{
+			pipelines.push_back(SortKey::GetPipeline(item.SortKey));
+		}
+
+		std::ranges::sort(pipelines);
+		pipelines.erase(std::unique(pipelines.begin(), pipelines.end()), pipelines.end());
+
+		return pipelines;
+	}
+
+	void RenderList::Record(Device* pDevice, CommandList* pCommandList, std::span<PipelineState*> Pipelines)
+	{
+		RecordRange(pDevice, pCommandList, Pipelines, 0, static_cast<uint32>(m_Items.size()), m_Stats);
+		m_Stats.Chunks++;
+	}
+
+	void RenderList::Record(Device* pDevice, std::span<CommandList*> Lists, std::span<PipelineState*> Pipelines)
+	{
+		RecordChunks(static_cast<uint32>(Lists.size()), [&](uint32 Chunk, uint32 Begin, uint32 End, RenderListStats& Stats)
+			{
+				RecordRange(pDevice, Lists[Chunk], Pipelines, Begin, End, Stats);
+			});
+	}
+
+	uint32 RenderList::GetChunkCount(uint32 MaxChunks) const
+	{
+		const uint32 chunks = static_cast<uint32>(m_Items.size()) / MinDrawsPerChunk;
+		return std::clamp(chunks, 1u, std::max(MaxChunks, 1u));
+	}
+
+	void RenderList::RecordChunks(uint32 Chunks, const std::function<void(uint32, uint32, uint32, RenderListStats&)>& Record)
+	{
+		if (Chunks == 0)
+		{
+			return;
+		}
+
+		// Chunk boundaries depend only on item and chunk count, never on scheduling.
+		const uint32 count = static_cast<uint32>(m_Items.size());
+		std::vector<RenderListStats> chunkStats(Chunks);
+
+		ThreadPool::GetInstance().ParallelFor(Chunks, 1, [&](uint32 Begin, uint32 End)
+			{
+				for (uint32 chunk = Begin; chunk < End; ++chunk)
+				{
+					const uint32 first	= static_cast<uint32>(static_cast<uint64>(count) * chunk / Chunks);
+					const uint32 last	= static_cast<uint32>(static_cast<uint64>(count) * (chunk + 1) / Chunks);
+					Record(chunk, first, last, chunkStats.at(chunk));
+				}
+			});
+
+		for (const auto& stats : chunkStats)
+		{
+			m_Stats += stats;
+		}
+		m_Stats.Chunks += Chunks;
+	}
+
+	void RenderList::RecordRange(Device* pDevice, CommandList* pCommandList, std::span<PipelineState*> Pipelines,
+		uint32 Begin, uint32 End, RenderListStats& Stats) const
+	{
+		DrawConstants drawConstants{};
+
+		uint32			lastPipeline		= UINT32_MAX;
+		BufferHandle	lastVertexBuffer	= UINT32_MAX;
+		BufferHandle	lastIndexBuffer		= UINT32_MAX;
+		const Material* lastMaterial		= nullptr;
+
+		for (uint32 index = Begin; index < End; ++index)
+		{
+			const auto& item = m_Items[index];
+
+			const uint32 pipeline = SortKey::GetPipeline(item.SortKey);
+			if (pipeline >= Pipelines.size() || !Pipelines[pipeline])
+			{
+				continue;
+			}
+
+			if (pipeline != lastPipeline)
+			{
+				pCommandList->BindPipeline(Pipelines[pipeline]);
+				lastPipeline = pipeline;
+				Stats.PipelineBinds++;
+			}
+			else
+			{
+				Stats.SkippedBinds++;
+			}
+
+			const StaticMesh& mesh = *item.pMesh;
+
+			if (mesh.VertexBuffer != lastVertexBuffer)
+			{
+				pCommandList->BindVertexBuffer(pDevice->LookupBuffer(mesh.VertexBuffer));
+				lastVertexBuffer = mesh.VertexBuffer;
+				Stats.VertexBufferBinds++;
+			}
+			else
+			{
+				Stats.SkippedBinds++;
+			}
+
+			drawConstants.BaseInstance = item.InstanceOffset;
+			pCommandList->PushConstants(0, 1, &drawConstants.BaseInstance, 1);
+
+			if (!lastMaterial || std::memcmp(lastMaterial, &mesh.Material, sizeof(Material)) != 0)
+			{
+				pCommandList->PushConstants(1, 16, &mesh.Material, 0);
+				lastMaterial = &mesh.Material;
+				Stats.MaterialBinds++;
+			}
+			else
+			{
+				Stats.SkippedBinds++;
+			}
+
+			if (mesh.NumIndices != 0)
+			{
+				if (mesh.IndexBuffer != lastIndexBuffer)
+				{
+					pCommandList->BindIndexBuffer(pDevice->LookupBuffer(mesh.IndexBuffer));
+					lastIndexBuffer = mesh.IndexBuffer;
+					Stats.IndexBufferBinds++;
+				}
+				else
+				{
+					Stats.SkippedBinds++;
+				}
+
+				pCommandList->DrawIndexedInstanced(item.InstanceCount, mesh.NumIndices, 0, 0);
+			}
+			else
+			{
+				pCommandList->DrawInstanced(item.InstanceCount, mesh.NumVertices, 0);
+			}
+
+			Stats.Draws++;
+			Stats.Instances += item.InstanceCount;
+		}
+	}
+
+	void RenderList::Clear()
+	{
+		m_Items.clear();
+		m_Groups.clear();
+		m_Pending.clear();
+		m_GroupLookup.clear();
+		m_InstanceAddress = 0;
+		m_Stats = RenderListStats();
+	}
+
+	void RenderList::RadixSort(std::vector<RenderItem>& Items, std::vector<RenderItem>& Scratch)
+	{
+		const usize count = Items.size();
+		if (count < 2)
+		{
+			return;
+		}
+
+		Scratch.resize(count);
+
+		RenderItem* src = Items.data();
+		RenderItem* dst = Scratch.data();
+
+		for (uint32 shift = 0; shift < 64; shift += 8)
+		{
+			std::array<uint32, 256> histogram{};
+			for (usize i = 0; i < count; ++i)
+			{
+				histogram[(src[i].SortKey >> shift) & 0xFF]++;
+			}
+
+			// Every key shares this byte; pass would be a plain copy.
+			if (histogram[(src[0].SortKey >> shift) & 0xFF] == count)
+			{
+				continue;
+			}
+
+			uint32 offset = 0;
+			for (auto& bucket : histogram)
+			{
+				const uint32 size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+
+			for (usize i = 0; i < count; ++i)
+			{
+				dst[histogram[(src[i].SortKey >> shift) & 0xFF]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != Items.data())
+		{
+			std::memcpy(Items.data(), src, count * sizeof(RenderItem));
+		}
+	}
+
+	uint32 RenderList::GetMaterialID(const Material& Material) const
+	{
+		// Identical materials across Models share an ID; fold hash to key width.
+		const uint64 hash = Hash::FNV1a(&Material, sizeof(Material));
+		return static_cast<uint32>((hash ^ (hash >> SortKey::MaterialBits) ^ (hash >> (2 * SortKey::MaterialBits))) & SortKey::MaterialMask);
+	}
+
+
+} // namespace lde
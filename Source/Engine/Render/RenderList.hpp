@@ -0,0 +1,237 @@
+#pragma once
+
+/*
+	Render/RenderList.hpp
+	Sort-key based draw list.
+	Meshes sharing geometry and material are merged into instanced draws,
+	every draw is turned into a single 64-bit key, keys are radix sorted
+	and draws are recorded in key order while skipping redundant state changes.
+	Sorted list can be split into chunks recorded on worker threads.
+*/
+
+#include <Core/CoreTypes.hpp>
+#include <RHI/BufferConstants.hpp>
+#include <RHI/RHICommon.hpp>
+#include <Scene/Model/Mesh.hpp>
+#include <array>
+#include <cfloat>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	class CommandList;
+	class D3D12CommandList;
+	class D3D12Device;
+	class Device;
+	class D3D12RHI;
+	struct D3D12PipelineState;
+	class PipelineState;
+	class Scene;
+
+	/// @brief Coarsest ordering level of the sort key.
+	/// Opaque draws are sorted front-to-back, transparent back-to-front.
+	enum class RenderLayer : uint8
+	{
+		eOpaque = 0,
+		eTransparent,
+		COUNT
+	};
+
+	/**
+	 * @brief 64-bit draw sort key.
+	 * | 63..60 Layer | 59..48 Pipeline | 47..24 Material | 23..0 Depth |
+	 */
+	namespace SortKey
+	{
+		constexpr uint64 DepthBits		= 24;
+		constexpr uint64 MaterialBits	= 24;
+		constexpr uint64 PipelineBits	= 12;
+		constexpr uint64 LayerBits		= 4;
+
+		constexpr uint64 DepthShift		= 0;
+		constexpr uint64 MaterialShift	= DepthShift + DepthBits;
+		constexpr uint64 PipelineShift	= MaterialShift + MaterialBits;
+		constexpr uint64 LayerShift		= PipelineShift + PipelineBits;
+
+		constexpr uint64 DepthMask		= (1ULL << DepthBits)	 - 1;
+		constexpr uint64 MaterialMask	= (1ULL << MaterialBits) - 1;
+		constexpr uint64 PipelineMask	= (1ULL << PipelineBits) - 1;
+		constexpr uint64 LayerMask		= (1ULL << LayerBits)	 - 1;
+
+		extern uint64 Encode(RenderLayer Layer, uint32 Pipeline, uint32 Material, float ViewDepth);
+
+		inline uint32 GetPipeline(uint64 Key) { return static_cast<uint32>((Key >> PipelineShift) & PipelineMask); }
+		inline uint32 GetMaterial(uint64 Key) { return static_cast<uint32>((Key >> MaterialShift) & MaterialMask); }
+	} // namespace SortKey
+
+	/// @brief Single entry of the draw list; one (possibly instanced) draw.
+	struct RenderItem
+	{
+		uint64				SortKey			= 0;
+		const StaticMesh*	pMesh			= nullptr;
+		uint32		InstanceOffset	= 0;
+		uint32		InstanceCount	= 1;
+	};
+
+	/// @brief Root constants at b1 of GBuffer Root Signature.
+	struct DrawConstants
+	{
+		uint32 VertexBufferIndex	= 0;
+		uint32 BaseInstance			= 0;
+	};
+
+	/// @brief Per-frame counters; reset on every Build().
+	struct RenderListStats
+	{
+		uint32 Draws				= 0;
+		uint32 Instances			= 0;
+		uint32 PipelineBinds		= 0;
+		uint32 VertexBufferBinds	= 0;
+		uint32 MaterialBinds		= 0;
+		uint32 IndexBufferBinds		= 0;
+		/// @brief State changes that were elided because the state was already bound.
+		uint32 SkippedBinds			= 0;
+		/// @brief Command lists the draws were split across; every one of them binds its state from scratch.
+		uint32 Chunks				= 0;
+
+		RenderListStats& operator+=(const RenderListStats& Other)
+		{
+			Draws				+= Other.Draws;
+			Instances			+= Other.Instances;
+			PipelineBinds		+= Other.PipelineBinds;
+			VertexBufferBinds	+= Other.VertexBufferBinds;
+			MaterialBinds		+= Other.MaterialBinds;
+			IndexBufferBinds	+= Other.IndexBufferBinds;
+			SkippedBinds		+= Other.SkippedBinds;
+			Chunks				+= Other.Chunks;
+			return *this;
+		}
+
+		uint32 TotalBinds() const
+		{
+			return PipelineBinds + VertexBufferBinds + MaterialBinds + IndexBufferBinds;
+		}
+	};
+
+	/// @brief Picks pipeline bits of the sort key for a mesh, i.e. its shader permutation.
+	using PipelineSelector = std::function<uint32(const StaticMesh& Mesh)>;
+
+	class RenderList
+	{
+	public:
+		RenderList() = default;
+
+		/**
+		 * @brief Gathers visible meshes of the Scene, merges repeated ones into instances,
+		 * uploads instance transforms for current frame through Device's frame allocator and sorts the list.
+		 * @param pGfx
+		 * @param pScene
+		 * @param Pipeline Index of Pipeline State used by the owning pass.
+		 */
+		void Build(D3D12RHI* pGfx, Scene* pScene, uint32 Pipeline = 0);
+
+		/// @brief Build with pipeline chosen per mesh; draws are sorted by it before material and depth.
+		void Build(D3D12RHI* pGfx, Scene* pScene, const PipelineSelector& SelectPipeline);
+
+		/**
+		 * @brief CPU part of Build; gathers, groups and sorts without uploading instances.
+		 * Instance data of the frame is available through GetInstances().
+		 */
+		void Gather(Scene* pScene, uint32 Pipeline = 0);
+		void Gather(Scene* pScene, const PipelineSelector& SelectPipeline);
+
+		/// @return Distinct pipeline bits of current items, ascending.
+		std::vector<uint32> GetPipelines() const;
+
+		/**
+		 * @brief Records draws in sorted order. Expects Root Signature to be already set.
+		 * Root layout: 2 constants b1 - DrawConstants, 16 constants b2 - material, root SRV t0 - instances.
+		 * Nothing is drawn if instances didn't fit into frame allocator.
+		 * @param pGfx
+		 * @param Pipelines Pipeline States indexed by the pipeline bits of the sort key; items without one are skipped.
+		 */
+		void Execute(D3D12RHI* pGfx, std::span<D3D12PipelineState*> Pipelines);
+
+		/**
+		 * @brief Splits sorted draws into contiguous chunks, one per list, and records them on worker threads.
+		 * Chunk i always goes to Lists[i], so submitting lists in order keeps the draw order of Execute.
+		 * @param Lists Open lists with Root Signature, targets and topology already set.
+		 */
+		void Execute(D3D12RHI* pGfx, std::span<D3D12CommandList*> Lists, std::span<D3D12PipelineState*> Pipelines);
+
+		/**
+		 * @brief Backend agnostic counterpart of Execute, for headless runs.
+		 * Binds pipelines and buffers through the RHI interfaces and skips the same redundant state changes.
+		 * @param Pipelines Indexed by the pipeline bits of the sort key; items without one are skipped.
+		 */
+		void Record(Device* pDevice, CommandList* pCommandList, std::span<PipelineState*> Pipelines);
+
+		/// @brief Backend agnostic counterpart of parallel Execute.
+		void Record(Device* pDevice, std::span<CommandList*> Lists, std::span<PipelineState*> Pipelines);
+
+		/**
+		 * @return Number of chunks worth recording in parallel, at most MaxChunks;
+		 * 1 if there are too few draws to pay for extra command lists.
+		 */
+		uint32 GetChunkCount(uint32 MaxChunks) const;
+
+		void Clear();
+
+		const RenderListStats& GetStats() const { return m_Stats; }
+		const std::vector<RenderItem>& GetItems() const { return m_Items; }
+		const std::vector<InstanceData>& GetInstances() const { return m_Instances; }
+
+		/// @brief Sorts items by SortKey; stable LSD radix sort, 8 bits per pass.
+		static void RadixSort(std::vector<RenderItem>& Items, std::vector<RenderItem>& Scratch);
+
+		/// @brief Smallest chunk GetChunkCount splits the list into.
+		static constexpr uint32 MinDrawsPerChunk = 128;
+
+	private:
+		uint32 GetMaterialID(const Material& Material) const;
+
+		/// @brief Copies instance data into Device's frame allocator; valid until GPU finishes current frame.
+		void UploadInstances(D3D12Device* pDevice);
+
+		/// @brief Records items [Begin, End) as if nothing was bound on the list before.
+		void ExecuteRange(D3D12Device* pDevice, D3D12CommandList* pCommandList, std::span<D3D12PipelineState*> Pipelines,
+			uint32 Begin, uint32 End, RenderListStats& Stats) const;
+		void RecordRange(Device* pDevice, CommandList* pCommandList, std::span<PipelineState*> Pipelines,
+			uint32 Begin, uint32 End, RenderListStats& Stats) const;
+
+		/// @brief Runs Record for each of Chunks contiguous ranges on the Thread Pool; stats are merged in chunk order.
+		void RecordChunks(uint32 Chunks, const std::function<void(uint32 Chunk, uint32 Begin, uint32 End, RenderListStats& Stats)>& Record);
+
+		std::vector<RenderItem> m_Items;
+		std::vector<RenderItem> m_Scratch;
+
+		// Instance grouping; rebuilt every frame.
+		struct InstanceGroup
+		{
+			const StaticMesh*	pMesh		= nullptr;
+			uint32				Count		= 0;
+			uint32				Offset		= 0;
+			float				MinDepth	= FLT_MAX;
+		};
+
+		struct PendingInstance
+		{
+			uint32		 Group = 0;
+			InstanceData Data{};
+		};
+
+		std::vector<InstanceGroup>			m_Groups;
+		std::vector<PendingInstance>		m_Pending;
+		std::unordered_map<uint64, uint32>	m_GroupLookup;
+		std::vector<InstanceData>			m_Instances;
+
+		// Instances of current frame; 0 if frame allocator ran out of space.
+		uint64 m_InstanceAddress = 0;
+
+		RenderListStats m_Stats{};
+
+	};
+} // namespace lde
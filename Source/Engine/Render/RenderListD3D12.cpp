@@ -0,0 +1,151 @@
+#include "Core/Logger.hpp"
+#include "RHI/D3D12/D3D12RHI.hpp"
+#include "RenderList.hpp"
+#include <cstring>
+
+/*===========================================================================================
+	Implements Build, Execute and instance upload of RenderList.hpp for D3D12 backend.
+	Kept apart, so the rest of RenderList builds without D3D12, i.e. for headless runs.
+===========================================================================================*/
+
+namespace lde
+{
+	void RenderList::Build(D3D12RHI* pGfx, Scene* pScene, uint32 Pipeline)
+	{
+		Gather(pScene, Pipeline);
+
+		UploadInstances(pGfx->Device.get());
+	}
+
+	void RenderList::Build(D3D12RHI* pGfx, Scene* pScene, const PipelineSelector& SelectPipeline)
+	{
+		Gather(pScene, SelectPipeline);
+
+		UploadInstances(pGfx->Device.get());
+	}
+
+	void RenderList::Execute(D3D12RHI* pGfx, std::span<D3D12PipelineState*> Pipelines)
+	{
+		auto* commandList = pGfx->Device->GetGfxCommandList();
+		commandList->Get()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+		ExecuteRange(pGfx->Device.get(), commandList, Pipelines, 0, static_cast<uint32>(m_Items.size()), m_Stats);
+		m_Stats.Chunks++;
+	}
+
+	void RenderList::Execute(D3D12RHI* pGfx, std::span<D3D12CommandList*> Lists, std::span<D3D12PipelineState*> Pipelines)
+	{
+		auto* device = pGfx->Device.get();
+
+		RecordChunks(static_cast<uint32>(Lists.size()), [&](uint32 Chunk, uint32 Begin, uint32 End, RenderListStats& Stats)
+			{
+				ExecuteRange(device, Lists[Chunk], Pipelines, Begin, End, Stats);
+			});
+	}
+
+	void RenderList::ExecuteRange(D3D12Device* pDevice, D3D12CommandList* pCommandList, std::span<D3D12PipelineState*> Pipelines,
+		uint32 Begin, uint32 End, RenderListStats& Stats) const
+	{
+		if (!m_InstanceAddress)
+		{
+			return;
+		}
+
+		// Lists inherit no root arguments, so each one binds instances on its own.
+		pCommandList->BindShaderResource(2, m_InstanceAddress);
+
+		DrawConstants drawConstants{};
+
+		uint32			lastPipeline		= UINT32_MAX;
+		BufferHandle	lastVertexBuffer	= UINT32_MAX;
+		BufferHandle	lastIndexBuffer		= UINT32_MAX;
+		const Material* lastMaterial		= nullptr;
+
+		for (uint32 index = Begin; index < End; ++index)
+		{
+			const auto& item = m_Items[index];
+
+			const uint32 pipeline = SortKey::GetPipeline(item.SortKey);
+			if (pipeline >= Pipelines.size() || !Pipelines[pipeline])
+			{
+				continue;
+			}
+
+			if (pipeline != lastPipeline)
+			{
+				pCommandList->Get()->SetPipelineState(Pipelines[pipeline]->Get());
+				lastPipeline = pipeline;
+				Stats.PipelineBinds++;
+			}
+			else
+			{
+				Stats.SkippedBinds++;
+			}
+
+			const StaticMesh& mesh = *item.pMesh;
+
+			if (mesh.VertexBuffer != lastVertexBuffer)
+			{
+				drawConstants.VertexBufferIndex = pDevice->Buffers.GetHot(mesh.VertexBuffer).ShaderResourceIndex;
+				// Push index to current Vertex Buffer.
+				pCommandList->PushConstants(0, 1, &drawConstants.VertexBufferIndex);
+				lastVertexBuffer = mesh.VertexBuffer;
+				Stats.VertexBufferBinds++;
+			}
+			else
+			{
+				Stats.SkippedBinds++;
+			}
+
+			// First instance changes every draw.
+			drawConstants.BaseInstance = item.InstanceOffset;
+			pCommandList->PushConstants(0, 1, &drawConstants.BaseInstance, 1);
+
+			// Material IDs are hashes, so actual contents decide whether constants must be pushed again.
+			if (!lastMaterial || std::memcmp(lastMaterial, &mesh.Material, sizeof(Material)) != 0)
+			{
+				// Push Material as constants; 64 bytes
+				pCommandList->PushConstants(1, 16, &mesh.Material, 0);
+				lastMaterial = &mesh.Material;
+				Stats.MaterialBinds++;
+			}
+			else
+			{
+				Stats.SkippedBinds++;
+			}
+
+			if (mesh.NumIndices != 0)
+			{
+				if (mesh.IndexBuffer != lastIndexBuffer)
+				{
+					pCommandList->BindIndexBuffer(pDevice->GetBuffer(mesh.IndexBuffer));
+					lastIndexBuffer = mesh.IndexBuffer;
+					Stats.IndexBufferBinds++;
+				}
+				else
+				{
+					Stats.SkippedBinds++;
+				}
+
+				pCommandList->DrawIndexedInstanced(item.InstanceCount, mesh.NumIndices, 0, 0);
+			}
+			else // Draw non-indexed
+			{
+				pCommandList->DrawInstanced(item.InstanceCount, mesh.NumVertices, 0);
+			}
+
+			Stats.Draws++;
+			Stats.Instances += item.InstanceCount;
+		}
+	}
+
+	void RenderList::UploadInstances(D3D12Device* pDevice)
+	{
+		m_InstanceAddress = pDevice->GetFrameAllocator()->UploadArray(std::span<const InstanceData>(m_Instances));
+		if (!m_InstanceAddress)
+		{
+			LOG_WARN("Frame allocator is full. Skipping GBuffer draws.");
+		}
+	}
+
+} // namespace lde
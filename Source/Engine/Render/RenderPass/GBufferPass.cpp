@@ -1,3 +1,5 @@
+#include "Core/Logger.hpp"
+#include "Core/ThreadPool.hpp"
 #include "RHI/D3D12/D3D12PipelineState.hpp"
 #include "RHI/D3D12/D3D12RootSignature.hpp"
 #include "RHI/D3D12/D3D12CommandList.hpp"
@@ -5,13 +7,29 @@
 #include "RHI/D3D12/D3D12RHI.hpp"
 #include "Scene/Scene.hpp"
 #include "RHI/D3D12/D3D12Utility.hpp"
+#include <chrono>
+#include <format>
 
 namespace lde
 {
+	namespace
+	{
+		constexpr std::string_view GBufferShader = "Shaders/Deferred/GBuffer.hlsl";
+	}
+
 	GBufferPass::GBufferPass(D3D12RHI* pGfx)
 	{
 		m_Gfx = pGfx;
 
+		m_Permutations.resize(m_Features.GetPermutationCount());
+		m_PipelineTable.resize(m_Features.GetPermutationCount(), nullptr);
+		m_PermutationStats.Declared = m_Features.GetPermutationCount();
+
+		// Base permutation compiles while render targets and Root Signature are created;
+		// it also leaves the shared Vertex Shader in the shader cache for the rest.
+		D3D12PipelineStateBuilder psoBuilder(m_Gfx->Device.get());
+		SetPermutationShaders(psoBuilder, 0);
+
 		m_RenderTargets.at(GBuffers::eDepth).Initialize(m_Gfx, DXGI_FORMAT_R8G8B8A8_UNORM, "GBuffer Depth");
 		m_RenderTargets.at(GBuffers::eBaseColor).Initialize(m_Gfx, DXGI_FORMAT_R8G8B8A8_UNORM, "GBuffer BaseColor");
 		m_RenderTargets.at(GBuffers::eTexCoords).Initialize(m_Gfx, DXGI_FORMAT_R8G8B8A8_UNORM, "GBuffer TexCoords");
@@ -22,36 +40,18 @@ namespace lde
 		
 		// Root Signature
 		{
-			m_RootSignature.AddCBV(0);			 // Per Object Matrices
-			m_RootSignature.AddConstants(1, 1);  // Index to Vertex Buffer
+			m_RootSignature.AddConstants(2, 1);  // Index to Vertex Buffer, base instance
 			m_RootSignature.AddConstants(16, 2); // Texture indices and properties
+			m_RootSignature.AddSRV(0, 0, D3D12_SHADER_VISIBILITY_VERTEX); // Instances of current frame
 			m_RootSignature.AddStaticSampler(0, 0, D3D12_FILTER_ANISOTROPIC, D3D12_TEXTURE_ADDRESS_MODE_WRAP, D3D12_COMPARISON_FUNC_LESS_EQUAL);
 			m_RootSignature.Build(m_Gfx->Device.get(), PipelineType::eGraphics, "GBuffer Root Signature");
 		}
 
-		// Pipeline State
-		D3D12PipelineStateBuilder psoBuilder(m_Gfx->Device.get());
-
 		// Base Pipeline
 		{
-			psoBuilder.SetVS("Shaders/Deferred/GBuffer.hlsl", L"VSmain");
-			psoBuilder.SetPS( "Shaders/Deferred/GBuffer.hlsl", L"PSmain");
-			psoBuilder.EnableDepth(true);
-			psoBuilder.SetCullMode(CullMode::eBack);
-			std::array<DXGI_FORMAT, (usize)GBuffers::COUNT> formats =
-			{
-				m_RenderTargets.at(GBuffers::eDepth).GetFormat(),
-				m_RenderTargets.at(GBuffers::eBaseColor).GetFormat(),
-				m_RenderTargets.at(GBuffers::eTexCoords).GetFormat(),
-				m_RenderTargets.at(GBuffers::eNormal).GetFormat(),
-				m_RenderTargets.at(GBuffers::eMetalRoughness).GetFormat(),
-				m_RenderTargets.at(GBuffers::eEmissive).GetFormat(),
-				m_RenderTargets.at(GBuffers::eWorldPosition).GetFormat()
-			};
-			psoBuilder.SetRenderTargetFormats(formats);
-
-			DX_CALL(psoBuilder.Build(m_PipelineState, &m_RootSignature));
-			psoBuilder.Reset();
+			const auto start = std::chrono::high_resolution_clock::now();
+			BuildPermutation(psoBuilder, 0);
+			m_PermutationStats.CompileTimeMs += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 		}
 	}
 
@@ -62,13 +62,13 @@ namespace lde
 
 	void GBufferPass::Render(Scene* pScene)
 	{
+		// Pipeline is bound per permutation by the Render List.
 		m_Gfx->SetRootSignature(&m_RootSignature);
-		m_Gfx->SetPipeline(&m_PipelineState);
 
+		// Render Graph transitions the targets.
 		std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> rtvs;
 		for (auto& renderTarget : m_RenderTargets)
 		{
-			m_Gfx->TransitResource(renderTarget.second.Get(), D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_RENDER_TARGET);
 			m_Gfx->ClearRenderTarget(renderTarget.second.GetRTV().GetCpuHandle());
 			rtvs.push_back(renderTarget.second.GetRTV().GetCpuHandle());
 		}
@@ -76,13 +76,40 @@ namespace lde
 		//m_Gfx->ClearDepthStencil();
 		m_Gfx->SetRenderTargets(rtvs, m_Gfx->SceneDepth->DSV().GetCpuHandle());
 
-		pScene->DrawScene();
+		// Draws are sorted by permutation, so each one is bound once per list.
+		m_RenderList.Build(m_Gfx, pScene, [](const StaticMesh& Mesh) { return GetMaterialFeatures(Mesh.Material); });
 
-		for (auto& rtv : m_RenderTargets)
+		// Only permutations some material needs are ever compiled; new ones show up as models are loaded.
+		std::vector<PermutationKey> missing;
+		for (const uint32 key : m_RenderList.GetPipelines())
 		{
-			m_Gfx->TransitResource(rtv.second.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_GENERIC_READ);
+			if (key < m_Permutations.size() && !m_Permutations.at(key))
+			{
+				missing.push_back(key);
+			}
+		}
+
+		if (!missing.empty())
+		{
+			CreatePermutations(missing);
+		}
+
+		std::span<D3D12PipelineState*> pipelines(m_PipelineTable);
+
+		// One chunk per pool worker and one for this thread.
+		const uint32 chunks = m_RenderList.GetChunkCount(ThreadPool::GetInstance().GetWorkerCount() + 1);
+		if (chunks > 1)
+		{
+			const auto depth = m_Gfx->SceneDepth->DSV().GetCpuHandle();
+			auto lists = m_Gfx->AcquireWorkerLists(chunks, &m_RootSignature, rtvs, &depth);
+			m_RenderList.Execute(m_Gfx, lists, pipelines);
+			// Clears and transitions recorded above go first, then chunks in draw order.
+			m_Gfx->ExecuteWorkerLists(lists);
+		}
+		else
+		{
+			m_RenderList.Execute(m_Gfx, pipelines);
 		}
-		
 	}
 
 	void GBufferPass::Resize(uint32 Width, uint32 Height)
@@ -95,9 +122,70 @@ namespace lde
 
 	void GBufferPass::Release()
 	{
+		m_PipelineTable.clear();
+		m_Permutations.clear();
+
 		m_RootSignature.Release();
 	}
 
+	void GBufferPass::SetPermutationShaders(D3D12PipelineStateBuilder& Builder, PermutationKey Key)
+	{
+		// Features only affect pixel stage; every permutation shares a single Vertex Shader.
+		Builder.SetVS(GBufferShader, L"VSmain");
+		Builder.SetPS(GBufferShader, L"PSmain", m_Features.GetDefines(Key));
+	}
+
+	void GBufferPass::BuildPermutation(D3D12PipelineStateBuilder& Builder, PermutationKey Key)
+	{
+		Builder.EnableDepth(true);
+		// Back faces of double sided materials get flipped normals in the shader.
+		const bool bDoubleSided = (Key & static_cast<uint32>(MaterialFeature::eDoubleSided)) != 0;
+		Builder.SetCullMode(bDoubleSided ? CullMode::eNone : CullMode::eBack);
+
+		std::array<DXGI_FORMAT, (usize)GBuffers::COUNT> formats =
+		{
+			m_RenderTargets.at(GBuffers::eDepth).GetFormat(),
+			m_RenderTargets.at(GBuffers::eBaseColor).GetFormat(),
+			m_RenderTargets.at(GBuffers::eTexCoords).GetFormat(),
+			m_RenderTargets.at(GBuffers::eNormal).GetFormat(),
+			m_RenderTargets.at(GBuffers::eMetalRoughness).GetFormat(),
+			m_RenderTargets.at(GBuffers::eEmissive).GetFormat(),
+			m_RenderTargets.at(GBuffers::eWorldPosition).GetFormat()
+		};
+		Builder.SetRenderTargetFormats(formats);
+
+		auto pipeline = std::make_unique<D3D12PipelineState>();
+		DX_CALL(Builder.Build(*pipeline, &m_RootSignature));
+		Builder.Reset();
+
+		m_PipelineTable.at(Key) = pipeline.get();
+		m_Permutations.at(Key) = std::move(pipeline);
+		m_PermutationStats.Compiled++;
+
+		LOG_INFO(std::format("GBuffer permutation {} created.", m_Features.GetName(Key)).c_str());
+	}
+
+	void GBufferPass::CreatePermutations(std::span<const PermutationKey> Keys)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+
+		// Every permutation starts compiling before the first one is waited on.
+		std::vector<std::unique_ptr<D3D12PipelineStateBuilder>> builders;
+		builders.reserve(Keys.size());
+		for (const PermutationKey key : Keys)
+		{
+			builders.push_back(std::make_unique<D3D12PipelineStateBuilder>(m_Gfx->Device.get()));
+			SetPermutationShaders(*builders.back(), key);
+		}
+
+		for (usize i = 0; i < Keys.size(); ++i)
+		{
+			BuildPermutation(*builders.at(i), Keys[i]);
+		}
+
+		m_PermutationStats.CompileTimeMs += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
 	std::array<int, 7> GBufferPass::GetTextureIndices()
 	{
 		std::array<int, 7> indices{};
@@ -7,8 +7,13 @@
 #include "RHI/D3D12/D3D12Texture.hpp"
 #include "RHI/D3D12/D3D12RootSignature.hpp"
 #include "RHI/D3D12/D3D12PipelineState.hpp"
+#include "Graphics/ShaderPermutation.hpp"
+#include "Render/RenderList.hpp"
 #include <Core/CoreTypes.hpp>
 #include <map>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace lde
 {
@@ -52,7 +57,7 @@ namespace lde
 		void Render(Scene* pScene);
 		void Resize(uint32 Width, uint32 Height);
 
-		std::map<GBuffers, D3D12RenderTexture> GetRenderTargets() const
+		std::map<GBuffers, D3D12RenderTexture>& GetRenderTargets()
 		{
 			return m_RenderTargets;
 		}
@@ -61,12 +66,30 @@ namespace lde
 		
 		std::array<int, 7> GetTextureIndices();
 
+		const RenderListStats& GetStats() const { return m_RenderList.GetStats(); }
+		const ShaderPermutationStats& GetPermutationStats() const { return m_PermutationStats; }
+
 	private:
+		/// @brief Starts compiling shaders of permutation Key; nothing waits yet.
+		void SetPermutationShaders(D3D12PipelineStateBuilder& Builder, PermutationKey Key);
+		/// @brief Waits for shaders set on Builder and creates pipeline of permutation Key.
+		void BuildPermutation(D3D12PipelineStateBuilder& Builder, PermutationKey Key);
+		/// @brief Compiles all Keys at once, then creates their pipelines.
+		void CreatePermutations(std::span<const PermutationKey> Keys);
+
 		PassContent m_GBuffer{};
 
 		D3D12RHI* m_Gfx = nullptr;
 		D3D12RootSignature m_RootSignature;
-		D3D12PipelineState m_PipelineState;
+
+		// Defines of GBuffer.hlsl, in MaterialFeature bit order.
+		ShaderFeatureSet m_Features{ { L"ALPHA_TEST", L"DOUBLE_SIDED", L"NO_NORMAL_MAP" } };
+		// Indexed by PermutationKey, which is also the pipeline of the sort key; created on first use.
+		std::vector<std::unique_ptr<D3D12PipelineState>> m_Permutations;
+		std::vector<D3D12PipelineState*> m_PipelineTable;
+		ShaderPermutationStats m_PermutationStats{};
+
+		RenderList m_RenderList;
 
 		std::map<GBuffers, D3D12RenderTexture> m_RenderTargets =
 		{
@@ -3,7 +3,13 @@
 #include "LightPass.hpp"
 #include "GBufferPass.hpp"
 #include <RHI/D3D12/D3D12RHI.hpp>
+#include <RHI/D3D12/D3D12Utility.hpp>
+#include <Core/Hash.hpp>
+#include <Core/Logger.hpp>
 #include <Graphics/Skybox.hpp>
+#include <Scene/Components/TransformComponent.hpp>
+#include <cmath>
+#include <cstring>
 
 namespace lde
 {
@@ -15,38 +21,63 @@ namespace lde
 
 	LightPass::~LightPass()
 	{	
+		Release();
 		m_Texture.reset();
 	}
 
 	void LightPass::Render(SceneCamera* pCamera, GBufferPass* pGBuffer, Skybox* pSkybox, Scene* pScene)
 	{
+		const auto viewport = m_Gfx->SceneViewport->GetViewport();
+		const uint32 width	= static_cast<uint32>(viewport.Width);
+		const uint32 height = static_cast<uint32>(viewport.Height);
+
 		// Send Shader data
 		m_SceneData.CameraPosition	= pCamera->GetPosition();
 		m_SceneData.View			= pCamera->GetView();
 		m_SceneData.InversedView	= XMMatrixTranspose(pCamera->GetInvView());
 		m_SceneData.Projection		= pCamera->GetProjection();
 		m_SceneData.InversedProjection = XMMatrixTranspose(pCamera->GetInvProjection());
+		m_SceneData.Width			= width;
+		m_SceneData.Height			= height;
+		m_SceneData.zNear			= pCamera->GetZNear();
+		m_SceneData.zFar			= pCamera->GetZFar();
 
-		auto* sceneConstBuffer = m_Gfx->Device->ConstantBuffers.at(m_SceneConstBuffer);
-		sceneConstBuffer->Update(&m_SceneData);
-		m_Gfx->BindConstantBuffer(sceneConstBuffer, 0);
+		auto* frameAllocator = m_Gfx->Device->GetFrameAllocator();
+		const auto sceneData = frameAllocator->Upload(m_SceneData);
 		
-		if (!pScene->PointLights.empty())
+		const auto dirtyRange = pScene->Lighting.Sync();
+		const auto pointLights = pScene->Lighting.GetPointLights();
+		UpdateLightBuffer(pointLights, dirtyRange);
+
+		m_Clusters.Build(pCamera->GetView(), pCamera->GetProjection(), pCamera->GetZNear(), ClusterDistance, width, height, pointLights);
+		m_LightsData.Clusters = m_Clusters.GetInfo();
+			
+		if (const auto* directional = pScene->Lighting.GetDirectionalLight())
 		{
-			for (usize i = 0; i < 4; ++i)
-			{
-				m_LightsData.Light[i] = pScene->PointLights.at(i)->GetComponent<PointLightComponent>();
-			}
+			m_LightsData.Directional = *directional;
 		}
-			
-		if (!pScene->DirectionalLights.empty())
+		if (bShadows)
 		{
-			m_LightsData.Directional = pScene->DirectionalLights.at(0)->GetComponent<DirectionalLightComponent>();
+			UpdateShadows(pCamera, pScene, pointLights);
 		}
 		
-		auto* lightingConstBuffer = m_Gfx->Device->ConstantBuffers.at(m_SceneLighting);
-		lightingConstBuffer->Update(&m_LightsData);
-		m_Gfx->BindConstantBuffer(lightingConstBuffer, 1);
+		const auto lightsData		= frameAllocator->Upload(m_LightsData);
+		const auto clusterRanges	= frameAllocator->UploadArray(m_Clusters.GetRanges());
+		const auto clusterIndices	= frameAllocator->UploadArray(m_Clusters.GetIndices());
+
+		// Frame allocator ran out of space; binding null address would fault on GPU.
+		if (!sceneData || !lightsData || !clusterRanges || !clusterIndices)
+		{
+			LOG_WARN("Frame allocator is full. Skipping light pass.");
+			return;
+		}
+
+		m_Gfx->BindConstantBuffer(sceneData, 0);
+		m_Gfx->BindConstantBuffer(lightsData, 1);
+
+		m_Gfx->BindShaderResource(m_LightBuffer.Resource->GetGPUVirtualAddress(), 4);
+		m_Gfx->BindShaderResource(clusterRanges, 5);
+		m_Gfx->BindShaderResource(clusterIndices, 6);
 
 		auto indices = pGBuffer->GetTextureIndices();
 		m_Gfx->Device->GetGfxCommandList()->PushConstants(2, 7, indices.data());
@@ -73,6 +104,147 @@ namespace lde
 
 	}
 
+	void LightPass::UpdateLightBuffer(std::span<const PointLightComponent> Lights, LightDirtyRange DirtyRange)
+	{
+		if (m_LightUpload.AdvanceFrame())
+		{
+			ReleaseLightBuffer(m_RetiredLightBuffer);
+		}
+
+		m_UploadedLights = 0;
+
+		const LightBufferPlan plan = m_LightUpload.Prepare(static_cast<uint32>(Lights.size()), DirtyRange);
+
+		if (plan.bGrow)
+		{
+			if (m_LightBuffer.Resource.Get())
+			{
+				ReleaseLightBuffer(m_RetiredLightBuffer);
+				m_RetiredLightBuffer = m_LightBuffer;
+			}
+
+			m_LightBuffer = AllocatedResource();
+			D3D12Memory::Allocate(m_LightBuffer, CreateBufferDesc(plan.Capacity * sizeof(PointLightComponent)), AllocType::eCopyDst);
+			SET_D3D12_NAME(m_LightBuffer.Resource, "LightPass Point Lights");
+
+			m_bLightBufferCopyDest = true;
+		}
+
+		if (!plan.Range.IsEmpty())
+		{
+			const uint64 offset	= plan.Range.Begin * sizeof(PointLightComponent);
+			const uint64 size	= (plan.Range.End - plan.Range.Begin) * sizeof(PointLightComponent);
+
+			// Without staging space the range stays pending and is retried next frame.
+			const auto staging = m_Gfx->Device->GetFrameAllocator()->Allocate(size);
+			if (staging.IsValid())
+			{
+				std::memcpy(staging.pCpuAddress, Lights.data() + plan.Range.Begin, size);
+
+				if (!m_bLightBufferCopyDest)
+				{
+					m_Gfx->TransitResource(m_LightBuffer.Resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
+					m_bLightBufferCopyDest = true;
+				}
+
+				m_Gfx->Device->GetGfxCommandList()->Get()->CopyBufferRegion(m_LightBuffer.Resource.Get(), offset, staging.pResource, staging.Offset, size);
+				m_UploadedLights = plan.Range.End - plan.Range.Begin;
+				m_LightUpload.Commit();
+			}
+		}
+
+		if (m_bLightBufferCopyDest)
+		{
+			m_Gfx->TransitResource(m_LightBuffer.Resource, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+			m_bLightBufferCopyDest = false;
+		}
+	}
+
+	void LightPass::Release()
+	{
+		ReleaseLightBuffer(m_LightBuffer);
+		ReleaseLightBuffer(m_RetiredLightBuffer);
+		m_LightUpload.Reset();
+	}
+
+	void LightPass::ReleaseLightBuffer(AllocatedResource& Buffer)
+	{
+		// Next buffer may get the same address.
+		if (Buffer.Resource.Get())
+		{
+			m_Gfx->Device->GetStateTracker()->Forget(Buffer.Resource.Get());
+		}
+
+		SAFE_RELEASE(Buffer.Allocation);
+		SAFE_RELEASE(Buffer.Resource);
+	}
+
+	void LightPass::UpdateShadows(SceneCamera* pCamera, Scene* pScene, std::span<const PointLightComponent> PointLights)
+	{
+		m_ShadowBounds.clear();
+		for (auto& model : pScene->Models)
+		{
+			const auto& transform = model.GetComponent<TransformComponent>();
+			for (const auto& mesh : model.GetStaticMeshes())
+			{
+				m_ShadowBounds.push_back(ShadowMap::TransformBounds(mesh.AABB, transform.WorldMatrix));
+			}
+		}
+
+		if (pScene->Lighting.GetDirectionalLight())
+		{
+			m_ShadowMap.Update(pCamera->GetView(), pCamera->GetProjection(), pCamera->GetZNear(), pCamera->GetZFar(),
+				m_LightsData.Directional.Direction, m_ShadowBounds);
+		}
+
+		// Cached atlas tiles stay valid until either light or any geometry changes.
+		const uint64 geometryVersion = Hash::FNV1a(std::span<const BoundingBox>(m_ShadowBounds));
+
+		const XMMATRIX view = pCamera->GetView();
+		const XMFLOAT4X4 projection = pCamera->GetProjectionFloats();
+		const float zNear = pCamera->GetZNear();
+
+		m_AtlasRequests.clear();
+		for (uint32 i = 0; i < static_cast<uint32>(PointLights.size()); ++i)
+		{
+			const auto& light = PointLights[i];
+			if (light.Visibility <= 0.0f)
+			{
+				continue;
+			}
+
+			XMFLOAT3 center{};
+			XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&light.Position), view));
+			if (center.z + light.Range < zNear || center.z - light.Range > ClusterDistance)
+			{
+				continue;
+			}
+
+			// Projected sphere as fraction of the screen.
+			float coverage = 1.0f;
+			const float distanceSq = center.x * center.x + center.y * center.y + center.z * center.z;
+			const float rangeSq = light.Range * light.Range;
+			if (distanceSq > rangeSq)
+			{
+				const float tangentDistance = std::sqrt(distanceSq - rangeSq);
+				const float radiusX = light.Range * projection._11 / tangentDistance;
+				const float radiusY = light.Range * projection._22 / tangentDistance;
+				coverage = std::min(XM_PI * radiusX * radiusY * 0.25f, 1.0f);
+			}
+
+			uint64 version = Hash::FNV1a(&light.Position, sizeof(light.Position), geometryVersion);
+			version = Hash::FNV1a(&light.Range, sizeof(light.Range), version);
+
+			// Lights are keyed by packed index; reordered light gets different version and is redrawn.
+			for (uint32 face = 0; face < 6; ++face)
+			{
+				m_AtlasRequests.push_back(ShadowAtlasRequest{ (static_cast<uint64>(i) << 3) | face, coverage, light.Visibility, version });
+			}
+		}
+
+		m_ShadowAtlas.Update(m_AtlasRequests);
+	}
+
 	void LightPass::Resize(uint32 Width, uint32 Height)
 	{
 		m_Texture->OnResize(Width, Height);
@@ -87,9 +259,5 @@ namespace lde
 		//std::array<uint32, 6> indices = { 0, 1, 2, 2, 3, 0 };
 		//m_IndexBuffer = pGfx->GetDevice()->CreateBuffer(BufferDesc(BufferUsage::eIndex, indices.data(), 6, 24, 4, false));
 
-		m_SceneConstBuffer = pGfx->GetDevice()->CreateConstantBuffer(&m_SceneData, sizeof(m_SceneData));
-
-		m_SceneLighting = pGfx->GetDevice()->CreateConstantBuffer(&m_LightsData, sizeof(m_LightsData));
-
 	}
 } // namespace lde
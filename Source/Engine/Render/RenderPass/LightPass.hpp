@@ -1,8 +1,15 @@
 #pragma once
 
 #include <Core/CoreTypes.hpp>
+#include <Graphics/ShadowAtlas.hpp>
+#include <Graphics/ShadowMap.hpp>
 #include <RHI/Buffer.hpp>
+#include <RHI/RHICommon.hpp>
+#include <RHI/D3D12/D3D12Memory.hpp>
+#include <Render/LightBufferUpload.hpp>
+#include <Render/LightClusters.hpp>
 #include <Scene/Components/LightComponent.hpp>
+#include <Scene/SceneLighting.hpp>
 #include <memory>
 
 namespace lde
@@ -19,7 +26,8 @@ namespace lde
 	{
 		// Global light
 		DirectionalLightComponent	Directional;
-		PointLightComponent			Light[4];
+		// Point lights are read from clustered lists.
+		ClusterInfo					Clusters;
 	};
 
 	class LightPass
@@ -36,22 +44,66 @@ namespace lde
 
 		D3D12RenderTexture* GetRenderTexture() { return m_Texture.get(); }
 
-		std::vector<PointLightComponent>& GetPointLights() { return m_PointLights; }
+		/// @brief Point lights copied to GPU during last frame.
+		uint32 GetUploadedLights() const { return m_UploadedLights; }
+
+		const LightClusterStats& GetClusterStats() const { return m_Clusters.GetStats(); }
+
+		/// @brief Cascades of directional light; updated only if Scene has one.
+		const ShadowMap& GetShadowMap() const { return m_ShadowMap; }
+
+		/// @brief Tiles of point light faces; no shadow pass draws into them yet.
+		const ShadowAtlas& GetShadowAtlas() const { return m_ShadowAtlas; }
+
+		/// @brief Lights further than that from camera are not clustered.
+		float ClusterDistance = 1000.0f;
+
+		/// @brief Fits cascades and assigns atlas tiles every frame. Off until a shadow pass and shader consume them.
+		bool bShadows = false;
 
 	private:
 		std::unique_ptr<D3D12RenderTexture> m_Texture;
 		D3D12RHI* m_Gfx = nullptr;
 	
-		BufferHandle m_SceneConstBuffer = 0;
 		SceneData m_SceneData{};
 
-		BufferHandle m_SceneLighting = 0;
 		DirectionalLightComponent m_DirLight{};
 		LightData m_LightsData{};
 
 		void Create(D3D12RHI* pGfx);
 
-		std::vector<PointLightComponent> m_PointLights{};
+		/**
+		 * @brief Copies changed range of point lights into GPU buffer.
+		 * Buffer is recreated and fully uploaded only when it has to grow.
+		 * Range stays pending until its copy is recorded, so lights aren't lost when frame allocator runs out.
+		 */
+		void UpdateLightBuffer(std::span<const PointLightComponent> Lights, LightDirtyRange DirtyRange);
+		/// @brief Also drops buffer from Device's state tracker.
+		void ReleaseLightBuffer(AllocatedResource& Buffer);
+
+		// Point lights in packed registry order, same as SceneLighting.
+		AllocatedResource	m_LightBuffer;
+		bool				m_bLightBufferCopyDest = false;
+		uint32				m_UploadedLights	= 0;
+		LightBufferUpload	m_LightUpload{ FRAME_COUNT };
+
+		// Previous buffer after growing; kept alive until frames that used it are done.
+		AllocatedResource	m_RetiredLightBuffer;
+
+		LightClusters m_Clusters;
+
+		/**
+		 * @brief Gathers casters from Scene Models, fits shadow cascades to camera
+		 * and assigns atlas tiles to faces of visible point lights.
+		 */
+		void UpdateShadows(SceneCamera* pCamera, Scene* pScene, std::span<const PointLightComponent> PointLights);
+
+		ShadowMap m_ShadowMap;
+		// World space bounds of every mesh, in Scene order.
+		std::vector<BoundingBox> m_ShadowBounds;
+
+		ShadowAtlas m_ShadowAtlas;
+		std::vector<ShadowAtlasRequest> m_AtlasRequests;
 
 	};
 } // namespace lde
@@ -19,8 +19,6 @@ namespace lde
 
 	void SkyPass::Render(Skybox* pSkybox, SceneCamera* pCamera)
 	{
-		m_Gfx->TransitResource(m_Texture->Get(), D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_RENDER_TARGET);
-
 		auto& rtvHandle = m_Texture->GetRTV().GetCpuHandle();
 		auto& depthHandle = m_Gfx->SceneDepth->DSV().GetCpuHandle();
 
@@ -29,7 +27,6 @@ namespace lde
 		m_Gfx->SetRenderTarget(rtvHandle, &depthHandle);
 
 		pSkybox->Draw(-1, pCamera);
-		m_Gfx->TransitResource(m_Texture->Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_GENERIC_READ);
 
 	}
 
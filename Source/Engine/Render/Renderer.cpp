@@ -3,6 +3,32 @@
 
 namespace lde
 {
+	static D3D12_RESOURCE_STATES ToResourceState(RenderGraphUsage eUsage)
+	{
+		switch (eUsage)
+		{
+		case RenderGraphUsage::eShaderRead:
+			// Render textures are created and tracked in it.
+			return D3D12_RESOURCE_STATE_GENERIC_READ;
+		case RenderGraphUsage::eRenderTarget:
+			return D3D12_RESOURCE_STATE_RENDER_TARGET;
+		case RenderGraphUsage::eDepthWrite:
+			return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+		case RenderGraphUsage::eDepthRead:
+			return D3D12_RESOURCE_STATE_DEPTH_READ;
+		case RenderGraphUsage::eUnorderedAccess:
+			return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+		case RenderGraphUsage::eCopySrc:
+			return D3D12_RESOURCE_STATE_COPY_SOURCE;
+		case RenderGraphUsage::eCopyDst:
+			return D3D12_RESOURCE_STATE_COPY_DEST;
+		case RenderGraphUsage::ePresent:
+			return D3D12_RESOURCE_STATE_PRESENT;
+		default:
+			return D3D12_RESOURCE_STATE_COMMON;
+		}
+	}
+
 	bool Renderer::bVSync = true;
 
 	Renderer::Renderer(D3D12RHI* pGfx)
@@ -17,8 +43,11 @@ namespace lde
 		m_ShaderCompiler = std::make_unique<ShaderCompiler>();
 		m_TextureManager = std::make_unique<TextureManager>();
 		m_AssetManager   = std::make_unique<AssetManager>();
+		m_MeshRegistry   = std::make_unique<MeshRegistry>();
 
 		m_TextureManager->Initialize(m_Gfx);
+		m_AssetManager->Initialize(m_Gfx);
+		m_MeshRegistry->Initialize(m_Gfx->Device.get(), m_AssetManager.get());
 
 		m_Skybox = std::make_unique<Skybox>();
 		SetScene(pScene);
@@ -64,37 +93,104 @@ namespace lde
 	void Renderer::RecordCommands()
 	{
 		m_Gfx->Device->GetGfxCommandList()->Get()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-		m_Gfx->ClearDepthStencil();
 
-		// G-Buffer
-		{
-			m_GBufferPass->Render(m_ActiveScene);
-		}
+		BuildRenderGraph();
+		m_RenderGraph.Compile();
+
+		m_RenderGraph.Execute([&](const RenderGraphPass&, std::span<const RenderGraphBarrier> Barriers)
+			{
+				for (const auto& barrier : Barriers)
+				{
+					// Transient textures aren't backed by memory yet; imported ones go through Device's state tracker.
+					const auto& resource = m_RenderGraph.GetResource(barrier.Resource);
+					if (barrier.Type == RenderGraphBarrierType::eTransition && resource.bImported)
+					{
+						m_Gfx->TransitResource(reinterpret_cast<ID3D12Resource*>(resource.External), ToResourceState(barrier.After));
+					}
+				}
+			});
 
-		m_Gfx->TransitResource(SceneImage.Get(), D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_RENDER_TARGET);
-		m_Gfx->SetRenderTarget(SceneImage.GetRTV().GetCpuHandle(), &m_Gfx->SceneDepth->DSV().GetCpuHandle());
-		m_Gfx->ClearRenderTarget(SceneImage.GetRTV().GetCpuHandle());
+	}
 
-		// Light Pass
-		{
-			m_Gfx->SetRootSignature(&m_LightRS);
-			m_Gfx->SetPipeline(&m_LightPSO);
-			m_LightPass->Render(m_ActiveScene->GetCamera(), m_GBufferPass, m_Skybox.get(), m_ActiveScene);
-		}	
+	void Renderer::BuildRenderGraph()
+	{
+		m_RenderGraph.Reset();
 
-		// Sky Pass
+		auto& gbufferTargets = m_GBufferPass->GetRenderTargets();
+
+		std::vector<RenderGraphResource> gbuffer;
+		for (auto& [type, target] : gbufferTargets)
 		{
-			m_Gfx->SetRootSignature(&m_SkyboxRS);
-			m_Gfx->SetPipeline(&m_SkyboxPSO);
-			m_Skybox->Draw(-1, m_ActiveScene->GetCamera()); 
+			gbuffer.push_back(m_RenderGraph.Import("GBuffer", reinterpret_cast<uint64>(target.Get()), RenderGraphUsage::eShaderRead));
 		}
-		m_Gfx->TransitResource(SceneImage.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_GENERIC_READ);
-		
-
-		m_Gfx->SetViewport();
-		m_Gfx->SetMainRenderTarget();
-		m_Gfx->ClearMainRenderTarget();
 
+		const auto depth		= m_RenderGraph.Import("Scene Depth", reinterpret_cast<uint64>(m_Gfx->SceneDepth->Get()), RenderGraphUsage::eDepthWrite);
+		const auto sceneImage	= m_RenderGraph.Import("Scene Image", reinterpret_cast<uint64>(SceneImage.Get()), RenderGraphUsage::eShaderRead);
+		const auto skyImage		= m_RenderGraph.Import("Sky Image", reinterpret_cast<uint64>(m_SkyPass->GetRenderTexture()->Get()), RenderGraphUsage::eShaderRead);
+		// BeginFrame and Present transition it.
+		const auto backbuffer	= m_RenderGraph.Import("Backbuffer", reinterpret_cast<uint64>(m_Gfx->SwapChain->GetBackbuffer()), RenderGraphUsage::eRenderTarget);
+
+		// Scene image is displayed by the Editor.
+		m_RenderGraph.MarkOutput(sceneImage);
+
+		const uint32 gbufferPass = m_RenderGraph.AddPass("GBuffer", [this]()
+			{
+				m_Gfx->ClearDepthStencil();
+				m_GBufferPass->Render(m_ActiveScene);
+			});
+		for (const auto target : gbuffer)
+		{
+			m_RenderGraph.Write(gbufferPass, target, RenderGraphUsage::eRenderTarget);
+		}
+		m_RenderGraph.Write(gbufferPass, depth, RenderGraphUsage::eDepthWrite);
+
+		const uint32 lightPass = m_RenderGraph.AddPass("Light", [this]()
+			{
+				m_Gfx->SetRenderTarget(SceneImage.GetRTV().GetCpuHandle(), &m_Gfx->SceneDepth->DSV().GetCpuHandle());
+				m_Gfx->ClearRenderTarget(SceneImage.GetRTV().GetCpuHandle());
+				m_Gfx->SetRootSignature(&m_LightRS);
+				m_Gfx->SetPipeline(&m_LightPSO);
+				m_LightPass->Render(m_ActiveScene->GetCamera(), m_GBufferPass, m_Skybox.get(), m_ActiveScene);
+			});
+		for (const auto target : gbuffer)
+		{
+			m_RenderGraph.Read(lightPass, target);
+		}
+		m_RenderGraph.Write(lightPass, sceneImage, RenderGraphUsage::eRenderTarget);
+
+		const uint32 skyPass = m_RenderGraph.AddPass("Sky", [this]()
+			{
+				m_Gfx->SetRenderTarget(SceneImage.GetRTV().GetCpuHandle(), &m_Gfx->SceneDepth->DSV().GetCpuHandle());
+				m_Gfx->SetRootSignature(&m_SkyboxRS);
+				m_Gfx->SetPipeline(&m_SkyboxPSO);
+				m_Skybox->Draw(-1, m_ActiveScene->GetCamera());
+			});
+		m_RenderGraph.Read(skyPass, depth, RenderGraphUsage::eDepthWrite);
+		m_RenderGraph.Write(skyPass, sceneImage, RenderGraphUsage::eRenderTarget);
+
+		// Culled unless its output is selected.
+		const uint32 skyPreviewPass = m_RenderGraph.AddPass("Sky Preview", [this]()
+			{
+				m_Gfx->SetRootSignature(&m_SkyboxRS);
+				m_Gfx->SetPipeline(&m_SkyboxPSO);
+				m_SkyPass->Render(m_Skybox.get(), m_ActiveScene->GetCamera());
+			});
+		m_RenderGraph.Read(skyPreviewPass, depth, RenderGraphUsage::eDepthWrite);
+		m_RenderGraph.Write(skyPreviewPass, skyImage, RenderGraphUsage::eRenderTarget);
+
+		const uint32 compositePass = m_RenderGraph.AddPass("Composite", [this]()
+			{
+				m_Gfx->SetViewport();
+				m_Gfx->SetMainRenderTarget();
+				m_Gfx->ClearMainRenderTarget();
+			});
+		m_RenderGraph.Read(compositePass, sceneImage);
+		if (SelectedRenderTarget == RenderOutput::eSkybox)
+		{
+			m_RenderGraph.Read(compositePass, skyImage);
+		}
+		m_RenderGraph.Write(compositePass, backbuffer, RenderGraphUsage::eRenderTarget);
+		m_RenderGraph.SetSideEffects(compositePass);
 	}
 
 	void Renderer::Update()
@@ -140,6 +236,9 @@ namespace lde
 		delete m_LightPass;
 		delete m_GBufferPass;
 
+		// Mesh assets release their textures, so they go first.
+		m_MeshRegistry.reset();
+
 		// Release gathered Textures
 		TextureManager::GetInstance().Release();
 		m_AssetManager.reset();
@@ -158,6 +257,10 @@ namespace lde
 			m_LightRS.AddConstants(7, 2);
 			// Image Based Lighting indices
 			m_LightRS.AddConstants(3, 3);
+			// Point lights, cluster ranges and light indices
+			m_LightRS.AddSRV(0, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+			m_LightRS.AddSRV(1, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+			m_LightRS.AddSRV(2, 0, D3D12_SHADER_VISIBILITY_PIXEL);
 			// Texture sampling
 			m_LightRS.AddStaticSampler(0, 0, D3D12_FILTER_MAXIMUM_ANISOTROPIC, D3D12_TEXTURE_ADDRESS_MODE_WRAP);
 			// Specular BRDF sampling
@@ -181,31 +284,32 @@ namespace lde
 
 	void Renderer::BuildPipelines()
 	{
-		D3D12PipelineStateBuilder psoBuilder(m_Gfx->Device.get());
+		// Separate builders, so shaders of both pipelines compile at once.
+		D3D12PipelineStateBuilder lightBuilder(m_Gfx->Device.get());
+		D3D12PipelineStateBuilder skyboxBuilder(m_Gfx->Device.get());
+
+		lightBuilder.SetVS("Shaders/Deferred/PBR.hlsl", L"VSmain");
+		lightBuilder.SetPS("Shaders/Deferred/PBR.hlsl", L"PSmain");
+		skyboxBuilder.SetVS("Shaders/Sky/Skybox.hlsl", L"VSmain");
+		skyboxBuilder.SetPS("Shaders/Sky/Skybox.hlsl", L"PSmain");
 
 		// Light Pass
 		{
-			psoBuilder.SetVS("Shaders/Deferred/PBR.hlsl", L"VSmain");
-			psoBuilder.SetPS("Shaders/Deferred/PBR.hlsl", L"PSmain");
-			psoBuilder.EnableDepth(false);
-			psoBuilder.SetCullMode(CullMode::eNone);
+			lightBuilder.EnableDepth(false);
+			lightBuilder.SetCullMode(CullMode::eNone);
 			std::array<DXGI_FORMAT, 1> formats{ DXGI_FORMAT_R32G32B32A32_FLOAT };
-			psoBuilder.SetRenderTargetFormats(formats);
+			lightBuilder.SetRenderTargetFormats(formats);
 
-			DX_CALL(psoBuilder.Build(m_LightPSO, &m_LightRS));
-			psoBuilder.Reset();
+			DX_CALL(lightBuilder.Build(m_LightPSO, &m_LightRS));
 		}
 
 		// Skybox
 		{
-			psoBuilder.SetVS("Shaders/Sky/Skybox.hlsl", L"VSmain");
-			psoBuilder.SetPS("Shaders/Sky/Skybox.hlsl", L"PSmain");
-			psoBuilder.EnableDepth(true);
+			skyboxBuilder.EnableDepth(true);
 			std::vector<DXGI_FORMAT> formats{ DXGI_FORMAT_R32G32B32A32_FLOAT };
-			psoBuilder.SetRenderTargetFormats(formats);
+			skyboxBuilder.SetRenderTargetFormats(formats);
 
-			DX_CALL(psoBuilder.Build(m_SkyboxPSO, &m_SkyboxRS));
-			psoBuilder.Reset();
+			DX_CALL(skyboxBuilder.Build(m_SkyboxPSO, &m_SkyboxRS));
 		}
 	}
 
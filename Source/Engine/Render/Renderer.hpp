@@ -6,10 +6,12 @@
 
 #include "Graphics/AssetManager.hpp"
 #include "Graphics/ImageBasedLighting.hpp"
+#include "Graphics/MeshRegistry.hpp"
 #include "Graphics/ShaderCompiler.hpp"
 #include "Graphics/Skybox.hpp"
 #include "Graphics/TextureManager.hpp"
 #include "Scene/Model/Model.hpp"
+#include "RenderGraph.hpp"
 #include <map>
 // RenderPasses
 #include "RenderPass/GBufferPass.hpp"
@@ -72,6 +74,7 @@ namespace lde
 		std::unique_ptr<ShaderCompiler>	m_ShaderCompiler;
 		std::unique_ptr<TextureManager> m_TextureManager;
 		std::unique_ptr<AssetManager>	m_AssetManager;
+		std::unique_ptr<MeshRegistry>	m_MeshRegistry;
 		
 		// PSOs
 		D3D12RootSignature m_GBufferRS;
@@ -92,6 +95,10 @@ namespace lde
 		BufferHandle   m_SceneConstBuffer = 0;
 		SceneData m_SceneData{};
 
+		// Rebuilt every frame in RecordCommands.
+		RenderGraph m_RenderGraph;
+		void BuildRenderGraph();
+
 	public:
 		std::unique_ptr<Skybox> m_Skybox;
 		std::unique_ptr<ImageBasedLighting> m_IBL;
@@ -106,5 +113,7 @@ namespace lde
 
 		RenderOutput SelectedRenderTarget = RenderOutput::eShaded;
 
+		const RenderGraph& GetRenderGraph() const { return m_RenderGraph; }
+
 	};
 } // namespace lde
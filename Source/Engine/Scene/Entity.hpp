@@ -56,6 +56,13 @@ namespace lde
 			m_World->Registry()->emplace<T>(this->m_ID, std::forward<Args>(InArgs)...);
 		}
 	
+		/// @brief Notifies on_update listeners of T, i.e. after editing component in place.
+		template<typename T>
+		void PatchComponent()
+		{
+			m_World->Registry()->patch<T>(m_ID);
+		}
+	
 		template<typename T>
 		void RemoveComponent()
 		{
@@ -0,0 +1,17 @@
+#pragma once
+
+/*
+	Scene/Model/BoundingBox.hpp
+	Axis aligned box; apart from Mesh.hpp, so CPU only code can use it without graphics API headers.
+*/
+
+#include <DirectXMath.h>
+
+namespace lde
+{
+	struct BoundingBox
+	{
+		DirectX::XMFLOAT3 Min = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		DirectX::XMFLOAT3 Max = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	};
+} // namespace lde
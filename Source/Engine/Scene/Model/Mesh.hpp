@@ -1,15 +1,14 @@
 #pragma once
 
 #include "Core/CoreMinimal.hpp"
-#include "RHI/D3D12/D3D12Buffer.hpp"
-#include "RHI/D3D12/D3D12Device.hpp"
+#include "RHI/Buffer.hpp"
+#include "BoundingBox.hpp"
 #include <DirectXMath.h>
+#include <string>
 #include <vector>
 
 namespace lde
 {
-	class D3D12Texture;
-	
 	struct Vertex
 	{
 		DirectX::XMFLOAT3 Position;
@@ -19,6 +18,24 @@ namespace lde
 		DirectX::XMFLOAT3 Bitangent;
 	};
 	
+	enum class MaterialAlphaMode : uint32
+	{
+		eOpaque,
+		// Texels below AlphaCutoff are discarded.
+		eMask,
+		// Not blended yet; alpha tested like eMask.
+		eBlend
+	};
+
+	/// @brief Material features that select a GBuffer shader permutation; bit order matches defines of GBuffer.hlsl.
+	enum class MaterialFeature : uint32
+	{
+		eNone			= 0,
+		eAlphaTest		= 1 << 0,
+		eDoubleSided	= 1 << 1,
+		eNoNormalMap	= 1 << 2,
+	};
+
 	struct Material
 	{
 		uint32 BaseColorIndex		= (uint32)-1;
@@ -33,20 +50,50 @@ namespace lde
 	
 		DirectX::XMFLOAT4 BaseColorFactor	= DirectX::XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
 		DirectX::XMFLOAT4 EmissiveFactor	= DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+
+		// CPU only; shaders get the 16 constants above.
+		MaterialAlphaMode AlphaMode = MaterialAlphaMode::eOpaque;
 	};
 
-	struct BoundingBox
+	/// @return MaterialFeature bits of the shader permutation the material needs.
+	inline uint32 GetMaterialFeatures(const Material& Material)
 	{
-		DirectX::XMFLOAT3 Min = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
-		DirectX::XMFLOAT3 Max = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		uint32 features = static_cast<uint32>(MaterialFeature::eNone);
+
+		// Without a texture alpha comes from nowhere, so there is nothing to test.
+		if (Material.AlphaMode != MaterialAlphaMode::eOpaque && Material.BaseColorIndex != (uint32)-1)
+		{
+			features |= static_cast<uint32>(MaterialFeature::eAlphaTest);
+		}
+		if (Material.bDoubleSided > 0)
+		{
+			features |= static_cast<uint32>(MaterialFeature::eDoubleSided);
+		}
+		if (Material.NormalIndex == (uint32)-1)
+		{
+			features |= static_cast<uint32>(MaterialFeature::eNoNormalMap);
+		}
+
+		return features;
+	}
+
+	/// @brief CPU side geometry kept after upload, from cheapest to complete.
+	enum class GeometryResidency : uint8
+	{
+		// Nothing; geometry is read back from GeometryCache when requested.
+		eNone,
+		// Positions and Indices only; enough for picking.
+		ePositions,
+		// Vertices and Indices.
+		eFull
 	};
-	
+
 	struct StaticMesh
 	{
 		std::vector<Vertex> Vertices;
 		std::vector<uint32> Indices;
-
-		D3D12_INDEX_BUFFER_VIEW IndexBufferView{};
+		// Compact copy of vertex positions; filled when Vertices are dropped with GeometryResidency::ePositions.
+		std::vector<DirectX::XMFLOAT3> Positions;
 
 		Material Material{};
 
@@ -57,6 +104,24 @@ namespace lde
 
 		uint32 NumVertices;
 		uint32 NumIndices;
+
+		// Hash of vertex and index data; meshes with equal hashes share buffers and are drawn as instances.
+		uint64 GeometryHash = 0;
+	};
+
+	/// @brief Geometry of a single imported file, shared by every Model that references it.
+	struct MeshAsset
+	{
+		std::string Filepath;
+		std::vector<StaticMesh> StaticMeshes;
+		// Textures created for Materials of StaticMeshes; released along with the asset.
+		std::vector<int32> Textures;
+
+		// CPU geometry currently held by StaticMeshes.
+		GeometryResidency Residency = GeometryResidency::eFull;
+
+		uint64 CpuBytes = 0;
+		uint64 GpuBytes = 0;
 	};
 
 } // namespace lde
@@ -2,27 +2,32 @@
 
 #include "../Entity.hpp"
 #include "Mesh.hpp"
-#include "RHI/D3D12/D3D12Buffer.hpp"
+#include <memory>
+#include <span>
 
 namespace lde
 {
-	class D3D12RHI;
 	class Buffer;
 	
+	/// @brief Entity drawing a shared MeshAsset. Copies only add a reference to the asset.
 	class Model : public Entity
 	{
 	public:
 		Model() = default;
 		~Model() = default;
 	
-		void Create(D3D12RHI* pGfx, World* pWorld);
-	
-		BufferHandle ConstBuffer = UINT32_MAX;
-		cbPerObject cbData{};
+		/// @brief Creates entity, unless it exists already, and adds default components.
+		void Create(World* pWorld, std::shared_ptr<MeshAsset> InAsset);
+
+		/// @return Meshes of the asset; empty if Model has none.
+		std::span<const StaticMesh> GetStaticMeshes() const
+		{
+			return Asset ? std::span<const StaticMesh>(Asset->StaticMeshes) : std::span<const StaticMesh>();
+		}
 
-		std::vector<StaticMesh> StaticMeshes;
+		const std::string& GetFilepath() const;
 
-		std::string Filepath;
+		std::shared_ptr<MeshAsset> Asset;
 
 	private:
 
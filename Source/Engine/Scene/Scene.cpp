@@ -1,29 +1,27 @@
 #include "Components/TransformComponent.hpp"
 #include "Components/NameComponent.hpp"
-#include "Graphics/AssetManager.hpp"
-#include "RHI/D3D12/D3D12RHI.hpp"
+#include "Graphics/MeshRegistry.hpp"
 #include "Scene.hpp"
 #include "Components/LightComponent.hpp"
 
 namespace lde
 {
-	Scene::Scene(uint32 Width, uint32 Height, D3D12RHI* pGfx)
+	Scene::Scene(uint32 Width, uint32 Height)
 	{
-		Initialize(Width, Height, pGfx);
+		Initialize(Width, Height);
 	}
 
 	Scene::~Scene()
 	{
-
+		Lighting.Release();
 	}
 	
-	void Scene::Initialize(uint32 Width, uint32 Height, D3D12RHI* pGfx)
+	void Scene::Initialize(uint32 Width, uint32 Height)
 	{
 		m_World = new lde::World();
 		Camera = std::make_unique<SceneCamera>(m_World, static_cast<float>(Width / Height));
-		m_Gfx = pGfx;
 		
-		PointLights.reserve(4);
+		Lighting.Initialize(m_World);
 		AddPointLight(XMFLOAT3(-8.0f, 1.0f, 0.5f));
 		AddPointLight(XMFLOAT3(-5.0f, 1.0f, 0.5f));
 		AddPointLight(XMFLOAT3(0.0f, 1.0f, 0.5f));
@@ -38,68 +36,29 @@ namespace lde
 		Camera->OnAspectRatioChange(AspectRatio);
 	}
 	
-	void Scene::DrawScene()
+	void Scene::Clear()
 	{
 		for (auto& model : Models)
 		{
-			DrawModel(model);
+			m_World->DestroyEntity(model.ID());
 		}
-	}
-
-	void Scene::DrawModel(Model& pModel)
-	{
-		auto* commandList	= m_Gfx->Device->GetGfxCommandList();
-		auto& transform		= pModel.GetComponent<TransformComponent>();
+		Models.clear();
 
-		const auto& WVP		= transform.WorldMatrix * Camera->GetViewProjection();
-		auto* constBuffer	= m_Gfx->Device->GetConstantBuffer(pModel.ConstBuffer);
+		Lighting.Clear();
+		Partition.Reset();
 
-		cbPerObject update	= { DirectX::XMMatrixTranspose(WVP), DirectX::XMMatrixTranspose(transform.WorldMatrix) };
-		constBuffer->Update(&update);
-
-		m_Gfx->BindConstantBuffer(constBuffer, 0);
-
-		commandList->Get()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-		for (auto& mesh : pModel.StaticMeshes)
-		{
-			auto* vertexBuffer = m_Gfx->Device->GetBuffer(mesh.VertexBuffer);
-
-			// Push index to current Vertex Buffer.
-			commandList->PushConstants(1, 1, &vertexBuffer->ShaderResource.m_Index);
-			// Push Material as constants; 64 bytes
-			commandList->PushConstants(2, 16, &mesh.Material, 0);
-
-			if (mesh.NumIndices != 0)
-			{
-				m_Gfx->BindIndexBuffer(mesh.IndexBufferView);
-				m_Gfx->DrawIndexed(mesh.NumIndices, 0, 0);
-			}
-			else // Draw non-indexed
-			{
-				m_Gfx->Draw(mesh.NumVertices);
-			}
-		}
+		// Assets aren't kept around for next scene.
+		MeshRegistry::GetInstance().ReleaseUnused();
 	}
-	
+
 	void Scene::AddPointLight(XMFLOAT3 Position)
 	{
-		Entity* newLight = new Entity();
-		newLight->Create(m_World);
-		newLight->AddComponent<NameComponent>(std::format("Point Light {}", PointLights.size()).c_str());
-		newLight->AddComponent<PointLightComponent>(Position);
-		
-		PointLights.push_back(newLight);
+		Lighting.AddPointLight(std::format("Point Light {}", Lighting.GetPointLightCount()), Position);
 	}
 
 	void Scene::AddDirectionalLight(XMFLOAT3 Direction)
 	{
-		Entity* newLight = new Entity();
-		newLight->Create(m_World);
-		newLight->AddComponent<NameComponent>(std::format("Directional Light {}", DirectionalLights.size()).c_str());
-		newLight->AddComponent<DirectionalLightComponent>(Direction);
-
-		DirectionalLights.push_back(newLight);
+		Lighting.AddDirectionalLight(std::format("Directional Light {}", Lighting.GetDirectionalLightCount()), Direction);
 	}
 
 } // namespace lde
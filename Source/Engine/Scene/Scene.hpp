@@ -3,19 +3,21 @@
 #include "Entity.hpp"
 #include "Model/Model.hpp"
 #include "SceneCamera.hpp"
+#include "SceneLighting.hpp"
+#include "WorldPartition.hpp"
 #include <Core/CoreMinimal.hpp>
+#include <Core/FileSystem.hpp>
+#include <optional>
 
 namespace lde
 {
-	class D3D12RHI;
-
 	class Scene
 	{
 	public:
-		Scene(uint32 Width, uint32 Height, D3D12RHI* pContext);
+		Scene(uint32 Width, uint32 Height);
 		~Scene();
 	
-		void Initialize(uint32 Width, uint32 Height, D3D12RHI* pContext);
+		void Initialize(uint32 Width, uint32 Height);
 	
 		void OnResize(float AspectRatio);
 	
@@ -34,11 +36,6 @@ namespace lde
 			return Entity(m_World);
 		}
 		
-		// Draw all Models in this scene.
-		void DrawScene();
-
-		void DrawModel(Model& pModel);
-
 		SceneCamera* GetCamera()
 		{
 			return Camera.get();
@@ -48,17 +45,28 @@ namespace lde
 
 		std::unique_ptr<SceneCamera> Camera;
 		
-		std::vector<Entity*> PointLights;
-		std::vector<Entity*> DirectionalLights;
+		SceneLighting Lighting;
 	
 		void AddPointLight(DirectX::XMFLOAT3 Position = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f));
 		void AddDirectionalLight(DirectX::XMFLOAT3 Direction = DirectX::XMFLOAT3(0.0f, -1.0f, 0.0f));
 
 		std::vector<Model> Models;
 
+		/// @brief Streamed content; its loaded cells add to Models and Lighting.
+		WorldPartition Partition;
+
+		/**
+		 * @brief Releases Models and lights along with their entities. Camera is kept.
+		 * Streamed cells are dropped as well.
+		 * GPU must not be using Model buffers anymore.
+		 */
+		void Clear();
+
+		/// @brief Snapshot to load before next frame is recorded; set by Editor.
+		std::optional<Filepath> PendingSnapshot;
+
 	private:
 		lde::World* m_World = nullptr;
-		D3D12RHI* m_Gfx = nullptr;
 
 	};
 
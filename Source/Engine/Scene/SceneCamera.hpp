@@ -3,13 +3,6 @@
 #include <DirectXMath.h>
 #include <array>
 
-// TODO:
-// https://learn.microsoft.com/en-us/gaming/gdk/_content/gc/input/overviews/input-readings
-#ifndef DIRECTINPUT_VERSION
-#define DIRECTINPUT_VERSION 0x0800
-#endif
-#include <dinput.h>
-
 #include "Entity.hpp"
 
 namespace lde
@@ -22,7 +15,7 @@ namespace lde
 	public:
 		SceneCamera() = default;
 		SceneCamera(World* pWorld, float AspectRatio);
-		~SceneCamera();
+		~SceneCamera() = default;
 	
 		void Initialize(World* pWorld, float AspectRatio);
 	
@@ -110,16 +103,13 @@ namespace lde
 	
 		inline static float CameraSpeed = 25.0f;
 	
-		// Inputs
+		// Inputs; implemented in SceneCameraInput.cpp.
+		// Devices are shared by every camera and owned by the Application, so cameras can exist without a window.
 	public:
-		void InitializeInputs();
+		/// @brief Creates keyboard and mouse devices; Window has to exist.
+		static void InitializeInputs();
+		static void ReleaseInputs();
 		void ProcessInputs(float DeltaTime);
-	private:
-		void ReleaseInputs();
-		inline static IDirectInputDevice8* DxKeyboard{};
-		inline static IDirectInputDevice8* DxMouse{};
-		inline static LPDIRECTINPUT8 DxInput{};
-		inline static DIMOUSESTATE DxLastMouseState{};
 	};
 
 } // namespace lde
@@ -0,0 +1,139 @@
+#include "Components/CameraComponent.hpp"
+#include "RHI/D3D12/D3D12Utility.hpp"
+#include "SceneCamera.hpp"
+#include <Platform/Window.hpp>
+
+// TODO:
+// https://learn.microsoft.com/en-us/gaming/gdk/_content/gc/input/overviews/input-readings
+#ifndef DIRECTINPUT_VERSION
+#define DIRECTINPUT_VERSION 0x0800
+#endif
+#include <dinput.h>
+
+#pragma comment(lib, "dinput8")
+
+/*===========================================================================================
+	Implements DirectInput handling of SceneCamera.hpp.
+	Kept apart, so cameras can be created without a window, i.e. for headless runs.
+===========================================================================================*/
+
+namespace lde
+{
+	namespace
+	{
+		IDirectInputDevice8* DxKeyboard{};
+		IDirectInputDevice8* DxMouse{};
+		LPDIRECTINPUT8 DxInput{};
+		DIMOUSESTATE DxLastMouseState{};
+	}
+
+	void SceneCamera::InitializeInputs()
+	{
+		DX_CALL(DirectInput8Create(Window::GetHInstance(), DIRECTINPUT_VERSION, IID_IDirectInput8, reinterpret_cast<void**>(&DxInput), NULL));
+		DX_CALL(DxInput->CreateDevice(GUID_SysKeyboard, &DxKeyboard, NULL));
+		DX_CALL(DxKeyboard->SetDataFormat(&c_dfDIKeyboard));
+		DX_CALL(DxKeyboard->SetCooperativeLevel(Window::GetHWnd(), DISCL_FOREGROUND | DISCL_NONEXCLUSIVE));
+		DX_CALL(DxInput->CreateDevice(GUID_SysMouse, &DxMouse, NULL));
+		DX_CALL(DxMouse->SetDataFormat(&c_dfDIMouse));
+		DX_CALL(DxMouse->SetCooperativeLevel(Window::GetHWnd(), DISCL_NONEXCLUSIVE | DISCL_NOWINKEY | DISCL_FOREGROUND));
+	}
+
+	void SceneCamera::ProcessInputs(float DeltaTime)
+	{
+		if (!DxKeyboard || !DxMouse)
+		{
+			return;
+		}
+
+		DIMOUSESTATE mouseState{};
+		constexpr int keys{ 256 };
+		std::array<BYTE, keys> keyboardState{};
+
+		DxKeyboard->Acquire();
+		DxMouse->Acquire();
+
+		DxMouse->GetDeviceState(sizeof(mouseState), reinterpret_cast<LPVOID>(&mouseState));
+		DxKeyboard->GetDeviceState(sizeof(keyboardState), reinterpret_cast<LPVOID>(&keyboardState));
+
+		constexpr int state{ 0x80 };
+
+		// ESC to exit
+		if (keyboardState.at(DIK_ESCAPE) & state)
+			Window::bShouldQuit = true;
+
+		// If RMB is not held - skip mouse and keyboard camera controls
+		if (!mouseState.rgbButtons[1])
+		{
+			Window::OnCursorShow();
+			return;
+		}
+
+		Window::OnCursorHide();
+
+		auto& comp = Entity::GetComponent<CameraComponent>();
+		const float speed{ comp.Speed * static_cast<float>(DeltaTime) };
+		constexpr float intensity{ 0.001f };
+		constexpr float upDownIntensity{ 0.75f };
+
+		if ((mouseState.lX != DxLastMouseState.lX) || (mouseState.lY != DxLastMouseState.lY))
+		{
+			m_Yaw += mouseState.lX * intensity;
+			m_Pitch += mouseState.lY * intensity;
+			DxLastMouseState = mouseState;
+		}
+		if (keyboardState.at(DIK_W) & state)
+		{
+			MoveForwardBack += speed;
+		}
+		if (keyboardState.at(DIK_S) & state)
+		{
+			MoveForwardBack -= speed;
+		}
+		if (keyboardState.at(DIK_A) & state)
+		{
+			MoveRightLeft -= speed;
+		}
+		if (keyboardState.at(DIK_D) & state)
+		{
+			MoveRightLeft += speed;
+		}
+		if (keyboardState.at(DIK_Q) & state)
+		{
+			MoveUpDown -= speed * upDownIntensity;
+		}
+		if (keyboardState.at(DIK_E) & state)
+		{
+			MoveUpDown += speed * upDownIntensity;
+		}
+		if (keyboardState.at(DIK_R) & state)
+		{
+			ResetCamera();
+		}
+	}
+
+	void SceneCamera::ReleaseInputs()
+	{
+		if (DxKeyboard)
+		{
+			DxKeyboard->Unacquire();
+			DxKeyboard->Release();
+			DxKeyboard = nullptr;
+		}
+	
+		if (DxMouse)
+		{
+			DxMouse->Unacquire();
+			DxMouse->Release();
+			DxMouse = nullptr;
+		}
+	
+		if (DxInput)
+		{
+			DxInput->Release();
+			DxInput = nullptr;
+		}
+	
+		DxLastMouseState = {};
+	}
+
+} // namespace lde
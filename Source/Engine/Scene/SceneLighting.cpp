@@ -0,0 +1,128 @@
+#include "Components/NameComponent.hpp"
+#include "SceneLighting.hpp"
+#include "World.hpp"
+#include <algorithm>
+
+namespace lde
+{
+	SceneLighting::~SceneLighting()
+	{
+		Release();
+	}
+
+	void SceneLighting::Initialize(World* pWorld)
+	{
+		m_Registry = pWorld->Registry();
+
+		m_Registry->on_construct<PointLightComponent>().connect<&SceneLighting::OnPointLightChanged>(this);
+		m_Registry->on_update<PointLightComponent>().connect<&SceneLighting::OnPointLightChanged>(this);
+		m_Registry->on_destroy<PointLightComponent>().connect<&SceneLighting::OnPointLightRemoved>(this);
+	}
+
+	void SceneLighting::Release()
+	{
+		if (!m_Registry)
+		{
+			return;
+		}
+
+		m_Registry->on_construct<PointLightComponent>().disconnect(this);
+		m_Registry->on_update<PointLightComponent>().disconnect(this);
+		m_Registry->on_destroy<PointLightComponent>().disconnect(this);
+		m_Registry = nullptr;
+
+		m_PointLights.clear();
+		m_DirtyRange = LightDirtyRange();
+	}
+
+	entt::entity SceneLighting::AddPointLight(std::string_view Name, DirectX::XMFLOAT3 Position)
+	{
+		const auto entity = m_Registry->create();
+		m_Registry->emplace<NameComponent>(entity, Name);
+		m_Registry->emplace<PointLightComponent>(entity, Position);
+
+		return entity;
+	}
+
+	entt::entity SceneLighting::AddDirectionalLight(std::string_view Name, DirectX::XMFLOAT3 Direction)
+	{
+		const auto entity = m_Registry->create();
+		m_Registry->emplace<NameComponent>(entity, Name);
+		m_Registry->emplace<DirectionalLightComponent>(entity, Direction);
+
+		return entity;
+	}
+
+	void SceneLighting::Clear()
+	{
+		auto pointLights = m_Registry->view<PointLightComponent>();
+		m_Registry->destroy(pointLights.begin(), pointLights.end());
+
+		auto directionalLights = m_Registry->view<DirectionalLightComponent>();
+		m_Registry->destroy(directionalLights.begin(), directionalLights.end());
+	}
+
+	LightDirtyRange SceneLighting::Sync()
+	{
+		auto& storage = m_Registry->storage<PointLightComponent>();
+		const uint32 count = static_cast<uint32>(storage.size());
+
+		m_PointLights.resize(count);
+
+		LightDirtyRange range{ std::min(m_DirtyRange.Begin, count), std::min(m_DirtyRange.End, count) };
+		for (uint32 i = range.Begin; i < range.End; ++i)
+		{
+			m_PointLights[i] = storage.get(storage.data()[i]);
+		}
+
+		m_DirtyRange = LightDirtyRange();
+
+		return range;
+	}
+
+	uint32 SceneLighting::GetPointLightCount() const
+	{
+		return static_cast<uint32>(m_Registry->storage<PointLightComponent>().size());
+	}
+
+	uint32 SceneLighting::GetDirectionalLightCount() const
+	{
+		return static_cast<uint32>(m_Registry->storage<DirectionalLightComponent>().size());
+	}
+
+	const DirectionalLightComponent* SceneLighting::GetDirectionalLight() const
+	{
+		auto& storage = m_Registry->storage<DirectionalLightComponent>();
+		if (storage.empty())
+		{
+			return nullptr;
+		}
+
+		return &storage.get(storage.data()[0]);
+	}
+
+	void SceneLighting::OnPointLightChanged(entt::registry& Registry, entt::entity Entity)
+	{
+		const uint32 index = static_cast<uint32>(Registry.storage<PointLightComponent>().index(Entity));
+		MarkDirty(index, index + 1);
+	}
+
+	void SceneLighting::OnPointLightRemoved(entt::registry& Registry, entt::entity Entity)
+	{
+		const auto& storage = Registry.storage<PointLightComponent>();
+		MarkDirty(static_cast<uint32>(storage.index(Entity)), static_cast<uint32>(storage.size()));
+	}
+
+	void SceneLighting::MarkDirty(uint32 Begin, uint32 End)
+	{
+		if (m_DirtyRange.IsEmpty())
+		{
+			m_DirtyRange = LightDirtyRange{ Begin, End };
+			return;
+		}
+
+		m_DirtyRange.Begin	= std::min(m_DirtyRange.Begin, Begin);
+		m_DirtyRange.End	= std::max(m_DirtyRange.End, End);
+	}
+
+} // namespace lde
@@ -0,0 +1,74 @@
+#pragma once
+
+/*
+	Scene/SceneLighting.hpp
+	Light entities of a Scene.
+	Point lights are mirrored in packed component order, so renderer reads a single contiguous array.
+	Mirror is refreshed from registry signals only; untouched lights cost nothing per frame.
+*/
+
+#include "Components/LightComponent.hpp"
+#include "Core/CoreTypes.hpp"
+#include <EnTT/entt.hpp>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace lde
+{
+	class World;
+
+	/// @brief Range of point lights changed since last Sync, [Begin, End).
+	struct LightDirtyRange
+	{
+		uint32 Begin	= 0;
+		uint32 End		= 0;
+
+		bool IsEmpty() const { return Begin >= End; }
+	};
+
+	class SceneLighting
+	{
+	public:
+		SceneLighting() = default;
+		~SceneLighting();
+
+		/// @brief Connects to light component signals of a given World.
+		void Initialize(World* pWorld);
+		void Release();
+
+		entt::entity AddPointLight(std::string_view Name, DirectX::XMFLOAT3 Position);
+		entt::entity AddDirectionalLight(std::string_view Name, DirectX::XMFLOAT3 Direction);
+
+		/// @brief Destroys every light entity.
+		void Clear();
+
+		/**
+		 * @brief Copies point lights changed since previous call into contiguous array.
+		 * @return Range of array that has to be uploaded to GPU.
+		 */
+		LightDirtyRange Sync();
+
+		/// @brief Point lights in packed registry order, valid after Sync.
+		std::span<const PointLightComponent> GetPointLights() const { return m_PointLights; }
+
+		uint32 GetPointLightCount() const;
+		uint32 GetDirectionalLightCount() const;
+
+		/// @brief First directional light; nullptr if there is none.
+		const DirectionalLightComponent* GetDirectionalLight() const;
+
+	private:
+		void OnPointLightChanged(entt::registry& Registry, entt::entity Entity);
+		// Removal moves last light into freed slot, so everything from that slot onwards is stale.
+		void OnPointLightRemoved(entt::registry& Registry, entt::entity Entity);
+
+		void MarkDirty(uint32 Begin, uint32 End);
+
+		entt::registry* m_Registry = nullptr;
+
+		std::vector<PointLightComponent> m_PointLights;
+		LightDirtyRange m_DirtyRange{};
+
+	};
+} // namespace lde
@@ -1,9 +1,10 @@
 #include "Core/Logger.hpp"
-#include "Graphics/AssetManager.hpp"
+#include "Graphics/MeshRegistry.hpp"
 #include "RHI/D3D12/D3D12RHI.hpp"
 #include "Scene.hpp"
 #include "Scene/Components/NameComponent.hpp"
 #include "SceneLoader.hpp"
+#include <algorithm>
 #include <fstream>
 #include <nlohmann/json.hpp>
 
@@ -16,7 +17,7 @@ namespace lde
 		std::ifstream f(Path.c_str());
 		nlohmann::json json = nlohmann::json::parse(f);
 
-		auto& importer = AssetManager::GetInstance();
+		auto& registry = MeshRegistry::GetInstance();
 
 		std::string sceneInfoLog = std::format("Loading scene: {0}\n", Path.filename().string());
 
@@ -29,16 +30,53 @@ namespace lde
 			
 			auto startTime = std::chrono::high_resolution_clock::now();
 			
-			importer.Import(pGfx, path, model.StaticMeshes);
+			// Optional CPU geometry policy: "full", "positions" or "none".
+			GeometryResidency residency = registry.DefaultResidency;
+			if (const auto geometry = record.value("geometry", std::string()); !geometry.empty())
+			{
+				residency = (geometry == "full")	  ? GeometryResidency::eFull :
+							(geometry == "positions") ? GeometryResidency::ePositions :
+							(geometry == "none")	  ? GeometryResidency::eNone : residency;
+			}
+
+			// Repeated paths share one asset.
+			auto asset = registry.Load(path, residency);
 
 			auto endTime = std::chrono::high_resolution_clock::now();
 
 			sceneInfoLog.append(std::format("\t- {0}, load time: {1}\n", name, std::chrono::duration<double>(endTime - startTime)));
-			model.Create(pGfx, pScene->World());
+			model.Create(pScene->World(), std::move(asset));
 			model.AddComponent<NameComponent>(name);
-			model.Filepath = path;
 
-			pScene->Models.emplace_back(model);
+			pScene->Models.emplace_back(std::move(model));
+		}
+
+		// Optional streamed content; imported later, as camera gets close to it.
+		if (json["scene"].contains("streaming"))
+		{
+			const auto& streaming = json["scene"]["streaming"];
+
+			auto toFloat3 = [](const nlohmann::json& Value) {
+				return DirectX::XMFLOAT3(Value[0].get<float>(), Value[1].get<float>(), Value[2].get<float>());
+			};
+
+			auto& partition = pScene->Partition;
+			partition.Initialize(streaming.value("cell_size", 32.0f));
+			partition.LoadRadius	= streaming.value("load_radius", partition.LoadRadius);
+			partition.UnloadRadius	= std::max(streaming.value("unload_radius", partition.UnloadRadius), partition.LoadRadius);
+			partition.BudgetBytes	= streaming.value("budget_mb", partition.BudgetBytes / (1024ull * 1024ull)) * 1024ull * 1024ull;
+
+			for (const auto& record : streaming.value("models", nlohmann::json::array()))
+			{
+				partition.AddModel(record["name"].get<std::string>(), record["path"].get<std::string>(), toFloat3(record["position"]));
+			}
+
+			for (const auto& record : streaming.value("point_lights", nlohmann::json::array()))
+			{
+				partition.AddPointLight(toFloat3(record["position"]));
+			}
+
+			sceneInfoLog.append(std::format("\t- streamed cells: {0}\n", partition.GetCells().size()));
 		}
 
 		LOG_INFO(sceneInfoLog.c_str());
@@ -0,0 +1,479 @@
+#include "Components/TransformComponent.hpp"
+#include "Core/Hash.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "Scene.hpp"
+#include "SceneCamera.hpp"
+#include "ScenePicker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+
+namespace lde
+{
+	using namespace DirectX;
+
+	namespace
+	{
+		constexpr uint32 MAX_LEAF_ITEMS	= 2;
+		constexpr uint32 STACK_SIZE		= 64;
+		constexpr float DET_EPSILON		= 1.0e-12f;
+		constexpr float T_EPSILON		= 1.0e-6f;
+
+		BoundingBox GetWorldBounds(const BoundingBox& Bounds, FXMMATRIX World)
+		{
+			XMVECTOR min = XMVectorReplicate(FLT_MAX);
+			XMVECTOR max = XMVectorReplicate(-FLT_MAX);
+			for (uint32 corner = 0; corner < 8; ++corner)
+			{
+				const XMVECTOR point = XMVectorSet(
+					(corner & 1) ? Bounds.Max.x : Bounds.Min.x,
+					(corner & 2) ? Bounds.Max.y : Bounds.Min.y,
+					(corner & 4) ? Bounds.Max.z : Bounds.Min.z, 1.0f);
+				const XMVECTOR transformed = XMVector3TransformCoord(point, World);
+				min = XMVectorMin(min, transformed);
+				max = XMVectorMax(max, transformed);
+			}
+
+			BoundingBox result{};
+			XMStoreFloat3(&result.Min, min);
+			XMStoreFloat3(&result.Max, max);
+			return result;
+		}
+
+		/// @brief Slab test. Returns entry distance or FLT_MAX on miss.
+		inline float IntersectBounds(const XMFLOAT3& Min, const XMFLOAT3& Max, const XMFLOAT3& Origin, const XMFLOAT3& InvDirection, float MaxT)
+		{
+			const float tx0 = (Min.x - Origin.x) * InvDirection.x;
+			const float tx1 = (Max.x - Origin.x) * InvDirection.x;
+			const float ty0 = (Min.y - Origin.y) * InvDirection.y;
+			const float ty1 = (Max.y - Origin.y) * InvDirection.y;
+			const float tz0 = (Min.z - Origin.z) * InvDirection.z;
+			const float tz1 = (Max.z - Origin.z) * InvDirection.z;
+
+			const float tNear = std::max({ std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0f });
+			const float tFar  = std::min({ std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), MaxT });
+
+			return (tNear <= tFar) ? tNear : FLT_MAX;
+		}
+
+		inline float SafeInverse(float Value)
+		{
+			return (std::abs(Value) > 1.0e-20f) ? (1.0f / Value) : std::copysign(FLT_MAX, Value);
+		}
+	}
+
+	PickRay ScenePicker::GetRay(const SceneCamera* pCamera, float NdcX, float NdcY)
+	{
+		const XMMATRIX inverseViewProjection = XMMatrixInverse(nullptr, pCamera->GetViewProjection());
+
+		const XMVECTOR nearPoint = XMVector3TransformCoord(XMVectorSet(NdcX, NdcY, 0.0f, 1.0f), inverseViewProjection);
+		const XMVECTOR farPoint  = XMVector3TransformCoord(XMVectorSet(NdcX, NdcY, 1.0f, 1.0f), inverseViewProjection);
+
+		PickRay ray{};
+		XMStoreFloat3(&ray.Origin, nearPoint);
+		XMStoreFloat3(&ray.Direction, XMVector3Normalize(XMVectorSubtract(farPoint, nearPoint)));
+
+		return ray;
+	}
+
+	PickResult ScenePicker::Pick(Scene* pScene, const PickRay& Ray)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		m_Stats.Nodes		= 0;
+		m_Stats.Meshes		= 0;
+		m_Stats.Triangles	= 0;
+
+		if (UpdateVersion(pScene))
+		{
+			Rebuild(pScene);
+		}
+
+		PickResult result{};
+		if (m_Nodes.empty())
+		{
+			return result;
+		}
+
+		const XMFLOAT3 invDirection(SafeInverse(Ray.Direction.x), SafeInverse(Ray.Direction.y), SafeInverse(Ray.Direction.z));
+		const XMVECTOR origin		= XMLoadFloat3(&Ray.Origin);
+		const XMVECTOR direction	= XMLoadFloat3(&Ray.Direction);
+
+		float bestT = FLT_MAX;
+
+		struct StackEntry
+		{
+			uint32	Node;
+			float	tNear;
+		};
+		StackEntry stack[STACK_SIZE];
+		uint32 stackSize = 0;
+
+		const float rootT = IntersectBounds(m_Nodes[0].Min, m_Nodes[0].Max, Ray.Origin, invDirection, bestT);
+		if (rootT != FLT_MAX)
+		{
+			stack[stackSize++] = { 0, rootT };
+		}
+
+		// Front to back; subtrees behind closest hit are skipped.
+		while (stackSize > 0)
+		{
+			const StackEntry entry = stack[--stackSize];
+			if (entry.tNear > bestT)
+			{
+				continue;
+			}
+
+			const Node& node = m_Nodes[entry.Node];
+			m_Stats.Nodes++;
+
+			if (node.Count > 0)
+			{
+				for (uint32 i = node.Offset; i < node.Offset + node.Count; ++i)
+				{
+					const uint32 itemIndex = m_ItemOrder[i];
+					const Item& item = m_Items[itemIndex];
+					if (IntersectBounds(item.Bounds.Min, item.Bounds.Max, Ray.Origin, invDirection, bestT) == FLT_MAX)
+					{
+						continue;
+					}
+
+					auto& model = pScene->Models[item.Model];
+					const auto& mesh = model.GetStaticMeshes()[item.Mesh];
+					auto& triangles = m_Triangles[itemIndex];
+					if (!triangles.bBuilt)
+					{
+						// Asset might keep no CPU geometry after upload. Triangles stay unbuilt on failure, so it's retried.
+						if (!MeshRegistry::GetInstance().RequestGeometry(*model.Asset, GeometryResidency::ePositions))
+						{
+							result.Skipped++;
+							continue;
+						}
+						BuildTriangles(mesh, triangles);
+					}
+
+					// Ray in model space isn't renormalized, so hit distance stays in world units.
+					const XMMATRIX inverseWorld = XMMatrixInverse(nullptr, model.GetComponent<TransformComponent>().WorldMatrix);
+					const XMVECTOR localOrigin		= XMVector3TransformCoord(origin, inverseWorld);
+					const XMVECTOR localDirection	= XMVector3TransformNormal(direction, inverseWorld);
+
+					m_Stats.Meshes++;
+					uint32 triangle = 0;
+					if (IntersectTriangles(triangles, localOrigin, localDirection, bestT, triangle, m_Stats.Triangles))
+					{
+						result.Entity	= model.ID();
+						result.Model	= item.Model;
+						result.Mesh		= item.Mesh;
+						result.Triangle	= triangle;
+					}
+				}
+				continue;
+			}
+
+			const uint32 left = node.Offset;
+			const uint32 right = node.Offset + 1;
+			const float leftT  = IntersectBounds(m_Nodes[left].Min,  m_Nodes[left].Max,  Ray.Origin, invDirection, bestT);
+			const float rightT = IntersectBounds(m_Nodes[right].Min, m_Nodes[right].Max, Ray.Origin, invDirection, bestT);
+
+			// Push further child first, so closer one is visited next.
+			const bool bLeftFirst = leftT <= rightT;
+			const StackEntry first	= bLeftFirst ? StackEntry{ left, leftT }	: StackEntry{ right, rightT };
+			const StackEntry second	= bLeftFirst ? StackEntry{ right, rightT }	: StackEntry{ left, leftT };
+
+			if (second.tNear != FLT_MAX && stackSize < STACK_SIZE)
+			{
+				stack[stackSize++] = second;
+			}
+			if (first.tNear != FLT_MAX && stackSize < STACK_SIZE)
+			{
+				stack[stackSize++] = first;
+			}
+		}
+
+		if (result.IsValid())
+		{
+			result.Distance = bestT;
+			XMStoreFloat3(&result.Position, XMVectorMultiplyAdd(direction, XMVectorReplicate(bestT), origin));
+		}
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		m_Stats.PickTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+		return result;
+	}
+
+	void ScenePicker::Reset()
+	{
+		m_Items.clear();
+		m_ItemOrder.clear();
+		m_Nodes.clear();
+		m_Triangles.clear();
+		m_GeometryVersion	= 0;
+		m_TransformVersion	= 0;
+	}
+
+	bool ScenePicker::UpdateVersion(Scene* pScene)
+	{
+		uint64 geometryVersion = Hash::FNV_OFFSET_BASIS;
+		uint64 transformVersion = Hash::FNV_OFFSET_BASIS;
+
+		for (auto& model : pScene->Models)
+		{
+			const auto meshSpan = model.GetStaticMeshes();
+			const auto* meshes = meshSpan.data();
+			const usize meshCount = meshSpan.size();
+			geometryVersion = Hash::FNV1a(&meshes, sizeof(meshes), geometryVersion);
+			geometryVersion = Hash::FNV1a(&meshCount, sizeof(meshCount), geometryVersion);
+
+			const auto& world = model.GetComponent<TransformComponent>().WorldMatrix;
+			transformVersion = Hash::FNV1a(&world, sizeof(world), transformVersion);
+		}
+
+		const bool bGeometryChanged = (geometryVersion != m_GeometryVersion);
+		const bool bTransformChanged = (transformVersion != m_TransformVersion);
+
+		if (bGeometryChanged)
+		{
+			m_Triangles.clear();
+		}
+
+		m_GeometryVersion	= geometryVersion;
+		m_TransformVersion	= transformVersion;
+
+		return bGeometryChanged || bTransformChanged || m_Nodes.empty();
+	}
+
+	void ScenePicker::Rebuild(Scene* pScene)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		m_Items.clear();
+		for (uint32 modelIndex = 0; modelIndex < static_cast<uint32>(pScene->Models.size()); ++modelIndex)
+		{
+			auto& model = pScene->Models[modelIndex];
+			const XMMATRIX world = model.GetComponent<TransformComponent>().WorldMatrix;
+
+			const auto meshes = model.GetStaticMeshes();
+			for (uint32 meshIndex = 0; meshIndex < static_cast<uint32>(meshes.size()); ++meshIndex)
+			{
+				Item item{};
+				item.Model	= modelIndex;
+				item.Mesh	= meshIndex;
+				item.Bounds = GetWorldBounds(meshes[meshIndex].AABB, world);
+				item.Centroid = XMFLOAT3(
+					(item.Bounds.Min.x + item.Bounds.Max.x) * 0.5f,
+					(item.Bounds.Min.y + item.Bounds.Max.y) * 0.5f,
+					(item.Bounds.Min.z + item.Bounds.Max.z) * 0.5f);
+				m_Items.push_back(item);
+			}
+		}
+
+		// Items keep their order between rebuilds of the same geometry, so cached triangles stay matched.
+		m_Triangles.resize(m_Items.size());
+
+		m_ItemOrder.resize(m_Items.size());
+		for (uint32 i = 0; i < static_cast<uint32>(m_ItemOrder.size()); ++i)
+		{
+			m_ItemOrder[i] = i;
+		}
+
+		m_Nodes.clear();
+		if (!m_Items.empty())
+		{
+			m_Nodes.reserve(m_Items.size() * 2);
+			m_Nodes.emplace_back();
+			BuildNode(0, 0, static_cast<uint32>(m_Items.size()));
+		}
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		m_Stats.BuildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+	}
+
+	uint32 ScenePicker::BuildNode(uint32 NodeIndex, uint32 Begin, uint32 End)
+	{
+		XMVECTOR boundsMin		= XMVectorReplicate(FLT_MAX);
+		XMVECTOR boundsMax		= XMVectorReplicate(-FLT_MAX);
+		XMVECTOR centroidMin	= XMVectorReplicate(FLT_MAX);
+		XMVECTOR centroidMax	= XMVectorReplicate(-FLT_MAX);
+
+		for (uint32 i = Begin; i < End; ++i)
+		{
+			const Item& item = m_Items[m_ItemOrder[i]];
+			boundsMin	= XMVectorMin(boundsMin, XMLoadFloat3(&item.Bounds.Min));
+			boundsMax	= XMVectorMax(boundsMax, XMLoadFloat3(&item.Bounds.Max));
+			centroidMin = XMVectorMin(centroidMin, XMLoadFloat3(&item.Centroid));
+			centroidMax = XMVectorMax(centroidMax, XMLoadFloat3(&item.Centroid));
+		}
+
+		XMStoreFloat3(&m_Nodes[NodeIndex].Min, boundsMin);
+		XMStoreFloat3(&m_Nodes[NodeIndex].Max, boundsMax);
+
+		const uint32 count = End - Begin;
+		if (count <= MAX_LEAF_ITEMS)
+		{
+			m_Nodes[NodeIndex].Offset	= Begin;
+			m_Nodes[NodeIndex].Count	= count;
+			return NodeIndex;
+		}
+
+		// Median split along the longest axis of centroids.
+		XMFLOAT3 extent{};
+		XMStoreFloat3(&extent, XMVectorSubtract(centroidMax, centroidMin));
+		const uint32 axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : ((extent.y >= extent.z) ? 1 : 2);
+
+		const uint32 middle = Begin + count / 2;
+		std::nth_element(m_ItemOrder.begin() + Begin, m_ItemOrder.begin() + middle, m_ItemOrder.begin() + End,
+			[&](uint32 Lhs, uint32 Rhs)
+			{
+				const float* lhs = &m_Items[Lhs].Centroid.x;
+				const float* rhs = &m_Items[Rhs].Centroid.x;
+				return lhs[axis] < rhs[axis];
+			});
+
+		const uint32 left = static_cast<uint32>(m_Nodes.size());
+		m_Nodes.emplace_back();
+		m_Nodes.emplace_back();
+		m_Nodes[NodeIndex].Offset	= left;
+		m_Nodes[NodeIndex].Count	= 0;
+
+		BuildNode(left, Begin, middle);
+		BuildNode(left + 1, middle, End);
+
+		return NodeIndex;
+	}
+
+	void ScenePicker::BuildTriangles(const StaticMesh& Mesh, MeshTriangles& Triangles)
+	{
+		Triangles.bBuilt = true;
+		Triangles.Packs.clear();
+
+		// Compact positions are there when full vertices were dropped.
+		const bool bCompact = !Mesh.Positions.empty();
+		const uint32 triangleCount = static_cast<uint32>(Mesh.Indices.size() / 3);
+		const uint32 vertexCount = static_cast<uint32>(bCompact ? Mesh.Positions.size() : Mesh.Vertices.size());
+
+		auto getPosition = [&](uint32 Index) -> const XMFLOAT3& {
+			return bCompact ? Mesh.Positions[Index] : Mesh.Vertices[Index].Position;
+		};
+
+		// Padding lanes have zero edges, so their determinant rejects them.
+		Triangles.Packs.resize((triangleCount + 3) / 4, TrianglePack{});
+
+		for (uint32 triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			const uint32 i0 = Mesh.Indices[triangle * 3 + 0];
+			const uint32 i1 = Mesh.Indices[triangle * 3 + 1];
+			const uint32 i2 = Mesh.Indices[triangle * 3 + 2];
+			if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+			{
+				continue;
+			}
+
+			const XMFLOAT3& v0 = getPosition(i0);
+			const XMFLOAT3& v1 = getPosition(i1);
+			const XMFLOAT3& v2 = getPosition(i2);
+
+			auto& pack = Triangles.Packs[triangle / 4];
+			const uint32 lane = triangle % 4;
+
+			pack.V0[0][lane] = v0.x;
+			pack.V0[1][lane] = v0.y;
+			pack.V0[2][lane] = v0.z;
+			pack.E1[0][lane] = v1.x - v0.x;
+			pack.E1[1][lane] = v1.y - v0.y;
+			pack.E1[2][lane] = v1.z - v0.z;
+			pack.E2[0][lane] = v2.x - v0.x;
+			pack.E2[1][lane] = v2.y - v0.y;
+			pack.E2[2][lane] = v2.z - v0.z;
+		}
+	}
+
+	bool ScenePicker::IntersectTriangles(const MeshTriangles& Triangles, FXMVECTOR Origin, FXMVECTOR Direction,
+		float& BestT, uint32& Triangle, uint32& Tested)
+	{
+		const XMVECTOR ox = XMVectorSplatX(Origin);
+		const XMVECTOR oy = XMVectorSplatY(Origin);
+		const XMVECTOR oz = XMVectorSplatZ(Origin);
+		const XMVECTOR dx = XMVectorSplatX(Direction);
+		const XMVECTOR dy = XMVectorSplatY(Direction);
+		const XMVECTOR dz = XMVectorSplatZ(Direction);
+
+		const XMVECTOR zero		= XMVectorZero();
+		const XMVECTOR one		= XMVectorSplatOne();
+		const XMVECTOR infinity = XMVectorSplatInfinity();
+		const XMVECTOR detEpsilon = XMVectorReplicate(DET_EPSILON);
+		const XMVECTOR tEpsilon	= XMVectorReplicate(T_EPSILON);
+
+		bool bHit = false;
+
+		// Möller–Trumbore for four triangles at once.
+		for (uint32 packIndex = 0; packIndex < static_cast<uint32>(Triangles.Packs.size()); ++packIndex)
+		{
+			const auto& pack = Triangles.Packs[packIndex];
+
+			const XMVECTOR v0x = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.V0[0]));
+			const XMVECTOR v0y = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.V0[1]));
+			const XMVECTOR v0z = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.V0[2]));
+			const XMVECTOR e1x = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.E1[0]));
+			const XMVECTOR e1y = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.E1[1]));
+			const XMVECTOR e1z = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.E1[2]));
+			const XMVECTOR e2x = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.E2[0]));
+			const XMVECTOR e2y = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.E2[1]));
+			const XMVECTOR e2z = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(pack.E2[2]));
+
+			// P = D x E2
+			const XMVECTOR px = XMVectorSubtract(XMVectorMultiply(dy, e2z), XMVectorMultiply(dz, e2y));
+			const XMVECTOR py = XMVectorSubtract(XMVectorMultiply(dz, e2x), XMVectorMultiply(dx, e2z));
+			const XMVECTOR pz = XMVectorSubtract(XMVectorMultiply(dx, e2y), XMVectorMultiply(dy, e2x));
+
+			const XMVECTOR det = XMVectorMultiplyAdd(e1x, px, XMVectorMultiplyAdd(e1y, py, XMVectorMultiply(e1z, pz)));
+			const XMVECTOR invDet = XMVectorReciprocal(det);
+
+			// T = O - V0
+			const XMVECTOR tx = XMVectorSubtract(ox, v0x);
+			const XMVECTOR ty = XMVectorSubtract(oy, v0y);
+			const XMVECTOR tz = XMVectorSubtract(oz, v0z);
+
+			const XMVECTOR u = XMVectorMultiply(XMVectorMultiplyAdd(tx, px, XMVectorMultiplyAdd(ty, py, XMVectorMultiply(tz, pz))), invDet);
+
+			// Q = T x E1
+			const XMVECTOR qx = XMVectorSubtract(XMVectorMultiply(ty, e1z), XMVectorMultiply(tz, e1y));
+			const XMVECTOR qy = XMVectorSubtract(XMVectorMultiply(tz, e1x), XMVectorMultiply(tx, e1z));
+			const XMVECTOR qz = XMVectorSubtract(XMVectorMultiply(tx, e1y), XMVectorMultiply(ty, e1x));
+
+			const XMVECTOR v = XMVectorMultiply(XMVectorMultiplyAdd(dx, qx, XMVectorMultiplyAdd(dy, qy, XMVectorMultiply(dz, qz))), invDet);
+			const XMVECTOR t = XMVectorMultiply(XMVectorMultiplyAdd(e2x, qx, XMVectorMultiplyAdd(e2y, qy, XMVectorMultiply(e2z, qz))), invDet);
+
+			XMVECTOR mask = XMVectorGreater(XMVectorAbs(det), detEpsilon);
+			mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(u, zero));
+			mask = XMVectorAndInt(mask, XMVectorGreaterOrEqual(v, zero));
+			mask = XMVectorAndInt(mask, XMVectorLessOrEqual(XMVectorAdd(u, v), one));
+			mask = XMVectorAndInt(mask, XMVectorGreater(t, tEpsilon));
+			mask = XMVectorAndInt(mask, XMVectorLess(t, XMVectorReplicate(BestT)));
+
+			Tested += 4;
+
+			if (XMVector4EqualInt(mask, XMVectorFalseInt()))
+			{
+				continue;
+			}
+
+			XMFLOAT4A hits{};
+			XMStoreFloat4A(&hits, XMVectorSelect(infinity, t, mask));
+
+			const float lanes[4] = { hits.x, hits.y, hits.z, hits.w };
+			for (uint32 lane = 0; lane < 4; ++lane)
+			{
+				if (lanes[lane] < BestT)
+				{
+					BestT		= lanes[lane];
+					Triangle	= packIndex * 4 + lane;
+					bHit		= true;
+				}
+			}
+		}
+
+		return bHit;
+	}
+
+} // namespace lde
@@ -0,0 +1,128 @@
+#pragma once
+
+/*
+	Scene/ScenePicker.hpp
+	CPU ray casting against Scene Models, i.e. for selecting entities by clicking the viewport.
+	Mesh bounds are kept in a BVH; exact hits come from ray-triangle tests on CPU-side geometry,
+	so no GPU readback is needed. Geometry dropped after upload is requested back from MeshRegistry.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Scene/Model/Mesh.hpp"
+#include <DirectXMath.h>
+#include <EnTT/entt.hpp>
+#include <vector>
+
+namespace lde
+{
+	class Scene;
+	class SceneCamera;
+
+	struct PickRay
+	{
+		DirectX::XMFLOAT3 Origin	= DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		// Normalized.
+		DirectX::XMFLOAT3 Direction = DirectX::XMFLOAT3(0.0f, 0.0f, 1.0f);
+	};
+
+	struct PickResult
+	{
+		entt::entity Entity		= entt::null;
+		uint32		 Model		= UINT32_MAX;
+		uint32		 Mesh		= UINT32_MAX;
+		uint32		 Triangle	= UINT32_MAX;
+		float		 Distance	= 0.0f;
+		DirectX::XMFLOAT3 Position = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		// Meshes under the ray left out, as their CPU geometry couldn't be restored; they're tried again next Pick.
+		uint32		 Skipped	= 0;
+
+		bool IsValid() const { return Entity != entt::null; }
+	};
+
+	struct PickStats
+	{
+		uint32 Nodes		= 0;
+		uint32 Meshes		= 0;
+		uint32 Triangles	= 0;
+		double BuildTimeMs	= 0.0;
+		double PickTimeMs	= 0.0;
+	};
+
+	class ScenePicker
+	{
+	public:
+		/**
+		 * @brief Ray through a point of the camera image.
+		 * @param NdcX [-1.0, 1.0], left to right.
+		 * @param NdcY [-1.0, 1.0], bottom to top.
+		 */
+		static PickRay GetRay(const SceneCamera* pCamera, float NdcX, float NdcY);
+
+		/**
+		 * @brief Closest Model hit by a ray. Both faces of triangles count.
+		 * BVH is rebuilt first if Models or their transforms changed since last call.
+		 */
+		PickResult Pick(Scene* pScene, const PickRay& Ray);
+
+		/// @brief Drops BVH and cached triangles; i.e. after Scene is cleared.
+		void Reset();
+
+		const PickStats& GetStats() const { return m_Stats; }
+
+	private:
+		struct Item
+		{
+			uint32				Model = 0;
+			uint32				Mesh  = 0;
+			BoundingBox			Bounds;
+			DirectX::XMFLOAT3	Centroid;
+		};
+
+		struct Node
+		{
+			DirectX::XMFLOAT3 Min;
+			// Leaf: first item; inner node: left child, right one follows.
+			uint32 Offset = 0;
+			DirectX::XMFLOAT3 Max;
+			// Zero for inner nodes.
+			uint32 Count = 0;
+		};
+
+		// Four triangles in SoA: first vertex and both edges, X/Y/Z lanes each.
+		struct alignas(16) TrianglePack
+		{
+			float V0[3][4];
+			float E1[3][4];
+			float E2[3][4];
+		};
+
+		struct MeshTriangles
+		{
+			std::vector<TrianglePack> Packs;
+			bool bBuilt = false;
+		};
+
+		/// @return True if BVH has to be rebuilt; false if Scene is unchanged.
+		bool UpdateVersion(Scene* pScene);
+		void Rebuild(Scene* pScene);
+		uint32 BuildNode(uint32 NodeIndex, uint32 Begin, uint32 End);
+
+		static void BuildTriangles(const StaticMesh& Mesh, MeshTriangles& Triangles);
+
+		/// @brief Closest hit in model space; updates BestT and Triangle if closer one is found.
+		static bool IntersectTriangles(const MeshTriangles& Triangles, DirectX::FXMVECTOR Origin, DirectX::FXMVECTOR Direction,
+			float& BestT, uint32& Triangle, uint32& Tested);
+
+		std::vector<Item>			m_Items;
+		std::vector<uint32>			m_ItemOrder;
+		std::vector<Node>			m_Nodes;
+		// Model space triangles per item; kept across transform changes.
+		std::vector<MeshTriangles>	m_Triangles;
+
+		uint64 m_GeometryVersion	= 0;
+		uint64 m_TransformVersion	= 0;
+
+		PickStats m_Stats{};
+
+	};
+} // namespace lde
@@ -0,0 +1,361 @@
+#include "Components/LightComponent.hpp"
+#include "Components/NameComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Core/Logger.hpp"
+#include "Core/Math.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "Scene.hpp"
+#include "SceneSerializer.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace lde
+{
+	namespace
+	{
+		/// @brief EnTT archive writing components back to back.
+		class OutputArchive
+		{
+		public:
+			explicit OutputArchive(std::vector<uint8>& Storage) : m_Storage(Storage) { }
+
+			template<typename T>
+			void operator()(const T& Value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "Component requires explicit overload.");
+				Write(&Value, sizeof(T));
+			}
+
+			// Only TRS is stored, World Matrix is rebuilt on load.
+			void operator()(const TransformComponent& Transform)
+			{
+				Write(&Transform.Translation, sizeof(DirectX::XMFLOAT3));
+				Write(&Transform.Rotation, sizeof(DirectX::XMFLOAT3));
+				Write(&Transform.Scale, sizeof(DirectX::XMFLOAT3));
+			}
+
+			void operator()(const NameComponent& Name)
+			{
+				const uint32 length = static_cast<uint32>(Name.Name.size());
+				Write(&length, sizeof(uint32));
+				Write(Name.Name.data(), length);
+			}
+
+		private:
+			void Write(const void* pData, usize Size)
+			{
+				const usize offset = m_Storage.size();
+				m_Storage.resize(offset + Size);
+				std::memcpy(m_Storage.data() + offset, pData, Size);
+			}
+
+			std::vector<uint8>& m_Storage;
+		};
+
+		/// @brief EnTT archive reading from continuous memory. Reads past the end yield zeroes and mark archive as invalid.
+		class InputArchive
+		{
+		public:
+			InputArchive(const uint8* pData, usize Size) : m_pData(pData), m_Size(Size) { }
+
+			template<typename T>
+			void operator()(T& Value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "Component requires explicit overload.");
+				Read(&Value, sizeof(T));
+			}
+
+			void operator()(TransformComponent& Transform)
+			{
+				Read(&Transform.Translation, sizeof(DirectX::XMFLOAT3));
+				Read(&Transform.Rotation, sizeof(DirectX::XMFLOAT3));
+				Read(&Transform.Scale, sizeof(DirectX::XMFLOAT3));
+				Transform.Update();
+			}
+
+			void operator()(NameComponent& Name)
+			{
+				uint32 length = 0;
+				Read(&length, sizeof(uint32));
+				if (length > m_Size - m_Offset)
+				{
+					m_bValid = false;
+					return;
+				}
+
+				Name.Name.assign(reinterpret_cast<const char*>(m_pData + m_Offset), length);
+				m_Offset += length;
+			}
+
+			bool IsValid() const { return m_bValid; }
+
+		private:
+			void Read(void* pData, usize Size)
+			{
+				if (Size > m_Size - m_Offset)
+				{
+					std::memset(pData, 0, Size);
+					m_bValid = false;
+					return;
+				}
+
+				std::memcpy(pData, m_pData + m_Offset, Size);
+				m_Offset += Size;
+			}
+
+			const uint8*	m_pData		= nullptr;
+			usize			m_Size		= 0;
+			usize			m_Offset	= 0;
+			bool			m_bValid	= true;
+		};
+
+		constexpr uint64 SectionAlignment = 8;
+
+		template<typename T>
+		void AppendSection(std::vector<uint8>& File, const T* pData, usize Count)
+		{
+			File.resize(Align(static_cast<uint64>(File.size()), SectionAlignment));
+			const usize offset = File.size();
+			File.resize(offset + Count * sizeof(T));
+			if (Count > 0)
+			{
+				std::memcpy(File.data() + offset, pData, Count * sizeof(T));
+			}
+		}
+
+		inline uint32 ToID(entt::entity Entity)
+		{
+			return static_cast<uint32>(Entity);
+		}
+	}
+
+	void SceneSerializer::WriteRegistry(const entt::registry& Registry, std::span<const entt::entity> Entities, std::vector<uint8>& Output)
+	{
+		OutputArchive archive(Output);
+
+		// Written by hand, as snapshot can only store whole entity storage.
+		// Every entity is alive, so in-use count equals length.
+		const uint32 count = static_cast<uint32>(Entities.size());
+		archive(count);
+		archive(count);
+		for (auto entity : Entities)
+		{
+			archive(entity);
+		}
+
+		entt::snapshot{ Registry }
+			.get<TransformComponent>(archive, Entities.begin(), Entities.end())
+			.get<NameComponent>(archive, Entities.begin(), Entities.end())
+			.get<PointLightComponent>(archive, Entities.begin(), Entities.end())
+			.get<DirectionalLightComponent>(archive, Entities.begin(), Entities.end());
+	}
+
+	bool SceneSerializer::ReadRegistry(entt::continuous_loader& Loader, const uint8* pData, usize Size)
+	{
+		InputArchive archive(pData, Size);
+
+		Loader
+			.get<entt::entity>(archive)
+			.get<TransformComponent>(archive)
+			.get<NameComponent>(archive)
+			.get<PointLightComponent>(archive)
+			.get<DirectionalLightComponent>(archive);
+
+		return archive.IsValid();
+	}
+
+	bool SceneSerializer::Save(Scene* pScene, const Filepath& Path)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		auto* registry = pScene->Registry();
+
+		SceneSnapshot::Header header{};
+
+		// Only scene content is stored; Camera and Skybox are owned by engine.
+		std::vector<entt::entity> entities;
+		entities.reserve(pScene->Models.size() + pScene->Lighting.GetPointLightCount() + pScene->Lighting.GetDirectionalLightCount());
+
+		std::vector<SceneSnapshot::AssetEntry> assets;
+		std::vector<char> strings;
+		std::unordered_map<std::string, uint32> assetIDs;
+		std::vector<SceneSnapshot::ModelReference> modelRefs;
+		modelRefs.reserve(pScene->Models.size());
+
+		for (auto& model : pScene->Models)
+		{
+			const auto& filepath = model.GetFilepath();
+			auto [it, bInserted] = assetIDs.try_emplace(filepath, static_cast<uint32>(assets.size()));
+			if (bInserted)
+			{
+				assets.push_back(SceneSnapshot::AssetEntry{
+					.PathOffset = static_cast<uint32>(strings.size()),
+					.PathLength = static_cast<uint32>(filepath.size())
+				});
+				strings.insert(strings.end(), filepath.begin(), filepath.end());
+			}
+
+			modelRefs.push_back(SceneSnapshot::ModelReference{ ToID(model.ID()), it->second });
+			entities.push_back(model.ID());
+		}
+
+		// Packed order, so lights keep their order in SceneLighting after load.
+		const auto& pointLights = registry->storage<PointLightComponent>();
+		entities.insert(entities.end(), pointLights.data(), pointLights.data() + pointLights.size());
+
+		const auto& directionalLights = registry->storage<DirectionalLightComponent>();
+		entities.insert(entities.end(), directionalLights.data(), directionalLights.data() + directionalLights.size());
+
+		std::vector<uint8> registryData;
+		WriteRegistry(*registry, entities, registryData);
+
+		header.EntityCount				= static_cast<uint32>(entities.size());
+		header.AssetCount				= static_cast<uint32>(assets.size());
+		header.ModelCount				= static_cast<uint32>(modelRefs.size());
+		header.PointLightCount			= static_cast<uint32>(pointLights.size());
+		header.DirectionalLightCount	= static_cast<uint32>(directionalLights.size());
+
+		std::vector<uint8> file;
+		file.reserve(sizeof(header) + assets.size() * sizeof(SceneSnapshot::AssetEntry) + strings.size() + registryData.size() + 64);
+
+		AppendSection(file, &header, 1);
+
+		header.AssetTableOffset = Align(static_cast<uint64>(file.size()), SectionAlignment);
+		AppendSection(file, assets.data(), assets.size());
+
+		header.StringsOffset = Align(static_cast<uint64>(file.size()), SectionAlignment);
+		header.StringsSize = strings.size();
+		AppendSection(file, strings.data(), strings.size());
+
+		header.ReferencesOffset = Align(static_cast<uint64>(file.size()), SectionAlignment);
+		AppendSection(file, modelRefs.data(), modelRefs.size());
+
+		header.RegistryOffset = Align(static_cast<uint64>(file.size()), SectionAlignment);
+		header.RegistrySize = registryData.size();
+		AppendSection(file, registryData.data(), registryData.size());
+
+		std::memcpy(file.data(), &header, sizeof(header));
+
+		std::ofstream stream(Path, std::ios::binary | std::ios::trunc);
+		if (!stream.is_open())
+		{
+			LOG_ERROR(std::format("Failed to open {} for writing!", Path.string()).c_str());
+			return false;
+		}
+
+		stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+		stream.close();
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		LOG_INFO(std::format("Scene snapshot saved: {0}, {1} entities, {2} bytes, time: {3}",
+			Path.filename().string(), header.EntityCount, file.size(), std::chrono::duration<double, std::milli>(endTime - startTime)).c_str());
+
+		return true;
+	}
+
+	bool SceneSerializer::Load(Scene* pScene, const Filepath& Path)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		std::ifstream stream(Path, std::ios::binary | std::ios::ate);
+		if (!stream.is_open())
+		{
+			LOG_ERROR(std::format("Failed to open scene snapshot: {}", Path.string()).c_str());
+			return false;
+		}
+
+		// Whole file is read at once; sections are used in place afterwards.
+		std::vector<uint8> file(static_cast<usize>(stream.tellg()));
+		stream.seekg(0);
+		stream.read(reinterpret_cast<char*>(file.data()), static_cast<std::streamsize>(file.size()));
+		stream.close();
+
+		if (file.size() < sizeof(SceneSnapshot::Header))
+		{
+			LOG_ERROR(std::format("Invalid scene snapshot: {}", Path.string()).c_str());
+			return false;
+		}
+
+		SceneSnapshot::Header header{};
+		std::memcpy(&header, file.data(), sizeof(header));
+
+		if (header.Magic != SceneSnapshot::Magic || header.Version != SceneSnapshot::Version)
+		{
+			LOG_ERROR(std::format("Scene snapshot {} is invalid or of unsupported version {}; expected {}.",
+				Path.string(), header.Version, SceneSnapshot::Version).c_str());
+			return false;
+		}
+
+		const uint64 referencesSize = static_cast<uint64>(header.ModelCount) * sizeof(SceneSnapshot::ModelReference);
+		const bool bInRange =
+			header.AssetTableOffset + header.AssetCount * sizeof(SceneSnapshot::AssetEntry) <= file.size() &&
+			header.StringsOffset + header.StringsSize <= file.size() &&
+			header.ReferencesOffset + referencesSize <= file.size() &&
+			header.RegistryOffset + header.RegistrySize <= file.size();
+
+		if (!bInRange)
+		{
+			LOG_ERROR(std::format("Scene snapshot {} is truncated.", Path.string()).c_str());
+			return false;
+		}
+
+		const auto* assets		= reinterpret_cast<const SceneSnapshot::AssetEntry*>(file.data() + header.AssetTableOffset);
+		const auto* strings		= reinterpret_cast<const char*>(file.data() + header.StringsOffset);
+		const auto* modelRefs	= reinterpret_cast<const SceneSnapshot::ModelReference*>(file.data() + header.ReferencesOffset);
+
+		pScene->Clear();
+
+		auto* registry = pScene->Registry();
+		entt::continuous_loader loader{ *registry };
+
+		if (!ReadRegistry(loader, file.data() + header.RegistryOffset, header.RegistrySize))
+		{
+			LOG_WARN(std::format("Scene snapshot {}: registry data is incomplete.", Path.string()).c_str());
+		}
+
+		auto mapEntity = [&](uint32 RemoteID) { return loader.map(static_cast<entt::entity>(RemoteID)); };
+
+		// Each asset is imported once; Models sharing it reference the same MeshAsset.
+		auto& meshRegistry = MeshRegistry::GetInstance();
+		std::vector<std::shared_ptr<MeshAsset>> imported(header.AssetCount);
+
+		pScene->Models.reserve(header.ModelCount);
+		for (uint32 i = 0; i < header.ModelCount; ++i)
+		{
+			const auto& reference = modelRefs[i];
+			if (reference.AssetID >= header.AssetCount)
+			{
+				continue;
+			}
+
+			const auto& asset = assets[reference.AssetID];
+			if (static_cast<uint64>(asset.PathOffset) + asset.PathLength > header.StringsSize)
+			{
+				continue;
+			}
+
+			const std::string path(strings + asset.PathOffset, asset.PathLength);
+
+			auto& importedAsset = imported.at(reference.AssetID);
+			if (!importedAsset)
+			{
+				importedAsset = meshRegistry.Load(path);
+			}
+
+			Model model{};
+			static_cast<Entity&>(model) = Entity(pScene->World(), mapEntity(reference.Entity));
+			model.Create(pScene->World(), importedAsset);
+
+			pScene->Models.emplace_back(std::move(model));
+		}
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		LOG_INFO(std::format("Scene snapshot loaded: {0}, {1} entities, {2} assets, time: {3}",
+			Path.filename().string(), header.EntityCount, header.AssetCount, std::chrono::duration<double, std::milli>(endTime - startTime)).c_str());
+
+		return true;
+	}
+
+} // namespace lde
@@ -0,0 +1,96 @@
+#pragma once
+
+/*
+	Scene/SceneSerializer.hpp
+	Binary snapshot of scene registry.
+	Complements SceneLoader: JSON describes what to import, snapshot stores edited state of a World.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Core/FileSystem.hpp"
+#include <EnTT/entt.hpp>
+#include <span>
+#include <vector>
+
+namespace lde
+{
+	class Scene;
+
+	namespace SceneSnapshot
+	{
+		constexpr uint32 Magic		= 0x5345444C; // 'LDES'
+		constexpr uint32 Version	= 2;
+		constexpr const char* Extension = ".ldescene";
+
+		/**
+		 * @brief File layout. Every section is 8 byte aligned and addressed by its offset from the start of the file,
+		 * so file can be either read in one go or memory-mapped as is.
+		 * [Header][AssetEntry * AssetCount][String blob][References][Registry archive]
+		 */
+		struct Header
+		{
+			uint32 Magic				= SceneSnapshot::Magic;
+			uint32 Version				= SceneSnapshot::Version;
+			uint32 EntityCount			= 0;
+			uint32 AssetCount			= 0;
+			uint32 ModelCount			= 0;
+			uint32 PointLightCount		= 0;
+			uint32 DirectionalLightCount = 0;
+			uint32 Reserved				= 0;
+
+			uint64 AssetTableOffset		= 0;
+			uint64 StringsOffset		= 0;
+			uint64 StringsSize			= 0;
+			uint64 ReferencesOffset		= 0;
+			uint64 RegistryOffset		= 0;
+			uint64 RegistrySize			= 0;
+		};
+
+		/// @brief Asset is referenced by its index in asset table.
+		struct AssetEntry
+		{
+			uint32 PathOffset = 0;
+			uint32 PathLength = 0;
+		};
+
+		/// @brief References section: ModelReference * ModelCount.
+		/// Lights need no references; SceneLighting picks them up from restored components.
+		struct ModelReference
+		{
+			uint32 Entity	= 0;
+			uint32 AssetID	= 0;
+		};
+	}
+
+	class SceneSerializer
+	{
+	public:
+		/**
+		 * @brief Writes Models and lights of a given Scene with their Transform, Name and Light components.
+		 * @return False if file couldn't be written.
+		 */
+		static bool Save(Scene* pScene, const Filepath& Path);
+
+		/**
+		 * @brief Replaces Models and lights of a given Scene with ones from snapshot.
+		 * Camera and Skybox entities are kept.
+		 * GPU must be idle and Graphics Command List open, as current scene buffers are released and assets are reimported.
+		 * @return False if file is missing, invalid or of different version. Scene is unchanged then.
+		 */
+		static bool Load(Scene* pScene, const Filepath& Path);
+
+		/**
+		 * @brief Appends registry archive of given entities to Output.
+		 * Entity section is laid out as EnTT snapshot would write it, [Count][In use][Entities],
+		 * followed by Transform, Name and Light storages of these entities.
+		 */
+		static void WriteRegistry(const entt::registry& Registry, std::span<const entt::entity> Entities, std::vector<uint8>& Output);
+
+		/**
+		 * @brief Restores archive written by WriteRegistry; Loader maps stored entities to newly created ones.
+		 * @return False if archive is truncated. Whatever could be read is restored anyway.
+		 */
+		static bool ReadRegistry(entt::continuous_loader& Loader, const uint8* pData, usize Size);
+
+	};
+} // namespace lde
@@ -0,0 +1,385 @@
+#include "Components/NameComponent.hpp"
+#include "Components/TransformComponent.hpp"
+#include "Core/Logger.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "Scene.hpp"
+#include "WorldPartition.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <unordered_set>
+
+namespace lde
+{
+	void WorldPartition::Initialize(float CellSize)
+	{
+		Reset();
+		m_CellSize = std::max(CellSize, 1.0f);
+	}
+
+	void WorldPartition::AddModel(std::string_view Name, std::string_view Path, DirectX::XMFLOAT3 Position)
+	{
+		auto& cell = GetCell(Position);
+		cell.ModelEntries.push_back(StreamedModel{ std::string(Name), std::string(Path), Position });
+
+		// File size is all that's known before the first load.
+		std::error_code error;
+		const auto fileSize = std::filesystem::file_size(Path, error);
+		if (!error)
+		{
+			cell.EstimatedBytes += static_cast<uint64>(fileSize);
+		}
+	}
+
+	void WorldPartition::AddPointLight(DirectX::XMFLOAT3 Position)
+	{
+		GetCell(Position).PointLightEntries.push_back(Position);
+	}
+
+	bool WorldPartition::Update(DirectX::XMFLOAT3 CameraPosition)
+	{
+		const double commitTime = m_Stats.CommitTimeMs;
+		m_Stats = {};
+		m_Stats.Cells = static_cast<uint32>(m_Cells.size());
+		m_Stats.CommitTimeMs = commitTime;
+
+		m_Order.clear();
+
+		uint64 committed = 0;
+		uint32 loading = 0;
+
+		for (uint32 i = 0; i < static_cast<uint32>(m_Cells.size()); ++i)
+		{
+			auto& cell = m_Cells.at(i);
+
+			const float minX = static_cast<float>(cell.X) * m_CellSize;
+			const float minZ = static_cast<float>(cell.Z) * m_CellSize;
+			const float dx = std::max({ minX - CameraPosition.x, 0.0f, CameraPosition.x - (minX + m_CellSize) });
+			const float dz = std::max({ minZ - CameraPosition.z, 0.0f, CameraPosition.z - (minZ + m_CellSize) });
+			cell.Distance = std::sqrt(dx * dx + dz * dz);
+
+			if (cell.State == CellState::eLoading && cell.PendingImport.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				if (cell.Distance > UnloadRadius)
+				{
+					// Camera moved away while importing; result is not needed anymore.
+					cell.PendingImport = {};
+					cell.State = CellState::eUnloaded;
+				}
+				else
+				{
+					cell.State = CellState::eReady;
+				}
+			}
+
+			if (cell.State == CellState::eLoaded && cell.Distance > UnloadRadius)
+			{
+				cell.State = CellState::eUnloading;
+			}
+
+			switch (cell.State)
+			{
+			case CellState::eUnloaded:
+				if (cell.Distance <= LoadRadius)
+				{
+					m_Order.push_back(i);
+				}
+				break;
+			case CellState::eLoading:
+				++loading;
+				committed += cell.EstimatedBytes;
+				break;
+			case CellState::eReady:
+				committed += cell.EstimatedBytes;
+				break;
+			case CellState::eLoaded:
+				committed += cell.ResidentBytes;
+				break;
+			case CellState::eUnloading:
+				// Released by Commit before anything new is created.
+				break;
+			}
+		}
+
+		// Measured sizes might have grown past the budget.
+		committed = Evict(committed, LoadRadius);
+
+		std::sort(m_Order.begin(), m_Order.end(), [&](uint32 Lhs, uint32 Rhs) {
+			return m_Cells.at(Lhs).Distance < m_Cells.at(Rhs).Distance;
+		});
+
+		for (auto index : m_Order)
+		{
+			if (loading >= MaxConcurrentLoads)
+			{
+				break;
+			}
+
+			auto& cell = m_Cells.at(index);
+
+			// Only cells farther than this one may make room for it.
+			const uint64 required = Evict(committed + cell.EstimatedBytes, cell.Distance);
+			if (required > BudgetBytes)
+			{
+				++m_Stats.OverBudget;
+				continue;
+			}
+
+			committed = required;
+			StartLoad(cell);
+			++loading;
+		}
+
+		bool bHasWork = false;
+		for (const auto& cell : m_Cells)
+		{
+			switch (cell.State)
+			{
+			case CellState::eLoading:
+				++m_Stats.Loading;
+				break;
+			case CellState::eReady:
+				++m_Stats.Loading;
+				bHasWork = true;
+				break;
+			case CellState::eLoaded:
+				++m_Stats.Loaded;
+				m_Stats.ResidentBytes += cell.ResidentBytes;
+				break;
+			case CellState::eUnloading:
+				++m_Stats.Unloading;
+				m_Stats.ResidentBytes += cell.ResidentBytes;
+				bHasWork = true;
+				break;
+			default:
+				break;
+			}
+		}
+
+		return bHasWork;
+	}
+
+	void WorldPartition::Commit(Scene* pScene)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		// Unloads go first, so their memory is free before new cells allocate.
+		bool bUnloaded = false;
+		for (auto& cell : m_Cells)
+		{
+			if (cell.State == CellState::eUnloading)
+			{
+				UnloadCell(pScene, cell);
+				bUnloaded = true;
+			}
+		}
+
+		// Assets still used by other cells or Models stay.
+		if (bUnloaded)
+		{
+			MeshRegistry::GetInstance().ReleaseUnused();
+		}
+
+		for (auto& cell : m_Cells)
+		{
+			if (cell.State == CellState::eReady)
+			{
+				LoadCell(pScene, cell);
+			}
+		}
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		m_Stats.CommitTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+	}
+
+	void WorldPartition::Reset()
+	{
+		// Imports still running finish on their own; their results are dropped with the futures.
+		m_Cells.clear();
+		m_Lookup.clear();
+		m_Stats = {};
+	}
+
+	WorldCell& WorldPartition::GetCell(DirectX::XMFLOAT3 Position)
+	{
+		const int32 x = static_cast<int32>(std::floor(Position.x / m_CellSize));
+		const int32 z = static_cast<int32>(std::floor(Position.z / m_CellSize));
+		const uint64 key = (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(z);
+
+		auto [it, bInserted] = m_Lookup.try_emplace(key, static_cast<uint32>(m_Cells.size()));
+		if (bInserted)
+		{
+			auto& cell = m_Cells.emplace_back();
+			cell.X = x;
+			cell.Z = z;
+		}
+
+		return m_Cells.at(it->second);
+	}
+
+	void WorldPartition::StartLoad(WorldCell& Cell)
+	{
+		// Files already resident, or repeated within the cell, aren't imported again; their slot stays empty.
+		auto& registry = MeshRegistry::GetInstance();
+		std::unordered_set<std::string_view> requested;
+		std::vector<std::string> paths;
+		paths.reserve(Cell.ModelEntries.size());
+
+		for (const auto& entry : Cell.ModelEntries)
+		{
+			const bool bImport = !registry.Contains(entry.Path) && requested.insert(entry.Path).second;
+			paths.push_back(bImport ? entry.Path : std::string());
+		}
+
+		Cell.State = CellState::eLoading;
+		Cell.PendingImport = ThreadPool::GetInstance().Submit([&registry, paths = std::move(paths)]() {
+			std::vector<ImportedModel> models(paths.size());
+
+			for (usize i = 0; i < paths.size(); ++i)
+			{
+				if (!paths.at(i).empty())
+				{
+					models.at(i) = registry.Import(paths.at(i));
+				}
+			}
+
+			return models;
+		});
+	}
+
+	void WorldPartition::LoadCell(Scene* pScene, WorldCell& Cell)
+	{
+		auto imported = Cell.PendingImport.get();
+
+		auto& registry = MeshRegistry::GetInstance();
+
+		// Shared assets count fully towards every cell using them.
+		std::unordered_set<const MeshAsset*> counted;
+		uint64 bytes = 0;
+
+		for (usize i = 0; i < imported.size(); ++i)
+		{
+			auto& result = imported.at(i);
+			const auto& entry = Cell.ModelEntries.at(i);
+
+			if (!result.IsValid())
+			{
+				LOG_WARN(std::format("World cell ({0}, {1}): {2}", Cell.X, Cell.Z, result.Error).c_str());
+				continue;
+			}
+
+			std::shared_ptr<MeshAsset> asset = registry.Find(entry.Path);
+			if (!asset)
+			{
+				// Empty result means the asset was resident when import started, but got released since.
+				asset = result.Filepath.empty() ? registry.Load(entry.Path, Residency) : registry.Create(result, Residency);
+			}
+
+			if (counted.insert(asset.get()).second)
+			{
+				bytes += asset->CpuBytes + asset->GpuBytes;
+			}
+
+			Model model{};
+			model.Create(pScene->World(), std::move(asset));
+			model.AddComponent<NameComponent>(entry.Name);
+
+			auto& transform = model.GetComponent<TransformComponent>();
+			transform.Translation = entry.Position;
+			transform.Update();
+
+			Cell.Models.push_back(model.ID());
+			pScene->Models.emplace_back(std::move(model));
+		}
+
+		for (usize i = 0; i < Cell.PointLightEntries.size(); ++i)
+		{
+			const auto name = std::format("Cell ({0}, {1}) Point Light {2}", Cell.X, Cell.Z, i);
+			Cell.Lights.push_back(pScene->Lighting.AddPointLight(name, Cell.PointLightEntries.at(i)));
+		}
+
+		Cell.ResidentBytes	= bytes;
+		Cell.EstimatedBytes = bytes;
+		Cell.State			= CellState::eLoaded;
+	}
+
+	void WorldPartition::UnloadCell(Scene* pScene, WorldCell& Cell)
+	{
+		auto* world = pScene->World();
+
+		std::erase_if(pScene->Models, [&](Model& InModel) {
+			if (std::find(Cell.Models.begin(), Cell.Models.end(), InModel.ID()) == Cell.Models.end())
+			{
+				return false;
+			}
+
+			world->DestroyEntity(InModel.ID());
+
+			return true;
+		});
+
+		// Lights might have been deleted by hand in the meantime.
+		auto* registry = pScene->Registry();
+		for (auto light : Cell.Lights)
+		{
+			if (registry->valid(light))
+			{
+				world->DestroyEntity(light);
+			}
+		}
+
+		Cell.Models.clear();
+		Cell.Lights.clear();
+
+		Cell.ResidentBytes	= 0;
+		Cell.State			= CellState::eUnloaded;
+	}
+
+	uint64 WorldPartition::Evict(uint64 Bytes, float MinDistance)
+	{
+		if (Bytes <= BudgetBytes)
+		{
+			return Bytes;
+		}
+
+		m_Evictable.clear();
+		uint64 evictable = 0;
+
+		for (uint32 i = 0; i < static_cast<uint32>(m_Cells.size()); ++i)
+		{
+			const auto& cell = m_Cells.at(i);
+			if (cell.State == CellState::eLoaded && cell.Distance > LoadRadius && cell.Distance > MinDistance)
+			{
+				m_Evictable.push_back(i);
+				evictable += cell.ResidentBytes;
+			}
+		}
+
+		// Nothing is released unless it makes enough room.
+		if (Bytes - std::min(evictable, Bytes) > BudgetBytes)
+		{
+			return Bytes;
+		}
+
+		std::sort(m_Evictable.begin(), m_Evictable.end(), [&](uint32 Lhs, uint32 Rhs) {
+			return m_Cells.at(Lhs).Distance > m_Cells.at(Rhs).Distance;
+		});
+
+		for (auto index : m_Evictable)
+		{
+			if (Bytes <= BudgetBytes)
+			{
+				break;
+			}
+
+			auto& cell = m_Cells.at(index);
+			cell.State = CellState::eUnloading;
+			Bytes -= std::min(cell.ResidentBytes, Bytes);
+		}
+
+		return Bytes;
+	}
+
+} // namespace lde
@@ -0,0 +1,143 @@
+#pragma once
+
+/*
+	Scene/WorldPartition.hpp
+	Splits streamed Scene content into square cells on XZ plane.
+	Cells near the camera are imported on worker threads and get their GPU resources between frames;
+	distant ones are released again, so only the surroundings of the camera stay resident.
+*/
+
+#include "Core/CoreTypes.hpp"
+#include "Graphics/AssetManager.hpp"
+#include <DirectXMath.h>
+#include <EnTT/entt.hpp>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lde
+{
+	class Scene;
+
+	enum class CellState : uint8
+	{
+		eUnloaded,
+		// Importing on worker thread.
+		eLoading,
+		// Imported; waits for Commit to create GPU resources.
+		eReady,
+		eLoaded,
+		// Waits for Commit to release its content.
+		eUnloading
+	};
+
+	struct StreamedModel
+	{
+		std::string Name;
+		std::string Path;
+		DirectX::XMFLOAT3 Position = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+	};
+
+	struct WorldCell
+	{
+		int32 X = 0;
+		int32 Z = 0;
+		CellState State = CellState::eUnloaded;
+
+		std::vector<StreamedModel>		ModelEntries;
+		std::vector<DirectX::XMFLOAT3>	PointLightEntries;
+
+		// Owned while loaded. Mesh assets and their textures are shared through MeshRegistry.
+		std::vector<entt::entity>	Models;
+		std::vector<entt::entity>	Lights;
+
+		// Guess from file sizes until cell is loaded once; measured size afterwards.
+		uint64 EstimatedBytes	= 0;
+		uint64 ResidentBytes	= 0;
+
+		// Distance from camera to the cell on XZ plane; 0 if camera is inside.
+		float Distance = 0.0f;
+
+		std::future<std::vector<ImportedModel>> PendingImport;
+	};
+
+	struct WorldPartitionStats
+	{
+		uint32 Cells		= 0;
+		uint32 Loaded		= 0;
+		uint32 Loading		= 0;
+		uint32 Unloading	= 0;
+		// Cells that should be loaded but don't fit into the budget.
+		uint32 OverBudget	= 0;
+		uint64 ResidentBytes = 0;
+		double CommitTimeMs	= 0.0;
+	};
+
+	class WorldPartition
+	{
+	public:
+		/// @brief Drops every cell and sets grid resolution. Content of loaded cells has to be released already.
+		void Initialize(float CellSize);
+
+		void AddModel(std::string_view Name, std::string_view Path, DirectX::XMFLOAT3 Position);
+		void AddPointLight(DirectX::XMFLOAT3 Position);
+
+		/**
+		 * @brief Decides which cells to load and unload; starts imports for the nearest ones.
+		 * CPU only, called every frame.
+		 * @return True if Commit has work to do.
+		 */
+		bool Update(DirectX::XMFLOAT3 CameraPosition);
+
+		/**
+		 * @brief Releases cells marked for unload and creates GPU resources of imported ones.
+		 * GPU must be idle and Graphics command list open.
+		 */
+		void Commit(Scene* pScene);
+
+		/// @brief Forgets every cell. Called by Scene::Clear, after it released all Models and lights.
+		void Reset();
+
+		bool IsEmpty() const { return m_Cells.empty(); }
+		float GetCellSize() const { return m_CellSize; }
+
+		const std::vector<WorldCell>& GetCells() const { return m_Cells; }
+		const WorldPartitionStats& GetStats() const { return m_Stats; }
+
+		/// @brief Cells within this distance from the camera are loaded.
+		float LoadRadius = 64.0f;
+		/// @brief Cells past this distance are unloaded. Larger than LoadRadius, so cells on the border don't reload every frame.
+		float UnloadRadius = 96.0f;
+		/// @brief Upper bound for resident and in-flight cells.
+		uint64 BudgetBytes = 1024ull * 1024ull * 1024ull;
+		/// @brief Cells imported at the same time.
+		uint32 MaxConcurrentLoads = 2;
+		/// @brief CPU geometry streamed assets keep; counts towards BudgetBytes. Positions are enough for picking.
+		GeometryResidency Residency = GeometryResidency::ePositions;
+
+	private:
+		WorldCell& GetCell(DirectX::XMFLOAT3 Position);
+
+		void StartLoad(WorldCell& Cell);
+		void LoadCell(Scene* pScene, WorldCell& Cell);
+		void UnloadCell(Scene* pScene, WorldCell& Cell);
+
+		/// @brief Marks loaded cells outside LoadRadius for unload, farthest first, until Bytes fit into the budget.
+		/// @return Bytes left committed.
+		uint64 Evict(uint64 Bytes, float MinDistance);
+
+		float m_CellSize = 32.0f;
+
+		std::vector<WorldCell> m_Cells;
+		// Packed cell coordinates -> index in m_Cells.
+		std::unordered_map<uint64, uint32> m_Lookup;
+
+		// Scratch for Update and Evict.
+		std::vector<uint32> m_Order;
+		std::vector<uint32> m_Evictable;
+
+		WorldPartitionStats m_Stats{};
+
+	};
+} // namespace lde
@@ -2,6 +2,7 @@
 #include <ImGui/imgui_impl_win32.h>
 
 #include <Engine/Scene/SceneLoader.hpp>
+#include <Engine/Scene/SceneSerializer.hpp>
 
 #if EDITOR_MODE
 	extern LRESULT IMGUI_API ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
@@ -15,15 +16,19 @@ namespace lde
 
 	}
 
-	App::~App() = default;
+	App::~App()
+	{
+		SceneCamera::ReleaseInputs();
+	}
 
 	void App::Initialize()
 	{
 		Window::Create();
+		SceneCamera::InitializeInputs();
 		
 		m_Gfx = std::make_unique<D3D12RHI>();
 
-		m_ActiveScene = std::make_unique<Scene>(Window::Width, Window::Height, m_Gfx.get());
+		m_ActiveScene = std::make_unique<Scene>(Window::Width, Window::Height);
 		m_Renderer = std::make_unique<Renderer>(m_Gfx.get(), m_ActiveScene.get());
 
 #if EDITOR_MODE
@@ -56,6 +61,16 @@ namespace lde
 				m_ActiveScene->GetCamera()->ProcessInputs(m_AppTimer.DeltaTime());
 				m_ActiveScene->Camera->Update();
 
+				if (m_ActiveScene->PendingSnapshot.has_value())
+				{
+					LoadPendingSnapshot();
+				}
+
+				if (m_ActiveScene->Partition.Update(m_ActiveScene->Camera->GetPositionFloat()))
+				{
+					CommitStreamedCells();
+				}
+
 #if EDITOR_MODE
 				m_Editor->OnBeginFrame();
 				m_Renderer->Update();
@@ -72,6 +87,40 @@ namespace lde
 		m_Gfx->Device->IdleGPU();
 	}
 
+	void App::LoadPendingSnapshot()
+	{
+		// Previous frames must finish before their buffers are released.
+		m_Gfx->Device->WaitForGPU(CommandType::eGraphics);
+		m_Gfx->OpenList(m_Gfx->Device->GetGfxCommandList());
+
+		SceneSerializer::Load(m_ActiveScene.get(), m_ActiveScene->PendingSnapshot.value());
+		m_ActiveScene->PendingSnapshot.reset();
+
+		m_Gfx->Device->ExecuteCommandList(CommandType::eGraphics, false);
+	}
+
+	void App::CommitStreamedCells()
+	{
+		// Unloaded cells release buffers that previous frames might still read.
+		// Graphics Queue waited for every earlier copy batch, so those are done as well.
+		m_Gfx->Device->WaitForGPU(CommandType::eGraphics);
+		m_Gfx->OpenList(m_Gfx->Device->GetGfxCommandList());
+
+		// Geometry of loaded cells is copied on Copy Queue while frames keep rendering.
+		auto* uploader = m_Gfx->Device->GetUploader();
+		uploader->Begin();
+
+		m_ActiveScene->Partition.Commit(m_ActiveScene.get());
+
+		const uint64 uploadFence = uploader->Submit();
+
+		// Textures are still uploaded on Graphics Queue.
+		m_Gfx->Device->ExecuteCommandList(CommandType::eGraphics, false);
+
+		// Frames drawing the new cells don't start on GPU before their geometry is copied; CPU doesn't wait.
+		uploader->WaitOnQueue(m_Gfx->Device->GetGfxQueue(), uploadFence);
+	}
+
 	void App::OnResize()
 	{
 		m_Renderer->OnResize(Window::Width, Window::Height);
@@ -28,6 +28,12 @@ namespace lde
 		void OnResize();
 		void Release();
 
+		/// @brief Replaces scene content with snapshot requested by Editor. Called between frames.
+		void LoadPendingSnapshot();
+
+		/// @brief Creates and releases GPU content of streamed cells. Called between frames.
+		void CommitStreamedCells();
+
 	protected:
 		LRESULT WindowProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam) final;
 
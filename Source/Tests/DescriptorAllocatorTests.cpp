@@ -0,0 +1,174 @@
+#include "RHI/DescriptorAllocator.hpp"
+#include "Test.hpp"
+
+using namespace lde;
+
+namespace
+{
+	void TestSingleReuse()
+	{
+		DescriptorAllocator allocator(16);
+
+		const DescriptorRange a = allocator.Allocate();
+		const DescriptorRange b = allocator.Allocate();
+		const DescriptorRange c = allocator.Allocate();
+		CHECK_EQ(a.Index, 0u);
+		CHECK_EQ(b.Index, 1u);
+		CHECK_EQ(c.Index, 2u);
+
+		// Freed single slots come back last-in first-out, before the free list is touched.
+		CHECK(allocator.Free(b));
+		CHECK(allocator.Free(c));
+		CHECK_EQ(allocator.Allocate().Index, 2u);
+		CHECK_EQ(allocator.Allocate().Index, 1u);
+		CHECK_EQ(allocator.Allocate().Index, 3u);
+		CHECK_EQ(allocator.GetUsed(), 4u);
+	}
+
+	void TestBestFit()
+	{
+		DescriptorAllocator allocator(32);
+
+		const DescriptorRange r0 = allocator.Allocate(8);
+		const DescriptorRange r1 = allocator.Allocate(2);
+		const DescriptorRange r2 = allocator.Allocate(4);
+		const DescriptorRange r3 = allocator.Allocate(2);
+		CHECK_EQ(r1.Index, 8u);
+		CHECK_EQ(r3.Index, 14u);
+
+		// Free: 8 at 0, 4 at 10, 16 at 16.
+		allocator.Free(r0);
+		allocator.Free(r2);
+
+		// Smallest range that fits wins.
+		CHECK_EQ(allocator.Allocate(3).Index, r2.Index);
+		CHECK_EQ(allocator.Allocate(5).Index, r0.Index);
+		// Remainder stays in place.
+		CHECK_EQ(allocator.Allocate(3).Index, 5u);
+		CHECK_EQ(allocator.Allocate(16).Index, 16u);
+
+		// Only a single slot at 13 is left.
+		CHECK(!allocator.Allocate(2).IsValid());
+		CHECK_EQ(allocator.GetStats().FailedAllocations, 1u);
+		CHECK_EQ(allocator.Allocate().Index, 13u);
+		CHECK_EQ(allocator.GetUsed(), 32u);
+	}
+
+	void TestReserved()
+	{
+		DescriptorAllocator allocator(8, 3);
+
+		CHECK_EQ(allocator.Allocate(5).Index, 3u);
+		CHECK(!allocator.Allocate().IsValid());
+
+		// Reset hands out everything but the reserved slots again.
+		allocator.Reset();
+		CHECK_EQ(allocator.GetUsed(), 0u);
+		CHECK_EQ(allocator.GetStats().LargestFreeRange, 5u);
+		CHECK_EQ(allocator.Allocate().Index, 3u);
+
+		CHECK(!allocator.Allocate(0).IsValid());
+	}
+
+	void TestGenerations()
+	{
+		DescriptorAllocator allocator(8);
+
+		const DescriptorRange a = allocator.Allocate(2);
+		CHECK(allocator.IsAlive(a));
+		CHECK(allocator.Free(a));
+		CHECK(!allocator.IsAlive(a));
+
+		// Double free is refused and counted.
+		CHECK(!allocator.Free(a));
+		CHECK_EQ(allocator.GetStats().StaleFrees, 1u);
+
+		// Same slots again; old handle stays dead.
+		const DescriptorRange b = allocator.Allocate(2);
+		CHECK_EQ(b.Index, a.Index);
+		CHECK(b.Generation != a.Generation);
+		CHECK(allocator.IsAlive(b));
+		CHECK(!allocator.IsAlive(a));
+		CHECK(!allocator.Free(a));
+		CHECK(allocator.IsAlive(b));
+
+		// Count is part of the handle.
+		CHECK(!allocator.IsAlive(DescriptorRange{ b.Index, 1, b.Generation }));
+		CHECK(!allocator.IsAlive(DescriptorRange{}));
+
+		// Reset makes every handed out range stale.
+		const DescriptorRange c = allocator.Allocate();
+		allocator.Reset();
+		CHECK(!allocator.IsAlive(b));
+		CHECK(!allocator.IsAlive(c));
+		CHECK(!allocator.Free(c));
+		CHECK_EQ(allocator.GetStats().StaleFrees, 3u);
+	}
+
+	void TestCoalescing()
+	{
+		DescriptorAllocator allocator(12);
+
+		const DescriptorRange a = allocator.Allocate(4);
+		const DescriptorRange b = allocator.Allocate(4);
+		const DescriptorRange c = allocator.Allocate(4);
+
+		allocator.Free(b);
+		CHECK_EQ(allocator.GetStats().FreeRanges, 1u);
+
+		// Left neighbour merges.
+		allocator.Free(a);
+		CHECK_EQ(allocator.GetStats().FreeRanges, 1u);
+		CHECK_EQ(allocator.GetStats().LargestFreeRange, 8u);
+
+		// Right neighbour merges; heap is whole again.
+		allocator.Free(c);
+		const DescriptorAllocatorStats stats = allocator.GetStats();
+		CHECK_EQ(stats.FreeRanges, 1u);
+		CHECK_EQ(stats.LargestFreeRange, 12u);
+		CHECK_EQ(stats.Fragmentation, 0.0f);
+		CHECK_EQ(stats.Peak, 12u);
+		CHECK_EQ(allocator.Allocate(12).Index, 0u);
+	}
+
+	void TestSinglesMerge()
+	{
+		DescriptorAllocator allocator(4);
+
+		DescriptorRange slots[4];
+		for (auto& slot : slots)
+		{
+			slot = allocator.Allocate();
+		}
+
+		allocator.Free(slots[0]);
+		allocator.Free(slots[2]);
+		DescriptorAllocatorStats stats = allocator.GetStats();
+		CHECK_EQ(stats.FreeRanges, 2u);
+		CHECK_EQ(stats.LargestFreeRange, 1u);
+		CHECK_EQ(stats.Fragmentation, 0.5f);
+
+		// Cached singles merge back when a range needs them.
+		allocator.Free(slots[1]);
+		allocator.Free(slots[3]);
+		const DescriptorRange range = allocator.Allocate(4);
+		CHECK_EQ(range.Index, 0u);
+		CHECK_EQ(range.Count, 4u);
+
+		stats = allocator.GetStats();
+		CHECK_EQ(stats.FreeRanges, 0u);
+		CHECK_EQ(stats.FailedAllocations, 0u);
+	}
+} // namespace
+
+int main()
+{
+	TestSingleReuse();
+	TestBestFit();
+	TestReserved();
+	TestGenerations();
+	TestCoalescing();
+	TestSinglesMerge();
+
+	return Test::Report("DescriptorAllocator");
+}
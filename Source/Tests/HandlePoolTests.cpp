@@ -0,0 +1,144 @@
+#include "RHI/HandlePool.hpp"
+#include "Test.hpp"
+#include <vector>
+
+using namespace lde;
+
+namespace
+{
+	struct Object
+	{
+		uint32 Value = 0;
+	};
+
+	struct Hot
+	{
+		uint32 Stride = 0;
+	};
+
+	std::unique_ptr<Object> MakeObject(uint32 Value)
+	{
+		return std::make_unique<Object>(Object{ Value });
+	}
+
+	void TestPacking()
+	{
+		static_assert(ResourceHandle::IndexBits == 20);
+		static_assert(ResourceHandle::IndexMask == 0xFFFFF);
+		static_assert(ResourceHandle::GenerationMask == 0xFFF);
+
+		const uint32 handle = ResourceHandle::Make(0x12345, 0xABC);
+		CHECK_EQ(handle, 0xABC12345u);
+		CHECK_EQ(ResourceHandle::GetIndex(handle), 0x12345u);
+		CHECK_EQ(ResourceHandle::GetGeneration(handle), 0xABCu);
+
+		// Index doesn't spill into generation bits.
+		CHECK_EQ(ResourceHandle::Make(0x123456, 0), 0x23456u);
+
+		// Only reserved last index with last generation is UINT32_MAX.
+		CHECK_EQ(ResourceHandle::Make(ResourceHandle::IndexMask, ResourceHandle::GenerationMask), UINT32_MAX);
+		CHECK(ResourceHandle::Make(ResourceHandle::MaxSlots - 1, ResourceHandle::GenerationMask) != UINT32_MAX);
+	}
+
+	void TestStaleHandles()
+	{
+		HandlePool<Object, Hot> pool;
+
+		const uint32 first	= pool.Insert(MakeObject(1), Hot{ 16 });
+		const uint32 second	= pool.Insert(MakeObject(2), Hot{ 32 });
+		CHECK_EQ(ResourceHandle::GetIndex(first), 0u);
+		CHECK_EQ(ResourceHandle::GetIndex(second), 1u);
+		CHECK_EQ(pool.Get(second)->Value, 2u);
+		CHECK_EQ(pool.GetHot(second).Stride, 32u);
+
+		CHECK(pool.Remove(first));
+		CHECK(!pool.IsValid(first));
+		CHECK(pool.Get(first) == nullptr);
+		// Double remove is caught.
+		CHECK(!pool.Remove(first));
+		CHECK_EQ(pool.GetAliveCount(), 1u);
+
+		// Slot is reused with next generation; old handle still doesn't resolve to the new object.
+		const uint32 reused = pool.Insert(MakeObject(3));
+		CHECK_EQ(ResourceHandle::GetIndex(reused), ResourceHandle::GetIndex(first));
+		CHECK_EQ(ResourceHandle::GetGeneration(reused), ResourceHandle::GetGeneration(first) + 1);
+		CHECK(pool.Get(first) == nullptr);
+		CHECK(!pool.Remove(first));
+		CHECK_EQ(pool.Get(reused)->Value, 3u);
+		// Hot data of removed object doesn't leak into the new one.
+		CHECK_EQ(pool.GetHot(reused).Stride, 0u);
+
+		// Out of range, future generation and invalid handles.
+		CHECK(!pool.IsValid(ResourceHandle::Make(2, 0)));
+		CHECK(!pool.IsValid(ResourceHandle::Make(1, 1)));
+		CHECK(!pool.IsValid(UINT32_MAX));
+		CHECK(pool.Get(UINT32_MAX) == nullptr);
+
+		// Clear drops every slot.
+		pool.Clear();
+		CHECK(!pool.IsValid(second));
+		CHECK_EQ(pool.GetSlotCount(), 0u);
+	}
+
+	void TestGenerationWrap()
+	{
+		HandlePool<Object> pool;
+
+		// Cycle a single slot through every generation.
+		std::vector<uint32> handles;
+		for (uint32 generation = 0; generation <= ResourceHandle::GenerationMask; ++generation)
+		{
+			const uint32 handle = pool.Insert(MakeObject(generation));
+			CHECK_EQ(ResourceHandle::GetIndex(handle), 0u);
+			CHECK_EQ(ResourceHandle::GetGeneration(handle), generation);
+			CHECK(pool.Remove(handle));
+			handles.push_back(handle);
+		}
+
+		// Slot at last generation is retired, not wrapped back to 0, where the first handle would resolve again.
+		CHECK_EQ(pool.GetRetiredCount(), 1u);
+		CHECK_EQ(pool.GetFreeSlotCount(), 0u);
+
+		const uint32 next = pool.Insert(MakeObject(0));
+		CHECK_EQ(ResourceHandle::GetIndex(next), 1u);
+		CHECK_EQ(ResourceHandle::GetGeneration(next), 0u);
+		CHECK_EQ(pool.GetSlotCount(), 2u);
+
+		for (uint32 handle : handles)
+		{
+			CHECK(!pool.IsValid(handle));
+		}
+		CHECK(pool.IsValid(next));
+	}
+
+	void TestFullPool()
+	{
+		HandlePool<Object> pool;
+
+		uint32 last = UINT32_MAX;
+		for (uint32 i = 0; i < ResourceHandle::MaxSlots; ++i)
+		{
+			last = pool.Insert(MakeObject(i));
+		}
+		CHECK_EQ(ResourceHandle::GetIndex(last), ResourceHandle::MaxSlots - 1);
+		CHECK_EQ(pool.GetAliveCount(), ResourceHandle::MaxSlots);
+
+		// Reserved index is never handed out.
+		CHECK_EQ(pool.Insert(MakeObject(0)), UINT32_MAX);
+
+		CHECK(pool.Remove(last));
+		const uint32 reused = pool.Insert(MakeObject(0));
+		CHECK_EQ(ResourceHandle::GetIndex(reused), ResourceHandle::MaxSlots - 1);
+		CHECK_EQ(ResourceHandle::GetGeneration(reused), 1u);
+	}
+} // namespace
+
+int main()
+{
+	TestPacking();
+	TestStaleHandles();
+	TestGenerationWrap();
+	TestFullPool();
+
+	return Test::Report("HandlePool");
+}
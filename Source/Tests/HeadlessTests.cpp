@@ -0,0 +1,249 @@
+#include "Graphics/AssetManager.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "Render/HeadlessRenderer.hpp"
+#include "RHI/Null/NullRHI.hpp"
+#include "Scene/Components/TransformComponent.hpp"
+#include "Scene/Scene.hpp"
+#include "Test.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace lde;
+using namespace DirectX;
+
+namespace
+{
+	// Triangle whose positions depend on Seed, so every seed has its own GeometryHash.
+	ImportedModel CreateTriangle(const std::string& Filepath, uint32 Seed)
+	{
+		const float offset = static_cast<float>(Seed);
+
+		StaticMesh mesh{};
+		mesh.Vertices.resize(3);
+		mesh.Vertices[0].Position = XMFLOAT3(offset, 0.0f, 0.0f);
+		mesh.Vertices[1].Position = XMFLOAT3(offset + 1.0f, 0.0f, 0.0f);
+		mesh.Vertices[2].Position = XMFLOAT3(offset, 1.0f, 0.0f);
+		mesh.Indices		= { 0, 1, 2 };
+		mesh.NumVertices	= 3;
+		mesh.NumIndices		= 3;
+		mesh.AABB.Min		= XMFLOAT3(offset, 0.0f, 0.0f);
+		mesh.AABB.Max		= XMFLOAT3(offset + 1.0f, 1.0f, 0.0f);
+
+		ImportedModel model{};
+		model.Filepath = Filepath;
+		model.StaticMeshes.push_back(std::move(mesh));
+		model.Textures.emplace_back();
+
+		return model;
+	}
+
+	void AddModel(Scene& Scene, std::shared_ptr<MeshAsset> Asset, XMFLOAT3 Position)
+	{
+		auto& model = Scene.Models.emplace_back();
+		model.Create(Scene.World(), std::move(Asset));
+
+		auto& transform = model.GetComponent<TransformComponent>();
+		transform.Translation = Position;
+		transform.Update();
+	}
+
+	void TestSingleList()
+	{
+		NullRHI rhi;
+		Scene scene(1280, 720);
+		HeadlessRenderer renderer(&rhi, &scene);
+
+		ImportedModel imported = CreateTriangle("Headless/Triangle.gltf", 0);
+		auto asset = MeshRegistry::GetInstance().Create(imported, GeometryResidency::eFull);
+		for (uint32 i = 0; i < 8; ++i)
+		{
+			AddModel(scene, asset, XMFLOAT3(static_cast<float>(i), 0.0f, 10.0f));
+		}
+
+		renderer.RenderFrame();
+
+		// Copies of one asset are a single instanced draw.
+		const auto& stats = renderer.GetStats();
+		CHECK_EQ(stats.RecordLists, 1u);
+		CHECK_EQ(stats.List.Draws, 1u);
+		CHECK_EQ(stats.List.Instances, 8u);
+		CHECK_EQ(stats.Commands.Draws, 1u);
+		CHECK_EQ(stats.Commands.Instances, 8u);
+		CHECK_EQ(stats.Commands.Indices, 3u * 8u);
+		CHECK_EQ(stats.Commands.PipelineBinds, 1u);
+		CHECK_EQ(stats.Commands.IndexBufferBinds, 1u);
+		CHECK_EQ(rhi.GetFrameCount(), 1u);
+
+		// Counters belong to the last frame only.
+		const HeadlessFrameStats average = renderer.Run(3);
+		CHECK_EQ(average.Commands.Draws, 1u);
+		CHECK_EQ(rhi.GetFrameCount(), 4u);
+
+		asset.reset();
+		scene.Clear();
+		CHECK_EQ(MeshRegistry::GetInstance().GetStats().Assets, 0u);
+	}
+
+	void TestWorkerLists()
+	{
+		constexpr uint32 Meshes = 3 * RenderList::MinDrawsPerChunk;
+
+		NullRHI rhi;
+		Scene scene(1280, 720);
+		HeadlessRenderer renderer(&rhi, &scene);
+
+		for (uint32 i = 0; i < Meshes; ++i)
+		{
+			ImportedModel imported = CreateTriangle("Headless/Triangle" + std::to_string(i) + ".gltf", i);
+			AddModel(scene, MeshRegistry::GetInstance().Create(imported, GeometryResidency::eFull), XMFLOAT3(0.0f, 0.0f, 10.0f));
+		}
+
+		renderer.RenderFrame();
+		const HeadlessFrameStats single = renderer.GetStats();
+		CHECK_EQ(single.RecordLists, 1u);
+		CHECK_EQ(single.Commands.Draws, Meshes);
+
+		renderer.SetRecordLists(4);
+		renderer.RenderFrame();
+
+		// Chunks are never smaller than MinDrawsPerChunk; every draw is recorded exactly once.
+		const HeadlessFrameStats split = renderer.GetStats();
+		CHECK_EQ(split.RecordLists, 3u);
+		CHECK_EQ(split.List.Chunks, 3u);
+		CHECK_EQ(split.Commands.Draws, Meshes);
+		CHECK_EQ(split.Commands.Instances, Meshes);
+		CHECK_EQ(split.Commands.Indices, single.Commands.Indices);
+		// Each list binds its state from scratch.
+		CHECK(split.Commands.PipelineBinds >= single.Commands.PipelineBinds);
+
+		scene.Clear();
+		CHECK_EQ(MeshRegistry::GetInstance().GetStats().Assets, 0u);
+	}
+
+	void TestSharedGeometry()
+	{
+		NullRHI rhi;
+		Scene scene(1280, 720);
+		HeadlessRenderer renderer(&rhi, &scene);
+
+		// Same geometry exported to two files.
+		ImportedModel first		= CreateTriangle("Headless/First.gltf", 7);
+		ImportedModel second	= CreateTriangle("Headless/Second.gltf", 7);
+		auto firstAsset		= MeshRegistry::GetInstance().Create(first, GeometryResidency::eFull);
+		auto secondAsset	= MeshRegistry::GetInstance().Create(second, GeometryResidency::eFull);
+
+		const StaticMesh& firstMesh		= firstAsset->StaticMeshes.at(0);
+		const StaticMesh& secondMesh	= secondAsset->StaticMeshes.at(0);
+		CHECK_EQ(firstMesh.VertexBuffer, secondMesh.VertexBuffer);
+		CHECK_EQ(firstMesh.IndexBuffer, secondMesh.IndexBuffer);
+		CHECK_EQ(rhi.Device->GetStats().Buffers, 2u);
+
+		const auto registryStats = MeshRegistry::GetInstance().GetStats();
+		CHECK_EQ(registryStats.Assets, 2u);
+		CHECK_EQ(registryStats.Meshes, 2u);
+		CHECK_EQ(registryStats.Geometries, 1u);
+		CHECK_EQ(registryStats.GpuBytes, firstAsset->GpuBytes);
+
+		AddModel(scene, firstAsset, XMFLOAT3(0.0f, 0.0f, 10.0f));
+		AddModel(scene, secondAsset, XMFLOAT3(2.0f, 0.0f, 10.0f));
+		AddModel(scene, secondAsset, XMFLOAT3(4.0f, 0.0f, 10.0f));
+
+		// Models of both assets end up in one instanced draw.
+		renderer.RenderFrame();
+		CHECK_EQ(renderer.GetStats().Commands.Draws, 1u);
+		CHECK_EQ(renderer.GetStats().Commands.Instances, 3u);
+
+		// Buffers outlive the first asset while the second one uses them.
+		const BufferHandle vertexBuffer = secondMesh.VertexBuffer;
+		firstAsset.reset();
+		scene.World()->DestroyEntity(scene.Models.front().ID());
+		scene.Models.erase(scene.Models.begin());
+		CHECK_EQ(MeshRegistry::GetInstance().ReleaseUnused(), 1u);
+		CHECK(rhi.Device->LookupBuffer(vertexBuffer) != nullptr);
+		CHECK_EQ(rhi.Device->GetStats().Buffers, 2u);
+
+		secondAsset.reset();
+		scene.Clear();
+		CHECK(rhi.Device->LookupBuffer(vertexBuffer) == nullptr);
+		CHECK_EQ(rhi.Device->GetStats().Buffers, 0u);
+		CHECK_EQ(MeshRegistry::GetInstance().GetStats().Geometries, 0u);
+	}
+
+	void TestGeometryResidency()
+	{
+		const Filepath cacheDirectory = std::filesystem::temp_directory_path() / "HeadlessTests" / "Geometry";
+		std::filesystem::remove_all(cacheDirectory.parent_path());
+
+		NullRHI rhi;
+		auto& registry = MeshRegistry::GetInstance();
+		registry.SetGeometryCache(cacheDirectory);
+
+		// Assets keep full geometry unless told otherwise.
+		ImportedModel full = CreateTriangle("Headless/Full.gltf", 20);
+		auto fullAsset = registry.Create(full);
+		CHECK(fullAsset->Residency == GeometryResidency::eFull);
+		CHECK_EQ(fullAsset->StaticMeshes.at(0).Vertices.size(), 3u);
+
+		ImportedModel positions = CreateTriangle("Headless/Positions.gltf", 21);
+		const std::vector<Vertex> vertices = positions.StaticMeshes.at(0).Vertices;
+		auto asset = registry.Create(positions, GeometryResidency::ePositions);
+		const StaticMesh& mesh = asset->StaticMeshes.at(0);
+		CHECK(asset->Residency == GeometryResidency::ePositions);
+		CHECK(mesh.Vertices.empty());
+		CHECK_EQ(mesh.Positions.size(), 3u);
+		CHECK_EQ(mesh.Indices.size(), 3u);
+		CHECK_EQ(registry.GetGeometryCache().GetStats().Stores, 1u);
+
+		// Restored from cooked geometry; there's no importer to read the file with.
+		CHECK(registry.RequestGeometry(*asset, GeometryResidency::eFull));
+		CHECK(asset->Residency == GeometryResidency::eFull);
+		CHECK_EQ(mesh.Vertices.size(), vertices.size());
+		CHECK(mesh.Positions.empty());
+		for (usize i = 0; i < vertices.size() && i < mesh.Vertices.size(); ++i)
+		{
+			CHECK(std::memcmp(&mesh.Vertices[i], &vertices[i], sizeof(Vertex)) == 0);
+		}
+		CHECK_EQ(registry.GetStats().GeometryReloads, 1u);
+
+		// Missing entry leaves asset as it was.
+		ImportedModel none = CreateTriangle("Headless/None.gltf", 22);
+		auto noneAsset = registry.Create(none, GeometryResidency::eNone);
+		CHECK(noneAsset->StaticMeshes.at(0).Indices.empty());
+		std::filesystem::remove_all(cacheDirectory);
+		CHECK(!registry.RequestGeometry(*noneAsset, GeometryResidency::ePositions));
+		CHECK(noneAsset->Residency == GeometryResidency::eNone);
+
+		// Geometry that can't be cooked isn't dropped; Blocked is a file, so no entries fit under it.
+		const Filepath blocked = cacheDirectory.parent_path() / "Blocked";
+		std::ofstream(blocked).put('\0');
+		registry.SetGeometryCache(blocked / "Geometry");
+
+		ImportedModel kept = CreateTriangle("Headless/Kept.gltf", 23);
+		auto keptAsset = registry.Create(kept, GeometryResidency::eNone);
+		CHECK(keptAsset->Residency == GeometryResidency::eFull);
+		CHECK_EQ(keptAsset->StaticMeshes.at(0).Vertices.size(), 3u);
+
+		fullAsset.reset();
+		asset.reset();
+		noneAsset.reset();
+		keptAsset.reset();
+		CHECK_EQ(registry.ReleaseUnused(), 4u);
+
+		registry.SetGeometryCache("Cache/Geometry");
+		std::filesystem::remove_all(cacheDirectory.parent_path());
+	}
+} // namespace
+
+int main()
+{
+	TestSingleList();
+	TestWorkerLists();
+	TestSharedGeometry();
+	TestGeometryResidency();
+
+	MeshRegistry::GetInstance().Release();
+
+	return Test::Report("Headless");
+}
@@ -0,0 +1,169 @@
+#include "Render/LightBufferUpload.hpp"
+#include "RHI/LinearAllocator.hpp"
+#include "Test.hpp"
+
+using namespace lde;
+
+namespace
+{
+	constexpr uint32 FramesInFlight = 2;
+	// Stand-in for light stride; only sizes staging allocations.
+	constexpr uint64 LightSize = 64;
+
+	bool Equal(LightDirtyRange Lhs, uint32 Begin, uint32 End)
+	{
+		return Lhs.Begin == Begin && Lhs.End == End;
+	}
+
+	/// @brief LightPass::UpdateLightBuffer without the copy: staging comes from frame allocator, commit only if it fits.
+	bool UploadFrame(LightBufferUpload& Upload, LinearAllocator& FrameAllocator, uint32 Count, LightDirtyRange DirtyRange, LightBufferPlan* pOutPlan = nullptr)
+	{
+		const LightBufferPlan plan = Upload.Prepare(Count, DirtyRange);
+		if (pOutPlan)
+		{
+			*pOutPlan = plan;
+		}
+
+		if (plan.Range.IsEmpty())
+		{
+			return true;
+		}
+
+		if (FrameAllocator.Allocate((plan.Range.End - plan.Range.Begin) * LightSize) == LinearAllocator::InvalidOffset)
+		{
+			return false;
+		}
+
+		Upload.Commit();
+		return true;
+	}
+
+	void TestGrowth()
+	{
+		LightBufferUpload upload(FramesInFlight);
+
+		// First frame creates buffer and uploads every light.
+		LightBufferPlan plan = upload.Prepare(10, LightDirtyRange{ 4, 6 });
+		CHECK(plan.bGrow);
+		CHECK_EQ(plan.Capacity, LightBufferUpload::MinCapacity);
+		CHECK(Equal(plan.Range, 0, 10));
+		CHECK(!upload.HasRetired());
+		upload.Commit();
+
+		// Within capacity only dirty range is copied.
+		CHECK(!upload.AdvanceFrame());
+		plan = upload.Prepare(64, LightDirtyRange{ 3, 5 });
+		CHECK(!plan.bGrow);
+		CHECK(Equal(plan.Range, 3, 5));
+		upload.Commit();
+
+		CHECK(!upload.AdvanceFrame());
+		plan = upload.Prepare(64, LightDirtyRange());
+		CHECK(plan.Range.IsEmpty());
+
+		// Growing rounds to a power of two; old buffer is retired for frames in flight.
+		CHECK(!upload.AdvanceFrame());
+		plan = upload.Prepare(65, LightDirtyRange{ 64, 65 });
+		CHECK(plan.bGrow);
+		CHECK_EQ(plan.Capacity, 128u);
+		CHECK(Equal(plan.Range, 0, 65));
+		CHECK(upload.HasRetired());
+		upload.Commit();
+
+		CHECK(!upload.AdvanceFrame());
+		CHECK(upload.AdvanceFrame());
+		CHECK(!upload.HasRetired());
+		CHECK(!upload.AdvanceFrame());
+
+		// Reset drops buffer; next frame creates it from scratch.
+		upload.Reset();
+		CHECK_EQ(upload.GetCapacity(), 0u);
+		plan = upload.Prepare(0, LightDirtyRange());
+		CHECK(plan.bGrow);
+		CHECK_EQ(plan.Capacity, LightBufferUpload::MinCapacity);
+		CHECK(plan.Range.IsEmpty());
+	}
+
+	void TestSkippedUpload()
+	{
+		// Room for 4 lights per frame.
+		LinearAllocator frameAllocator(4 * LightSize, FramesInFlight, LightSize);
+		LightBufferUpload upload(FramesInFlight);
+
+		uint64 fence = 0;
+		auto beginFrame = [&](uint32 Frame) {
+			frameAllocator.EndFrame(++fence);
+			CHECK(frameAllocator.BeginFrame(Frame % FramesInFlight, fence));
+			upload.AdvanceFrame();
+		};
+
+		CHECK(frameAllocator.BeginFrame(0, 0));
+		CHECK(UploadFrame(upload, frameAllocator, 4, LightDirtyRange{ 0, 4 }));
+
+		// Frame allocator is exhausted by other uploads; range stays pending.
+		beginFrame(1);
+		CHECK(frameAllocator.Allocate(3 * LightSize) != LinearAllocator::InvalidOffset);
+		CHECK(!UploadFrame(upload, frameAllocator, 4, LightDirtyRange{ 1, 3 }));
+		CHECK(Equal(upload.GetPending(), 1, 3));
+
+		// Nothing new is dirty; pending range is retried on its own.
+		beginFrame(2);
+		CHECK(frameAllocator.Allocate(3 * LightSize) != LinearAllocator::InvalidOffset);
+		LightBufferPlan plan{};
+		CHECK(!UploadFrame(upload, frameAllocator, 4, LightDirtyRange(), &plan));
+		CHECK(Equal(plan.Range, 1, 3));
+
+		// Retried together with new dirty range once there's space.
+		beginFrame(3);
+		CHECK(UploadFrame(upload, frameAllocator, 4, LightDirtyRange{ 3, 4 }, &plan));
+		CHECK(Equal(plan.Range, 1, 4));
+		CHECK(upload.GetPending().IsEmpty());
+
+		beginFrame(4);
+		CHECK(UploadFrame(upload, frameAllocator, 4, LightDirtyRange(), &plan));
+		CHECK(plan.Range.IsEmpty());
+	}
+
+	void TestSkippedGrowth()
+	{
+		LightBufferUpload upload(FramesInFlight);
+		upload.Prepare(8, LightDirtyRange{ 0, 8 });
+		upload.Commit();
+
+		// New buffer is empty; if its first upload is skipped, every light is still pending.
+		LightBufferPlan plan = upload.Prepare(100, LightDirtyRange{ 99, 100 });
+		CHECK(plan.bGrow);
+		CHECK(Equal(upload.GetPending(), 0, 100));
+
+		plan = upload.Prepare(100, LightDirtyRange{ 50, 51 });
+		CHECK(!plan.bGrow);
+		CHECK(Equal(plan.Range, 0, 100));
+		upload.Commit();
+	}
+
+	void TestRemovedLights()
+	{
+		LightBufferUpload upload(FramesInFlight);
+		upload.Prepare(32, LightDirtyRange{ 0, 32 });
+		upload.Commit();
+
+		// Pending range past the last light is clamped.
+		upload.Prepare(32, LightDirtyRange{ 20, 30 });
+		LightBufferPlan plan = upload.Prepare(25, LightDirtyRange{ 2, 3 });
+		CHECK(Equal(plan.Range, 2, 25));
+
+		plan = upload.Prepare(1, LightDirtyRange());
+		CHECK(plan.Range.IsEmpty());
+		CHECK(!plan.bGrow);
+	}
+} // namespace
+
+int main()
+{
+	TestGrowth();
+	TestSkippedUpload();
+	TestSkippedGrowth();
+	TestRemovedLights();
+
+	return Test::Report("LightBufferUpload");
+}
@@ -0,0 +1,88 @@
+#include "Render/LightClusters.hpp"
+#include "Core/ThreadPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace lde;
+using namespace DirectX;
+
+namespace
+{
+	constexpr uint32 Width			= 1920;
+	constexpr uint32 Height			= 1080;
+	constexpr float  zNear			= 0.1f;
+	constexpr float  zFar			= 1000.0f;
+	constexpr float  MaxDistance	= 200.0f;
+
+	// Same seed every run, so results compare between builds.
+	std::vector<PointLightComponent> CreateLights(uint32 Count)
+	{
+		std::mt19937 generator(1337);
+		std::uniform_real_distribution<float> horizontal(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> vertical(0.0f, 20.0f);
+		std::uniform_real_distribution<float> range(2.0f, 12.0f);
+
+		std::vector<PointLightComponent> lights(Count);
+		for (auto& light : lights)
+		{
+			light.Position	= XMFLOAT3(horizontal(generator), vertical(generator), horizontal(generator) + 100.0f);
+			light.Range		= range(generator);
+		}
+
+		return lights;
+	}
+} // namespace
+
+/**
+ * Times LightClusters::Build over synthetic point lights scattered in front of the camera.
+ * Build touches no graphics API, so nothing but the ThreadPool is needed.
+ * Usage: LightClustersBenchmark [iterations]
+ */
+int main(int argc, char* argv[])
+{
+	const uint32 iterations = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 200;
+
+	const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 10.0f, -20.0f, 1.0f), XMVectorSet(0.0f, 5.0f, 100.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<float>(Width) / Height, zNear, zFar);
+
+	std::printf("LightClusters::Build, %ux%ux%u clusters, %u workers, %u iterations\n",
+		CLUSTER_TILES_X, CLUSTER_TILES_Y, CLUSTER_SLICES, ThreadPool::GetInstance().GetWorkerCount(), iterations);
+	std::printf("%8s %10s %10s %10s %10s %8s %8s %10s\n", "Lights", "Mean ms", "Min ms", "Max ms", "Indices", "MaxPer", "Active", "Overflows");
+
+	for (const uint32 count : { 256u, 1024u, 4096u, 16384u })
+	{
+		const std::vector<PointLightComponent> lights = CreateLights(count);
+
+		LightClusters clusters;
+		// Warm up: cluster bounds and worker buffers are built on first use.
+		clusters.Build(view, projection, zNear, MaxDistance, Width, Height, lights);
+
+		double total = 0.0;
+		double fastest = 1.0e30;
+		double slowest = 0.0;
+		for (uint32 i = 0; i < iterations; ++i)
+		{
+			clusters.Build(view, projection, zNear, MaxDistance, Width, Height, lights);
+
+			const double time = clusters.GetStats().BuildTimeMs;
+			total	+= time;
+			fastest	 = std::min(fastest, time);
+			slowest	 = std::max(slowest, time);
+		}
+
+		const LightClusterStats& stats = clusters.GetStats();
+		if (stats.Lights != count || stats.Indices == 0)
+		{
+			std::fprintf(stderr, "Unexpected result for %u lights: %u lights, %u indices\n", count, stats.Lights, stats.Indices);
+			return 1;
+		}
+
+		std::printf("%8u %10.3f %10.3f %10.3f %10u %8u %8u %10u\n",
+			count, total / iterations, fastest, slowest, stats.Indices, stats.MaxPerCluster, stats.ActiveClusters, stats.Overflows);
+	}
+
+	return 0;
+}
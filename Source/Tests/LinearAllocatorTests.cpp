@@ -0,0 +1,102 @@
+#include "RHI/LinearAllocator.hpp"
+#include "Test.hpp"
+
+using namespace lde;
+
+namespace
+{
+	void TestAlignment()
+	{
+		// Region size is rounded up, so every region starts aligned.
+		LinearAllocator allocator(1000, 3);
+		CHECK_EQ(allocator.GetRegionSize(), 1024u);
+		CHECK_EQ(allocator.GetTotalSize(), 3072u);
+
+		CHECK_EQ(allocator.Allocate(100), 0u);
+		CHECK_EQ(allocator.Allocate(1), 256u);
+		// Larger alignment than the default is honored, smaller one is raised to it.
+		CHECK_EQ(allocator.Allocate(1, 512), 512u);
+		CHECK_EQ(allocator.Allocate(1, 16), 768u);
+		CHECK_EQ(allocator.GetUsedSize(), 769u);
+
+		// Aligned offset would run past the region.
+		CHECK_EQ(allocator.Allocate(1), LinearAllocator::InvalidOffset);
+		CHECK_EQ(allocator.GetFailedAllocations(), 1u);
+		CHECK_EQ(allocator.GetUsedSize(), 769u);
+
+		// Custom default alignment.
+		LinearAllocator small(64, 1, 16);
+		CHECK_EQ(small.Allocate(3), 0u);
+		CHECK_EQ(small.Allocate(3), 16u);
+		CHECK_EQ(small.Allocate(32), 32u);
+		CHECK_EQ(small.Allocate(1), LinearAllocator::InvalidOffset);
+	}
+
+	void TestRegions()
+	{
+		LinearAllocator allocator(1024, 3);
+
+		// Offsets are from the start of the whole range.
+		for (uint32 frame = 0; frame < 3; ++frame)
+		{
+			CHECK(allocator.BeginFrame(frame, 0));
+			CHECK_EQ(allocator.GetCurrentFrame(), frame);
+			CHECK_EQ(allocator.Allocate(1024), frame * 1024u);
+			CHECK_EQ(allocator.Allocate(1), LinearAllocator::InvalidOffset);
+		}
+
+		CHECK_EQ(allocator.GetPeakSize(), 1024u);
+		CHECK_EQ(allocator.GetFailedAllocations(), 3u);
+	}
+
+	void TestFenceReset()
+	{
+		LinearAllocator allocator(1024, 2);
+		uint64 fenceValue = 0;
+
+		CHECK(allocator.BeginFrame(0, 0));
+		CHECK_EQ(allocator.Allocate(512), 0u);
+		allocator.EndFrame(++fenceValue);
+
+		CHECK(allocator.BeginFrame(1, 0));
+		CHECK_EQ(allocator.Allocate(256), 1024u);
+		allocator.EndFrame(++fenceValue);
+
+		// GPU hasn't finished frame 0; its region is neither reset nor handed out.
+		CHECK(!allocator.BeginFrame(0, 0));
+		CHECK_EQ(allocator.GetUsedSize(), 512u);
+		CHECK_EQ(allocator.Allocate(16), LinearAllocator::InvalidOffset);
+		CHECK_EQ(allocator.GetFailedAllocations(), 1u);
+
+		// Fence of frame 0 reached; region starts over.
+		CHECK(allocator.BeginFrame(0, 1));
+		CHECK_EQ(allocator.GetUsedSize(), 0u);
+		CHECK_EQ(allocator.Allocate(16), 0u);
+		allocator.EndFrame(++fenceValue);
+
+		// Completed value past the tag works too; frame 1 was tagged with 2.
+		CHECK(!allocator.BeginFrame(1, 1));
+		CHECK(allocator.BeginFrame(1, 3));
+		CHECK_EQ(allocator.Allocate(16), 1024u);
+
+		CHECK_EQ(allocator.GetPeakSize(), 512u);
+	}
+
+	void TestUninitialized()
+	{
+		LinearAllocator allocator;
+		CHECK_EQ(allocator.Allocate(16), LinearAllocator::InvalidOffset);
+		CHECK_EQ(allocator.GetUsedSize(), 0u);
+		CHECK_EQ(allocator.GetTotalSize(), 0u);
+	}
+} // namespace
+
+int main()
+{
+	TestAlignment();
+	TestRegions();
+	TestFenceReset();
+	TestUninitialized();
+
+	return Test::Report("LinearAllocator");
+}
@@ -0,0 +1,290 @@
+#include "RHI/PipelineCache.hpp"
+#include "RHI/PipelineState.hpp"
+#include "Test.hpp"
+#include <cstring>
+#include <filesystem>
+#include <map>
+
+using namespace lde;
+
+namespace
+{
+	const Filepath Root = std::filesystem::temp_directory_path() / "LdePipelineCacheTests";
+
+	// Stands in for a driver compiled pipeline.
+	using FakePipeline = uint32;
+
+	/**
+	 * Stands in for ID3D12PipelineLibrary: pipelines by key, serialized as driver ID followed by key and pipeline pairs.
+	 * Blob of another driver is rejected, as drivers do.
+	 */
+	struct FakeLibrary
+	{
+		uint32 Driver = 1;
+		std::map<uint64, FakePipeline> Pipelines;
+		bool bStoreFails = false;
+
+		bool Open(std::span<const uint8> Blob)
+		{
+			uint32 driver = 0;
+			if (Blob.size() < sizeof(driver))
+			{
+				return false;
+			}
+			std::memcpy(&driver, Blob.data(), sizeof(driver));
+			if (driver != Driver)
+			{
+				return false;
+			}
+
+			for (usize offset = sizeof(driver); offset + sizeof(uint64) + sizeof(FakePipeline) <= Blob.size(); offset += sizeof(uint64) + sizeof(FakePipeline))
+			{
+				uint64 key = 0;
+				FakePipeline pipeline = 0;
+				std::memcpy(&key, Blob.data() + offset, sizeof(key));
+				std::memcpy(&pipeline, Blob.data() + offset + sizeof(key), sizeof(pipeline));
+				Pipelines.emplace(key, pipeline);
+			}
+
+			return true;
+		}
+
+		std::vector<uint8> Serialize() const
+		{
+			std::vector<uint8> blob(sizeof(Driver));
+			std::memcpy(blob.data(), &Driver, sizeof(Driver));
+
+			for (const auto& [key, pipeline] : Pipelines)
+			{
+				const usize offset = blob.size();
+				blob.resize(offset + sizeof(key) + sizeof(pipeline));
+				std::memcpy(blob.data() + offset, &key, sizeof(key));
+				std::memcpy(blob.data() + offset + sizeof(key), &pipeline, sizeof(pipeline));
+			}
+
+			return blob;
+		}
+	};
+
+	/// @brief What D3D12PipelineCache does per run: open library from file, request pipelines, save if dirty.
+	struct FakeRun
+	{
+		FakeLibrary Library;
+		PipelineCache<FakePipeline> Cache;
+		uint32 Compiled = 0;
+		bool bCreateFails = false;
+
+		explicit FakeRun(uint32 Driver, const Filepath& Path)
+		{
+			Library.Driver = Driver;
+
+			std::vector<uint8> blob;
+			if (PipelineLibraryFile::Read(Path, blob) && !Library.Open(blob))
+			{
+				// Out of date; rebuilt from scratch.
+				Library.Pipelines.clear();
+			}
+		}
+
+		PipelineSource Get(uint64 Key, FakePipeline& OutPipeline)
+		{
+			return Cache.Get(Key, OutPipeline,
+				[&](uint64 Hash, FakePipeline& Pipeline)
+				{
+					auto it = Library.Pipelines.find(Hash);
+					if (it == Library.Pipelines.end())
+					{
+						return false;
+					}
+					Pipeline = it->second;
+					return true;
+				},
+				[&](FakePipeline& Pipeline)
+				{
+					if (bCreateFails)
+					{
+						return false;
+					}
+					Pipeline = ++Compiled + 100;
+					return true;
+				},
+				[&](uint64 Hash, const FakePipeline& Pipeline)
+				{
+					return !Library.bStoreFails && Library.Pipelines.emplace(Hash, Pipeline).second;
+				});
+		}
+
+		bool Save(const Filepath& Path)
+		{
+			if (!Cache.IsDirty())
+			{
+				return false;
+			}
+
+			if (PipelineLibraryFile::Write(Path, Library.Serialize()))
+			{
+				Cache.MarkSaved();
+			}
+
+			return true;
+		}
+	};
+
+	void TestLookup()
+	{
+		FakeRun run(1, Root / "Missing.bin");
+		CHECK(run.Library.Pipelines.empty());
+
+		FakePipeline first = 0;
+		FakePipeline second = 0;
+		CHECK(run.Get(0xA, first) == PipelineSource::eCreated);
+		CHECK(run.Cache.IsDirty());
+
+		// Equal keys share a single pipeline.
+		CHECK(run.Get(0xA, second) == PipelineSource::eMemory);
+		CHECK_EQ(first, second);
+		CHECK(run.Get(0xB, second) == PipelineSource::eCreated);
+		CHECK(first != second);
+
+		// Library already has it from elsewhere; i.e. another cache of the same run saved it.
+		run.Library.Pipelines.emplace(0xC, 7u);
+		CHECK(run.Get(0xC, second) == PipelineSource::eLibrary);
+		CHECK_EQ(second, 7u);
+		CHECK(run.Get(0xC, second) == PipelineSource::eMemory);
+
+		const PipelineCacheStats stats = run.Cache.GetStats();
+		CHECK_EQ(stats.Requests, 5u);
+		CHECK_EQ(stats.MemoryHits, 2u);
+		CHECK_EQ(stats.LibraryHits, 1u);
+		CHECK_EQ(stats.Created, 2u);
+		CHECK_EQ(stats.Pipelines, 3u);
+		CHECK_EQ(run.Compiled, 2u);
+
+		run.Cache.Clear();
+		CHECK_EQ(run.Cache.GetStats().Pipelines, 0u);
+		CHECK(run.Get(0xA, second) == PipelineSource::eLibrary);
+	}
+
+	void TestFailures()
+	{
+		FakeRun run(1, Root / "Missing.bin");
+
+		// Failed creation caches nothing; next request tries again.
+		FakePipeline pipeline = 0;
+		run.bCreateFails = true;
+		CHECK(run.Get(0xA, pipeline) == PipelineSource::eFailed);
+		CHECK_EQ(pipeline, 0u);
+		CHECK_EQ(run.Cache.GetStats().Pipelines, 0u);
+		CHECK(!run.Cache.IsDirty());
+
+		run.bCreateFails = false;
+		CHECK(run.Get(0xA, pipeline) == PipelineSource::eCreated);
+		CHECK(pipeline != 0u);
+
+		// Pipeline library didn't take it; pipeline is still used, but there's nothing to save.
+		FakeRun unsupported(1, Root / "Missing.bin");
+		unsupported.Library.bStoreFails = true;
+		CHECK(unsupported.Get(0xA, pipeline) == PipelineSource::eCreated);
+		CHECK(unsupported.Get(0xA, pipeline) == PipelineSource::eMemory);
+		CHECK(!unsupported.Cache.IsDirty());
+		CHECK(!unsupported.Save(Root / "Unsupported.bin"));
+		CHECK(!std::filesystem::exists(Root / "Unsupported.bin"));
+	}
+
+	void TestSerialization()
+	{
+		const Filepath path = Root / "Pipelines.bin";
+		FakePipeline pipeline = 0;
+
+		// First run compiles everything and saves.
+		FakePipeline compiled = 0;
+		{
+			FakeRun run(1, path);
+			CHECK(run.Get(0xA, compiled) == PipelineSource::eCreated);
+			CHECK(run.Get(0xB, pipeline) == PipelineSource::eCreated);
+			CHECK(run.Save(path));
+			CHECK(!run.Cache.IsDirty());
+			CHECK(!run.Save(path));
+		}
+
+		// Second run loads both; nothing new, so file isn't rewritten.
+		{
+			const auto written = std::filesystem::last_write_time(path);
+
+			FakeRun run(1, path);
+			CHECK_EQ(run.Library.Pipelines.size(), 2u);
+			CHECK(run.Get(0xA, pipeline) == PipelineSource::eLibrary);
+			CHECK_EQ(pipeline, compiled);
+			CHECK(run.Get(0xB, pipeline) == PipelineSource::eLibrary);
+			CHECK_EQ(run.Compiled, 0u);
+			CHECK(!run.Save(path));
+			CHECK(std::filesystem::last_write_time(path) == written);
+
+			// New pipeline makes it dirty again.
+			CHECK(run.Get(0xC, pipeline) == PipelineSource::eCreated);
+			CHECK(run.Save(path));
+		}
+
+		// Another driver rejects the blob; library is rebuilt and saved over the old one.
+		{
+			FakeRun run(2, path);
+			CHECK(run.Library.Pipelines.empty());
+			CHECK(run.Get(0xA, pipeline) == PipelineSource::eCreated);
+			CHECK(run.Save(path));
+		}
+		{
+			FakeRun run(2, path);
+			CHECK_EQ(run.Library.Pipelines.size(), 1u);
+			CHECK(run.Get(0xA, pipeline) == PipelineSource::eLibrary);
+		}
+	}
+
+	void TestLibraryFile()
+	{
+		const Filepath path = Root / "File.bin";
+		const std::vector<uint8> blob = { 1, 2, 3, 4, 5 };
+
+		std::vector<uint8> read = { 9 };
+		CHECK(!PipelineLibraryFile::Read(Root / "Missing.bin", read));
+		CHECK(read.empty());
+
+		CHECK(PipelineLibraryFile::Write(path, blob));
+		CHECK(PipelineLibraryFile::Read(path, read));
+		CHECK(read == blob);
+
+		std::vector<uint8> file;
+		CHECK(Files::ReadBinary(path, file));
+		CHECK_EQ(file.size(), blob.size() + 2 * sizeof(uint32));
+
+		// Written with another PipelineKey::Version; keys inside no longer match.
+		std::vector<uint8> stale = file;
+		const uint32 version = PipelineKey::Version + 1;
+		std::memcpy(stale.data() + sizeof(uint32), &version, sizeof(version));
+		CHECK(Files::WriteBinary(path, stale));
+		CHECK(!PipelineLibraryFile::Read(path, read));
+
+		// Not a library file at all.
+		std::vector<uint8> foreign = file;
+		foreign.at(0) ^= 0xFF;
+		CHECK(Files::WriteBinary(path, foreign));
+		CHECK(!PipelineLibraryFile::Read(path, read));
+
+		// Header alone has no blob.
+		CHECK(PipelineLibraryFile::Write(path, {}));
+		CHECK(!PipelineLibraryFile::Read(path, read));
+	}
+} // namespace
+
+int main()
+{
+	std::filesystem::remove_all(Root);
+
+	TestLookup();
+	TestFailures();
+	TestSerialization();
+	TestLibraryFile();
+
+	std::filesystem::remove_all(Root);
+
+	return Test::Report("PipelineCache");
+}
@@ -0,0 +1,216 @@
+#include "RHI/PipelineState.hpp"
+#include "Test.hpp"
+#include <cstring>
+#include <limits>
+#include <new>
+
+using namespace lde;
+
+namespace
+{
+	constexpr uint8 VertexBytecode[] = { 0x44, 0x58, 0x42, 0x43, 0x01, 0x02, 0x03, 0x04 };
+	constexpr uint8 PixelBytecode[]	 = { 0x44, 0x58, 0x42, 0x43, 0x05, 0x06, 0x07, 0x08 };
+
+	// Arbitrary backend enum values.
+	constexpr uint32 FormatRGBA8	= 28;
+	constexpr uint32 FormatRGBA16F	= 10;
+	constexpr uint32 FormatD32		= 40;
+
+	void SetShader(PipelineStateDesc& Desc, PipelineShaderSlot Slot, uint64 Hash)
+	{
+		Desc.Shaders.at(static_cast<usize>(Slot)) = Hash;
+	}
+
+	PipelineStateDesc CreateGraphicsDesc()
+	{
+		PipelineStateDesc desc{};
+		desc.RootSignature = 0x1234;
+		SetShader(desc, PipelineShaderSlot::eVertex, PipelineKey::HashBlob(VertexBytecode, sizeof(VertexBytecode)));
+		SetShader(desc, PipelineShaderSlot::ePixel, PipelineKey::HashBlob(PixelBytecode, sizeof(PixelBytecode)));
+
+		desc.DepthStencil.bDepthEnable		= true;
+		desc.DepthStencil.DepthWriteMask	= 1;
+		desc.DepthStencil.DepthFunc			= 2;
+
+		desc.PrimitiveTopology		= 3;
+		desc.RenderTargetCount		= 2;
+		desc.RenderTargetFormats	= { FormatRGBA8, FormatRGBA16F };
+		desc.DepthFormat			= FormatD32;
+
+		return desc;
+	}
+
+	void TestPadding()
+	{
+		// Same fields over differently filled memory; padding bytes keep the fill.
+		alignas(PipelineStateDesc) uint8 storageA[sizeof(PipelineStateDesc)];
+		alignas(PipelineStateDesc) uint8 storageB[sizeof(PipelineStateDesc)];
+		std::memset(storageA, 0x00, sizeof(storageA));
+		std::memset(storageB, 0xCD, sizeof(storageB));
+
+		auto* descA = new (storageA) PipelineStateDesc;
+		auto* descB = new (storageB) PipelineStateDesc;
+		*descA = CreateGraphicsDesc();
+		*descB = CreateGraphicsDesc();
+
+		std::vector<uint8> bytesA;
+		std::vector<uint8> bytesB;
+		PipelineKey::Canonicalize(*descA, bytesA);
+		PipelineKey::Canonicalize(*descB, bytesB);
+
+		CHECK(bytesA == bytesB);
+		CHECK_EQ(PipelineKey::Compute(*descA), PipelineKey::Compute(*descB));
+	}
+
+	void TestUnusedFields()
+	{
+		const PipelineStateDesc base = CreateGraphicsDesc();
+		const uint64 key = PipelineKey::Compute(base);
+
+		// Depth state with depth disabled.
+		{
+			PipelineStateDesc a = base;
+			PipelineStateDesc b = base;
+			a.DepthStencil.bDepthEnable = false;
+			b.DepthStencil.bDepthEnable = false;
+			b.DepthStencil.DepthFunc	= 7;
+			b.DepthStencil.DepthWriteMask = 0;
+			CHECK_EQ(PipelineKey::Compute(a), PipelineKey::Compute(b));
+		}
+
+		// Stencil state with stencil disabled.
+		{
+			PipelineStateDesc desc = base;
+			desc.DepthStencil.StencilReadMask = 0x0F;
+			desc.DepthStencil.FrontFace.PassOp = 3;
+			desc.DepthStencil.BackFace.Func = 5;
+			CHECK_EQ(PipelineKey::Compute(desc), key);
+		}
+
+		// Blend factors with blending disabled, logic op with logic ops disabled.
+		{
+			PipelineStateDesc desc = base;
+			desc.Blend.RenderTargets.at(0).SrcBlend = 5;
+			desc.Blend.RenderTargets.at(0).BlendOpAlpha = 2;
+			desc.Blend.RenderTargets.at(0).LogicOp = 4;
+			CHECK_EQ(PipelineKey::Compute(desc), key);
+		}
+
+		// Targets past RenderTargetCount.
+		{
+			PipelineStateDesc desc = base;
+			desc.RenderTargetFormats.at(5) = FormatRGBA8;
+			desc.Blend.RenderTargets.at(5).bBlendEnable = true;
+			CHECK_EQ(PipelineKey::Compute(desc), key);
+		}
+
+		// Without independent blend only the first target's state is used.
+		{
+			PipelineStateDesc desc = base;
+			desc.Blend.RenderTargets.at(1).bBlendEnable = true;
+			desc.Blend.RenderTargets.at(1).WriteMask = 0x1;
+			CHECK_EQ(PipelineKey::Compute(desc), key);
+		}
+
+		// Signed zero and NaN payloads.
+		{
+			PipelineStateDesc a = base;
+			PipelineStateDesc b = base;
+			a.Raster.SlopeScaledDepthBias = 0.0f;
+			b.Raster.SlopeScaledDepthBias = -0.0f;
+			CHECK_EQ(PipelineKey::Compute(a), PipelineKey::Compute(b));
+
+			a.Raster.DepthBiasClamp = std::numeric_limits<float>::quiet_NaN();
+			b.Raster.DepthBiasClamp = -std::numeric_limits<float>::signaling_NaN();
+			CHECK_EQ(PipelineKey::Compute(a), PipelineKey::Compute(b));
+		}
+
+		// Graphics state of compute pipelines.
+		{
+			PipelineStateDesc a{};
+			a.Type = PipelineType::eCompute;
+			SetShader(a, PipelineShaderSlot::eCompute, 0xABCD);
+
+			PipelineStateDesc b = a;
+			b.Raster.CullMode = 2;
+			b.RenderTargetCount = 1;
+			b.RenderTargetFormats.at(0) = FormatRGBA8;
+			SetShader(b, PipelineShaderSlot::ePixel, 0x1111);
+			CHECK_EQ(PipelineKey::Compute(a), PipelineKey::Compute(b));
+		}
+	}
+
+	void TestShaderChange()
+	{
+		const PipelineStateDesc base = CreateGraphicsDesc();
+
+		// Single byte of bytecode differs.
+		uint8 bytecode[sizeof(PixelBytecode)];
+		std::memcpy(bytecode, PixelBytecode, sizeof(bytecode));
+		bytecode[sizeof(bytecode) - 1] ^= 0x1;
+
+		const uint64 pixelHash = PipelineKey::HashBlob(bytecode, sizeof(bytecode));
+		CHECK(pixelHash != PipelineKey::HashBlob(PixelBytecode, sizeof(PixelBytecode)));
+
+		PipelineStateDesc desc = base;
+		SetShader(desc, PipelineShaderSlot::ePixel, pixelHash);
+		CHECK(PipelineKey::Compute(desc) != PipelineKey::Compute(base));
+
+		// Same bytecode in another stage is another pipeline.
+		PipelineStateDesc swapped = base;
+		std::swap(swapped.Shaders.at(static_cast<usize>(PipelineShaderSlot::eVertex)),
+				  swapped.Shaders.at(static_cast<usize>(PipelineShaderSlot::ePixel)));
+		CHECK(PipelineKey::Compute(swapped) != PipelineKey::Compute(base));
+
+		PipelineStateDesc computeA{};
+		computeA.Type = PipelineType::eCompute;
+		PipelineStateDesc computeB = computeA;
+		SetShader(computeA, PipelineShaderSlot::eCompute, PipelineKey::HashBlob(PixelBytecode, sizeof(PixelBytecode)));
+		SetShader(computeB, PipelineShaderSlot::eCompute, pixelHash);
+		CHECK(PipelineKey::Compute(computeA) != PipelineKey::Compute(computeB));
+
+		CHECK_EQ(PipelineKey::HashBlob(nullptr, 16), 0u);
+		CHECK_EQ(PipelineKey::HashBlob(PixelBytecode, 0), 0u);
+	}
+
+	void TestRenderTargets()
+	{
+		const PipelineStateDesc base = CreateGraphicsDesc();
+		const uint64 key = PipelineKey::Compute(base);
+
+		PipelineStateDesc swapped = base;
+		swapped.RenderTargetFormats = { FormatRGBA16F, FormatRGBA8 };
+		CHECK(PipelineKey::Compute(swapped) != key);
+
+		PipelineStateDesc fewer = base;
+		fewer.RenderTargetCount = 1;
+		CHECK(PipelineKey::Compute(fewer) != key);
+
+		// Unused slot now counts.
+		PipelineStateDesc more = base;
+		more.RenderTargetCount = 3;
+		CHECK(PipelineKey::Compute(more) != key);
+		PipelineStateDesc moreFormat = more;
+		moreFormat.RenderTargetFormats.at(2) = FormatRGBA8;
+		CHECK(PipelineKey::Compute(moreFormat) != PipelineKey::Compute(more));
+
+		// With independent blend each target's blend state is its own.
+		PipelineStateDesc independentA = base;
+		independentA.Blend.bIndependentBlend = true;
+		independentA.Blend.RenderTargets.at(0).bBlendEnable = true;
+		PipelineStateDesc independentB = base;
+		independentB.Blend.bIndependentBlend = true;
+		independentB.Blend.RenderTargets.at(1).bBlendEnable = true;
+		CHECK(PipelineKey::Compute(independentA) != PipelineKey::Compute(independentB));
+	}
+} // namespace
+
+int main()
+{
+	TestPadding();
+	TestUnusedFields();
+	TestShaderChange();
+	TestRenderTargets();
+
+	return Test::Report("PipelineKey");
+}
@@ -0,0 +1,142 @@
+#include "Core/ThreadPool.hpp"
+#include "Graphics/AssetManager.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "Render/HeadlessRenderer.hpp"
+#include "RHI/Null/NullRHI.hpp"
+#include "Scene/Components/TransformComponent.hpp"
+#include "Scene/Scene.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace lde;
+using namespace DirectX;
+
+namespace
+{
+	// Same seed every run, so results compare between builds.
+	// Every mesh has its own geometry, so each Model is a draw of its own; materials cover every GBuffer permutation.
+	void CreateScene(Scene& Scene, uint32 Count)
+	{
+		std::mt19937 generator(1337);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_int_distribution<uint32> feature(0, 1);
+
+		auto& registry = MeshRegistry::GetInstance();
+
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			const float offset = static_cast<float>(i);
+
+			StaticMesh mesh{};
+			mesh.Vertices.resize(3);
+			mesh.Vertices[0].Position = XMFLOAT3(offset, 0.0f, 0.0f);
+			mesh.Vertices[1].Position = XMFLOAT3(offset + 1.0f, 0.0f, 0.0f);
+			mesh.Vertices[2].Position = XMFLOAT3(offset, 1.0f, 0.0f);
+			mesh.Indices		= { 0, 1, 2 };
+			mesh.NumVertices	= 3;
+			mesh.NumIndices		= 3;
+			mesh.AABB.Min		= XMFLOAT3(offset, 0.0f, 0.0f);
+			mesh.AABB.Max		= XMFLOAT3(offset + 1.0f, 1.0f, 0.0f);
+
+			mesh.Material.BaseColorIndex	= i % 64;
+			mesh.Material.NormalIndex		= feature(generator) ? i % 64 : (uint32)-1;
+			mesh.Material.bDoubleSided		= feature(generator) ? 1 : -1;
+			mesh.Material.AlphaMode			= feature(generator) ? MaterialAlphaMode::eMask : MaterialAlphaMode::eOpaque;
+
+			ImportedModel imported{};
+			imported.Filepath = "Benchmark/Mesh" + std::to_string(i) + ".gltf";
+			imported.StaticMeshes.push_back(std::move(mesh));
+			imported.Textures.emplace_back();
+
+			auto& model = Scene.Models.emplace_back();
+			model.Create(Scene.World(), registry.Create(imported));
+
+			auto& transform = model.GetComponent<TransformComponent>();
+			transform.Translation = XMFLOAT3(position(generator), position(generator), position(generator) + 150.0f);
+			transform.Update();
+		}
+	}
+} // namespace
+
+/**
+ * Times RenderList::Record of synthetic draws on the Null RHI, split across 1 up to every Thread Pool worker and the calling thread.
+ * Every split is checked to record the same draws, in the same order and with the same state, as a single list does.
+ * Usage: RecordingBenchmark [iterations]
+ */
+int main(int argc, char* argv[])
+{
+	const uint32 iterations = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 200;
+	const uint32 maxLists	= ThreadPool::GetInstance().GetWorkerCount() + 1;
+
+	std::printf("RenderList::Record, up to %u lists, %u iterations\n", maxLists, iterations);
+	std::printf("%8s %8s %10s %10s %10s %10s\n", "Draws", "Lists", "Mean ms", "Min ms", "Max ms", "Speedup");
+
+	for (const uint32 count : { 1024u, 4096u, 16384u })
+	{
+		NullRHI rhi;
+		Scene scene(1920, 1080);
+		HeadlessRenderer renderer(&rhi, &scene);
+
+		CreateScene(scene, count);
+
+		// Reference recording on Graphics command list alone.
+		rhi.SetCaptureDraws(true);
+		renderer.SetRecordLists(1);
+		renderer.RenderFrame();
+		const std::vector<NullDrawRecord> reference = rhi.GetDraws();
+
+		if (reference.size() != count)
+		{
+			std::fprintf(stderr, "Unexpected result for %u meshes: %zu draws\n", count, reference.size());
+			return 1;
+		}
+
+		double singleMean = 0.0;
+
+		for (uint32 lists = 1; lists <= maxLists; ++lists)
+		{
+			renderer.SetRecordLists(lists);
+
+			rhi.SetCaptureDraws(true);
+			renderer.RenderFrame();
+			if (rhi.GetDraws() != reference)
+			{
+				std::fprintf(stderr, "%u meshes on %u lists: draws differ from single list recording\n", count, renderer.GetStats().RecordLists);
+				return 1;
+			}
+			rhi.SetCaptureDraws(false);
+
+			double total = 0.0;
+			double fastest = 1.0e30;
+			double slowest = 0.0;
+			for (uint32 i = 0; i < iterations; ++i)
+			{
+				renderer.RenderFrame();
+
+				const double time = renderer.GetStats().RecordMs;
+				total	+= time;
+				fastest	 = std::min(fastest, time);
+				slowest	 = std::max(slowest, time);
+			}
+
+			const double mean = total / iterations;
+			if (lists == 1)
+			{
+				singleMean = mean;
+			}
+
+			std::printf("%8u %8u %10.3f %10.3f %10.3f %9.2fx\n",
+				count, renderer.GetStats().RecordLists, mean, fastest, slowest, mean > 0.0 ? singleMean / mean : 0.0);
+		}
+
+		scene.Clear();
+	}
+
+	MeshRegistry::GetInstance().Release();
+
+	return 0;
+}
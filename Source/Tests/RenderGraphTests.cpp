@@ -0,0 +1,223 @@
+#include "Render/RenderGraph.hpp"
+#include "Test.hpp"
+#include <algorithm>
+
+using namespace lde;
+
+namespace
+{
+	constexpr RenderGraphTextureDesc TextureDesc = { 256, 256, 4, 1, 1 };
+
+	uint32 GetPosition(const RenderGraph& Graph, uint32 Pass)
+	{
+		const auto schedule = Graph.GetSchedule();
+		return static_cast<uint32>(std::find(schedule.begin(), schedule.end(), Pass) - schedule.begin());
+	}
+
+	void TestCulling()
+	{
+		RenderGraph graph;
+		const RenderGraphResource backBuffer = graph.Import("BackBuffer", 1, RenderGraphUsage::ePresent);
+		const RenderGraphResource scene		 = graph.CreateTexture("Scene", TextureDesc);
+		const RenderGraphResource unused	 = graph.CreateTexture("Unused", TextureDesc);
+		const RenderGraphResource unusedBlur = graph.CreateTexture("UnusedBlur", TextureDesc);
+		graph.MarkOutput(backBuffer);
+
+		uint32 executed = 0;
+		const uint32 draw = graph.AddPass("Draw", [&] { executed++; });
+		graph.Write(draw, scene);
+		const uint32 composite = graph.AddPass("Composite", [&] { executed++; });
+		graph.Read(composite, scene);
+		graph.Write(composite, backBuffer);
+
+		// Chain nobody consumes.
+		const uint32 orphan = graph.AddPass("Orphan", [&] { executed++; });
+		graph.Write(orphan, unused);
+		const uint32 orphanBlur = graph.AddPass("OrphanBlur", [&] { executed++; });
+		graph.Read(orphanBlur, unused);
+		graph.Write(orphanBlur, unusedBlur);
+
+		// Writes outside of the graph.
+		const uint32 readback = graph.AddPass("Readback", [&] { executed++; });
+		graph.SetSideEffects(readback);
+
+		graph.Compile();
+
+		CHECK(!graph.GetPass(draw).bCulled);
+		CHECK(!graph.GetPass(composite).bCulled);
+		CHECK(graph.GetPass(orphan).bCulled);
+		CHECK(graph.GetPass(orphanBlur).bCulled);
+		CHECK(!graph.GetPass(readback).bCulled);
+		CHECK_EQ(graph.GetStats().CulledPasses, 2u);
+		CHECK_EQ(graph.GetSchedule().size(), 3u);
+
+		// Resources of culled passes get no lifetime and no memory.
+		CHECK_EQ(graph.GetResource(unused).FirstUse, UINT32_MAX);
+		CHECK_EQ(graph.GetResource(unused).MemorySlot, UINT32_MAX);
+		CHECK_EQ(graph.GetStats().TransientResources, 1u);
+
+		graph.Execute();
+		CHECK_EQ(executed, 3u);
+
+		// Consuming the chain keeps it alive.
+		graph.MarkOutput(unusedBlur);
+		graph.Compile();
+		CHECK(!graph.GetPass(orphan).bCulled);
+		CHECK(!graph.GetPass(orphanBlur).bCulled);
+		CHECK_EQ(graph.GetStats().CulledPasses, 0u);
+	}
+
+	void TestOrder()
+	{
+		// Consumer of what was just produced runs right after its producer.
+		{
+			RenderGraph graph;
+			const RenderGraphResource a		= graph.CreateTexture("A", TextureDesc);
+			const RenderGraphResource b		= graph.CreateTexture("B", TextureDesc);
+			const RenderGraphResource outA	= graph.Import("OutA", 1, RenderGraphUsage::eShaderRead);
+			const RenderGraphResource outB	= graph.Import("OutB", 2, RenderGraphUsage::eShaderRead);
+			graph.MarkOutput(outA);
+			graph.MarkOutput(outB);
+
+			const uint32 produceA = graph.AddPass("ProduceA");
+			graph.Write(produceA, a);
+			const uint32 produceB = graph.AddPass("ProduceB");
+			graph.Write(produceB, b);
+			const uint32 consumeA = graph.AddPass("ConsumeA");
+			graph.Read(consumeA, a);
+			graph.Write(consumeA, outA);
+			const uint32 consumeB = graph.AddPass("ConsumeB");
+			graph.Read(consumeB, b);
+			graph.Write(consumeB, outB);
+
+			graph.Compile();
+
+			const auto schedule = graph.GetSchedule();
+			CHECK_EQ(schedule.size(), 4u);
+			CHECK_EQ(schedule[0], produceA);
+			CHECK_EQ(schedule[1], consumeA);
+			CHECK_EQ(schedule[2], produceB);
+			CHECK_EQ(schedule[3], consumeB);
+		}
+
+		// Readers of a resource run before the pass overwriting it.
+		{
+			RenderGraph graph;
+			const RenderGraphResource history	= graph.CreateTexture("History", TextureDesc);
+			const RenderGraphResource outA		= graph.Import("OutA", 1, RenderGraphUsage::eShaderRead);
+			const RenderGraphResource outB		= graph.Import("OutB", 2, RenderGraphUsage::eShaderRead);
+			graph.MarkOutput(outA);
+			graph.MarkOutput(outB);
+
+			const uint32 write = graph.AddPass("Write");
+			graph.Write(write, history);
+			const uint32 read = graph.AddPass("Read");
+			graph.Read(read, history);
+			graph.Write(read, outA);
+			const uint32 overwrite = graph.AddPass("Overwrite");
+			graph.Write(overwrite, history);
+			const uint32 readAgain = graph.AddPass("ReadAgain");
+			graph.Read(readAgain, history);
+			graph.Write(readAgain, outB);
+
+			graph.Compile();
+
+			CHECK(GetPosition(graph, write) < GetPosition(graph, read));
+			CHECK(GetPosition(graph, read) < GetPosition(graph, overwrite));
+			CHECK(GetPosition(graph, overwrite) < GetPosition(graph, readAgain));
+		}
+	}
+
+	void TestAliasing()
+	{
+		RenderGraph graph;
+		const RenderGraphResource a		= graph.CreateTexture("A", TextureDesc);
+		const RenderGraphResource b		= graph.CreateTexture("B", TextureDesc);
+		const RenderGraphResource c		= graph.CreateTexture("C", TextureDesc);
+		const RenderGraphResource out	= graph.Import("Out", 1, RenderGraphUsage::ePresent);
+		graph.MarkOutput(out);
+
+		// a -> b -> c -> out; lifetimes [0, 1], [1, 2], [2, 3].
+		const uint32 p0 = graph.AddPass("P0");
+		graph.Write(p0, a);
+		const uint32 p1 = graph.AddPass("P1");
+		graph.Read(p1, a);
+		graph.Write(p1, b);
+		const uint32 p2 = graph.AddPass("P2");
+		graph.Read(p2, b);
+		graph.Write(p2, c);
+		const uint32 p3 = graph.AddPass("P3");
+		graph.Read(p3, c);
+		graph.Write(p3, out);
+
+		graph.Compile();
+
+		const uint64 size = graph.GetResource(a).Size;
+		CHECK_EQ(size, 256u * 256u * 4u);
+		CHECK_EQ(graph.GetResource(b).LastUse, 2u);
+
+		// Overlapping lifetimes never share memory; c takes over a's memory once a is done.
+		CHECK(graph.GetResource(a).MemorySlot != graph.GetResource(b).MemorySlot);
+		CHECK_EQ(graph.GetResource(c).MemorySlot, graph.GetResource(a).MemorySlot);
+		CHECK_EQ(graph.GetResource(c).MemoryOffset, graph.GetResource(a).MemoryOffset);
+		CHECK_EQ(graph.GetResource(c).AliasedFrom, a);
+		CHECK_EQ(graph.GetResource(a).AliasedFrom, RenderGraph::InvalidResource);
+
+		const RenderGraphStats& stats = graph.GetStats();
+		CHECK_EQ(stats.MemorySlots, 2u);
+		CHECK_EQ(stats.TransientBytes, 3 * size);
+		CHECK_EQ(stats.AllocatedBytes, 2 * size);
+		CHECK_EQ(stats.AliasingBarriers, 1u);
+
+		// Aliasing barrier comes with first use of c.
+		const auto& barriers = graph.GetPass(p2).Barriers;
+		const auto aliasing = std::find_if(barriers.begin(), barriers.end(), [](const RenderGraphBarrier& Barrier) { return Barrier.Type == RenderGraphBarrierType::eAliasing; });
+		CHECK(aliasing != barriers.end());
+		CHECK_EQ(aliasing->Resource, c);
+		CHECK_EQ(aliasing->AliasedFrom, a);
+
+		// b is read after being written; imported output leaves its initial state.
+		const auto hasTransition = [&](uint32 Pass, RenderGraphResource Resource, RenderGraphUsage Before, RenderGraphUsage After)
+			{
+				const auto& passBarriers = graph.GetPass(Pass).Barriers;
+				return std::any_of(passBarriers.begin(), passBarriers.end(), [&](const RenderGraphBarrier& Barrier)
+					{
+						return Barrier.Type == RenderGraphBarrierType::eTransition && Barrier.Resource == Resource
+							&& Barrier.Before == Before && Barrier.After == After;
+					});
+			};
+		CHECK(hasTransition(p2, b, RenderGraphUsage::eRenderTarget, RenderGraphUsage::eShaderRead));
+		CHECK(hasTransition(p3, out, RenderGraphUsage::ePresent, RenderGraphUsage::eRenderTarget));
+
+		// Barriers are handed out before the pass runs.
+		uint32 calls = 0;
+		graph.Execute([&](const RenderGraphPass& Pass, std::span<const RenderGraphBarrier> Barriers)
+			{
+				CHECK(!Barriers.empty());
+				CHECK(Pass.Name != "P0");
+				calls++;
+			});
+		CHECK_EQ(calls, 3u);
+	}
+
+	void TestPlacementAlignment()
+	{
+		RenderGraph graph;
+		const RenderGraphResource small = graph.CreateTexture("Small", { 100, 100, 4, 1, 1 });
+		const RenderGraphResource mips	= graph.CreateTexture("Mips", { 256, 256, 4, 9, 1 });
+
+		CHECK_EQ(graph.GetResource(small).Size, RenderGraph::PlacementAlignment);
+		CHECK_EQ(graph.GetResource(mips).Size % RenderGraph::PlacementAlignment, 0u);
+		CHECK(graph.GetResource(mips).Size > 256u * 256u * 4u);
+	}
+} // namespace
+
+int main()
+{
+	TestCulling();
+	TestOrder();
+	TestAliasing();
+	TestPlacementAlignment();
+
+	return Test::Report("RenderGraph");
+}
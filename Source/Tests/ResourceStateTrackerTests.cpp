@@ -0,0 +1,228 @@
+#include "RHI/ResourceStateTracker.hpp"
+#include "Test.hpp"
+#include <vector>
+
+using namespace lde;
+
+namespace
+{
+	// Opaque states; tracker only compares them.
+	enum State : uint32
+	{
+		eCommon,
+		eRenderTarget,
+		eShaderResource,
+		eCopyDest,
+		ePresent,
+	};
+
+	bool Equal(const StateTransition& Lhs, uint64 Resource, uint32 Subresource, uint32 Before, uint32 After)
+	{
+		return Lhs.Resource == Resource && Lhs.Subresource == Subresource && Lhs.Before == Before && Lhs.After == After;
+	}
+
+	void TestMerging()
+	{
+		ResourceStateTracker tracker;
+		tracker.Register(1, eCommon);
+		tracker.Register(2, eCommon);
+
+		// Chain of requests is a single transition from the first before to the last after state.
+		CHECK(tracker.Transition(1, eCopyDest));
+		CHECK(tracker.Transition(2, eRenderTarget));
+		CHECK(tracker.Transition(1, eShaderResource));
+		CHECK(tracker.Transition(1, eRenderTarget));
+
+		std::vector<StateTransition> transitions;
+		tracker.Flush(transitions);
+
+		CHECK_EQ(transitions.size(), 2u);
+		CHECK(Equal(transitions.at(0), 1, ResourceStateTracker::AllSubresources, eCommon, eRenderTarget));
+		CHECK(Equal(transitions.at(1), 2, ResourceStateTracker::AllSubresources, eCommon, eRenderTarget));
+
+		const ResourceStateStats stats = tracker.GetStats();
+		CHECK_EQ(stats.Requested, 4u);
+		CHECK_EQ(stats.Merged, 2u);
+		CHECK_EQ(stats.Issued, 2u);
+		CHECK_EQ(stats.Batches, 1u);
+
+		// Flush ends the chain.
+		transitions.clear();
+		CHECK(tracker.Transition(1, eShaderResource));
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 1u);
+		CHECK(Equal(transitions.at(0), 1, ResourceStateTracker::AllSubresources, eRenderTarget, eShaderResource));
+
+		// Register overrides the state; pending transition isn't extended from a state resource is no longer in.
+		transitions.clear();
+		CHECK(tracker.Transition(2, eShaderResource));
+		tracker.Register(2, eCopyDest);
+		CHECK(tracker.Transition(2, eCommon));
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 2u);
+		CHECK(Equal(transitions.at(0), 2, ResourceStateTracker::AllSubresources, eRenderTarget, eShaderResource));
+		CHECK(Equal(transitions.at(1), 2, ResourceStateTracker::AllSubresources, eCopyDest, eCommon));
+
+		CHECK(!tracker.Transition(3, eCommon));
+		CHECK_EQ(tracker.GetState(3), UINT32_MAX);
+	}
+
+	void TestElision()
+	{
+		ResourceStateTracker tracker;
+		tracker.Register(1, eShaderResource);
+
+		// Already in requested state.
+		CHECK(tracker.Transition(1, eShaderResource));
+		CHECK(!tracker.HasPending());
+		CHECK_EQ(tracker.GetStats().Skipped, 1u);
+
+		// Round trip drops out at Flush; empty flush isn't a batch.
+		CHECK(tracker.Transition(1, eRenderTarget));
+		CHECK(tracker.Transition(1, eShaderResource));
+		CHECK(tracker.HasPending());
+
+		std::vector<StateTransition> transitions;
+		tracker.Flush(transitions);
+		CHECK(transitions.empty());
+		CHECK(!tracker.HasPending());
+		CHECK_EQ(tracker.GetStats().Issued, 0u);
+		CHECK_EQ(tracker.GetStats().Batches, 0u);
+
+		// Forget drops pending transitions of released resource only.
+		tracker.Register(2, eCommon);
+		CHECK(tracker.Transition(1, eCopyDest));
+		CHECK(tracker.Transition(2, eCopyDest));
+		tracker.Forget(1);
+		CHECK(!tracker.IsTracked(1));
+
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 1u);
+		CHECK(Equal(transitions.at(0), 2, ResourceStateTracker::AllSubresources, eCommon, eCopyDest));
+	}
+
+	void TestSubresources()
+	{
+		ResourceStateTracker tracker;
+		tracker.Register(1, eShaderResource, 3);
+
+		// Requests of one subresource merge past other subresources' transitions.
+		CHECK(tracker.Transition(1, eRenderTarget, 0));
+		CHECK(tracker.Transition(1, eCopyDest, 1));
+		CHECK(tracker.Transition(1, eCopyDest, 0));
+		CHECK(tracker.Transition(1, eShaderResource, 1));
+		CHECK_EQ(tracker.GetState(1, 0), static_cast<uint32>(eCopyDest));
+		CHECK_EQ(tracker.GetState(1, 1), static_cast<uint32>(eShaderResource));
+		CHECK_EQ(tracker.GetState(1, 2), static_cast<uint32>(eShaderResource));
+
+		std::vector<StateTransition> transitions;
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 1u);
+		CHECK(Equal(transitions.at(0), 1, 0, eShaderResource, eCopyDest));
+		CHECK_EQ(tracker.GetStats().Merged, 2u);
+
+		// Diverged subresources need their own before state for whole resource transition.
+		transitions.clear();
+		CHECK(tracker.Transition(1, eRenderTarget));
+		CHECK_EQ(tracker.GetState(1, 0), static_cast<uint32>(eRenderTarget));
+		CHECK_EQ(tracker.GetState(1, 2), static_cast<uint32>(eRenderTarget));
+
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 3u);
+		CHECK(Equal(transitions.at(0), 1, 0, eCopyDest, eRenderTarget));
+		CHECK(Equal(transitions.at(1), 1, 1, eShaderResource, eRenderTarget));
+		CHECK(Equal(transitions.at(2), 1, 2, eShaderResource, eRenderTarget));
+
+		// Whole resource transition overlaps every subresource; subresource chain doesn't extend into it.
+		transitions.clear();
+		CHECK(tracker.Transition(1, eShaderResource));
+		CHECK(tracker.Transition(1, eCopyDest, 2));
+		CHECK(tracker.Transition(1, eCopyDest, 0));
+		CHECK(tracker.Transition(1, eCommon, 2));
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 3u);
+		CHECK(Equal(transitions.at(0), 1, ResourceStateTracker::AllSubresources, eRenderTarget, eShaderResource));
+		CHECK(Equal(transitions.at(1), 1, 2, eShaderResource, eCommon));
+		CHECK(Equal(transitions.at(2), 1, 0, eShaderResource, eCopyDest));
+
+		// Once subresources agree again, the resource is back to a single state.
+		transitions.clear();
+		CHECK(tracker.Transition(1, eShaderResource, 0));
+		CHECK(tracker.Transition(1, eShaderResource, 2));
+		tracker.Flush(transitions);
+		CHECK_EQ(transitions.size(), 2u);
+		CHECK(tracker.Transition(1, eShaderResource));
+		CHECK(!tracker.HasPending());
+	}
+
+	/*
+		Worker lists don't flush; D3D12Device records pending transitions on the Graphics list
+		right before worker lists are executed. So while workers record, tracker already reports
+		the states they render in, yet nothing of it has been issued.
+	*/
+	void TestWorkerLists()
+	{
+		constexpr uint64 Backbuffer	= 1;
+		constexpr uint64 GBuffer[]	= { 2, 3, 4 };
+		constexpr uint64 Depth		= 5;
+
+		ResourceStateTracker tracker;
+		tracker.Register(Backbuffer, ePresent);
+		for (auto target : GBuffer)
+		{
+			tracker.Register(target, eShaderResource);
+		}
+		tracker.Register(Depth, eShaderResource, 2);
+
+		// Graphics list, before worker lists are handed out.
+		for (auto target : GBuffer)
+		{
+			CHECK(tracker.Transition(target, eRenderTarget));
+		}
+		CHECK(tracker.Transition(Depth, eCopyDest));
+
+		// Resolved state is visible at once, transitions stay pending.
+		CHECK(tracker.HasPending());
+		CHECK_EQ(tracker.GetState(GBuffer[1]), static_cast<uint32>(eRenderTarget));
+		CHECK_EQ(tracker.GetState(Depth, 1), static_cast<uint32>(eCopyDest));
+		CHECK_EQ(tracker.GetStats().Issued, 0u);
+
+		// Pass after the split changes its mind about depth.
+		CHECK(tracker.Transition(Depth, eRenderTarget));
+
+		// Submission: one batch for every list, in request order.
+		std::vector<StateTransition> graphicsList;
+		tracker.Flush(graphicsList);
+		CHECK(!tracker.HasPending());
+		CHECK_EQ(graphicsList.size(), 4u);
+		CHECK(Equal(graphicsList.at(0), GBuffer[0], ResourceStateTracker::AllSubresources, eShaderResource, eRenderTarget));
+		CHECK(Equal(graphicsList.at(2), GBuffer[2], ResourceStateTracker::AllSubresources, eShaderResource, eRenderTarget));
+		CHECK(Equal(graphicsList.at(3), Depth, ResourceStateTracker::AllSubresources, eShaderResource, eRenderTarget));
+		CHECK_EQ(tracker.GetStats().Batches, 1u);
+
+		// Next frame reads G-Buffer and presents; backbuffer round trip within the frame drops out.
+		tracker.ResetStats();
+		for (auto target : GBuffer)
+		{
+			CHECK(tracker.Transition(target, eShaderResource));
+		}
+		CHECK(tracker.Transition(Backbuffer, eRenderTarget));
+		CHECK(tracker.Transition(Backbuffer, ePresent));
+
+		std::vector<StateTransition> nextFrame;
+		tracker.Flush(nextFrame);
+		CHECK_EQ(nextFrame.size(), 3u);
+		CHECK_EQ(tracker.GetStats().Merged, 1u);
+		CHECK_EQ(tracker.GetState(Backbuffer), static_cast<uint32>(ePresent));
+	}
+} // namespace
+
+int main()
+{
+	TestMerging();
+	TestElision();
+	TestSubresources();
+	TestWorkerLists();
+
+	return Test::Report("ResourceStateTracker");
+}
@@ -0,0 +1,165 @@
+#include "RHI/RingAllocator.hpp"
+#include "Test.hpp"
+
+using namespace lde;
+
+namespace
+{
+	// Stands in for a GPU fence; values complete only when told to.
+	struct FakeFence
+	{
+		uint64 Signaled		= 0;
+		uint64 Completed	= 0;
+
+		uint64 Signal() { return ++Signaled; }
+		void Complete(uint64 Value) { Completed = Value; }
+	};
+
+	constexpr uint64 RingSize	= 1024;
+	constexpr uint64 Alignment	= 256;
+
+	void TestAlignment()
+	{
+		RingAllocator ring(RingSize, Alignment);
+
+		CHECK_EQ(ring.Allocate(100), 0u);
+		CHECK_EQ(ring.Allocate(100), 256u);
+		// Larger alignment than the default is honored, smaller one is raised to it.
+		CHECK_EQ(ring.Allocate(16, 512), 512u);
+		CHECK_EQ(ring.Allocate(16, 16), 768u);
+
+		// Padding counts as used.
+		CHECK_EQ(ring.GetUsedSize(), 784u);
+		CHECK_EQ(ring.GetOpenSize(), 784u);
+	}
+
+	void TestWrapAround()
+	{
+		RingAllocator ring(RingSize, Alignment);
+		FakeFence fence;
+
+		CHECK_EQ(ring.Allocate(512), 0u);
+		ring.Submit(fence.Signal());
+		CHECK_EQ(ring.Allocate(256), 512u);
+		ring.Submit(fence.Signal());
+
+		fence.Complete(1);
+		CHECK_EQ(ring.Retire(fence.Completed), 1u);
+		CHECK_EQ(ring.GetUsedSize(), 256u);
+
+		// Doesn't fit in [768, 1024); restarts at 0, and skipped tail stays used.
+		CHECK_EQ(ring.Allocate(512), 0u);
+		CHECK_EQ(ring.GetUsedSize(), RingSize);
+
+		// Full: head met the tail.
+		CHECK_EQ(ring.Allocate(1), RingAllocator::InvalidOffset);
+		CHECK_EQ(ring.GetFailedAllocations(), 1u);
+
+		ring.Submit(fence.Signal());
+		fence.Complete(3);
+		CHECK_EQ(ring.Retire(fence.Completed), 2u);
+		CHECK_EQ(ring.GetUsedSize(), 0u);
+		CHECK_EQ(ring.GetPeakSize(), RingSize);
+
+		// Empty ring starts over at the beginning.
+		CHECK_EQ(ring.Allocate(1024), 0u);
+	}
+
+	void TestLargerThanTail()
+	{
+		RingAllocator ring(RingSize, Alignment);
+		FakeFence fence;
+
+		CHECK_EQ(ring.Allocate(256), 0u);
+		ring.Submit(fence.Signal());
+		CHECK_EQ(ring.Allocate(512), 256u);
+		ring.Submit(fence.Signal());
+
+		fence.Complete(1);
+		ring.Retire(fence.Completed);
+
+		// 256 bytes left at the end and 256 before the tail; neither fits 300 contiguous bytes.
+		CHECK_EQ(ring.Allocate(300), RingAllocator::InvalidOffset);
+		// Failed allocation leaves no trace.
+		CHECK_EQ(ring.GetUsedSize(), 512u);
+		CHECK_EQ(ring.GetOpenSize(), 0u);
+
+		// Exactly what is left at the end, then before the tail.
+		CHECK_EQ(ring.Allocate(256), 768u);
+		CHECK_EQ(ring.Allocate(256), 0u);
+		CHECK_EQ(ring.GetUsedSize(), RingSize);
+
+		// Never fits, no matter what retires.
+		RingAllocator empty(RingSize, Alignment);
+		CHECK_EQ(empty.Allocate(RingSize + 1), RingAllocator::InvalidOffset);
+		CHECK_EQ(empty.GetUsedSize(), 0u);
+	}
+
+	void TestPartialRetire()
+	{
+		RingAllocator ring(RingSize, Alignment);
+		FakeFence fence;
+
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			CHECK_EQ(ring.Allocate(256), i * 256u);
+			ring.Submit(fence.Signal());
+		}
+
+		// Submitting nothing opens no batch.
+		ring.Submit(fence.Signal());
+		CHECK_EQ(ring.GetPendingBatches(), 3u);
+
+		fence.Complete(2);
+		CHECK_EQ(ring.Retire(fence.Completed), 2u);
+		CHECK_EQ(ring.GetPendingBatches(), 1u);
+		CHECK_EQ(ring.GetOldestFenceValue(), 3u);
+		CHECK_EQ(ring.GetUsedSize(), 256u);
+
+		// Space of the batch still in flight is never handed out.
+		CHECK_EQ(ring.Allocate(256), 768u);
+		CHECK_EQ(ring.Allocate(512), 0u);
+		CHECK_EQ(ring.Allocate(1), RingAllocator::InvalidOffset);
+	}
+
+	void TestOutOfOrderRetire()
+	{
+		RingAllocator ring(RingSize, Alignment);
+		FakeFence fence;
+
+		ring.Allocate(256);
+		ring.Submit(fence.Signal());
+		ring.Allocate(256);
+		ring.Submit(fence.Signal());
+
+		// Newer value completes everything before it.
+		fence.Complete(2);
+		CHECK_EQ(ring.Retire(fence.Completed), 2u);
+
+		// Stale value reported late retires nothing.
+		CHECK_EQ(ring.Retire(1), 0u);
+		CHECK_EQ(ring.GetUsedSize(), 0u);
+
+		// Batches retire oldest-first only; value below the oldest one frees nothing.
+		ring.Allocate(256);
+		ring.Submit(fence.Signal());
+		ring.Allocate(256);
+		ring.Submit(fence.Signal());
+		CHECK_EQ(ring.Retire(2), 0u);
+		CHECK_EQ(ring.GetPendingBatches(), 2u);
+		CHECK_EQ(ring.GetOldestFenceValue(), 3u);
+		CHECK_EQ(ring.Retire(4), 2u);
+		CHECK_EQ(ring.GetOldestFenceValue(), 0u);
+	}
+} // namespace
+
+int main()
+{
+	TestAlignment();
+	TestWrapAround();
+	TestLargerThanTail();
+	TestPartialRetire();
+	TestOutOfOrderRetire();
+
+	return Test::Report("RingAllocator");
+}
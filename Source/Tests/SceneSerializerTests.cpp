@@ -0,0 +1,317 @@
+#include "Graphics/AssetManager.hpp"
+#include "Graphics/MeshRegistry.hpp"
+#include "RHI/Null/NullRHI.hpp"
+#include "Scene/Components/NameComponent.hpp"
+#include "Scene/Components/TransformComponent.hpp"
+#include "Scene/Scene.hpp"
+#include "Scene/SceneSerializer.hpp"
+#include "Test.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace lde;
+using namespace DirectX;
+
+namespace
+{
+	// Every file is the same triangle; Models only need an asset to reference.
+	class TriangleImporter : public MeshImporter
+	{
+	public:
+		ImportedModel Import(std::string_view Filepath) override
+		{
+			StaticMesh mesh{};
+			mesh.Vertices.resize(3);
+			mesh.Vertices[0].Position = XMFLOAT3(0.0f, 0.0f, 0.0f);
+			mesh.Vertices[1].Position = XMFLOAT3(1.0f, 0.0f, 0.0f);
+			mesh.Vertices[2].Position = XMFLOAT3(0.0f, 1.0f, 0.0f);
+			mesh.Indices		= { 0, 1, 2 };
+			mesh.NumVertices	= 3;
+			mesh.NumIndices		= 3;
+
+			ImportedModel model{};
+			model.Filepath = std::string(Filepath);
+			model.StaticMeshes.push_back(std::move(mesh));
+			model.Textures.emplace_back();
+
+			++Imports;
+			return model;
+		}
+
+		void CreateTextures(ImportedModel&, std::vector<int32>&) override { }
+		void DestroyTexture(int32) override { }
+		uint64 GetTextureSize(int32) const override { return 0; }
+
+		uint32 Imports = 0;
+	};
+
+	/// @brief Writes values back to back, like archives of SceneSerializer do for trivial types.
+	struct ByteArchive
+	{
+		template<typename T>
+		void operator()(const T& Value)
+		{
+			const auto* bytes = reinterpret_cast<const uint8*>(&Value);
+			Bytes.insert(Bytes.end(), bytes, bytes + sizeof(T));
+		}
+
+		std::vector<uint8> Bytes;
+	};
+
+	bool Equal(const XMFLOAT3& Lhs, const XMFLOAT3& Rhs)
+	{
+		return Lhs.x == Rhs.x && Lhs.y == Rhs.y && Lhs.z == Rhs.z;
+	}
+
+	bool Equal(const XMFLOAT4& Lhs, const XMFLOAT4& Rhs)
+	{
+		return Lhs.x == Rhs.x && Lhs.y == Rhs.y && Lhs.z == Rhs.z && Lhs.w == Rhs.w;
+	}
+
+	bool Equal(const TransformComponent& Lhs, const TransformComponent& Rhs)
+	{
+		return Equal(Lhs.Translation, Rhs.Translation) && Equal(Lhs.Rotation, Rhs.Rotation) && Equal(Lhs.Scale, Rhs.Scale);
+	}
+
+	bool Equal(const PointLightComponent& Lhs, const PointLightComponent& Rhs)
+	{
+		return Equal(Lhs.Position, Rhs.Position) && Lhs.Visibility == Rhs.Visibility && Equal(Lhs.Ambient, Rhs.Ambient) && Lhs.Range == Rhs.Range;
+	}
+
+	bool Equal(const DirectionalLightComponent& Lhs, const DirectionalLightComponent& Rhs)
+	{
+		return Equal(Lhs.Direction, Rhs.Direction) && Lhs.Visibility == Rhs.Visibility && Equal(Lhs.Ambient, Rhs.Ambient);
+	}
+
+	// Entities of a storage in packed order, the order SceneLighting mirrors them in.
+	template<typename T>
+	std::vector<entt::entity> GetPacked(entt::registry& Registry)
+	{
+		const auto& storage = Registry.storage<T>();
+		return std::vector<entt::entity>(storage.data(), storage.data() + storage.size());
+	}
+
+	void TestEntityLayout()
+	{
+		entt::registry source;
+		std::vector<entt::entity> entities;
+		for (uint32 i = 0; i < 5; ++i)
+		{
+			entities.push_back(source.create());
+		}
+
+		// Hand-written entity section has to match what EnTT snapshot writes for the same live entities,
+		// since continuous_loader reads it back: [Count][In use][Entities].
+		ByteArchive expected;
+		entt::snapshot{ source }.get<entt::entity>(expected);
+
+		std::vector<uint8> archive;
+		SceneSerializer::WriteRegistry(source, entities, archive);
+
+		CHECK(archive.size() >= expected.Bytes.size());
+		CHECK(std::memcmp(archive.data(), expected.Bytes.data(), expected.Bytes.size()) == 0);
+
+		// Target already holds entities, so stored IDs can't be reused as they are.
+		entt::registry target;
+		const auto existing = target.create();
+
+		entt::continuous_loader loader{ target };
+		CHECK(SceneSerializer::ReadRegistry(loader, archive.data(), archive.size()));
+		CHECK_EQ(target.storage<entt::entity>().free_list(), entities.size() + 1);
+
+		for (auto entity : entities)
+		{
+			CHECK(loader.contains(entity));
+			CHECK(target.valid(loader.map(entity)));
+			CHECK(loader.map(entity) != existing);
+		}
+
+		// Truncated archive is reported.
+		entt::registry truncated;
+		entt::continuous_loader truncatedLoader{ truncated };
+		CHECK(!SceneSerializer::ReadRegistry(truncatedLoader, archive.data(), archive.size() - 1));
+	}
+
+	void TestRoundTrip()
+	{
+		const Filepath path = std::filesystem::temp_directory_path() / "SceneSerializerTests.ldescene";
+
+		NullRHI rhi;
+		TriangleImporter importer;
+		MeshRegistry::GetInstance().Initialize(rhi.Device.get(), &importer);
+
+		Scene scene(1280, 720);
+
+		const char* files[] = { "Serializer/A.gltf", "Serializer/B.gltf", "Serializer/A.gltf" };
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			auto& model = scene.Models.emplace_back();
+			model.Create(scene.World(), MeshRegistry::GetInstance().Load(files[i]));
+
+			auto& transform = model.GetComponent<TransformComponent>();
+			transform.Translation	= XMFLOAT3(static_cast<float>(i), 2.0f, -3.5f);
+			transform.Rotation		= XMFLOAT3(0.25f, 0.5f * i, 0.0f);
+			transform.Scale			= XMFLOAT3(1.0f, 2.0f, 0.5f + i);
+			transform.Update();
+		}
+
+		auto* registry = scene.Registry();
+		const auto pointLight = scene.Lighting.AddPointLight("Lamp", XMFLOAT3(1.0f, 4.0f, -2.0f));
+		registry->patch<PointLightComponent>(pointLight, [](auto& Light) { Light.Range = 12.5f; Light.Visibility = 0.25f; });
+		const auto sun = scene.Lighting.AddDirectionalLight("Sun", XMFLOAT3(0.3f, -0.9f, 0.1f));
+		registry->get<DirectionalLightComponent>(sun).Ambient = XMFLOAT4(0.5f, 0.4f, 0.3f, 1.0f);
+
+		// Copies in packed order; lights keep their order after load.
+		std::vector<TransformComponent> transforms;
+		for (auto& model : scene.Models)
+		{
+			transforms.push_back(model.GetComponent<TransformComponent>());
+		}
+
+		std::vector<std::pair<std::string, PointLightComponent>> pointLights;
+		for (auto entity : GetPacked<PointLightComponent>(*registry))
+		{
+			pointLights.emplace_back(registry->get<NameComponent>(entity).Name, registry->get<PointLightComponent>(entity));
+		}
+
+		std::vector<std::pair<std::string, DirectionalLightComponent>> directionalLights;
+		for (auto entity : GetPacked<DirectionalLightComponent>(*registry))
+		{
+			directionalLights.emplace_back(registry->get<NameComponent>(entity).Name, registry->get<DirectionalLightComponent>(entity));
+		}
+
+		CHECK(SceneSerializer::Save(&scene, path));
+
+		// Edits after saving are discarded by load.
+		scene.AddPointLight(XMFLOAT3(9.0f, 9.0f, 9.0f));
+		scene.Models.front().GetComponent<TransformComponent>().Translation = XMFLOAT3(100.0f, 0.0f, 0.0f);
+
+		const uint32 importsBefore = importer.Imports;
+		CHECK(SceneSerializer::Load(&scene, path));
+
+		// Models sharing a file share the asset; Load imports each file once.
+		CHECK_EQ(importer.Imports - importsBefore, 2u);
+		CHECK_EQ(scene.Models.size(), transforms.size());
+		for (usize i = 0; i < scene.Models.size() && i < transforms.size(); ++i)
+		{
+			CHECK(Equal(scene.Models[i].GetComponent<TransformComponent>(), transforms[i]));
+			CHECK_EQ(scene.Models[i].GetFilepath(), files[i]);
+		}
+		CHECK(scene.Models.size() < 3 || scene.Models[0].Asset == scene.Models[2].Asset);
+
+		// World matrix is rebuilt from TRS.
+		TransformComponent expected = transforms.front();
+		expected.Update();
+		const auto& restored = scene.Models.front().GetComponent<TransformComponent>();
+		CHECK(std::memcmp(&restored.WorldMatrix, &expected.WorldMatrix, sizeof(XMMATRIX)) == 0);
+
+		const auto restoredPointLights = GetPacked<PointLightComponent>(*registry);
+		CHECK_EQ(restoredPointLights.size(), pointLights.size());
+		for (usize i = 0; i < restoredPointLights.size() && i < pointLights.size(); ++i)
+		{
+			CHECK_EQ(registry->get<NameComponent>(restoredPointLights[i]).Name, pointLights[i].first);
+			CHECK(Equal(registry->get<PointLightComponent>(restoredPointLights[i]), pointLights[i].second));
+		}
+
+		const auto restoredDirectionalLights = GetPacked<DirectionalLightComponent>(*registry);
+		CHECK_EQ(restoredDirectionalLights.size(), directionalLights.size());
+		for (usize i = 0; i < restoredDirectionalLights.size() && i < directionalLights.size(); ++i)
+		{
+			CHECK_EQ(registry->get<NameComponent>(restoredDirectionalLights[i]).Name, directionalLights[i].first);
+			CHECK(Equal(registry->get<DirectionalLightComponent>(restoredDirectionalLights[i]), directionalLights[i].second));
+		}
+
+		// Camera survives load.
+		CHECK(scene.GetCamera() != nullptr);
+
+		scene.Clear();
+		MeshRegistry::GetInstance().Release();
+		MeshRegistry::GetInstance().Initialize(nullptr);
+		std::filesystem::remove(path);
+	}
+
+	// Registry archive alone; file IO and asset import aren't part of it.
+	void TestLargeRegistry()
+	{
+		constexpr uint32 Count = 100'000;
+
+		entt::registry source;
+		std::vector<entt::entity> entities;
+		entities.reserve(Count);
+
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			const auto entity = source.create();
+			const float value = static_cast<float>(i);
+
+			auto& transform = source.emplace<TransformComponent>(entity, XMFLOAT3(value, -value, 0.5f * value));
+			transform.Update();
+			source.emplace<NameComponent>(entity, "Entity " + std::to_string(i));
+
+			if (i % 4 == 0)
+			{
+				source.emplace<PointLightComponent>(entity, XMFLOAT3(value, 1.0f, 0.0f));
+			}
+			else if (i % 1000 == 1)
+			{
+				source.emplace<DirectionalLightComponent>(entity, XMFLOAT3(0.0f, -1.0f, value));
+			}
+
+			entities.push_back(entity);
+		}
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		std::vector<uint8> archive;
+		SceneSerializer::WriteRegistry(source, entities, archive);
+
+		auto midTime = std::chrono::high_resolution_clock::now();
+
+		entt::registry target;
+		entt::continuous_loader loader{ target };
+		CHECK(SceneSerializer::ReadRegistry(loader, archive.data(), archive.size()));
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+
+		std::printf("%u entities, %zu bytes: write %.2f ms, read %.2f ms\n", Count, archive.size(),
+			std::chrono::duration<double, std::milli>(midTime - startTime).count(),
+			std::chrono::duration<double, std::milli>(endTime - midTime).count());
+
+		CHECK_EQ(target.storage<entt::entity>().free_list(), static_cast<usize>(Count));
+		CHECK_EQ(target.storage<PointLightComponent>().size(), source.storage<PointLightComponent>().size());
+		CHECK_EQ(target.storage<DirectionalLightComponent>().size(), source.storage<DirectionalLightComponent>().size());
+
+		uint32 mismatches = 0;
+		for (auto entity : entities)
+		{
+			const auto local = loader.map(entity);
+			if (!target.valid(local) ||
+				!Equal(target.get<TransformComponent>(local), source.get<TransformComponent>(entity)) ||
+				target.get<NameComponent>(local).Name != source.get<NameComponent>(entity).Name ||
+				target.all_of<PointLightComponent>(local) != source.all_of<PointLightComponent>(entity) ||
+				target.all_of<DirectionalLightComponent>(local) != source.all_of<DirectionalLightComponent>(entity))
+			{
+				++mismatches;
+				continue;
+			}
+
+			if (source.all_of<PointLightComponent>(entity) &&
+				!Equal(target.get<PointLightComponent>(local), source.get<PointLightComponent>(entity)))
+			{
+				++mismatches;
+			}
+		}
+		CHECK_EQ(mismatches, 0u);
+	}
+} // namespace
+
+int main()
+{
+	TestEntityLayout();
+	TestRoundTrip();
+	TestLargeRegistry();
+
+	return Test::Report("SceneSerializer");
+}
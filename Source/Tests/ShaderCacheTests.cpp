@@ -0,0 +1,178 @@
+#include "Graphics/ShaderCache.hpp"
+#include "Test.hpp"
+#include <fstream>
+#include <string_view>
+
+using namespace lde;
+
+namespace
+{
+	// Scratch directory; removed when tests finish.
+	const Filepath Root = std::filesystem::temp_directory_path() / "LdeShaderCacheTests";
+
+	void WriteText(const Filepath& Path, std::string_view Text)
+	{
+		std::filesystem::create_directories(Path.parent_path());
+		std::ofstream file(Path, std::ios::binary | std::ios::trunc);
+		file << Text;
+	}
+
+	void TestParseIncludes()
+	{
+		const auto includes = ShaderIncludeScanner::ParseIncludes(
+			"#include \"Common.hlsli\"\r\n"
+			"  #  include <Lighting/BRDF.hlsli>\n"
+			"// #include \"LineComment.hlsli\"\n"
+			"/* #include \"BlockComment.hlsli\"\n"
+			"#include \"StillComment.hlsli\" */\n"
+			"#include \"Path//WithSlashes.hlsli\"\n"
+			"#define INCLUDE \"NotAnInclude.hlsli\"\n"
+			"#include \"\"\n"
+			"#include \"NoNewline.hlsli\"");
+
+		CHECK_EQ(includes.size(), 4u);
+		if (includes.size() == 4)
+		{
+			CHECK(includes[0] == "Common.hlsli");
+			CHECK(includes[1] == "Lighting/BRDF.hlsli");
+			CHECK(includes[2] == "Path//WithSlashes.hlsli");
+			CHECK(includes[3] == "NoNewline.hlsli");
+		}
+	}
+
+	void TestIncludeCycles()
+	{
+		const Filepath dir = Root / "Cycles";
+		WriteText(dir / "A.hlsl",	"#include \"B.hlsli\"\n");
+		WriteText(dir / "B.hlsli",	"#include \"A.hlsl\"\n#include \"C.hlsli\"\n");
+		WriteText(dir / "C.hlsli",	"#include \"B.hlsli\"\n#include \"C.hlsli\"\n#include \"Missing.hlsli\"\n");
+
+		ShaderIncludeScanner scanner;
+
+		// Every file once; the shader itself and unresolved includes aren't dependencies.
+		const auto dependencies = scanner.GetDependencies(dir / "A.hlsl");
+		CHECK_EQ(dependencies.size(), 2u);
+		if (dependencies.size() == 2)
+		{
+			CHECK(dependencies[0] == (dir / "B.hlsli").lexically_normal());
+			CHECK(dependencies[1] == (dir / "C.hlsli").lexically_normal());
+		}
+
+		// Starting inside the cycle sees the rest of it.
+		CHECK_EQ(scanner.GetDependencies(dir / "C.hlsli").size(), 2u);
+	}
+
+	void TestIncludeDirs()
+	{
+		const Filepath shaders	= Root / "Dirs" / "Shaders";
+		const Filepath common	= Root / "Dirs" / "Include";
+		WriteText(shaders / "Pass.hlsl",		"#include <Common.hlsli>\n#include \"Local.hlsli\"\n");
+		WriteText(shaders / "Local.hlsli",		"\n");
+		WriteText(common / "Common.hlsli",		"\n");
+		// Same name next to the includer wins over include directories.
+		WriteText(common / "Local.hlsli",		"\n");
+
+		ShaderIncludeScanner scanner({ common });
+		const auto dependencies = scanner.GetDependencies(shaders / "Pass.hlsl");
+		CHECK_EQ(dependencies.size(), 2u);
+		if (dependencies.size() == 2)
+		{
+			CHECK(dependencies[0] == (common / "Common.hlsli").lexically_normal());
+			CHECK(dependencies[1] == (shaders / "Local.hlsli").lexically_normal());
+		}
+	}
+
+	void TestKeyChange()
+	{
+		const Filepath dir = Root / "Keys";
+		WriteText(dir / "Shader.hlsl",		"#include \"Material.hlsli\"\nfloat4 main() : SV_Target { return 0; }\n");
+		WriteText(dir / "Material.hlsli",	"#include \"Constants.hlsli\"\n");
+		WriteText(dir / "Constants.hlsli",	"#define VALUE 1\n");
+		WriteText(dir / "Unrelated.hlsli",	"#define VALUE 1\n");
+
+		ShaderCache cache(Root / "Cache");
+
+		ShaderCacheKeyDesc desc{};
+		desc.Path				= dir / "Shader.hlsl";
+		desc.EntryPoint			= "main";
+		desc.Profile			= "ps_6_6";
+		desc.Defines			= { "ALPHA_TEST" };
+		desc.CompilerVersion	= "1.8";
+
+		const uint64 key = cache.ComputeKey(desc);
+		CHECK(key != 0);
+		CHECK_EQ(cache.ComputeKey(desc), key);
+
+		// Files outside of the include tree don't matter.
+		WriteText(dir / "Unrelated.hlsli", "#define VALUE 2\n");
+		cache.GetScanner().Invalidate();
+		CHECK_EQ(cache.ComputeKey(desc), key);
+
+		// Change of an indirect include; seen only once the scanner forgets parsed files.
+		WriteText(dir / "Constants.hlsli", "#define VALUE 2\n");
+		CHECK_EQ(cache.ComputeKey(desc), key);
+		cache.GetScanner().Invalidate();
+		const uint64 changedKey = cache.ComputeKey(desc);
+		CHECK(changedKey != key);
+
+		// Reverting contents gives the old key back.
+		WriteText(dir / "Constants.hlsli", "#define VALUE 1\n");
+		cache.GetScanner().Invalidate();
+		CHECK_EQ(cache.ComputeKey(desc), key);
+
+		// Adding an include is a change too.
+		WriteText(dir / "Material.hlsli", "#include \"Constants.hlsli\"\n#include \"Unrelated.hlsli\"\n");
+		cache.GetScanner().Invalidate();
+		CHECK(cache.ComputeKey(desc) != key);
+
+		// Compile settings.
+		ShaderCacheKeyDesc settings = desc;
+		settings.Defines = { "ALPHA_TEST", "NO_NORMAL_MAP" };
+		CHECK(cache.ComputeKey(settings) != cache.ComputeKey(desc));
+		settings = desc;
+		settings.Profile = "ps_6_7";
+		CHECK(cache.ComputeKey(settings) != cache.ComputeKey(desc));
+
+		ShaderCacheKeyDesc missing = desc;
+		missing.Path = dir / "Missing.hlsl";
+		CHECK_EQ(cache.ComputeKey(missing), 0u);
+	}
+
+	void TestStore()
+	{
+		ShaderCache cache(Root / "Store");
+		const std::vector<uint8> bytecode = { 0x44, 0x58, 0x42, 0x43, 0x01 };
+
+		std::vector<uint8> loaded;
+		CHECK(!cache.Load(0x1234, loaded));
+
+		cache.Store(0x1234, bytecode);
+		CHECK(cache.Load(0x1234, loaded));
+		CHECK(loaded == bytecode);
+
+		// Key 0 and empty bytecode are never stored.
+		cache.Store(0, bytecode);
+		cache.Store(0x5678, {});
+		CHECK(!cache.Load(0x5678, loaded));
+
+		const ShaderCacheStats stats = cache.GetStats();
+		CHECK_EQ(stats.Hits, 1u);
+		CHECK_EQ(stats.Misses, 2u);
+		CHECK_EQ(stats.Stores, 1u);
+	}
+} // namespace
+
+int main()
+{
+	std::filesystem::remove_all(Root);
+
+	TestParseIncludes();
+	TestIncludeCycles();
+	TestIncludeDirs();
+	TestKeyChange();
+	TestStore();
+
+	std::filesystem::remove_all(Root);
+
+	return Test::Report("ShaderCache");
+}
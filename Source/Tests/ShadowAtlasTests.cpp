@@ -0,0 +1,296 @@
+#include "Graphics/ShadowAtlas.hpp"
+#include "Test.hpp"
+#include <vector>
+
+using namespace lde;
+
+namespace
+{
+	ShadowAtlasRequest CreateRequest(uint64 Key, float Coverage = 1.0f, float Importance = 1.0f, uint64 Version = 0)
+	{
+		return ShadowAtlasRequest{ Key, Coverage, Importance, Version };
+	}
+
+	void TestAllocatorTiles()
+	{
+		ShadowAtlasAllocator allocator(1024, 64);
+		CHECK_EQ(allocator.GetLevelCount(), 5u);
+		CHECK_EQ(allocator.GetTileSize(2), 256u);
+
+		// Sizes round down to the tile that fits; out of range ones are clamped.
+		CHECK_EQ(allocator.GetLevel(1024), 0u);
+		CHECK_EQ(allocator.GetLevel(600), 1u);
+		CHECK_EQ(allocator.GetLevel(64), 4u);
+		CHECK_EQ(allocator.GetLevel(1), 4u);
+		CHECK_EQ(allocator.GetLevel(5000), 0u);
+
+		// Quadrants in Morton order.
+		const AtlasTile tiles[4] = { allocator.Allocate(1), allocator.Allocate(1), allocator.Allocate(1), allocator.Allocate(1) };
+		CHECK(tiles[0].X == 0 && tiles[0].Y == 0);
+		CHECK(tiles[1].X == 512 && tiles[1].Y == 0);
+		CHECK(tiles[2].X == 0 && tiles[2].Y == 512);
+		CHECK(tiles[3].X == 512 && tiles[3].Y == 512);
+		CHECK_EQ(tiles[3].Size, 512u);
+		CHECK_EQ(allocator.GetUsedArea(), 1024u * 1024u);
+		CHECK_EQ(allocator.GetLastAllocated(1), 3u);
+
+		CHECK(!allocator.Allocate(1).IsValid());
+		CHECK(!allocator.Allocate(4).IsValid());
+		CHECK(!allocator.Allocate(5).IsValid());
+
+		// Freeing all four merges them back into the whole atlas.
+		for (const AtlasTile& tile : tiles)
+		{
+			allocator.Free(tile);
+		}
+		CHECK_EQ(allocator.GetUsedArea(), 0u);
+		CHECK_EQ(allocator.GetLastAllocated(1), AtlasTile::InvalidNode);
+		CHECK_EQ(allocator.Allocate(0).Size, 1024u);
+	}
+
+	void TestAllocatorSplit()
+	{
+		ShadowAtlasAllocator allocator(1024, 64);
+
+		// Small tile splits the first quadrant; its siblings stay free.
+		const AtlasTile small = allocator.Allocate(2);
+		CHECK(small.X == 0 && small.Y == 0 && small.Size == 256);
+		CHECK_EQ(allocator.Allocate(1).X, 512u);
+		CHECK_EQ(allocator.Allocate(2).X, 256u);
+		CHECK_EQ(allocator.GetUsedArea(), 2u * 256u * 256u + 512u * 512u);
+
+		// Double free and invalid tile are ignored.
+		allocator.Free(small);
+		allocator.Free(small);
+		allocator.Free(AtlasTile());
+		CHECK_EQ(allocator.GetUsedArea(), 256u * 256u + 512u * 512u);
+
+		// Freed slot is reused first.
+		CHECK_EQ(allocator.Allocate(2).Node, small.Node);
+
+		allocator.Reset();
+		CHECK_EQ(allocator.GetUsedArea(), 0u);
+		CHECK(allocator.Allocate(0).IsValid());
+	}
+
+	void TestAllocatorFragmentation()
+	{
+		ShadowAtlasAllocator allocator(1024, 64);
+
+		std::vector<AtlasTile> tiles;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			tiles.push_back(allocator.Allocate(2));
+		}
+		CHECK(!allocator.Allocate(2).IsValid());
+
+		// Every other tile freed: half of the atlas is free, yet no quadrant is whole.
+		for (uint32 i = 0; i < 16; i += 2)
+		{
+			allocator.Free(tiles[i]);
+		}
+		CHECK_EQ(allocator.GetUsedArea(), 512u * 1024u);
+		CHECK(!allocator.Allocate(1).IsValid());
+		const AtlasTile small = allocator.Allocate(3);
+		CHECK(small.IsValid());
+
+		// Quadrant with all of its level 2 tiles free still can't merge while the small tile sits in it.
+		allocator.Free(tiles[1]);
+		allocator.Free(tiles[3]);
+		CHECK(!allocator.Allocate(1).IsValid());
+
+		allocator.Free(small);
+		CHECK_EQ(allocator.Allocate(1).Node, 0u);
+	}
+
+	void TestAtlasCaching()
+	{
+		ShadowAtlas atlas(4096, 1024, 64);
+
+		const std::vector<ShadowAtlasRequest> requests = {
+			CreateRequest(1, 1.0f),
+			CreateRequest(2, 0.25f),
+			CreateRequest(3, 1.0f, 0.0f),
+		};
+		atlas.Update(requests);
+
+		// Tile size follows sqrt of coverage times importance; results come in request order.
+		auto allocations = atlas.GetAllocations();
+		CHECK_EQ(allocations.size(), 3u);
+		CHECK_EQ(allocations[0].Tile.Size, 1024u);
+		CHECK_EQ(allocations[1].Tile.Size, 512u);
+		CHECK_EQ(allocations[2].Tile.Size, 64u);
+		CHECK(allocations[0].bRender && allocations[1].bRender && allocations[2].bRender);
+		CHECK_EQ(atlas.GetStats().Rendered, 3u);
+
+		// Nothing changed; tiles stay and content is reused.
+		const AtlasTile first = allocations[0].Tile;
+		atlas.Update(requests);
+		allocations = atlas.GetAllocations();
+		CHECK_EQ(allocations[0].Tile.Node, first.Node);
+		CHECK(!allocations[0].bRender);
+		CHECK_EQ(atlas.GetStats().Cached, 3u);
+
+		// New version redraws only that view.
+		std::vector<ShadowAtlasRequest> changed = requests;
+		changed[1].Version = 7;
+		atlas.Update(changed);
+		CHECK(atlas.GetAllocations()[1].bRender);
+		CHECK_EQ(atlas.GetStats().Rendered, 1u);
+		CHECK_EQ(atlas.GetStats().Cached, 2u);
+
+		// Small coverage change stays within hysteresis; larger one resizes.
+		changed[0].Coverage = 0.8f;
+		atlas.Update(changed);
+		CHECK_EQ(atlas.GetAllocations()[0].Tile.Size, 1024u);
+		CHECK(!atlas.GetAllocations()[0].bRender);
+
+		changed[0].Coverage = 0.5f;
+		atlas.Update(changed);
+		CHECK_EQ(atlas.GetAllocations()[0].Tile.Size, 512u);
+		CHECK(atlas.GetAllocations()[0].bRender);
+
+		atlas.Reset();
+		atlas.Update(changed);
+		CHECK_EQ(atlas.GetStats().Rendered, 3u);
+	}
+
+	void TestAtlasEviction()
+	{
+		ShadowAtlas atlas(4096, 1024, 64);
+
+		atlas.Update(std::vector<ShadowAtlasRequest>{ CreateRequest(1), CreateRequest(2) });
+		const float occupancy = atlas.GetStats().Occupancy;
+		CHECK_EQ(occupancy, 2.0f / 16.0f);
+
+		// View not requested anymore gives its tile back; remaining one keeps its own.
+		const AtlasTile kept = atlas.GetAllocations()[1].Tile;
+		atlas.Update(std::vector<ShadowAtlasRequest>{ CreateRequest(2) });
+		CHECK_EQ(atlas.GetStats().Allocated, 1u);
+		CHECK_EQ(atlas.GetStats().Occupancy, 1.0f / 16.0f);
+		CHECK_EQ(atlas.GetAllocations()[0].Tile.Node, kept.Node);
+		CHECK(!atlas.GetAllocations()[0].bRender);
+
+		// Returning view is a new one and is drawn again.
+		atlas.Update(std::vector<ShadowAtlasRequest>{ CreateRequest(2), CreateRequest(1) });
+		CHECK(atlas.GetAllocations()[1].bRender);
+		CHECK(!atlas.GetAllocations()[0].bRender);
+
+		atlas.Update(std::vector<ShadowAtlasRequest>{});
+		CHECK_EQ(atlas.GetAllocator().GetUsedArea(), 0u);
+	}
+
+	void TestAtlasOversubscription()
+	{
+		// Every tile is scaled down by the same number of levels until all fit.
+		{
+			ShadowAtlas atlas(4096, 1024, 64);
+			std::vector<ShadowAtlasRequest> requests;
+			for (uint64 key = 0; key < 20; ++key)
+			{
+				requests.push_back(CreateRequest(key));
+			}
+
+			atlas.Update(requests);
+			const ShadowAtlasStats& stats = atlas.GetStats();
+			CHECK_EQ(stats.LevelBias, 1u);
+			CHECK_EQ(stats.Allocated, 20u);
+			CHECK_EQ(stats.Rejected, 0u);
+			for (const auto& allocation : atlas.GetAllocations())
+			{
+				CHECK_EQ(allocation.Tile.Size, 512u);
+			}
+		}
+
+		// Already at the smallest tile; least important views go without.
+		{
+			ShadowAtlas atlas(1024, 512, 256);
+			std::vector<ShadowAtlasRequest> requests;
+			for (uint64 key = 0; key < 20; ++key)
+			{
+				requests.push_back(CreateRequest(key, 1.0f, static_cast<float>(key + 1) / 40.0f));
+			}
+
+			atlas.Update(requests);
+			CHECK_EQ(atlas.GetStats().Allocated, 16u);
+			CHECK_EQ(atlas.GetStats().Rejected, 4u);
+			CHECK_EQ(atlas.GetStats().Occupancy, 1.0f);
+			for (uint32 i = 0; i < 20; ++i)
+			{
+				CHECK_EQ(atlas.GetAllocations()[i].Tile.IsValid(), i >= 4);
+			}
+		}
+	}
+
+	void TestAtlasDefragment()
+	{
+		// 1024 atlas of 256 tiles; 512 tile for a full screen view.
+		ShadowAtlas atlas(1024, 512, 256);
+
+		std::vector<ShadowAtlasRequest> requests;
+		for (uint64 key = 0; key < 16; ++key)
+		{
+			requests.push_back(CreateRequest(key, 1.0f, 0.5f));
+		}
+		atlas.Update(requests);
+		CHECK_EQ(atlas.GetStats().Allocated, 16u);
+
+		// Every other tile released: enough area for a 512 tile, but no free quadrant.
+		std::vector<ShadowAtlasRequest> sparse;
+		for (uint64 key = 0; key < 16; key += 2)
+		{
+			sparse.push_back(CreateRequest(key, 1.0f, 0.5f));
+		}
+		sparse.push_back(CreateRequest(100));
+
+		atlas.DefragBudget = 2;
+		atlas.Update(sparse);
+
+		// Large view makes do with a small tile while two tiles move out of the last quadrant.
+		ShadowAtlasStats stats = atlas.GetStats();
+		CHECK_EQ(atlas.GetAllocations().back().Tile.Size, 256u);
+		CHECK_EQ(stats.Downsized, 1u);
+		CHECK_EQ(stats.Moved, 2u);
+		// Moved tiles are drawn again, just like the new one.
+		CHECK_EQ(stats.Rendered, 3u);
+		CHECK_EQ(stats.Cached, 6u);
+
+		// Freed quadrant fits another large view; downsized one stays put within hysteresis.
+		sparse.push_back(CreateRequest(101));
+		atlas.Update(sparse);
+		stats = atlas.GetStats();
+		const AtlasTile large = atlas.GetAllocations().back().Tile;
+		CHECK_EQ(large.Size, 512u);
+		CHECK(large.X == 512 && large.Y == 512);
+		CHECK_EQ(atlas.GetAllocations()[8].Tile.Size, 256u);
+		CHECK_EQ(stats.Downsized, 0u);
+		CHECK_EQ(stats.Moved, 0u);
+		CHECK_EQ(stats.Rendered, 1u);
+
+		// Tiles never overlap.
+		const auto allocations = atlas.GetAllocations();
+		for (usize i = 0; i < allocations.size(); ++i)
+		{
+			for (usize j = i + 1; j < allocations.size(); ++j)
+			{
+				const AtlasTile& a = allocations[i].Tile;
+				const AtlasTile& b = allocations[j].Tile;
+				const bool bOverlap = a.X < b.X + b.Size && b.X < a.X + a.Size && a.Y < b.Y + b.Size && b.Y < a.Y + a.Size;
+				CHECK(!bOverlap);
+			}
+		}
+	}
+} // namespace
+
+int main()
+{
+	TestAllocatorTiles();
+	TestAllocatorSplit();
+	TestAllocatorFragmentation();
+	TestAtlasCaching();
+	TestAtlasEviction();
+	TestAtlasOversubscription();
+	TestAtlasDefragment();
+
+	return Test::Report("ShadowAtlas");
+}
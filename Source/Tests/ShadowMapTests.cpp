@@ -0,0 +1,243 @@
+#include "Graphics/ShadowMap.hpp"
+#include "Test.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace lde;
+using namespace DirectX;
+
+namespace
+{
+	constexpr float zNear	= 0.1f;
+	constexpr float zFar	= 1000.0f;
+	constexpr uint32 Resolution = 1024;
+
+	bool IsNear(float Lhs, float Rhs, float Tolerance = 1.0e-4f)
+	{
+		return std::abs(Lhs - Rhs) <= Tolerance * std::max({ 1.0f, std::abs(Lhs), std::abs(Rhs) });
+	}
+
+	bool IsWhole(float Value)
+	{
+		return std::abs(Value - std::round(Value)) < 1.0e-2f;
+	}
+
+	XMMATRIX CreateProjection()
+	{
+		return XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, zNear, zFar);
+	}
+
+	XMMATRIX CreateView(XMFLOAT3 Eye, XMFLOAT3 Target)
+	{
+		return XMMatrixLookAtLH(XMLoadFloat3(&Eye), XMLoadFloat3(&Target), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	}
+
+	// Cascade center in light space, in texels.
+	XMFLOAT3 GetTexelCenter(const ShadowCascade& Cascade)
+	{
+		XMFLOAT3 center{};
+		XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&Cascade.Center), XMLoadFloat4x4(&Cascade.View)));
+		return XMFLOAT3(center.x / Cascade.TexelSize, center.y / Cascade.TexelSize, center.z);
+	}
+
+	void TestSplits()
+	{
+		std::array<float, 5> splits{};
+
+		ShadowMap::ComputeSplits(1.0f, 100.0f, 0.0f, splits);
+		CHECK(IsNear(splits[0], 1.0f));
+		CHECK(IsNear(splits[1], 25.75f));
+		CHECK(IsNear(splits[2], 50.5f));
+		CHECK(IsNear(splits[3], 75.25f));
+		CHECK(IsNear(splits[4], 100.0f));
+
+		ShadowMap::ComputeSplits(1.0f, 100.0f, 1.0f, splits);
+		CHECK(IsNear(splits[1], std::pow(100.0f, 0.25f)));
+		CHECK(IsNear(splits[2], 10.0f));
+		CHECK(IsNear(splits[4], 100.0f));
+
+		// Lambda is clamped; blend lies between both schemes.
+		std::array<float, 5> clamped{};
+		ShadowMap::ComputeSplits(1.0f, 100.0f, 4.0f, clamped);
+		CHECK(clamped == splits);
+
+		std::array<float, 5> blend{};
+		ShadowMap::ComputeSplits(1.0f, 100.0f, 0.5f, blend);
+		for (uint32 i = 1; i < 4; ++i)
+		{
+			CHECK(blend[i] > splits[i] && blend[i] < 1.0f + 24.75f * i);
+			CHECK(blend[i] > blend[i - 1]);
+		}
+
+		// Degenerate planes.
+		std::array<float, 3> degenerate{};
+		ShadowMap::ComputeSplits(0.0f, -5.0f, 0.5f, degenerate);
+		CHECK(degenerate[0] > 0.0f);
+		CHECK_EQ(degenerate[2], degenerate[0]);
+	}
+
+	void TestCascadeFit()
+	{
+		ShadowMap shadowMap(Resolution, 4);
+		const XMMATRIX view = CreateView({ 0.0f, 5.0f, -10.0f }, { 0.0f, 5.0f, 0.0f });
+		shadowMap.Update(view, CreateProjection(), zNear, zFar, { 0.3f, -1.0f, 0.2f }, {});
+
+		// Far plane is clamped to MaxDistance.
+		std::array<float, 5> splits{};
+		ShadowMap::ComputeSplits(zNear, shadowMap.MaxDistance, shadowMap.SplitLambda, splits);
+
+		for (uint32 i = 0; i < shadowMap.GetCascadeCount(); ++i)
+		{
+			const ShadowCascade& cascade = shadowMap.GetCascade(i);
+			CHECK(IsNear(cascade.SplitNear, splits[i]));
+			CHECK(IsNear(cascade.SplitFar, splits[i + 1]));
+			CHECK(IsNear(cascade.TexelSize, 2.0f * cascade.Radius / Resolution));
+
+			// Sphere is at least as wide as the far end of its slice.
+			const float tanY = std::tan(XM_PIDIV4 * 0.5f);
+			const float tanX = tanY * 16.0f / 9.0f;
+			CHECK(cascade.Radius >= cascade.SplitFar * std::sqrt(tanX * tanX + tanY * tanY));
+
+			// Radius is quantized to 1/16.
+			CHECK(IsWhole(cascade.Radius * 16.0f));
+
+			if (i > 0)
+			{
+				CHECK(cascade.Radius >= shadowMap.GetCascade(i - 1).Radius);
+			}
+		}
+		CHECK(IsNear(shadowMap.GetCascade(3).SplitFar, shadowMap.MaxDistance));
+
+		// Cascade count is clamped.
+		CHECK_EQ(ShadowMap(Resolution, 0).GetCascadeCount(), 1u);
+		CHECK_EQ(ShadowMap(Resolution, 9).GetCascadeCount(), MAX_SHADOW_CASCADES);
+	}
+
+	void TestTexelSnapping()
+	{
+		ShadowMap shadowMap(Resolution, 4);
+		const XMFLOAT3 light = { 0.3f, -1.0f, 0.2f };
+
+		shadowMap.Update(CreateView({ 0.0f, 5.0f, -10.0f }, { 0.0f, 5.0f, 0.0f }), CreateProjection(), zNear, zFar, light, {});
+
+		std::array<ShadowCascade, MAX_SHADOW_CASCADES> previous{};
+		for (uint32 i = 0; i < shadowMap.GetCascadeCount(); ++i)
+		{
+			previous[i] = shadowMap.GetCascade(i);
+
+			// Centers sit on the texel grid.
+			const XMFLOAT3 center = GetTexelCenter(previous[i]);
+			CHECK(IsWhole(center.x));
+			CHECK(IsWhole(center.y));
+		}
+
+		// Sub-texel camera moves shift cascades by a whole texel or not at all.
+		const float step = previous[0].TexelSize * 0.3f;
+		for (uint32 move = 1; move <= 8; ++move)
+		{
+			const float x = step * move;
+			shadowMap.Update(CreateView({ x, 5.0f, -10.0f }, { x, 5.0f, 0.0f }), CreateProjection(), zNear, zFar, light, {});
+
+			for (uint32 i = 0; i < shadowMap.GetCascadeCount(); ++i)
+			{
+				const ShadowCascade& cascade = shadowMap.GetCascade(i);
+				CHECK_EQ(cascade.Radius, previous[i].Radius);
+
+				const XMFLOAT3 before	= GetTexelCenter(previous[i]);
+				const XMFLOAT3 after	= GetTexelCenter(cascade);
+				CHECK(IsWhole(after.x - before.x));
+				CHECK(IsWhole(after.y - before.y));
+				CHECK(std::abs(after.x - before.x) <= 1.01f);
+
+				previous[i] = cascade;
+			}
+		}
+
+		// Rotating camera keeps the radius, so texel size never changes.
+		for (const float yaw : { 0.5f, 1.5f, 3.0f })
+		{
+			const XMFLOAT3 eye = { 0.0f, 5.0f, -10.0f };
+			shadowMap.Update(CreateView(eye, { std::sin(yaw) * 10.0f, 5.0f, -10.0f + std::cos(yaw) * 10.0f }),
+				CreateProjection(), zNear, zFar, light, {});
+
+			for (uint32 i = 0; i < shadowMap.GetCascadeCount(); ++i)
+			{
+				CHECK_EQ(shadowMap.GetCascade(i).Radius, previous[i].Radius);
+				CHECK_EQ(shadowMap.GetCascade(i).TexelSize, previous[i].TexelSize);
+			}
+		}
+	}
+
+	void TestCasters()
+	{
+		ShadowMap shadowMap(Resolution, 4);
+
+		const std::vector<BoundingBox> bounds = {
+			// Ground under the camera; receives in every cascade.
+			{ { -500.0f, -1.0f, -500.0f }, { 500.0f, 0.0f, 500.0f } },
+			// High above visible area, but between light and ground.
+			{ { -1.0f, 100.0f, 9.0f }, { 1.0f, 101.0f, 11.0f } },
+			// Far away from every cascade.
+			{ { 10000.0f, 0.0f, 10000.0f }, { 10001.0f, 1.0f, 10001.0f } },
+		};
+
+		// Light straight down.
+		shadowMap.Update(CreateView({ 0.0f, 5.0f, -10.0f }, { 0.0f, 5.0f, 0.0f }), CreateProjection(), zNear, zFar,
+			{ 0.0f, -1.0f, 0.0f }, bounds);
+
+		const ShadowMapStats& stats = shadowMap.GetStats();
+		CHECK_EQ(stats.Casters, 3u);
+
+		for (uint32 i = 0; i < shadowMap.GetCascadeCount(); ++i)
+		{
+			CHECK(stats.CascadeReceivers[i] >= 1u);
+
+			const auto casters = shadowMap.GetCasters(i);
+			CHECK_EQ(stats.CascadeCasters[i], static_cast<uint32>(casters.size()));
+			CHECK(std::find(casters.begin(), casters.end(), 0u) != casters.end());
+			CHECK(std::find(casters.begin(), casters.end(), 2u) == casters.end());
+			CHECK(std::is_sorted(casters.begin(), casters.end()));
+		}
+
+		// Caster outside of the cascade sphere still shadows it; near plane is pulled back to it.
+		const auto casters = shadowMap.GetCasters(0);
+		CHECK(std::find(casters.begin(), casters.end(), 1u) != casters.end());
+
+		const ShadowCascade& cascade = shadowMap.GetCascade(0);
+		const BoundingBox tower = ShadowMap::TransformBounds(bounds[1], XMLoadFloat4x4(&cascade.View));
+		CHECK(cascade.LightNear <= tower.Min.z);
+		CHECK(cascade.LightFar > cascade.LightNear);
+	}
+
+	void TestTransformBounds()
+	{
+		const BoundingBox box = { { -1.0f, -2.0f, -3.0f }, { 1.0f, 2.0f, 3.0f } };
+
+		const BoundingBox moved = ShadowMap::TransformBounds(box, XMMatrixTranslation(10.0f, 0.0f, 0.0f));
+		CHECK(IsNear(moved.Min.x, 9.0f));
+		CHECK(IsNear(moved.Max.x, 11.0f));
+		CHECK(IsNear(moved.Max.z, 3.0f));
+
+		// 90 degrees around Y swaps X and Z extents.
+		XMMATRIX rotation = XMMatrixIdentity();
+		rotation.r[0] = XMVectorSet(0.0f, 0.0f, -1.0f, 0.0f);
+		rotation.r[2] = XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+		const BoundingBox rotated = ShadowMap::TransformBounds(box, rotation);
+		CHECK(IsNear(rotated.Min.x, -3.0f));
+		CHECK(IsNear(rotated.Max.x, 3.0f));
+		CHECK(IsNear(rotated.Min.z, -1.0f));
+		CHECK(IsNear(rotated.Max.z, 1.0f));
+	}
+} // namespace
+
+int main()
+{
+	TestSplits();
+	TestCascadeFit();
+	TestTexelSnapping();
+	TestCasters();
+	TestTransformBounds();
+
+	return Test::Report("ShadowMap");
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/*
+	Tests/Test.hpp
+	Minimal checks shared by test executables.
+	Each test is a standalone executable that builds only sources it covers, so no graphics device is needed.
+*/
+
+#include <cstdio>
+
+namespace lde::Test
+{
+	inline int& GetFailures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	inline bool Check(bool bCondition, const char* Expression, const char* File, int Line)
+	{
+		if (!bCondition)
+		{
+			std::fprintf(stderr, "%s(%d): check failed: %s\n", File, Line, Expression);
+			++GetFailures();
+		}
+
+		return bCondition;
+	}
+
+	/// @return Exit code for main().
+	inline int Report(const char* Name)
+	{
+		if (GetFailures() > 0)
+		{
+			std::fprintf(stderr, "%s: %d check(s) failed\n", Name, GetFailures());
+			return 1;
+		}
+
+		std::printf("%s: passed\n", Name);
+		return 0;
+	}
+} // namespace lde::Test
+
+#define CHECK(Expression) ::lde::Test::Check(static_cast<bool>(Expression), #Expression, __FILE__, __LINE__)
+#define CHECK_EQ(Lhs, Rhs) ::lde::Test::Check((Lhs) == (Rhs), #Lhs " == " #Rhs, __FILE__, __LINE__)
@@ -0,0 +1,175 @@
+#include "RHI/UploadQueue.hpp"
+#include "Test.hpp"
+#include <vector>
+
+using namespace lde;
+
+namespace
+{
+	// Stands in for a GPU fence; values complete only when told to.
+	struct FakeFence
+	{
+		uint64 Signaled		= 0;
+		uint64 Completed	= 0;
+
+		uint64 Signal() { return ++Signaled; }
+		void Complete(uint64 Value) { Completed = Value; }
+	};
+
+	enum State : uint32
+	{
+		eVertexBuffer = 1,
+		eIndexBuffer,
+	};
+
+	constexpr uint64 RingSize	= 1024;
+	constexpr uint64 Alignment	= 256;
+
+	/// @brief What D3D12Device does around ExecuteCommandLists: flush into the list, submit it, then signal.
+	void Execute(UploadQueue& Queue, FakeFence& Fence, std::vector<BufferCopy>& OutRecorded)
+	{
+		Queue.Flush(OutRecorded);
+		if (Queue.NeedsSignal())
+		{
+			Queue.Submit(Fence.Signal());
+		}
+	}
+
+	void TestBatching()
+	{
+		UploadQueue queue(RingSize, Alignment);
+		FakeFence fence;
+
+		CHECK_EQ(queue.Queue(1, 100, eVertexBuffer), 0u);
+		CHECK_EQ(queue.Queue(2, 300, eIndexBuffer), 256u);
+		CHECK_EQ(queue.Queue(3, 10, eVertexBuffer), 768u);
+		CHECK_EQ(queue.GetQueuedCopies(), 3u);
+
+		// Nothing is recorded, so there's nothing to wait for yet.
+		CHECK(!queue.NeedsSignal());
+
+		// Every copy ends up in a single list, in queue order.
+		std::vector<BufferCopy> recorded;
+		Execute(queue, fence, recorded);
+		CHECK_EQ(recorded.size(), 3u);
+		CHECK_EQ(recorded.at(0).Destination, 1u);
+		CHECK_EQ(recorded.at(1).Destination, 2u);
+		CHECK_EQ(recorded.at(1).Offset, 256u);
+		CHECK_EQ(recorded.at(1).Size, 300u);
+		CHECK_EQ(recorded.at(1).State, static_cast<uint32>(eIndexBuffer));
+		CHECK_EQ(recorded.at(2).Destination, 3u);
+		CHECK(!queue.HasQueuedCopies());
+
+		const UploadQueueStats stats = queue.GetStats();
+		CHECK_EQ(stats.Queued, 3u);
+		CHECK_EQ(stats.Flushes, 1u);
+		CHECK_EQ(stats.Batches, 1u);
+		CHECK_EQ(queue.GetAllocator().GetPendingBatches(), 1u);
+		CHECK_EQ(queue.GetAllocator().GetOldestFenceValue(), fence.Signaled);
+
+		// Executing a list without uploads neither flushes nor signals.
+		recorded.clear();
+		Execute(queue, fence, recorded);
+		CHECK(recorded.empty());
+		CHECK_EQ(queue.GetStats().Flushes, 1u);
+		CHECK_EQ(queue.GetStats().Batches, 1u);
+		CHECK_EQ(fence.Signaled, 1u);
+
+		// Space comes back once GPU is done with the batch.
+		CHECK_EQ(queue.Retire(fence.Completed), 0u);
+		fence.Complete(fence.Signaled);
+		CHECK_EQ(queue.Retire(fence.Completed), 1u);
+		CHECK_EQ(queue.GetAllocator().GetUsedSize(), 0u);
+	}
+
+	void TestFullRing()
+	{
+		UploadQueue queue(RingSize, Alignment);
+		FakeFence fence;
+		std::vector<BufferCopy> recorded;
+
+		for (uint64 i = 0; i < 4; ++i)
+		{
+			CHECK(queue.Queue(i, Alignment, eVertexBuffer) != RingAllocator::InvalidOffset);
+		}
+
+		// Ring is full of queued copies; D3D12Buffer::Create executes the list and retries.
+		CHECK_EQ(queue.Queue(4, Alignment, eVertexBuffer), RingAllocator::InvalidOffset);
+		CHECK_EQ(queue.GetStats().Rejected, 1u);
+		CHECK_EQ(queue.GetQueuedCopies(), 4u);
+
+		Execute(queue, fence, recorded);
+		// Execution waits for GPU.
+		fence.Complete(fence.Signaled);
+		queue.Retire(fence.Completed);
+
+		CHECK_EQ(queue.Queue(4, Alignment, eVertexBuffer), 0u);
+		CHECK_EQ(recorded.size(), 4u);
+
+		// Batch still in flight keeps its space.
+		Execute(queue, fence, recorded);
+		for (uint64 i = 5; i < 8; ++i)
+		{
+			CHECK(queue.Queue(i, Alignment, eVertexBuffer) != RingAllocator::InvalidOffset);
+		}
+		CHECK_EQ(queue.Queue(8, Alignment, eVertexBuffer), RingAllocator::InvalidOffset);
+		CHECK_EQ(queue.Retire(fence.Completed), 0u);
+
+		fence.Complete(fence.Signaled);
+		CHECK_EQ(queue.Retire(fence.Completed), 1u);
+		CHECK_EQ(queue.Queue(8, Alignment, eVertexBuffer), 0u);
+
+		// Larger than the whole ring never fits; caller takes dedicated path.
+		CHECK_EQ(queue.Queue(9, RingSize + 1, eVertexBuffer), RingAllocator::InvalidOffset);
+	}
+
+	void TestQueuedAfterFlush()
+	{
+		UploadQueue queue(RingSize, Alignment);
+		FakeFence fence;
+		std::vector<BufferCopy> recorded;
+
+		// Frame start flushes into Graphics list; more uploads are queued while the frame is recorded.
+		CHECK(queue.Queue(1, Alignment, eVertexBuffer) != RingAllocator::InvalidOffset);
+		queue.Flush(recorded);
+		CHECK(queue.NeedsSignal());
+		CHECK(queue.Queue(2, Alignment, eVertexBuffer) != RingAllocator::InvalidOffset);
+
+		// Worker list submission of previous frame signals before the second copy is recorded.
+		// Tagging now would free second copy's space as soon as that value completes.
+		CHECK(!queue.NeedsSignal());
+		queue.Submit(fence.Signal());
+		CHECK_EQ(queue.GetAllocator().GetPendingBatches(), 0u);
+		CHECK_EQ(queue.GetStats().Batches, 0u);
+
+		fence.Complete(fence.Signaled);
+		queue.Retire(fence.Completed);
+		CHECK_EQ(queue.GetAllocator().GetUsedSize(), 2 * Alignment);
+
+		// End of frame records the rest; one batch covers both copies.
+		Execute(queue, fence, recorded);
+		CHECK_EQ(recorded.size(), 2u);
+		CHECK_EQ(queue.GetAllocator().GetPendingBatches(), 1u);
+		CHECK_EQ(queue.GetStats().Flushes, 2u);
+		CHECK_EQ(queue.GetStats().Batches, 1u);
+
+		fence.Complete(fence.Signaled);
+		CHECK_EQ(queue.Retire(fence.Completed), 1u);
+		CHECK_EQ(queue.GetAllocator().GetUsedSize(), 0u);
+
+		// Released backend drops queued copies; their space returns with the next batch.
+		CHECK(queue.Queue(3, 100, eVertexBuffer) != RingAllocator::InvalidOffset);
+		queue.Clear();
+		CHECK(!queue.HasQueuedCopies());
+		CHECK(queue.NeedsSignal());
+	}
+} // namespace
+
+int main()
+{
+	TestBatching();
+	TestFullRing();
+	TestQueuedAfterFlush();
+
+	return Test::Report("UploadQueue");
+}